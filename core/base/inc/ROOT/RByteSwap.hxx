@@ -0,0 +1,40 @@
+/// \file ROOT/RByteSwap.hxx
+/// \date 2020-10-17
+
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RByteSwap
+#define ROOT_RByteSwap
+
+#include <cstddef>
+
+namespace ROOT {
+namespace Internal {
+
+/// The instruction sets for which a byte-swapping copy kernel is available. The best kernel supported by the CPU is
+/// selected the first time one of the ByteSwapCopy functions is called.
+enum class EByteSwapKernel { kScalar, kSSSE3, kAVX2, kAVX512, kNEON };
+
+/// Copy `n` elements of 2, 4 or 8 bytes from `from` to `to`, reversing the byte order of each element. This converts
+/// arrays between the host byte order of little-endian machines and the big-endian order of ROOT files.
+/// The buffers do not need to be aligned. They must either be the same buffer (in-place swap) or not overlap.
+void ByteSwapCopy16(void *to, const void *from, std::size_t n);
+void ByteSwapCopy32(void *to, const void *from, std::size_t n);
+void ByteSwapCopy64(void *to, const void *from, std::size_t n);
+
+/// Return the kernel used by the ByteSwapCopy functions.
+EByteSwapKernel GetByteSwapKernel();
+/// Use the given kernel in the ByteSwapCopy functions, e.g. for testing or benchmarking. Return false and leave the
+/// kernel unchanged if the CPU does not support it.
+bool SetByteSwapKernel(EByteSwapKernel kernel);
+
+} // namespace Internal
+} // namespace ROOT
+
+#endif
@@ -0,0 +1,272 @@
+/// \file RByteSwap.cxx
+/// \date 2020-10-17
+
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/RByteSwap.hxx"
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+
+// Kernels for the x86 vector extensions are compiled with per-function target attributes and selected at runtime,
+// so that the library does not require a CPU more recent than the one it is compiled for.
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__)) && !defined(__INTEL_COMPILER)
+#define R__BYTESWAP_X86
+#include <immintrin.h>
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#define R__BYTESWAP_NEON
+#include <arm_neon.h>
+#endif
+
+namespace {
+
+using ROOT::Internal::EByteSwapKernel;
+
+inline std::uint16_t Swap(std::uint16_t x)
+{
+   return (x >> 8) | (x << 8);
+}
+
+inline std::uint32_t Swap(std::uint32_t x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+   return __builtin_bswap32(x);
+#else
+   return ((x & 0x000000ffU) << 24) | ((x & 0x0000ff00U) << 8) | ((x & 0x00ff0000U) >> 8) | ((x & 0xff000000U) >> 24);
+#endif
+}
+
+inline std::uint64_t Swap(std::uint64_t x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+   return __builtin_bswap64(x);
+#else
+   return (std::uint64_t(Swap(std::uint32_t(x))) << 32) | Swap(std::uint32_t(x >> 32));
+#endif
+}
+
+/// Byte-swap `n` elements of type T. Elements are accessed through memcpy because the buffers need not be aligned.
+template <typename T>
+void CopyScalar(void *to, const void *from, std::size_t n)
+{
+   auto dst = static_cast<unsigned char *>(to);
+   auto src = static_cast<const unsigned char *>(from);
+   for (std::size_t i = 0; i < n; ++i) {
+      T x;
+      std::memcpy(&x, src + i * sizeof(T), sizeof(T));
+      x = Swap(x);
+      std::memcpy(dst + i * sizeof(T), &x, sizeof(T));
+   }
+}
+
+/// Byte shuffle patterns that reverse each element of a 16 bytes lane, for elements of 2, 4 and 8 bytes
+alignas(16) const unsigned char kShuffle16[16] = {1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14};
+alignas(16) const unsigned char kShuffle32[16] = {3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12};
+alignas(16) const unsigned char kShuffle64[16] = {7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8};
+
+template <typename T>
+const unsigned char *GetShuffle();
+template <>
+const unsigned char *GetShuffle<std::uint16_t>()
+{
+   return kShuffle16;
+}
+template <>
+const unsigned char *GetShuffle<std::uint32_t>()
+{
+   return kShuffle32;
+}
+template <>
+const unsigned char *GetShuffle<std::uint64_t>()
+{
+   return kShuffle64;
+}
+
+#ifdef R__BYTESWAP_X86
+// Each vector is loaded before it is stored, so that the kernels also work in place.
+
+template <typename T>
+__attribute__((target("ssse3"))) void CopySSSE3(void *to, const void *from, std::size_t n)
+{
+   auto dst = static_cast<unsigned char *>(to);
+   auto src = static_cast<const unsigned char *>(from);
+   const std::size_t nBytes = n * sizeof(T);
+   const __m128i shuffle = _mm_load_si128(reinterpret_cast<const __m128i *>(GetShuffle<T>()));
+   std::size_t i = 0;
+   for (; i + 16 <= nBytes; i += 16) {
+      const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), _mm_shuffle_epi8(v, shuffle));
+   }
+   CopyScalar<T>(dst + i, src + i, (nBytes - i) / sizeof(T));
+}
+
+template <typename T>
+__attribute__((target("avx2"))) void CopyAVX2(void *to, const void *from, std::size_t n)
+{
+   auto dst = static_cast<unsigned char *>(to);
+   auto src = static_cast<const unsigned char *>(from);
+   const std::size_t nBytes = n * sizeof(T);
+   const __m256i shuffle =
+      _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i *>(GetShuffle<T>())));
+   std::size_t i = 0;
+   for (; i + 64 <= nBytes; i += 64) {
+      const __m256i v0 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+      const __m256i v1 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i + 32));
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), _mm256_shuffle_epi8(v0, shuffle));
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i + 32), _mm256_shuffle_epi8(v1, shuffle));
+   }
+   for (; i + 32 <= nBytes; i += 32) {
+      const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), _mm256_shuffle_epi8(v, shuffle));
+   }
+   CopyScalar<T>(dst + i, src + i, (nBytes - i) / sizeof(T));
+}
+
+template <typename T>
+__attribute__((target("avx512f,avx512bw"))) void CopyAVX512(void *to, const void *from, std::size_t n)
+{
+   auto dst = static_cast<unsigned char *>(to);
+   auto src = static_cast<const unsigned char *>(from);
+   const std::size_t nBytes = n * sizeof(T);
+   const __m512i shuffle =
+      _mm512_broadcast_i32x4(_mm_load_si128(reinterpret_cast<const __m128i *>(GetShuffle<T>())));
+   std::size_t i = 0;
+   for (; i + 64 <= nBytes; i += 64) {
+      const __m512i v = _mm512_loadu_si512(src + i);
+      _mm512_storeu_si512(dst + i, _mm512_shuffle_epi8(v, shuffle));
+   }
+   // the remainder is handled with a masked load and store of whole elements
+   const std::size_t nRest = nBytes - i;
+   if (nRest > 0) {
+      const __mmask64 mask = (__mmask64(1) << nRest) - 1;
+      const __m512i v = _mm512_maskz_loadu_epi8(mask, src + i);
+      _mm512_mask_storeu_epi8(dst + i, mask, _mm512_shuffle_epi8(v, shuffle));
+   }
+}
+#endif // R__BYTESWAP_X86
+
+#ifdef R__BYTESWAP_NEON
+inline uint8x16_t SwapNEON(uint8x16_t v, std::uint16_t)
+{
+   return vrev16q_u8(v);
+}
+inline uint8x16_t SwapNEON(uint8x16_t v, std::uint32_t)
+{
+   return vrev32q_u8(v);
+}
+inline uint8x16_t SwapNEON(uint8x16_t v, std::uint64_t)
+{
+   return vrev64q_u8(v);
+}
+
+template <typename T>
+void CopyNEON(void *to, const void *from, std::size_t n)
+{
+   auto dst = static_cast<unsigned char *>(to);
+   auto src = static_cast<const unsigned char *>(from);
+   const std::size_t nBytes = n * sizeof(T);
+   std::size_t i = 0;
+   for (; i + 16 <= nBytes; i += 16)
+      vst1q_u8(dst + i, SwapNEON(vld1q_u8(src + i), T()));
+   CopyScalar<T>(dst + i, src + i, (nBytes - i) / sizeof(T));
+}
+#endif // R__BYTESWAP_NEON
+
+using Copy_t = void (*)(void *, const void *, std::size_t);
+
+struct RKernels {
+   EByteSwapKernel fKernel;
+   Copy_t fCopy16;
+   Copy_t fCopy32;
+   Copy_t fCopy64;
+};
+
+const RKernels kScalarKernels{EByteSwapKernel::kScalar, CopyScalar<std::uint16_t>, CopyScalar<std::uint32_t>,
+                              CopyScalar<std::uint64_t>};
+#ifdef R__BYTESWAP_X86
+const RKernels kSSSE3Kernels{EByteSwapKernel::kSSSE3, CopySSSE3<std::uint16_t>, CopySSSE3<std::uint32_t>,
+                             CopySSSE3<std::uint64_t>};
+const RKernels kAVX2Kernels{EByteSwapKernel::kAVX2, CopyAVX2<std::uint16_t>, CopyAVX2<std::uint32_t>,
+                            CopyAVX2<std::uint64_t>};
+const RKernels kAVX512Kernels{EByteSwapKernel::kAVX512, CopyAVX512<std::uint16_t>, CopyAVX512<std::uint32_t>,
+                              CopyAVX512<std::uint64_t>};
+#endif
+#ifdef R__BYTESWAP_NEON
+const RKernels kNEONKernels{EByteSwapKernel::kNEON, CopyNEON<std::uint16_t>, CopyNEON<std::uint32_t>,
+                            CopyNEON<std::uint64_t>};
+#endif
+
+/// Return the kernels for the given instruction set, or nullptr if it is not supported by this build or this CPU
+const RKernels *FindKernels(EByteSwapKernel kernel)
+{
+   switch (kernel) {
+   case EByteSwapKernel::kScalar: return &kScalarKernels;
+#ifdef R__BYTESWAP_X86
+   case EByteSwapKernel::kSSSE3: return __builtin_cpu_supports("ssse3") ? &kSSSE3Kernels : nullptr;
+   case EByteSwapKernel::kAVX2: return __builtin_cpu_supports("avx2") ? &kAVX2Kernels : nullptr;
+   case EByteSwapKernel::kAVX512:
+      return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") ? &kAVX512Kernels : nullptr;
+#endif
+#ifdef R__BYTESWAP_NEON
+   case EByteSwapKernel::kNEON: return &kNEONKernels;
+#endif
+   default: return nullptr;
+   }
+}
+
+const RKernels *FindBestKernels()
+{
+   for (auto kernel : {EByteSwapKernel::kAVX512, EByteSwapKernel::kAVX2, EByteSwapKernel::kSSSE3,
+                       EByteSwapKernel::kNEON}) {
+      if (auto kernels = FindKernels(kernel))
+         return kernels;
+   }
+   return &kScalarKernels;
+}
+
+std::atomic<const RKernels *> &GetKernels()
+{
+   static std::atomic<const RKernels *> kernels{FindBestKernels()};
+   return kernels;
+}
+
+} // anonymous namespace
+
+void ROOT::Internal::ByteSwapCopy16(void *to, const void *from, std::size_t n)
+{
+   GetKernels().load(std::memory_order_relaxed)->fCopy16(to, from, n);
+}
+
+void ROOT::Internal::ByteSwapCopy32(void *to, const void *from, std::size_t n)
+{
+   GetKernels().load(std::memory_order_relaxed)->fCopy32(to, from, n);
+}
+
+void ROOT::Internal::ByteSwapCopy64(void *to, const void *from, std::size_t n)
+{
+   GetKernels().load(std::memory_order_relaxed)->fCopy64(to, from, n);
+}
+
+ROOT::Internal::EByteSwapKernel ROOT::Internal::GetByteSwapKernel()
+{
+   return GetKernels().load(std::memory_order_relaxed)->fKernel;
+}
+
+bool ROOT::Internal::SetByteSwapKernel(EByteSwapKernel kernel)
+{
+   auto kernels = FindKernels(kernel);
+   if (!kernels)
+      return false;
+   GetKernels().store(kernels, std::memory_order_relaxed);
+   return true;
+}
@@ -0,0 +1,80 @@
+#include "gtest/gtest.h"
+
+#include "ROOT/RByteSwap.hxx"
+
+#include <cstddef>
+#include <vector>
+
+using ROOT::Internal::EByteSwapKernel;
+
+namespace {
+/// Restores the automatically selected kernel at the end of a test
+class RKernelGuard {
+   EByteSwapKernel fKernel;
+
+public:
+   RKernelGuard() : fKernel(ROOT::Internal::GetByteSwapKernel()) {}
+   ~RKernelGuard() { ROOT::Internal::SetByteSwapKernel(fKernel); }
+};
+
+using Copy_t = void (*)(void *, const void *, std::size_t);
+
+/// Check the kernel against the expected byte order, for several sizes and buffer offsets, out-of-place and in place
+void CheckKernel(Copy_t copy, std::size_t width)
+{
+   for (std::size_t n = 0; n < 150; ++n) {
+      for (std::size_t offset = 0; offset < 8; ++offset) {
+         const std::size_t nBytes = n * width;
+         std::vector<unsigned char> src(nBytes + 16);
+         for (std::size_t i = 0; i < src.size(); ++i)
+            src[i] = static_cast<unsigned char>(i * 7 + 1);
+         std::vector<unsigned char> dst(nBytes + 16, 0xaa);
+
+         copy(dst.data() + offset, src.data() + offset, n);
+         for (std::size_t i = 0; i < n; ++i)
+            for (std::size_t b = 0; b < width; ++b)
+               ASSERT_EQ(src[offset + i * width + width - 1 - b], dst[offset + i * width + b]);
+         // the kernel must not write past the end of the array
+         EXPECT_EQ(0xaa, dst[offset + nBytes]);
+
+         copy(src.data() + offset, src.data() + offset, n);
+         for (std::size_t i = offset; i < offset + nBytes; ++i)
+            ASSERT_EQ(dst[i], src[i]);
+      }
+   }
+}
+} // anonymous namespace
+
+TEST(RByteSwap, Kernels)
+{
+   RKernelGuard guard;
+   for (auto kernel : {EByteSwapKernel::kScalar, EByteSwapKernel::kSSSE3, EByteSwapKernel::kAVX2,
+                       EByteSwapKernel::kAVX512, EByteSwapKernel::kNEON}) {
+      if (!ROOT::Internal::SetByteSwapKernel(kernel))
+         continue;
+      EXPECT_EQ(kernel, ROOT::Internal::GetByteSwapKernel());
+      CheckKernel(ROOT::Internal::ByteSwapCopy16, 2);
+      CheckKernel(ROOT::Internal::ByteSwapCopy32, 4);
+      CheckKernel(ROOT::Internal::ByteSwapCopy64, 8);
+   }
+}
+
+TEST(RByteSwap, Values)
+{
+   unsigned short s = 0x0102;
+   ROOT::Internal::ByteSwapCopy16(&s, &s, 1);
+   EXPECT_EQ(0x0201, s);
+   unsigned int i = 0x01020304u;
+   ROOT::Internal::ByteSwapCopy32(&i, &i, 1);
+   EXPECT_EQ(0x04030201u, i);
+   unsigned long long l = 0x0102030405060708ull;
+   ROOT::Internal::ByteSwapCopy64(&l, &l, 1);
+   EXPECT_EQ(0x0807060504030201ull, l);
+}
+
+TEST(RByteSwap, ScalarAlwaysAvailable)
+{
+   RKernelGuard guard;
+   EXPECT_TRUE(ROOT::Internal::SetByteSwapKernel(EByteSwapKernel::kScalar));
+   EXPECT_EQ(EByteSwapKernel::kScalar, ROOT::Internal::GetByteSwapKernel());
+}
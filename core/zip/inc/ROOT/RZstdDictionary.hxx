@@ -0,0 +1,76 @@
+/// \file ROOT/RZstdDictionary.hxx
+/// \date 2020-10-17
+
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RZstdDictionary
+#define ROOT_RZstdDictionary
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace ROOT {
+namespace Internal {
+
+/// A zstd dictionary, trained on samples of the data that it compresses, e.g. the first baskets of a branch.
+/// Small buffers of similar content compress much better, and decompress faster, with a dictionary.
+///
+/// Buffers compressed with a dictionary start with a "ZD" block header instead of the "ZS" header used by
+/// R__zipMultipleAlgorithm for zstd. R__unzip_header() understands this header but R__unzip() cannot decompress
+/// such buffers: they must be passed to Decompress() of the same dictionary.
+///
+/// The digested forms of the dictionary used by zstd are built on first use and cached, for compression once per
+/// compression level. Compress() and Decompress() can be called concurrently.
+class RZstdDictionary {
+   struct RDigestedCDict;
+   struct RDigestedDDict;
+
+   std::vector<char> fContent;
+   unsigned int fId = 0;
+   mutable std::mutex fCDictMutex;
+   mutable std::once_flag fDDictFlag;
+   mutable std::map<int, std::unique_ptr<RDigestedCDict>> fCDicts; ///< Digested dictionaries by compression level
+   mutable std::unique_ptr<RDigestedDDict> fDDict;
+
+public:
+   /// Samples are split in pieces of at most this size for the training.
+   static constexpr std::size_t kMaxSampleSize = 4096;
+
+   /// Use the given content, e.g. read back from a file, as a dictionary.
+   explicit RZstdDictionary(std::vector<char> content);
+   RZstdDictionary(const RZstdDictionary &) = delete;
+   RZstdDictionary &operator=(const RZstdDictionary &) = delete;
+   ~RZstdDictionary();
+
+   /// Train a dictionary of at most `maxSize` bytes on the `nSamples` samples stored one after the other in `samples`.
+   /// Return nullptr if zstd cannot build a dictionary from them, e.g. because there are too few samples.
+   static std::unique_ptr<RZstdDictionary>
+   Train(const char *samples, const std::size_t *sampleSizes, unsigned int nSamples, std::size_t maxSize);
+
+   const std::vector<char> &GetContent() const { return fContent; }
+   /// The zstd dictionary ID, also stored in the frames compressed with this dictionary.
+   unsigned int GetId() const { return fId; }
+
+   /// Compress `src` into `tgt`, with the same arguments and return value (`irep`) as R__zipMultipleAlgorithm.
+   void Compress(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, int *irep) const;
+   /// Decompress a block compressed by Compress(), with the same arguments and return value (`irep`) as R__unzip.
+   /// Blocks that were not compressed with a dictionary are passed on to R__unzip.
+   void Decompress(int *srcsize, unsigned char *src, int *tgtsize, unsigned char *tgt, int *irep) const;
+
+   /// Whether the compressed block starting at `src` was compressed with a dictionary.
+   static bool IsCompressedWithDictionary(const unsigned char *src) { return src[0] == 'Z' && src[1] == 'D'; }
+};
+
+} // namespace Internal
+} // namespace ROOT
+
+#endif
@@ -272,10 +272,16 @@ static int is_valid_header_zstd(unsigned char *src)
    return src[0] == 'Z' && src[1] == 'S' && src[2] == '\1';
 }
 
+// Buffers compressed with a zstd dictionary, see ROOT::Internal::RZstdDictionary
+static int is_valid_header_zstd_dict(unsigned char *src)
+{
+   return src[0] == 'Z' && src[1] == 'D' && src[2] == '\1';
+}
+
 static int is_valid_header(unsigned char *src)
 {
    return is_valid_header_zlib(src) || is_valid_header_old(src) || is_valid_header_lzma(src) ||
-          is_valid_header_lz4(src) || is_valid_header_zstd(src);
+          is_valid_header_lz4(src) || is_valid_header_zstd(src) || is_valid_header_zstd_dict(src);
 }
 
 int R__unzip_header(int *srcsize, uch *src, int *tgtsize)
@@ -368,6 +374,9 @@ void R__unzip(int *srcsize, uch *src, int *tgtsize, uch *tgt, int *irep)
    } else if (is_valid_header_zstd(src)) {
       R__unzipZSTD(srcsize, src, tgtsize, tgt, irep);
       return;
+   } else if (is_valid_header_zstd_dict(src)) {
+      fprintf(stderr, "R__unzip: buffer was compressed with a zstd dictionary, which is not available here\n");
+      return;
    }
 
    /* Old zlib format */
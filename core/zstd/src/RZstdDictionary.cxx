@@ -0,0 +1,146 @@
+/// \file RZstdDictionary.cxx
+/// \date 2020-10-17
+
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/RZstdDictionary.hxx"
+#include "RZip.h"
+
+#include "ROOT/RConfig.hxx"
+
+#include "zdict.h"
+#include <zstd.h>
+
+#include <iostream>
+
+static const int kHeaderSize = 9;
+
+static const size_t errorCodeSmallBuffer = (size_t)-70;
+
+struct ROOT::Internal::RZstdDictionary::RDigestedCDict {
+   ZSTD_CDict *fCDict;
+   RDigestedCDict(const std::vector<char> &content, int level)
+      : fCDict(ZSTD_createCDict(content.data(), content.size(), level))
+   {
+   }
+   ~RDigestedCDict() { ZSTD_freeCDict(fCDict); }
+};
+
+struct ROOT::Internal::RZstdDictionary::RDigestedDDict {
+   ZSTD_DDict *fDDict;
+   RDigestedDDict(const std::vector<char> &content) : fDDict(ZSTD_createDDict(content.data(), content.size())) {}
+   ~RDigestedDDict() { ZSTD_freeDDict(fDDict); }
+};
+
+ROOT::Internal::RZstdDictionary::RZstdDictionary(std::vector<char> content)
+   : fContent(std::move(content)), fId(ZDICT_getDictID(fContent.data(), fContent.size()))
+{
+}
+
+ROOT::Internal::RZstdDictionary::~RZstdDictionary() = default;
+
+std::unique_ptr<ROOT::Internal::RZstdDictionary>
+ROOT::Internal::RZstdDictionary::Train(const char *samples, const std::size_t *sampleSizes, unsigned int nSamples,
+                                       std::size_t maxSize)
+{
+   std::vector<char> content(maxSize);
+   size_t retval = ZDICT_trainFromBuffer(content.data(), content.size(), samples, sampleSizes, nSamples);
+   if (ZDICT_isError(retval))
+      return nullptr;
+   content.resize(retval);
+   content.shrink_to_fit();
+   return std::unique_ptr<RZstdDictionary>(new RZstdDictionary(std::move(content)));
+}
+
+void ROOT::Internal::RZstdDictionary::Compress(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt,
+                                               int *irep) const
+{
+   *irep = 0;
+   if (*srcsize < 1 + kHeaderSize + 1 || cxlevel <= 0 || *tgtsize <= kHeaderSize)
+      return;
+
+   const RDigestedCDict *cdict;
+   {
+      std::lock_guard<std::mutex> lock(fCDictMutex);
+      auto &entry = fCDicts[cxlevel];
+      if (!entry)
+         entry.reset(new RDigestedCDict(fContent, 2 * cxlevel));
+      cdict = entry.get();
+   }
+   if (R__unlikely(!cdict->fCDict)) {
+      std::cerr << "Error in zip ZSTD: cannot digest the compression dictionary" << std::endl;
+      return;
+   }
+
+   using Ctx_ptr = std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)>;
+   Ctx_ptr fCtx{ZSTD_createCCtx(), &ZSTD_freeCCtx};
+
+   size_t retval = ZSTD_compress_usingCDict(fCtx.get(),
+                                            &tgt[kHeaderSize], static_cast<size_t>(*tgtsize - kHeaderSize),
+                                            src, static_cast<size_t>(*srcsize), cdict->fCDict);
+
+   if (R__unlikely(ZSTD_isError(retval))) {
+      if (R__unlikely(retval != errorCodeSmallBuffer)) {
+         std::cerr << "Error in zip ZSTD. Type = " << ZSTD_getErrorName(retval) <<
+         " . Code = " << retval << std::endl;
+      }
+      return;
+   }
+   *irep = static_cast<int>(retval + kHeaderSize);
+
+   size_t deflate_size = retval;
+   size_t inflate_size = static_cast<size_t>(*srcsize);
+   tgt[0] = 'Z';
+   tgt[1] = 'D';
+   tgt[2] = '\1';
+   tgt[3] = deflate_size & 0xff;
+   tgt[4] = (deflate_size >> 8) & 0xff;
+   tgt[5] = (deflate_size >> 16) & 0xff;
+   tgt[6] = inflate_size & 0xff;
+   tgt[7] = (inflate_size >> 8) & 0xff;
+   tgt[8] = (inflate_size >> 16) & 0xff;
+}
+
+void ROOT::Internal::RZstdDictionary::Decompress(int *srcsize, unsigned char *src, int *tgtsize, unsigned char *tgt,
+                                                 int *irep) const
+{
+   if (!IsCompressedWithDictionary(src)) {
+      R__unzip(srcsize, src, tgtsize, tgt, irep);
+      return;
+   }
+
+   *irep = 0;
+   if (R__unlikely(*srcsize < kHeaderSize)) {
+      std::cerr << "RZstdDictionary::Decompress: too small source" << std::endl;
+      return;
+   }
+
+   std::call_once(fDDictFlag, [this]() { fDDict.reset(new RDigestedDDict(fContent)); });
+   if (R__unlikely(!fDDict->fDDict)) {
+      std::cerr << "Error in unzip ZSTD: cannot digest the compression dictionary" << std::endl;
+      return;
+   }
+
+   using Ctx_ptr = std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)>;
+   Ctx_ptr fCtx{ZSTD_createDCtx(), &ZSTD_freeDCtx};
+
+   size_t retval = ZSTD_decompress_usingDDict(fCtx.get(),
+                                              tgt, static_cast<size_t>(*tgtsize),
+                                              &src[kHeaderSize], static_cast<size_t>(*srcsize - kHeaderSize),
+                                              fDDict->fDDict);
+
+   if (R__unlikely(ZSTD_isError(retval))) {
+      if (R__unlikely(retval != errorCodeSmallBuffer)) {
+         std::cerr << "Error in unzip ZSTD. Type = " << ZSTD_getErrorName(retval) <<
+         " . Code = " << retval << std::endl;
+      }
+      return;
+   }
+   *irep = static_cast<int>(retval);
+}
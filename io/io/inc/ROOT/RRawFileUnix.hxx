@@ -38,6 +38,7 @@ protected:
    std::uint64_t GetSizeImpl() final;
    void *MapImpl(size_t nbytes, std::uint64_t offset, std::uint64_t &mapdOffset) final;
    void UnmapImpl(void *region, size_t nbytes) final;
+   void ReadVImpl(RIOVec *ioVec, unsigned int nReq) final;
 
 public:
    RRawFileUnix(std::string_view url, RRawFile::ROptions options);
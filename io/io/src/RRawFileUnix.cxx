@@ -113,6 +113,15 @@ size_t ROOT::Internal::RRawFileUnix::ReadAtImpl(void *buffer, size_t nbytes, std
    return total_bytes;
 }
 
+void ROOT::Internal::RRawFileUnix::ReadVImpl(RIOVec *ioVec, unsigned int nReq)
+{
+   // Vector reads are typically issued for large, coalesced byte ranges. Serve them with one pread() each and
+   // bypass the block buffers, which would otherwise result in an additional copy for small requests.
+   for (unsigned int i = 0; i < nReq; ++i) {
+      ioVec[i].fOutBytes = ReadAtImpl(ioVec[i].fBuffer, ioVec[i].fSize, ioVec[i].fOffset);
+   }
+}
+
 void ROOT::Internal::RRawFileUnix::UnmapImpl(void *region, size_t nbytes)
 {
    int rv = munmap(region, nbytes);
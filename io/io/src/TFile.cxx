@@ -2276,6 +2276,19 @@ void TFile::Streamer(TBuffer &b)
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Account for `nbytes` read from this file in `readcalls` reads issued
+/// outside of ReadBuffer() and ReadBuffers(), e.g. by the TTreeCache reading
+/// ahead in a background thread.
+
+void TFile::AddBytesRead(Long64_t nbytes, Int_t readcalls)
+{
+   fBytesRead  += nbytes;
+   fgBytesRead += nbytes;
+   fReadCalls  += readcalls;
+   fgReadCalls += readcalls;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Increment statistics for buffer sizes of objects in this file.
 
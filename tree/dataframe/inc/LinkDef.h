@@ -55,6 +55,7 @@
 #pragma link C++ class ROOT::Internal::RDF::RColumnValue<std::vector<Long64_t>>-;
 #pragma link C++ class ROOT::Internal::RDF::RColumnValue<std::vector<ULong64_t>>-;
 #pragma link C++ class ROOT::Internal::RDF::RBookedCustomColumns-;
+#pragma link C++ class ROOT::RDF::RResultHandle-;
 #pragma link C++ class ROOT::Detail::RDF::RMergeableValueBase+;
 #pragma link C++ class ROOT::Detail::RDF::RMergeableValue<int>+;
 #pragma link C++ class ROOT::Detail::RDF::RMergeableValue<unsigned int>+;
@@ -0,0 +1,34 @@
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RCACHEOPTIONS
+#define ROOT_RCACHEOPTIONS
+
+#include "RtypesCore.h" // ULong64_t
+#include <string>
+
+namespace ROOT {
+
+namespace RDF {
+/// A collection of options to steer where the entries of a cached dataset are stored
+struct RCacheOptions {
+   RCacheOptions() = default;
+   RCacheOptions(const RCacheOptions &) = default;
+   RCacheOptions(RCacheOptions &&) = default;
+   RCacheOptions(ULong64_t memoryBudget, const std::string &spillDirectory = "")
+      : fMemoryBudget(memoryBudget), fSpillDirectory(spillDirectory)
+   {
+   }
+   ULong64_t fMemoryBudget = 0; ///< Maximum size in bytes of the entries kept in memory, 0 means no limit
+   std::string fSpillDirectory; ///< Directory of the files that store the entries beyond the budget, empty means the
+                                ///< temporary directory of the system
+};
+} // ns RDF
+} // ns ROOT
+
+#endif
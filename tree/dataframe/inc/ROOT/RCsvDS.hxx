@@ -17,6 +17,7 @@
 #include <deque>
 #include <list>
 #include <map>
+#include <memory>
 #include <vector>
 #include <fstream>
 
@@ -24,6 +25,10 @@
 
 namespace ROOT {
 
+namespace Internal {
+class RRawFile;
+}
+
 namespace RDF {
 
 class RCsvDS final : public ROOT::RDF::RDataSource {
@@ -37,6 +42,7 @@ private:
    bool fReadHeaders = false;
    unsigned int fNSlots = 0U;
    std::ifstream fStream;
+   std::unique_ptr<ROOT::Internal::RRawFile> fCsvFile; // memory-mapped in GetEntryRanges, if the whole file is read
    const char fDelimiter;
    const Long64_t fLinesChunkSize;
    ULong64_t fEntryRangesRequested = 0ULL;
@@ -56,13 +62,14 @@ private:
    static TRegexp intRegex, doubleRegex1, doubleRegex2, doubleRegex3, trueRegex, falseRegex;
 
    void FillHeaders(const std::string &);
-   void FillRecord(const std::string &, Record_t &);
+   void FillRecord(std::string_view, Record_t &);
+   void FillRecordsFromMap();
    void GenerateHeaders(size_t);
    std::vector<void *> GetColumnReadersImpl(std::string_view, const std::type_info &);
    void InferColTypes(std::vector<std::string> &);
    void InferType(const std::string &, unsigned int);
-   std::vector<std::string> ParseColumns(const std::string &);
-   size_t ParseValue(const std::string &, std::vector<std::string> &, size_t);
+   std::vector<std::string> ParseColumns(std::string_view);
+   size_t ParseValue(std::string_view, std::vector<std::string> &, size_t);
    ColType_t GetType(std::string_view colName) const;
 
 protected:
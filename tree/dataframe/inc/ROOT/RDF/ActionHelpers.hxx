@@ -21,10 +21,15 @@
 
 #include "Compression.h"
 #include "ROOT/RIntegerSequence.hxx"
+#include "ROOT/RCacheOptions.hxx"
 #include "ROOT/RStringView.hxx"
 #include "ROOT/RVec.hxx"
 #include "ROOT/TBufferMerger.hxx" // for SnapshotHelper
+#include "ROOT/RDF/RBookedCustomColumns.hxx"
+#include "ROOT/RDF/RCacheDS.hxx" // for CacheHelper
 #include "ROOT/RDF/RCutFlowReport.hxx"
+#include "ROOT/RDF/RProfiler.hxx" // for ProfileReportHelper
+#include "ROOT/RDF/RProfileReport.hxx"
 #include "ROOT/RDF/Utils.hxx"
 #include "ROOT/RMakeUnique.hxx"
 #include "ROOT/RSnapshotOptions.hxx"
@@ -38,16 +43,21 @@
 #include "TH1.h"
 #include "TGraph.h"
 #include "TLeaf.h"
+#include "TNotifyLink.h" // for SnapshotHelper
 #include "TObject.h"
 #include "TTree.h"
+#include "TTreeCloner.h" // for SnapshotHelper
 #include "TTreeReader.h" // for SnapshotHelper
+#include "TUUID.h"       // for CacheHelper
 #include "ROOT/RDF/RMergeableValue.hxx"
 
 #include <algorithm>
+#include <functional>
 #include <limits>
 #include <memory>
 #include <stdexcept>
 #include <string>
+#include <tuple>
 #include <type_traits>
 #include <vector>
 #include <iomanip>
@@ -125,6 +135,43 @@ public:
    std::string GetActionName() { return "ForeachSlot"; }
 };
 
+/// The column types of a callable that takes RVecs of column values, as ForeachBatchSlot does
+template <typename BatchTypes>
+struct BatchColumnTypes;
+
+template <typename... ColTypes>
+struct BatchColumnTypes<TypeList<ROOT::VecOps::RVec<ColTypes>...>> {
+   using type = TypeList<ColTypes...>;
+};
+
+/// Helper for ForeachBatchSlot: the callable receives the values of the entries of a batch that pass the upstream
+/// filters, see RLoopManager::SetBatchSize. If the event loop is not batched, it receives the entries one at a time.
+template <typename F, typename ColumnTypes = typename BatchColumnTypes<
+                         RemoveFirstParameter_t<typename CallableTraits<F>::arg_types>>::type>
+class ForeachBatchSlotHelper;
+
+template <typename F, typename... ColTypes>
+class ForeachBatchSlotHelper<F, TypeList<ColTypes...>>
+   : public RActionImpl<ForeachBatchSlotHelper<F, TypeList<ColTypes...>>> {
+   F fCallable;
+
+public:
+   using ColumnTypes_t = TypeList<ColTypes...>;
+   ForeachBatchSlotHelper(F &&f) : fCallable(f) {}
+   ForeachBatchSlotHelper(ForeachBatchSlotHelper &&) = default;
+   ForeachBatchSlotHelper(const ForeachBatchSlotHelper &) = delete;
+
+   void InitTask(TTreeReader *, unsigned int) {}
+
+   void ExecBatch(unsigned int slot, ROOT::VecOps::RVec<ColTypes> &... values) { fCallable(slot, values...); }
+
+   void Initialize() { /* noop */}
+
+   void Finalize() { /* noop */}
+
+   std::string GetActionName() { return "ForeachBatchSlot"; }
+};
+
 class CountHelper : public RActionImpl<CountHelper> {
    const std::shared_ptr<ULong64_t> fResultCount;
    Results<ULong64_t> fCounts;
@@ -179,6 +226,30 @@ public:
    std::string GetActionName() { return "Report"; }
 };
 
+class ProfileReportHelper : public RActionImpl<ProfileReportHelper> {
+   const std::shared_ptr<ROOT::RDF::RProfileReport> fReport;
+   std::shared_ptr<RProfiler> fProfiler;
+
+public:
+   using ColumnTypes_t = TypeList<>;
+   ProfileReportHelper(const std::shared_ptr<ROOT::RDF::RProfileReport> &report,
+                       const std::shared_ptr<RProfiler> &profiler)
+      : fReport(report), fProfiler(profiler){};
+   ProfileReportHelper(ProfileReportHelper &&) = default;
+   ProfileReportHelper(const ProfileReportHelper &) = delete;
+   void InitTask(TTreeReader *, unsigned int) {}
+   void Exec(unsigned int /* slot */) {}
+   void Initialize() { /* noop */}
+   void Finalize()
+   {
+      fProfiler->FillReport(*fReport);
+      // the profiles of the input columns are owned by the profiler, which only lives for one event loop
+      fProfiler.reset();
+   }
+
+   std::string GetActionName() { return "ProfileReport"; }
+};
+
 class FillHelper : public RActionImpl<FillHelper> {
    // this sets a total initial size of 16 MB for the buffers (can increase)
    static constexpr unsigned int fgTotalBufSize = 2097152;
@@ -750,6 +821,129 @@ extern template class TakeHelper<float, float, std::vector<float>>;
 extern template class TakeHelper<double, double, std::vector<double>>;
 #endif
 
+/// Helper of RInterface::Cache when a memory budget is given. Each slot buffers its entries in memory and gets an equal
+/// share of the budget; as soon as the estimated size of its buffered entries exceeds its share, the slot moves its
+/// buffer to a TTree in its own spill file. At the end of the event loop the spill files and the remaining buffers
+/// become the chunks of the cached data.
+template <typename... ColTypes>
+class CacheHelper : public RActionImpl<CacheHelper<ColTypes...>> {
+   using Data_t = RCachedData<ColTypes...>;
+   using Columns_t = typename Data_t::Columns_t;
+   using DiskValues_t = std::tuple<typename RCacheDiskType<ColTypes>::Type_t...>;
+
+   std::shared_ptr<Data_t> fData;
+   const ULong64_t fSlotMemoryBudget;
+   std::string fFilePrefix;
+   std::vector<Columns_t> fBuffers;
+   std::vector<ULong64_t> fBufferSizes;
+   std::vector<std::unique_ptr<TFile>> fFiles;
+   std::vector<TTree *> fTrees; // owned by the corresponding fFiles
+   std::vector<ULong64_t> fNSpilledEntries;
+   std::vector<DiskValues_t> fDiskValues;
+
+   template <typename T>
+   static void CheckSpillable(const std::string &colName)
+   {
+      using DiskT = typename RCacheDiskType<T>::Type_t;
+      if (!std::is_arithmetic<DiskT>::value && !TClass::GetClass(typeid(DiskT)))
+         throw std::runtime_error("Cache: column \"" + colName + "\" is of type " + TypeID2TypeName(typeid(T)) +
+                                  " which has no dictionary: it cannot be written to a spill file.");
+   }
+
+   template <std::size_t... S>
+   void CreateSpillFile(unsigned int slot, std::index_sequence<S...>)
+   {
+      const auto fileName = fFilePrefix + std::to_string(slot) + ".root";
+      TDirectory::TContext ctxt;
+      // spill files are local and short-lived: do not spend time compressing them
+      fFiles[slot].reset(TFile::Open(fileName.c_str(), "RECREATE", "", 0));
+      if (!fFiles[slot] || fFiles[slot]->IsZombie())
+         throw std::runtime_error("Cache: cannot create spill file " + fileName);
+      fTrees[slot] = new TTree(Data_t::fgTreeName, Data_t::fgTreeName);
+      fTrees[slot]->SetImplicitMT(false);
+      std::initializer_list<int> expander{
+         (fTrees[slot]->Branch(("c" + std::to_string(S)).c_str(), &std::get<S>(fDiskValues[slot])), 0)...};
+      (void)expander;
+   }
+
+   template <std::size_t... S>
+   static void PushBack(Columns_t &buffer, std::index_sequence<S...>, const ColTypes &... values)
+   {
+      std::initializer_list<int> expander{(std::get<S>(buffer).emplace_back(values), 0)...};
+      (void)expander;
+   }
+
+   template <std::size_t... S>
+   void Spill(unsigned int slot, std::index_sequence<S...> seq)
+   {
+      if (!fTrees[slot])
+         CreateSpillFile(slot, seq);
+      auto &buffer = fBuffers[slot];
+      const auto nEntries = std::get<0>(buffer).size();
+      for (auto i = 0u; i < nEntries; ++i) {
+         std::initializer_list<int> expander{
+            (RCacheDiskType<ColTypes>::ToDisk(std::get<S>(buffer)[i], std::get<S>(fDiskValues[slot])), 0)...};
+         (void)expander;
+         fTrees[slot]->Fill();
+      }
+      fNSpilledEntries[slot] += nEntries;
+      buffer = Columns_t();
+      fBufferSizes[slot] = 0ull;
+   }
+
+public:
+   using ColumnTypes_t = TypeList<ColTypes...>;
+   CacheHelper(const std::shared_ptr<Data_t> &data, const ColumnNames_t &colNames, const RCacheOptions &options,
+               unsigned int nSlots)
+      : fData(data), fSlotMemoryBudget(options.fMemoryBudget / nSlots), fBuffers(nSlots), fBufferSizes(nSlots, 0ull),
+        fFiles(nSlots), fTrees(nSlots, nullptr), fNSpilledEntries(nSlots, 0ull), fDiskValues(nSlots)
+   {
+      auto colName = colNames.begin();
+      std::initializer_list<int> expander{(CheckSpillable<ColTypes>(*colName++), 0)...};
+      (void)expander;
+      const std::string dir =
+         options.fSpillDirectory.empty() ? std::string(gSystem->TempDirectory()) : options.fSpillDirectory;
+      fFilePrefix = dir + "/rdfcache_" + TUUID().AsString() + "_";
+   }
+   CacheHelper(CacheHelper &&) = default;
+   CacheHelper(const CacheHelper &) = delete;
+
+   void InitTask(TTreeReader *, unsigned int) {}
+
+   void Exec(unsigned int slot, const ColTypes &... values)
+   {
+      auto &buffer = fBuffers[slot];
+      std::size_t size = 0u;
+      std::initializer_list<int> expander{(size += EstimateCacheSize(values, 0), 0)...};
+      (void)expander;
+      PushBack(buffer, std::index_sequence_for<ColTypes...>(), values...);
+      if ((fBufferSizes[slot] += size) > fSlotMemoryBudget)
+         Spill(slot, std::index_sequence_for<ColTypes...>());
+   }
+
+   void Initialize() { /* noop */}
+
+   void Finalize()
+   {
+      for (auto slot = 0u; slot < fBuffers.size(); ++slot) {
+         if (fTrees[slot]) {
+            TDirectory::TContext ctxt(fFiles[slot].get());
+            fTrees[slot]->Write();
+            fTrees[slot] = nullptr;
+            fFiles[slot]->Close();
+            fData->AddDiskChunk(fFiles[slot]->GetName(), fNSpilledEntries[slot]);
+            fFiles[slot].reset();
+         }
+         if (!std::get<0>(fBuffers[slot]).empty())
+            fData->AddMemoryChunk(std::move(fBuffers[slot]));
+      }
+   }
+
+   Data_t &PartialUpdate(unsigned int) { return *fData; }
+
+   std::string GetActionName() { return "Cache"; }
+};
+
 
 template <typename ResultType>
 class MinHelper : public RActionImpl<MinHelper<ResultType>> {
@@ -1020,6 +1214,9 @@ public:
    template <typename... Columns>
    void Exec(unsigned int, Columns... columns)
    {
+      // in batched mode, the entries that follow the last row of the batch reach the helper too
+      if (!fDisplayerHelper->HasNext())
+         return;
       fDisplayerHelper->AddRow(columns...);
       if (!fDisplayerHelper->HasNext()) {
          fPrevNode->StopProcessing();
@@ -1195,6 +1392,36 @@ void SetBranchesHelper(BoolArrayMap &boolArrays, TTree *inputTree, TTree &output
    }
 }
 
+/// Helper function for SnapshotHelper. It points an output branch cloned from the input tree, whose baskets are not
+/// copied for the current input tree, to the value of the column.
+template <typename T>
+void SetClonedBranchAddress(BoolArrayMap &, TTree &outputTree, const std::string &name, TBranch *&branch,
+                            void *&branchAddress, T *address)
+{
+   outputTree.SetBranchAddress(name.c_str(), address);
+   branch = nullptr;
+   branchAddress = nullptr;
+}
+
+/// Helper function for SnapshotHelper. Overload for columns of type `RVec<T>`, which were cloned either from a C array
+/// or from a std::vector (see FindClonableBranches).
+template <typename T>
+void SetClonedBranchAddress(BoolArrayMap &boolArrays, TTree &outputTree, const std::string &name, TBranch *&branch,
+                            void *&branchAddress, RVec<T> *ab)
+{
+   auto *const outputBranch = outputTree.GetBranch(name.c_str());
+   if (std::string(outputBranch->GetClassName()).empty()) {
+      // C array: like in SetBranchesHelper, keep track of the address so that changes can be intercepted
+      outputBranch->SetAddress(UpdateBoolArrayIfBool(boolArrays, *ab, name));
+      if (!std::is_same<bool, T>::value) {
+         branch = outputBranch;
+         branchAddress = GetData(*ab);
+      }
+   } else {
+      outputTree.SetBranchAddress(name.c_str(), &ab->AsVector());
+   }
+}
+
 // generic version, no-op
 template <typename T>
 void UpdateBoolArray(BoolArrayMap &, T&, const std::string &, TTree &) {}
@@ -1217,7 +1444,37 @@ inline void UpdateBoolArray(BoolArrayMap &boolArrays, RVec<bool> &v, const std::
 
 void ValidateSnapshotOutput(const RSnapshotOptions &opts, const std::string &treeName, const std::string &fileName);
 
+/// Return, for each column written by a single-thread Snapshot, whether the compressed baskets of the corresponding
+/// input branch can be copied to the output tree instead of reading and re-writing its values. An empty vector means
+/// that all columns must be re-written. Only the tree currently loaded by the input TTree or TChain is inspected: the
+/// other trees of a chain are checked when they are loaded during the event loop.
+std::vector<bool> FindClonableBranches(TTree *tree, const ColumnNames_t &inputNames, const ColumnNames_t &outputNames,
+                                       const RBookedCustomColumns &customColumns, const RSnapshotOptions &opts);
+
+/// Calls a function when the TTree or TChain it is linked to loads a new tree, then notifies the next link. Unlike
+/// TNotifyLink, it does not need a dictionary for each class that wants to be notified.
+class RNotifyCallback final : public TNotifyLinkBase {
+   std::function<void()> fCallback;
+
+public:
+   RNotifyCallback(std::function<void()> callback) : fCallback(std::move(callback)) {}
+   Bool_t Notify() final
+   {
+      fCallback();
+      return fNext ? fNext->Notify() : kTRUE;
+   }
+};
+
 /// Helper object for a single-thread Snapshot action
+///
+/// If the event loop runs over all entries of the input tree (no Filter, no Range) the output branches of the columns
+/// read unchanged from the input tree are cloned from the input branches (see FindClonableBranches). Whenever the input
+/// TTree or TChain loads a tree whose file has the output compression settings, the compressed baskets of these
+/// branches are copied to the output tree with TTreeCloner, their values are not read, and only the other columns are
+/// filled entry by entry. For the other trees of a chain, all columns are read and filled as usual.
+/// The output tree keeps the clusters of the copied trees: the baskets of the filled branches are flushed at the end of
+/// each cluster, and the size of the written baskets is accounted for in the totals of the tree when they are written.
+/// Auto-save does not take place before the end of the event loop.
 template <typename... BranchTypes>
 class SnapshotHelper : public RActionImpl<SnapshotHelper<BranchTypes...>> {
    const std::string fFileName;
@@ -1233,14 +1490,116 @@ class SnapshotHelper : public RActionImpl<SnapshotHelper<BranchTypes...>> {
    BoolArrayMap fBoolArrays; // Storage for C arrays of bools to be written out
    std::vector<TBranch *> fBranches;     // Addresses of branches in output, non-null only for the ones holding C arrays
    std::vector<void *> fBranchAddresses; // Addresses associated to output branches, non-null only for the ones holding C arrays
+   TTree *fTreeToClone = nullptr;         // Input tree of the event loop, whose baskets are copied for fIsCloned columns
+   std::vector<bool> fIsCloned;           // Whether the output branch of each column is cloned, empty if none is
+   std::unique_ptr<RNotifyCallback> fNotifyLink; // Copies the baskets of each tree loaded by fInputTree, if possible
+   Int_t fInputTreeNumber = -1;           // Tree number in fInputTree of the last tree considered for copying baskets
+   bool fIsInputTreeCopied = false;       // Whether the baskets of the current input tree were copied
+   bool fAreClonedBranchesSet = false;    // Whether the cloned output branches point to the values of the columns
+   std::vector<TBranch *> fFilledBranches; // Output branches filled at every entry, if some baskets are copied
+   std::vector<Long64_t> fClusterEnds;     // End (exclusive) of the clusters of the current input tree, if copied
+   std::size_t fNextClusterEnd = 0;        // Index in fClusterEnds of the cluster currently being filled
+   Long64_t fNWrittenEntries = 0;          // Entries written to the output tree so far
+
+   /// Open the output file and return the directory that will contain the output tree
+   TDirectory *OpenOutputFile()
+   {
+      fOutputTree.reset();
+      fOutputFile.reset(
+         TFile::Open(fFileName.c_str(), fOptions.fMode.c_str(), /*ftitle=*/"",
+                     ROOT::CompressionSettings(fOptions.fCompressionAlgorithm, fOptions.fCompressionLevel)));
+
+      TDirectory *outputDir = fOutputFile.get();
+      if (!fDirName.empty()) {
+         TString checkupdate = fOptions.fMode;
+         checkupdate.ToLower();
+         if (checkupdate == "update")
+            outputDir = fOutputFile->mkdir(fDirName.c_str(), "", true);  // do not overwrite existing directory
+         else
+            outputDir = fOutputFile->mkdir(fDirName.c_str());
+      }
+      return outputDir;
+   }
+
+   /// Create the output tree as an empty clone of the input tree restricted to the fIsCloned columns. Return false if
+   /// the input tree could not be cloned.
+   bool CloneOutputTree(TDirectory *outputDir)
+   {
+      // CloneTree only clones the active branches
+      fTreeToClone->SetBranchStatus("*", false);
+      for (auto i = 0u; i < fIsCloned.size(); ++i)
+         if (fIsCloned[i])
+            fTreeToClone->SetBranchStatus(fInputBranchNames[i].c_str(), true);
+      {
+         TDirectory::TContext ctxt(outputDir);
+         fOutputTree.reset(fTreeToClone->CloneTree(0));
+      }
+      fTreeToClone->SetBranchStatus("*", true);
+      if (!fOutputTree)
+         return false;
+
+      // the cloned branches are either copied or pointed to the values of the columns, never to the input branches
+      for (auto *tree : {fTreeToClone, fTreeToClone->GetTree()})
+         if (auto *clones = tree->GetListOfClones())
+            clones->Remove(fOutputTree.get());
+      fOutputTree->ResetBranchAddresses();
+
+      fOutputTree->SetDirectory(outputDir);
+      fOutputTree->SetName(fTreeName.c_str());
+      fOutputTree->SetTitle(fTreeName.c_str());
+      return true;
+   }
+
+   /// Copy the baskets of the cloned branches from the tree just loaded by fInputTree, if that is possible
+   void CopyBasketsOfInputTree()
+   {
+      auto *tree = fInputTree->GetTree();
+      if (!tree || fInputTree->GetTreeNumber() == fInputTreeNumber)
+         return;
+      fInputTreeNumber = fInputTree->GetTreeNumber();
+      // write the partially filled baskets of the previous tree, so that no basket spans two input trees
+      if (!fIsInputTreeCopied && fNWrittenEntries > 0)
+         fOutputTree->FlushBaskets(/*create_cluster=*/false);
+      fIsInputTreeCopied = CopyBaskets(*tree);
+   }
+
+   /// Copy the baskets of the cloned branches from the given input tree. Return false, without changing the output
+   /// tree, if its baskets cannot be copied as they are: all columns must be read and filled for its entries then.
+   bool CopyBaskets(TTree &tree)
+   {
+      auto *file = tree.GetCurrentFile();
+      if (!file || file->GetCompressionSettings() != fOutputFile->GetCompressionSettings())
+         return false;
+      // TTreeCloner copies the baskets of all output branches found in the input tree: these must be the cloned ones
+      for (auto i = 0u; i < fIsCloned.size(); ++i) {
+         if (fIsCloned[i] != (tree.GetListOfBranches()->FindObject(fOutputBranchNames[i].c_str()) != nullptr))
+            return false;
+      }
+      TTreeCloner cloner(&tree, fOutputTree.get(), "", TTreeCloner::kNoWarnings | TTreeCloner::kIgnoreMissingTopLevel);
+      if (!cloner.IsValid())
+         return false;
+      const auto start = fOutputTree->GetEntries();
+      const auto end = start + tree.GetEntries();
+      fOutputTree->SetEntries(end);
+      cloner.Exec();
+
+      // the filled branches follow the clusters imported from the input tree
+      fClusterEnds.clear();
+      fNextClusterEnd = 0;
+      auto clusters = fOutputTree->GetClusterIterator(start);
+      while (clusters.Next() < end)
+         fClusterEnds.emplace_back(std::min(clusters.GetNextEntry(), end));
+      return true;
+   }
 
 public:
    using ColumnTypes_t = TypeList<BranchTypes...>;
    SnapshotHelper(std::string_view filename, std::string_view dirname, std::string_view treename,
-                  const ColumnNames_t &vbnames, const ColumnNames_t &bnames, const RSnapshotOptions &options)
+                  const ColumnNames_t &vbnames, const ColumnNames_t &bnames, const RSnapshotOptions &options,
+                  TTree *treeToClone = nullptr, const std::vector<bool> &isCloned = {})
       : fFileName(filename), fDirName(dirname), fTreeName(treename), fOptions(options), fInputBranchNames(vbnames),
         fOutputBranchNames(ReplaceDotWithUnderscore(bnames)), fBranches(vbnames.size(), nullptr),
-        fBranchAddresses(vbnames.size(), nullptr)
+        fBranchAddresses(vbnames.size(), nullptr), fTreeToClone(treeToClone), fIsCloned(isCloned)
    {
       ValidateSnapshotOutput(fOptions, fTreeName, fFileName);
    }
@@ -1253,12 +1612,27 @@ public:
       if (!r) // empty source, nothing to do
          return;
       fInputTree = r->GetTree();
+      if (!fIsCloned.empty()) {
+         // decide for each tree of the input chain, when it is loaded, whether its baskets can be copied
+         fNotifyLink = std::make_unique<RNotifyCallback>([this] { CopyBasketsOfInputTree(); });
+         fNotifyLink->PrependLink(*fInputTree);
+         CopyBasketsOfInputTree(); // the first tree is already loaded
+         return;
+      }
       // AddClone guarantees that if the input file changes the branches of the output tree are updated with the new
       // addresses of the branch values
       fInputTree->AddClone(fOutputTree.get());
    }
 
-   void Exec(unsigned int /* slot */, BranchTypes &... values)
+   void FinalizeTask(unsigned int /* slot */)
+   {
+      if (fNotifyLink && fNotifyLink->IsLinked())
+         fNotifyLink->RemoveLink(*fInputTree);
+   }
+
+   /// Write the current entry. The values of the columns whose baskets are copied from the current input tree are
+   /// not read (see IsCloned) and are passed as nullptr.
+   void Exec(unsigned int /* slot */, BranchTypes *... values)
    {
       using ind_t = std::index_sequence_for<BranchTypes...>;
       if (! fIsFirstEvent) {
@@ -1267,12 +1641,33 @@ public:
          SetBranches(values..., ind_t{});
          fIsFirstEvent = false;
       }
+      if (!fIsInputTreeCopied && !fAreClonedBranchesSet) {
+         SetClonedBranches(values..., ind_t{});
+         fAreClonedBranchesSet = true;
+      }
       UpdateBoolArrays(values..., ind_t{});
-      fOutputTree->Fill();
+      ++fNWrittenEntries;
+      if (!fIsInputTreeCopied) {
+         fOutputTree->Fill();
+      } else {
+         // the entries of the cloned branches are already in the output tree. Like TTree::Fill with auto-flush, write
+         // the baskets of the filled branches at the end of each cluster.
+         for (auto *branch : fFilledBranches)
+            branch->Fill();
+         if (fNextClusterEnd < fClusterEnds.size() && fNWrittenEntries == fClusterEnds[fNextClusterEnd]) {
+            for (auto *branch : fFilledBranches)
+               branch->FlushBaskets();
+            ++fNextClusterEnd;
+         }
+      }
    }
 
+   /// Whether the values of the i-th column are not needed for the current entry, because the compressed baskets of
+   /// its branch are copied from the current input tree
+   bool IsCloned(std::size_t i) const { return fIsInputTreeCopied && fIsCloned[i]; }
+
    template <std::size_t... S>
-   void UpdateCArraysPtrs(BranchTypes &... values, std::index_sequence<S...> /*dummy*/)
+   void UpdateCArraysPtrs(BranchTypes *... values, std::index_sequence<S...> /*dummy*/)
    {
       // This code deals with branches which hold C arrays of variable size. It can happen that the buffers
       // associated to those is re-allocated. As a result the value of the pointer can change therewith
@@ -1280,46 +1675,64 @@ public:
       // With this code, we set the value of the pointer in the output branch anew when needed.
       // Nota bene: the extra ",0" after the invocation of SetAddress, is because that method returns void and 
       // we need an int for the expander list.
-      int expander[] = {(fBranches[S] && fBranchAddresses[S] != GetData(values)
-                         ? fBranches[S]->SetAddress(GetData(values)),
-                         fBranchAddresses[S] = GetData(values), 0 : 0, 0)...,
+      int expander[] = {(values && fBranches[S] && fBranchAddresses[S] != GetData(*values)
+                         ? fBranches[S]->SetAddress(GetData(*values)),
+                         fBranchAddresses[S] = GetData(*values), 0 : 0, 0)...,
                         0};
       (void)expander; // avoid unused variable warnings for older compilers such as gcc 4.9
    }
 
    template <std::size_t... S>
-   void SetBranches(BranchTypes &... values, std::index_sequence<S...> /*dummy*/)
+   void SetBranches(BranchTypes *... values, std::index_sequence<S...> /*dummy*/)
    {
       // create branches in output tree (and fill fBoolArrays for RVec<bool> columns)
-      int expander[] = {(SetBranchesHelper(fBoolArrays, fInputTree, *fOutputTree, fInputBranchNames[S],
-                                           fOutputBranchNames[S], fBranches[S], fBranchAddresses[S], &values),
-                         0)...,
+      // the branches of cloned columns are already present in the output tree
+      int expander[] = {(!fIsCloned.empty() && fIsCloned[S]
+                            ? 0
+                            : (SetBranchesHelper(fBoolArrays, fInputTree, *fOutputTree, fInputBranchNames[S],
+                                                 fOutputBranchNames[S], fBranches[S], fBranchAddresses[S], values),
+                               0))...,
+                        0};
+      (void)expander; // avoid unused variable warnings for older compilers such as gcc 4.9
+      if (!fIsCloned.empty()) {
+         for (auto i = 0u; i < fIsCloned.size(); ++i)
+            if (!fIsCloned[i])
+               fFilledBranches.emplace_back(fOutputTree->GetBranch(fOutputBranchNames[i].c_str()));
+      }
+   }
+
+   template <std::size_t... S>
+   void SetClonedBranches(BranchTypes *... values, std::index_sequence<S...> /*dummy*/)
+   {
+      // point the cloned branches to the values of the columns, which are read when baskets are not copied
+      int expander[] = {(!fIsCloned.empty() && fIsCloned[S]
+                            ? (SetClonedBranchAddress(fBoolArrays, *fOutputTree, fOutputBranchNames[S], fBranches[S],
+                                                      fBranchAddresses[S], values),
+                               0)
+                            : 0)...,
                         0};
       (void)expander; // avoid unused variable warnings for older compilers such as gcc 4.9
    }
 
    template <std::size_t... S>
-   void UpdateBoolArrays(BranchTypes &...values, std::index_sequence<S...> /*dummy*/)
+   void UpdateBoolArrays(BranchTypes *...values, std::index_sequence<S...> /*dummy*/)
    {
-      int expander[] = {(UpdateBoolArray(fBoolArrays, values, fOutputBranchNames[S], *fOutputTree), 0)..., 0};
+      int expander[] = {
+         (values ? UpdateBoolArray(fBoolArrays, *values, fOutputBranchNames[S], *fOutputTree) : void(), 0)..., 0};
       (void)expander; // avoid unused variable warnings for older compilers such as gcc 4.9
    }
 
    void Initialize()
    {
-      fOutputFile.reset(
-         TFile::Open(fFileName.c_str(), fOptions.fMode.c_str(), /*ftitle=*/"",
-                     ROOT::CompressionSettings(fOptions.fCompressionAlgorithm, fOptions.fCompressionLevel)));
+      TDirectory *outputDir = OpenOutputFile();
 
-      TDirectory *outputDir = fOutputFile.get();
-      if (!fDirName.empty()) {
-         TString checkupdate = fOptions.fMode;
-         checkupdate.ToLower();
-         if (checkupdate == "update")
-            outputDir = fOutputFile->mkdir(fDirName.c_str(), "", true);  // do not overwrite existing directory
-         else
-            outputDir = fOutputFile->mkdir(fDirName.c_str());
+      if (!fIsCloned.empty() && !CloneOutputTree(outputDir)) {
+         Warning("Snapshot", "Could not clone the input tree, all columns will be read and re-written.");
+         fIsCloned.clear();
+         outputDir = OpenOutputFile(); // start over from an empty file, fOptions.fMode is "RECREATE"
       }
+      if (!fIsCloned.empty())
+         return; // the output tree is the clone of the input tree
 
       fOutputTree =
          std::make_unique<TTree>(fTreeName.c_str(), fTreeName.c_str(), fOptions.fSplitLevel, /*dir=*/outputDir);
@@ -45,6 +45,10 @@ std::shared_ptr<GraphNode> CreateRangeNode(const ROOT::Detail::RDF::RRangeBase *
 bool CheckIfDefaultOrDSColumn(const std::string &name,
                               const std::shared_ptr<ROOT::Detail::RDF::RCustomColumnBase> &column);
 
+/// Return the annotation of a graph node with the number of calls and the time recorded in its profile, or an empty
+/// string if the node has not been profiled.
+std::string FormatProfile(const RNodeProfile &profile);
+
 // clang-format off
 /**
 \class ROOT::Internal::RDF::GraphCreatorHelper
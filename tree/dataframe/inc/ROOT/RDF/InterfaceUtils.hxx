@@ -25,6 +25,7 @@
 #include <ROOT/RMakeUnique.hxx>
 #include <ROOT/RStringView.hxx>
 #include <ROOT/TypeTraits.hxx>
+#include <RConfigure.h> // R__HAS_ROOT7
 #include <TError.h> // gErrorIgnoreLevel
 #include <TH1.h>
 
@@ -32,6 +33,7 @@
 #include <functional>
 #include <map>
 #include <memory>
+#include <stdexcept>
 #include <string>
 #include <type_traits>
 #include <typeinfo>
@@ -75,6 +77,11 @@ HeadNode_t CreateSnapshotRDF(const ColumnNames_t &validCols,
                             RLoopManager &loopManager,
                             std::unique_ptr<RDFInternal::RActionBase> actionPtr);
 
+#ifdef R__HAS_ROOT7
+/// Return a loop manager that reads the RNTuple `ntupleName` from file `fileName`, used by Snapshot to RNTuple
+std::shared_ptr<RLoopManager> MakeNTupleLoopManager(std::string_view ntupleName, std::string_view fileName);
+#endif
+
 std::string DemangleTypeIdName(const std::type_info &typeInfo);
 
 ColumnNames_t ConvertRegexToColumns(const RDFInternal::RBookedCustomColumns &customColumns, TTree *tree,
@@ -236,6 +243,52 @@ std::unique_ptr<RActionBase> BuildAction(const ColumnNames_t &bl, const std::sha
 
 /****** end BuildAndBook ******/
 
+/// Copy the result of an action before the event loop runs, so that a varied copy of the action can fill it
+template <typename T, typename std::enable_if<std::is_copy_constructible<T>::value, int>::type = 0>
+std::shared_ptr<T> CopyResultForVariation(const std::shared_ptr<T> &r)
+{
+   return std::make_shared<T>(*r);
+}
+
+template <typename T, typename std::enable_if<!std::is_copy_constructible<T>::value, int>::type = 0>
+std::shared_ptr<T> CopyResultForVariation(const std::shared_ptr<T> &)
+{
+   throw std::runtime_error("The result of this action cannot be copied, so it does not support systematic variations.");
+}
+
+/// Return a factory for varied copies of the action that BuildAction creates with the same arguments
+template <typename... BranchTypes, typename ActionTag, typename ActionResultType, typename PrevNodeType>
+RActionBase::VariedActionFactory_t
+MakeVariedActionFactory(const ColumnNames_t &bl, const std::shared_ptr<ActionResultType> &r, const unsigned int nSlots,
+                        const std::shared_ptr<PrevNodeType> &, ActionTag)
+{
+   return [bl, r, nSlots](const std::shared_ptr<RNodeBase> &prevNode, RDFInternal::RBookedCustomColumns &&columns,
+                          std::shared_ptr<void> &variedResult) {
+      auto variedR = CopyResultForVariation(r);
+      variedResult = variedR;
+      // varied nodes have the same type as their nominal counterpart
+      return BuildAction<BranchTypes...>(bl, variedR, nSlots, std::static_pointer_cast<PrevNodeType>(prevNode),
+                                         ActionTag{}, std::move(columns));
+   };
+}
+
+/// Return a factory for varied copies of actions whose helper is constructed from the result and the number of slots
+template <typename Helper, typename ActionResultType, typename PrevNodeType>
+RActionBase::VariedActionFactory_t MakeVariedHelperActionFactory(const ColumnNames_t &bl,
+                                                                 const std::shared_ptr<ActionResultType> &r,
+                                                                 const unsigned int nSlots,
+                                                                 const std::shared_ptr<PrevNodeType> &)
+{
+   return [bl, r, nSlots](const std::shared_ptr<RNodeBase> &prevNode, RDFInternal::RBookedCustomColumns &&columns,
+                          std::shared_ptr<void> &variedResult) -> std::unique_ptr<RActionBase> {
+      auto variedR = CopyResultForVariation(r);
+      variedResult = variedR;
+      using Action_t = RAction<Helper, PrevNodeType>;
+      return std::make_unique<Action_t>(Helper(variedR, nSlots), bl, std::static_pointer_cast<PrevNodeType>(prevNode),
+                                        std::move(columns));
+   };
+}
+
 template <typename Filter>
 void CheckFilter(Filter &)
 {
@@ -247,8 +300,27 @@ void CheckFilter(Filter &)
 void CheckCustomColumn(std::string_view definedCol, TTree *treePtr, const ColumnNames_t &customCols,
                        const std::map<std::string, std::string> &aliasMap, const ColumnNames_t &dataSourceColumns);
 
+/// Check that a new systematic variation has at least one tag and that its name is not in use yet
+void CheckVariation(const std::string &variationName, const std::vector<std::string> &variationTags,
+                    const ColumnNames_t &variations);
+
 std::string PrettyPrintAddr(const void *const addr);
 
+/// Entry point of a jitted Filter expression compiled into the jit cache, calls JitFilterHelper
+using JitCacheFilterBooker_t = void (*)(const ColumnNames_t &cols, const std::string &name, void *wkJittedFilter,
+                                        void *prevNodeOnHeap, void *customColumns);
+/// Entry point of a jitted Define expression compiled into the jit cache, calls JitDefineHelper
+using JitCacheDefineBooker_t = void (*)(const ColumnNames_t &cols, const std::string &name, RLoopManager *lm,
+                                        void *wkJittedCustomCol, void *customColumns, void *prevNodeOnHeap);
+
+/// Return the compiled entry point for the given Filter lambda from the jit cache, nullptr if it is not available
+JitCacheFilterBooker_t GetJitCacheFilterBooker(const std::string &lambdaExpr);
+/// Return the compiled entry point for the given Define lambda from the jit cache, nullptr if it is not available.
+/// retType is set to the name of the return type of the lambda.
+JitCacheDefineBooker_t GetJitCacheDefineBooker(const std::string &lambdaExpr, std::string &retType);
+/// Compile the expressions that were looked up in the jit cache but were not found into the cache directory
+void CompilePendingJitCacheEntries();
+
 void BookFilterJit(const std::shared_ptr<RJittedFilter> &jittedFilter, std::shared_ptr<RNodeBase> *prevNodeOnHeap,
                    std::string_view name, std::string_view expression,
                    const std::map<std::string, std::string> &aliasMap, const ColumnNames_t &branches,
@@ -455,8 +527,10 @@ void CallBuildAction(std::shared_ptr<PrevNodeType> *prevNodeOnHeap, const Column
                                                     std::make_index_sequence<nColumns>(), ColTypes_t())
                         : *customColumns;
 
+   auto variedActionFactory = MakeVariedActionFactory<BranchTypes...>(bl, rOnHeap, nSlots, prevNodePtr, ActionTag{});
    auto actionPtr = BuildAction<BranchTypes...>(bl, std::move(rOnHeap), nSlots, std::move(prevNodePtr), ActionTag{},
                                                 std::move(newColumns));
+   actionPtr->SetVariedActionFactory(std::move(variedActionFactory));
    jittedActionOnHeap->SetAction(std::move(actionPtr));
 
    // customColumns points to the columns structure in the heap, created before the jitted call so that the jitter can
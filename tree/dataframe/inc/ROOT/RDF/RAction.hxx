@@ -13,14 +13,19 @@
 
 #include "ROOT/RDF/GraphNode.hxx"
 #include "ROOT/RDF/RActionBase.hxx"
+#include "ROOT/RDF/RBatch.hxx"
 #include "ROOT/RDF/NodesUtils.hxx" // InitRDFValues
 #include "ROOT/RDF/Utils.hxx"      // ColumnNames_t
 #include "ROOT/RDF/RColumnValue.hxx"
 #include "ROOT/RDF/RLoopManager.hxx"
 
+#include <algorithm>
 #include <cstddef> // std::size_t
 #include <memory>
+#include <stdexcept>
 #include <string>
+#include <tuple>
+#include <type_traits>
 #include <vector>
 
 namespace ROOT {
@@ -34,6 +39,7 @@ namespace RDFGraphDrawing = ROOT::Internal::RDF::GraphDrawing;
 namespace GraphDrawing {
 std::shared_ptr<GraphNode> CreateDefineNode(const std::string &colName, const RDFDetail::RCustomColumnBase *columnPtr);
 bool CheckIfDefaultOrDSColumn(const std::string &name, const std::shared_ptr<RDFDetail::RCustomColumnBase> &column);
+std::string FormatProfile(const RNodeProfile &profile);
 } // ns GraphDrawing
 
 /// Unused, not instantiatable. Only the partial specialization RActionCRTP<RAction<...>> can be used.
@@ -92,6 +98,17 @@ void ResetRDFValueTuple(std::vector<RTypeErasedColumnValue> &values, std::index_
    (void)expander{(values[S].Cast<ColTypes>()->Reset(), 0)...};
 }
 
+/// Whether Helper processes batches of entries, i.e. implements `ExecBatch(unsigned int, RVec<ColTypes> &...)`
+template <typename Helper, typename ColumnTypes_t, typename = void>
+struct HasExecBatch : std::false_type {
+};
+
+template <typename Helper, typename... ColTypes>
+struct HasExecBatch<Helper, ROOT::TypeTraits::TypeList<ColTypes...>,
+                    decltype(void(std::declval<Helper &>().ExecBatch(
+                       0u, std::declval<ROOT::VecOps::RVec<ColTypes> &>()...)))> : std::true_type {
+};
+
 // fwd decl for RActionCRTP
 template <typename Helper, typename PrevDataFrame, typename ColumnTypes_t>
 class RAction;
@@ -154,10 +171,23 @@ public:
    void Run(unsigned int slot, Long64_t entry) final
    {
       // check if entry passes all filters
-      if (fPrevData.CheckFilters(slot, entry))
+      if (fPrevData.CheckFilters(slot, entry)) {
+         RProfileScope profileScope(fProfile, slot);
          static_cast<Action_t *>(this)->Exec(slot, entry, TypeInd_t());
+      }
    }
 
+   void RunBatch(unsigned int slot, const RBatch &batch) final
+   {
+      const auto &mask = fPrevData.CheckFiltersBatch(slot, batch);
+      if (std::none_of(mask.begin(), mask.end(), [](int m) { return m != 0; }))
+         return;
+      RProfileScope profileScope(fProfile, slot);
+      static_cast<Action_t *>(this)->ExecBatch(slot, batch, mask, TypeInd_t());
+   }
+
+   bool CanRunBatches() const final { return Action_t::kCanRunBatches; }
+
    void TriggerChildrenCount() final { fPrevData.IncrChildrenCount(); }
 
    void FinalizeSlot(unsigned int slot) final
@@ -177,6 +207,8 @@ public:
       SetHasRun();
    }
 
+   void SetUpProfiling(RProfiler *profiler) final { SetUpNodeProfiles(profiler, fHelper.GetActionName()); }
+
    std::shared_ptr<RDFGraphDrawing::GraphNode> GetGraph()
    {
       auto prevNode = fPrevData.GetGraph();
@@ -184,7 +216,8 @@ public:
 
       // Action nodes do not need to ask an helper to create the graph nodes. They are never common nodes between
       // multiple branches
-      auto thisNode = std::make_shared<RDFGraphDrawing::GraphNode>(fHelper.GetActionName());
+      auto thisNode = std::make_shared<RDFGraphDrawing::GraphNode>(fHelper.GetActionName() +
+                                                                   RDFGraphDrawing::FormatProfile(fProfile));
       auto evaluatedNode = thisNode;
       for (auto &column : GetCustomColumns().GetColumns()) {
          /* Each column that this node has but the previous hadn't has been defined in between,
@@ -208,6 +241,18 @@ public:
    /// user-defined callback registered via RResultPtr::RegisterCallback
    void *PartialUpdate(unsigned int slot) final { return PartialUpdateImpl(slot); }
 
+   std::unique_ptr<RActionBase> MakeVariedAction(const std::string &variation, std::shared_ptr<void> &variedResult) final
+   {
+      auto variedPrev = fPrevData.GetVariedNode(variation);
+      auto variedColumns = GetCustomColumns().GetVaried(variation);
+      if (!variedPrev && !GetCustomColumns().IsAnyVaried(GetColumnNames(), variedColumns))
+         return nullptr;
+      std::shared_ptr<RNodeBase> prevNode = fPrevDataPtr;
+      if (variedPrev)
+         prevNode = variedPrev;
+      return BuildVariedAction(prevNode, std::move(variedColumns), variedResult);
+   }
+
 private:
    // this overload is SFINAE'd out if Helper does not implement `PartialUpdate`
    // the template parameter is required to defer instantiation of the method to SFINAE time
@@ -224,10 +269,61 @@ private:
 /// An action node in a RDF computation graph.
 template <typename Helper, typename PrevDataFrame, typename ColumnTypes_t = typename Helper::ColumnTypes_t>
 class RAction final : public RActionCRTP<RAction<Helper, PrevDataFrame, ColumnTypes_t>> {
+   using HasExecBatch_t = HasExecBatch<Helper, ColumnTypes_t>;
+
    std::vector<RDFValueTuple_t<ColumnTypes_t>> fValues;
 
+   template <std::size_t... S>
+   void ExecEntry(unsigned int slot, Long64_t entry, std::index_sequence<S...>, std::false_type)
+   {
+      (void)entry; // avoid bogus 'unused parameter' warning in gcc4.9
+      ActionCRTP_t::GetHelper().Exec(slot, std::get<S>(fValues[slot]).Get(entry)...);
+   }
+
+   // the helper processes batches: the values of the entry are passed as a batch of size one
+   template <std::size_t... S>
+   void ExecEntry(unsigned int slot, Long64_t entry, std::index_sequence<S...>, std::true_type)
+   {
+      (void)entry; // avoid bogus 'unused parameter' warning in gcc4.9
+      auto spans = std::make_tuple(MakeEntrySpan(std::get<S>(fValues[slot]).Get(entry))...);
+      ActionCRTP_t::GetHelper().ExecBatch(slot, std::get<S>(spans)...);
+      (void)spans;
+   }
+
+   template <std::size_t... S>
+   void ExecSelected(unsigned int slot, const RBatch &batch, const RBatchMask_t &mask, std::index_sequence<S...>,
+                     std::false_type)
+   {
+      auto columns = GetBatchValues(batch, mask, std::get<S>(fValues[slot])...);
+      auto &helper = ActionCRTP_t::GetHelper();
+      for (std::size_t i = 0; i < mask.size(); ++i)
+         if (mask[i])
+            helper.Exec(slot, std::get<S>(columns)[i]...);
+      // silence "unused" warnings in gcc for actions without input columns
+      (void)batch;
+      (void)columns;
+   }
+
+   // the helper processes batches: it receives the values of the selected entries only
+   template <std::size_t... S>
+   void ExecSelected(unsigned int slot, const RBatch &batch, const RBatchMask_t &mask, std::index_sequence<S...>,
+                     std::true_type)
+   {
+      const auto nSelected =
+         static_cast<std::size_t>(std::count_if(mask.begin(), mask.end(), [](int m) { return m != 0; }));
+      auto columns = GetBatchValues(batch, mask, std::get<S>(fValues[slot])...);
+      auto spans = std::make_tuple(MakeBatchSpan(std::get<S>(columns), mask, nSelected)...);
+      ActionCRTP_t::GetHelper().ExecBatch(slot, std::get<S>(spans)...);
+      // silence "unused" warnings in gcc for actions without input columns
+      (void)batch;
+      (void)nSelected;
+      (void)columns;
+      (void)spans;
+   }
+
 public:
    using ActionCRTP_t = RActionCRTP<RAction<Helper, PrevDataFrame, ColumnTypes_t>>;
+   static constexpr bool kCanRunBatches = true;
 
    RAction(Helper &&h, const ColumnNames_t &bl, std::shared_ptr<PrevDataFrame> pd,
            RBookedCustomColumns &&customColumns)
@@ -240,10 +336,15 @@ public:
    }
 
    template <std::size_t... S>
-   void Exec(unsigned int slot, Long64_t entry, std::index_sequence<S...>)
+   void Exec(unsigned int slot, Long64_t entry, std::index_sequence<S...> s)
    {
-      (void)entry; // avoid bogus 'unused parameter' warning in gcc4.9
-      ActionCRTP_t::GetHelper().Exec(slot, std::get<S>(fValues[slot]).Get(entry)...);
+      ExecEntry(slot, entry, s, HasExecBatch_t{});
+   }
+
+   template <std::size_t... S>
+   void ExecBatch(unsigned int slot, const RBatch &batch, const RBatchMask_t &mask, std::index_sequence<S...> s)
+   {
+      ExecSelected(slot, batch, mask, s, HasExecBatch_t{});
    }
 
    template <std::size_t... S>
@@ -294,7 +395,18 @@ public:
    void Exec(unsigned int slot, Long64_t entry, std::index_sequence<S...>)
    {
       (void)entry; // avoid bogus 'unused parameter' warning in gcc4.9
-      ActionCRTP_t::GetHelper().Exec(slot, fValues[slot][S].template Get<ColTypes>(entry)...);
+      auto &helper = ActionCRTP_t::GetHelper();
+      // the values of the columns whose baskets are copied are not read, the helper skips them
+      helper.Exec(slot, (helper.IsCloned(S) ? nullptr : &fValues[slot][S].template Get<ColTypes>(entry))...);
+   }
+
+   // the output branches are bound to the addresses of the values of the current entry
+   static constexpr bool kCanRunBatches = false;
+
+   template <std::size_t... S>
+   void ExecBatch(unsigned int, const RBatch &, const RBatchMask_t &, std::index_sequence<S...>)
+   {
+      throw std::logic_error("Snapshot cannot process batches of entries.");
    }
 
    template <std::size_t... S>
@@ -337,6 +449,15 @@ public:
       ActionCRTP_t::GetHelper().Exec(slot, fValues[slot][S].template Get<ColTypes>(entry)...);
    }
 
+   // the output branches are bound to the addresses of the values of the current entry
+   static constexpr bool kCanRunBatches = false;
+
+   template <std::size_t... S>
+   void ExecBatch(unsigned int, const RBatch &, const RBatchMask_t &, std::index_sequence<S...>)
+   {
+      throw std::logic_error("Snapshot cannot process batches of entries.");
+   }
+
    template <std::size_t... S>
    void ResetColumnValues(unsigned int slot, std::index_sequence<S...> s)
    {
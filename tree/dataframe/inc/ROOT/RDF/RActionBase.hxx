@@ -11,12 +11,16 @@
 #ifndef ROOT_RACTIONBASE
 #define ROOT_RACTIONBASE
 
+#include "ROOT/RDF/RBatch.hxx"
 #include "ROOT/RDF/RBookedCustomColumns.hxx"
+#include "ROOT/RDF/RProfiler.hxx"
 #include "ROOT/RDF/Utils.hxx" // ColumnNames_t
 #include "RtypesCore.h"
 
+#include <functional>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace ROOT {
 
@@ -25,6 +29,7 @@ namespace RDF {
 class RLoopManager;
 class RCustomColumnBase;
 class RMergeableValueBase;
+class RNodeBase;
 } // namespace RDF
 } // namespace Detail
 
@@ -43,6 +48,12 @@ bool CheckIfDefaultOrDSColumn(const std::string &name,
 } // namespace GraphDrawing
 
 class RActionBase {
+public:
+   /// Builds a copy of an action that reads the given (varied) upstream node and columns. The varied action fills a
+   /// new result object, which is returned type-erased through the last argument.
+   using VariedActionFactory_t = std::function<std::unique_ptr<RActionBase>(
+      const std::shared_ptr<RNodeBase> &, RBookedCustomColumns &&, std::shared_ptr<void> &)>;
+
 protected:
    /// A raw pointer to the RLoopManager at the root of this functional graph.
    /// Never null: children nodes have shared ownership of parent nodes in the graph.
@@ -54,6 +65,16 @@ private:
    const ColumnNames_t fColumnNames;
 
    RBookedCustomColumns fCustomColumns;
+   VariedActionFactory_t fVariedActionFactory;
+
+protected:
+   /// Time spent executing the action helper, if profiling is enabled
+   RNodeProfile fProfile;
+
+   void SetUpNodeProfiles(RProfiler *profiler, const std::string &actionName);
+   std::unique_ptr<RActionBase> BuildVariedAction(const std::shared_ptr<RNodeBase> &prevNode,
+                                                  RBookedCustomColumns &&variedColumns,
+                                                  std::shared_ptr<void> &variedResult);
 
 public:
    RActionBase(RLoopManager *lm, const ColumnNames_t &colNames, RBookedCustomColumns &&customColumns);
@@ -66,12 +87,19 @@ public:
    RLoopManager *GetLoopManager() { return fLoopManager; }
    unsigned int GetNSlots() const { return fNSlots; }
    virtual void Run(unsigned int slot, Long64_t entry) = 0;
+   /// Execute the action on the entries of the batch that pass the upstream filters, in batched mode
+   virtual void RunBatch(unsigned int slot, const RBatch &batch) = 0;
+   /// Whether the action can run in batched mode. The event loop processes entries one at a time if any action cannot.
+   virtual bool CanRunBatches() const { return true; }
    virtual void Initialize() = 0;
    virtual void InitSlot(TTreeReader *r, unsigned int slot) = 0;
    virtual void TriggerChildrenCount() = 0;
    virtual void ClearValueReaders(unsigned int slot) = 0;
    virtual void FinalizeSlot(unsigned int) = 0;
    virtual void Finalize() = 0;
+   /// Register the profiles of this action and of the custom columns it reads with the profiler of the next event
+   /// loop, or disable them if the event loop is not profiled (i.e. `profiler` is null).
+   virtual void SetUpProfiling(RProfiler *profiler) = 0;
    /// This method is invoked to update a partial result during the event loop, right before passing the result to a
    /// user-defined callback registered via RResultPtr::RegisterCallback
    virtual void *PartialUpdate(unsigned int slot) = 0;
@@ -87,6 +115,14 @@ public:
       with others of the same type.
    */
    virtual std::unique_ptr<RMergeableValueBase> GetMergeableValue() const = 0;
+
+   void SetVariedActionFactory(VariedActionFactory_t &&factory) { fVariedActionFactory = std::move(factory); }
+   /// Return the names of the systematic variations registered upstream of this action
+   virtual std::vector<std::string> GetVariations() const { return fCustomColumns.GetVariationNames(); }
+   /// Create a copy of this action for the given systematic variation, which fills the object returned through
+   /// `variedResult`. Return nullptr if the action is not affected by the variation.
+   virtual std::unique_ptr<RActionBase>
+   MakeVariedAction(const std::string &variation, std::shared_ptr<void> &variedResult) = 0;
 };
 } // namespace RDF
 } // namespace Internal
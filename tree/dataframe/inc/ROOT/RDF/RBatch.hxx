@@ -0,0 +1,166 @@
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RDF_RBATCH
+#define ROOT_RDF_RBATCH
+
+#include "ROOT/RVec.hxx"
+#include "RtypesCore.h"
+
+#include <cstddef> // std::size_t
+#include <deque>
+#include <type_traits>
+#include <vector>
+
+class TTreeReader;
+
+namespace ROOT {
+namespace Internal {
+namespace RDF {
+
+/// The buffer holding the values of a column for the entries of a batch.
+/// std::vector<bool> is avoided, so that nodes can take the values by reference like in the per-entry event loop.
+template <typename T>
+using RBatchValues_t = typename std::conditional<std::is_same<T, bool>::value, std::deque<T>, std::vector<T>>::type;
+
+/// Selection of the entries of a batch: the n-th element is non-zero if the n-th entry passes the filters of a node.
+/// Like the masks of the RVec comparison operators, it is a RVec<int>.
+using RBatchMask_t = ROOT::VecOps::RVec<int>;
+
+/// Base class of the readers of data-source columns, which copy the value of the current entry in their buffer as the
+/// entries are added to the batch, see RBatch
+class RBatchLoaderBase {
+public:
+   virtual ~RBatchLoaderBase() {}
+   /// Copy the value of `entry`, the current entry of the event loop, at position `i` of the buffer of the batch
+   virtual void Load(std::size_t i, Long64_t entry) = 0;
+};
+
+/**
+\class ROOT::Internal::RDF::RBatch
+\ingroup dataframe
+\brief The entries that a slot processes together when the event loop runs in batched mode.
+
+The event loop adds the entries to the batch one at a time. Once the batch is full, the nodes of the computation graph
+process all its entries at once: filters compute selection masks, custom columns fill buffers with their values for the
+selected entries and actions execute on the values of the selected entries. Nodes cache their results per batch,
+identified by GetId().
+
+Tree columns are read by the nodes that use them, once per batch and only for the entries selected by the upstream
+filters: the TTreeReader of the slot is moved back to these entries with Seek(). A batch never spans two clusters or
+two trees of a chain, see IsLastOfCluster(), so that this does not refill the TTreeCache or load another tree. The
+values of data-source columns, which a data source might only provide in order, are instead copied in the buffers of
+the batch as the entries are added.
+**/
+class RBatch {
+   ULong64_t fId = 0ull;                       ///< Unique among the batches of a slot
+   std::vector<Long64_t> fEntries;             ///< The entry numbers, as passed to the nodes in per-entry mode
+   RBatchMask_t fMask;                         ///< All the entries are selected, for the head node of the graph
+   std::vector<RBatchLoaderBase *> fLoaders;   ///< Non-owning, registered while the nodes are set up for a task
+   TTreeReader *fReader = nullptr;             ///< Non-owning, the reader of tree columns of the task, if any
+   std::vector<Long64_t> fReaderEntries;       ///< The entry numbers of fReader, one per entry of the batch
+   mutable std::size_t fPosition = 0;          ///< The entry of the batch fReader is at
+   Long64_t fClusterEnd = 0;                   ///< One past the last entry of the cluster of the batch, in its tree
+
+   void AddReaderEntry(std::size_t i);
+   void RestoreReader();
+
+public:
+   /// Never the id of a batch, to invalidate the cached results of the nodes
+   static constexpr ULong64_t kInvalidId = static_cast<ULong64_t>(-1);
+
+   ULong64_t GetId() const { return fId; }
+   std::size_t GetSize() const { return fEntries.size(); }
+   Long64_t GetEntry(std::size_t i) const { return fEntries[i]; }
+   const RBatchMask_t &GetMask() const { return fMask; }
+
+   void AddLoader(RBatchLoaderBase *loader) { fLoaders.emplace_back(loader); }
+   /// Set the reader of the tree columns of the task, null if the event loop does not read a tree
+   void SetReader(TTreeReader *reader) { fReader = reader; }
+   /// Append the current entry of the event loop, copying the values of the data-source columns
+   void AddEntry(Long64_t entry)
+   {
+      const auto i = fEntries.size();
+      fEntries.emplace_back(entry);
+      fMask.emplace_back(1);
+      if (fReader)
+         AddReaderEntry(i);
+      for (auto *loader : fLoaders)
+         loader->Load(i, entry);
+   }
+   bool IsLastOfCluster() const;
+   /// Move the reader of tree columns to the i-th entry of the batch
+   void Seek(std::size_t i) const;
+   /// Start the next batch of the task
+   void Clear()
+   {
+      if (fReader && !fEntries.empty())
+         RestoreReader();
+      fEntries.clear();
+      fReaderEntries.clear();
+      fMask.clear();
+      ++fId;
+   }
+   /// Start the batches of a new task, whose readers are registered anew. The reader of the previous task, which might
+   /// be gone already, is left alone.
+   void Reset()
+   {
+      fReader = nullptr;
+      Clear();
+      fLoaders.clear();
+   }
+
+   /// Set the batch of the task that is being set up on this thread. The readers of input columns that are created
+   /// while the task is set up register with it. A null batch means that the event loop is not batched.
+   static void SetCurrent(RBatch *batch);
+   static RBatch *GetCurrent();
+};
+
+/// A RVec with the values of the selected entries of a batch. If all entries are selected, it is a view on the buffer.
+template <typename T>
+ROOT::VecOps::RVec<T> MakeBatchSpan(std::vector<T> &values, const RBatchMask_t &mask, std::size_t nSelected)
+{
+   const auto nEntries = mask.size();
+   if (nSelected == nEntries)
+      return ROOT::VecOps::RVec<T>(values.data(), nEntries);
+   ROOT::VecOps::RVec<T> span;
+   span.reserve(nSelected);
+   for (std::size_t i = 0; i < nEntries; ++i)
+      if (mask[i])
+         span.emplace_back(values[i]);
+   return span;
+}
+
+/// RVec<bool> cannot adopt memory, the values are always copied
+inline ROOT::VecOps::RVec<bool> MakeBatchSpan(std::deque<bool> &values, const RBatchMask_t &mask, std::size_t nSelected)
+{
+   ROOT::VecOps::RVec<bool> span;
+   span.reserve(nSelected);
+   for (std::size_t i = 0; i < mask.size(); ++i)
+      if (mask[i])
+         span.emplace_back(values[i]);
+   return span;
+}
+
+/// A RVec with the single value of an entry, for actions that process batches in a per-entry event loop
+template <typename T>
+ROOT::VecOps::RVec<T> MakeEntrySpan(T &value)
+{
+   return ROOT::VecOps::RVec<T>(&value, 1);
+}
+
+inline ROOT::VecOps::RVec<bool> MakeEntrySpan(bool &value)
+{
+   return ROOT::VecOps::RVec<bool>(1, value);
+}
+
+} // namespace RDF
+} // namespace Internal
+} // namespace ROOT
+
+#endif // ROOT_RDF_RBATCH
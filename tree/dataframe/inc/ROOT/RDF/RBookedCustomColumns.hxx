@@ -39,14 +39,19 @@ namespace RDFDetail = ROOT::Detail::RDF;
 class RBookedCustomColumns {
    using RCustomColumnBasePtrMap_t = std::map<std::string, std::shared_ptr<RDFDetail::RCustomColumnBase>>;
    using ColumnNames_t = std::vector<std::string>;
+   /// Maps the name of a systematic variation ("variationName:tag") to the varied column and its value in the variation
+   using RVariedColumnsMap_t =
+      std::map<std::string, std::pair<std::string, std::shared_ptr<RDFDetail::RCustomColumnBase>>>;
 
    // Since RBookedCustomColumns is meant to be an immutable, copy-on-write object, the actual values are set as const
    using RCustomColumnBasePtrMapPtr_t = std::shared_ptr<const RCustomColumnBasePtrMap_t>;
    using ColumnNamesPtr_t = std::shared_ptr<const ColumnNames_t>;
+   using RVariedColumnsMapPtr_t = std::shared_ptr<const RVariedColumnsMap_t>;
 
 private:
    RCustomColumnBasePtrMapPtr_t fCustomColumns;
    ColumnNamesPtr_t fCustomColumnsNames;
+   RVariedColumnsMapPtr_t fVariedColumns;
 
 public:
    ////////////////////////////////////////////////////////////////////////////
@@ -63,8 +68,9 @@ public:
 
    ////////////////////////////////////////////////////////////////////////////
    /// \brief Creates the object starting from the provided maps
-   RBookedCustomColumns(RCustomColumnBasePtrMapPtr_t customColumns, ColumnNamesPtr_t customColumnNames)
-      : fCustomColumns(customColumns), fCustomColumnsNames(customColumnNames)
+   RBookedCustomColumns(RCustomColumnBasePtrMapPtr_t customColumns, ColumnNamesPtr_t customColumnNames,
+                        RVariedColumnsMapPtr_t variedColumns = std::make_shared<RVariedColumnsMap_t>())
+      : fCustomColumns(customColumns), fCustomColumnsNames(customColumnNames), fVariedColumns(variedColumns)
    {
    }
 
@@ -72,7 +78,8 @@ public:
    /// \brief Creates a new wrapper with empty maps
    RBookedCustomColumns()
       : fCustomColumns(std::make_shared<RCustomColumnBasePtrMap_t>()),
-        fCustomColumnsNames(std::make_shared<ColumnNames_t>())
+        fCustomColumnsNames(std::make_shared<ColumnNames_t>()),
+        fVariedColumns(std::make_shared<RVariedColumnsMap_t>())
    {
    }
 
@@ -95,6 +102,26 @@ public:
    ////////////////////////////////////////////////////////////////////////////
    /// \brief Internally it recreates the map with the new column name, and swaps with the old one.
    void AddName(std::string_view name);
+
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Registers the value that the column `colName` takes in the systematic variation `variation`.
+   /// Internally it recreates the map of variations, and swaps with the old one.
+   void AddVariedColumn(std::string_view variation, std::string_view colName,
+                        const std::shared_ptr<RDFDetail::RCustomColumnBase> &column);
+
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Returns the names of the systematic variations registered so far, in the form "variationName:tag"
+   ColumnNames_t GetVariationNames() const;
+
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Returns the columns as they are seen in the given systematic variation
+   /// The varied column is replaced by its value in the variation, and the custom columns that depend on it are
+   /// replaced by varied copies. The object is returned unchanged if the variation is not registered.
+   RBookedCustomColumns GetVaried(const std::string &variation) const;
+
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Check whether any of the given columns is replaced by a different column in `varied`
+   bool IsAnyVaried(const ColumnNames_t &names, const RBookedCustomColumns &varied) const;
 };
 
 } // Namespace RDF
@@ -0,0 +1,310 @@
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RCACHEDS
+#define ROOT_RCACHEDS
+
+#include "ROOT/RDataSource.hxx"
+#include "ROOT/RDF/Utils.hxx" // TypeID2TypeName
+#include "ROOT/RIntegerSequence.hxx"
+#include "ROOT/RResultPtr.hxx"
+#include "ROOT/RVec.hxx"
+#include "RtypesCore.h"
+#include "TDirectory.h"
+#include "TFile.h"
+#include "TSystem.h"
+#include "TTree.h"
+
+#include <algorithm>
+#include <array>
+#include <deque>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+namespace ROOT {
+namespace Internal {
+namespace RDF {
+
+/// Type used to store a cached column of type T in a spill file, and the conversions from and to it.
+/// RVecs are written as std::vectors, as Snapshot does.
+template <typename T>
+struct RCacheDiskType {
+   using Type_t = T;
+   static void ToDisk(T &in, Type_t &out) { out = std::move(in); }
+};
+
+template <typename T>
+struct RCacheDiskType<ROOT::VecOps::RVec<T>> {
+   using Type_t = std::vector<T>;
+   static void ToDisk(ROOT::VecOps::RVec<T> &in, Type_t &out) { out.assign(in.begin(), in.end()); }
+   static void FromDisk(const Type_t &in, ROOT::VecOps::RVec<T> &out)
+   {
+      out.resize(in.size());
+      std::copy(in.begin(), in.end(), out.begin());
+   }
+};
+
+/// Estimate the memory used by a cached value: collections also account for their elements
+template <typename T>
+auto EstimateCacheSize(const T &v, int) -> decltype(v.size(), std::size_t())
+{
+   return sizeof(T) + v.size() * sizeof(typename T::value_type);
+}
+
+template <typename T>
+std::size_t EstimateCacheSize(const T &, long)
+{
+   return sizeof(T);
+}
+
+/// The entries stored by RInterface::Cache when a memory budget is given. Each chunk of entries is either held in
+/// memory or, if it did not fit in the budget, in a TTree written to a spill file. Spill files are removed when the
+/// cached data is destroyed.
+template <typename... ColTypes>
+struct RCachedData {
+   using Columns_t = std::tuple<std::deque<ColTypes>...>;
+   struct RChunk {
+      Columns_t fColumns;      ///< The entries of the chunk, if it is held in memory
+      std::string fFileName;   ///< The spill file of the chunk, empty if it is held in memory
+      ULong64_t fNEntries = 0; ///< Number of entries in the chunk
+   };
+   static constexpr const char *fgTreeName = "rdfcache";
+
+   std::vector<RChunk> fChunks;
+
+   RCachedData() = default;
+   RCachedData(const RCachedData &) = delete;
+   RCachedData &operator=(const RCachedData &) = delete;
+   ~RCachedData()
+   {
+      for (const auto &chunk : fChunks)
+         if (!chunk.fFileName.empty())
+            gSystem->Unlink(chunk.fFileName.c_str());
+   }
+
+   void AddMemoryChunk(Columns_t &&columns)
+   {
+      RChunk chunk;
+      chunk.fNEntries = std::get<0>(columns).size();
+      chunk.fColumns = std::move(columns);
+      fChunks.emplace_back(std::move(chunk));
+   }
+
+   void AddDiskChunk(const std::string &fileName, ULong64_t nEntries)
+   {
+      RChunk chunk;
+      chunk.fFileName = fileName;
+      chunk.fNEntries = nEntries;
+      fChunks.emplace_back(std::move(chunk));
+   }
+};
+
+/// A RDataSource that reads the entries produced by RInterface::Cache when a memory budget is given. Entries held in
+/// memory are accessed without copies, entries in spill files are streamed back by each slot one chunk at a time.
+/// The event loop that fills the cache is triggered by the first event loop over this data source.
+template <typename... ColTypes>
+class RCacheDS final : public ROOT::RDF::RDataSource {
+   using Data_t = RCachedData<ColTypes...>;
+   using DiskValues_t = std::tuple<typename RCacheDiskType<ColTypes>::Type_t...>;
+
+   /// Per-slot reading state. Slots are never resized once the number of slots is known, so the addresses of the
+   /// column pointers handed out by GetColumnReadersImpl stay valid.
+   struct RSlotData {
+      std::tuple<ColTypes *...> fPtrs{}; ///< Pointers to the values of the current entry
+      std::size_t fChunk = 0;           ///< Index of the chunk that contains the current entry
+      std::unique_ptr<TFile> fFile;     ///< Spill file of the current chunk, if it is on disk
+      TTree *fTree = nullptr;           ///< Tree of the current chunk, if it is on disk (owned by fFile)
+      std::string fFileName;            ///< Name of fFile
+      DiskValues_t fDiskValues;         ///< Values read from fTree
+      std::tuple<ColTypes...> fValues;  ///< Values converted from fDiskValues, for types stored differently on disk
+   };
+
+   ROOT::RDF::RResultPtr<Data_t> fData;
+   const std::vector<std::string> fColNames;
+   const std::vector<std::string> fColTypeNames;
+   std::vector<RSlotData> fSlots;
+   std::vector<ULong64_t> fChunkBegins; ///< Index of the first entry of each chunk
+   std::vector<std::pair<ULong64_t, ULong64_t>> fEntryRanges;
+   unsigned int fNSlots = 0;
+
+   template <std::size_t... S>
+   std::array<void *, sizeof...(ColTypes)> GetPtrAddresses(RSlotData &slotData, std::index_sequence<S...>)
+   {
+      return {{static_cast<void *>(&std::get<S>(slotData.fPtrs))...}};
+   }
+
+   Record_t GetColumnReadersImpl(std::string_view colName, const std::type_info &id)
+   {
+      const auto colNameStr = std::string(colName);
+      const auto it = std::find(fColNames.begin(), fColNames.end(), colNameStr);
+      if (it == fColNames.end()) {
+         std::string err = "The specified column name, \"" + colNameStr + "\" is not known to the data source.";
+         throw std::runtime_error(err);
+      }
+      const auto index = std::distance(fColNames.begin(), it);
+      const auto idName = ROOT::Internal::RDF::TypeID2TypeName(id);
+      if (fColTypeNames[index] != idName) {
+         std::string err = "Column " + colNameStr + " has type " + fColTypeNames[index] +
+                           " while the id specified is associated to type " + idName;
+         throw std::runtime_error(err);
+      }
+
+      Record_t ret(fNSlots);
+      for (auto slot = 0u; slot < fNSlots; ++slot)
+         ret[slot] = GetPtrAddresses(fSlots[slot], std::index_sequence_for<ColTypes...>())[index];
+      return ret;
+   }
+
+   template <std::size_t... S>
+   void OpenSpillFile(RSlotData &slotData, const std::string &fileName, std::index_sequence<S...>)
+   {
+      if (slotData.fFileName == fileName)
+         return;
+      TDirectory::TContext ctxt;
+      slotData.fFile.reset(TFile::Open(fileName.c_str(), "READ"));
+      if (!slotData.fFile || slotData.fFile->IsZombie())
+         throw std::runtime_error("Cache: cannot open spill file " + fileName);
+      slotData.fFileName = fileName;
+      slotData.fFile->GetObject(Data_t::fgTreeName, slotData.fTree);
+      if (!slotData.fTree)
+         throw std::runtime_error("Cache: cannot read the entries stored in spill file " + fileName);
+      std::initializer_list<int> expander{(
+         slotData.fTree->SetBranchAddress(("c" + std::to_string(S)).c_str(), &std::get<S>(slotData.fDiskValues)),
+         0)...};
+      (void)expander;
+   }
+
+   template <typename T>
+   static T *FromDisk(T &diskValue, T &)
+   {
+      return &diskValue;
+   }
+
+   template <typename T>
+   static ROOT::VecOps::RVec<T> *FromDisk(std::vector<T> &diskValue, ROOT::VecOps::RVec<T> &value)
+   {
+      RCacheDiskType<ROOT::VecOps::RVec<T>>::FromDisk(diskValue, value);
+      return &value;
+   }
+
+   template <std::size_t... S>
+   void SetEntryHelper(RSlotData &slotData, ULong64_t entry, std::index_sequence<S...>)
+   {
+      auto &chunk = fData->fChunks[slotData.fChunk];
+      const auto localEntry = entry - fChunkBegins[slotData.fChunk];
+      if (chunk.fFileName.empty()) {
+         std::initializer_list<int> expander{
+            (std::get<S>(slotData.fPtrs) = &std::get<S>(chunk.fColumns)[localEntry], 0)...};
+         (void)expander;
+      } else {
+         slotData.fTree->GetEntry(localEntry);
+         std::initializer_list<int> expander{(std::get<S>(slotData.fPtrs) = FromDisk(
+                                                 std::get<S>(slotData.fDiskValues), std::get<S>(slotData.fValues)),
+                                              0)...};
+         (void)expander;
+      }
+   }
+
+protected:
+   std::string AsString() { return "cache data source"; };
+
+public:
+   RCacheDS(const ROOT::RDF::RResultPtr<Data_t> &data, const std::vector<std::string> &colNames)
+      : fData(data), fColNames(colNames),
+        fColTypeNames({ROOT::Internal::RDF::TypeID2TypeName(typeid(ColTypes))...})
+   {
+   }
+
+   const std::vector<std::string> &GetColumnNames() const { return fColNames; }
+
+   std::string GetTypeName(std::string_view colName) const
+   {
+      const auto colNameStr = std::string(colName);
+      const auto it = std::find(fColNames.begin(), fColNames.end(), colNameStr);
+      if (it == fColNames.end())
+         throw std::runtime_error("The specified column name, \"" + colNameStr + "\" is not known to the data source.");
+      return fColTypeNames[std::distance(fColNames.begin(), it)];
+   }
+
+   bool HasColumn(std::string_view colName) const
+   {
+      return std::find(fColNames.begin(), fColNames.end(), std::string(colName)) != fColNames.end();
+   }
+
+   std::vector<std::pair<ULong64_t, ULong64_t>> GetEntryRanges()
+   {
+      auto entryRanges(std::move(fEntryRanges)); // empty fEntryRanges
+      return entryRanges;
+   }
+
+   bool SetEntry(unsigned int slot, ULong64_t entry)
+   {
+      SetEntryHelper(fSlots[slot], entry, std::index_sequence_for<ColTypes...>());
+      return true;
+   }
+
+   void SetNSlots(unsigned int nSlots)
+   {
+      fNSlots = nSlots;
+      fSlots = std::vector<RSlotData>(fNSlots);
+   }
+
+   void Initialise()
+   {
+      // Accessing the data triggers the event loop that fills the cache, the first time
+      const auto &chunks = fData->fChunks;
+      fChunkBegins.clear();
+      ULong64_t nEntries = 0ull;
+      for (const auto &chunk : chunks) {
+         fChunkBegins.emplace_back(nEntries);
+         nEntries += chunk.fNEntries;
+      }
+
+      // Ranges never span more than one chunk, so that each task reads at most one spill file
+      const auto rangeSize = std::max(1ull, nEntries / (2ull * fNSlots));
+      fEntryRanges.clear();
+      for (auto i = 0u; i < chunks.size(); ++i) {
+         const auto chunkEnd = fChunkBegins[i] + chunks[i].fNEntries;
+         for (auto begin = fChunkBegins[i]; begin < chunkEnd; begin += rangeSize)
+            fEntryRanges.emplace_back(begin, std::min(begin + rangeSize, chunkEnd));
+      }
+   }
+
+   void InitSlot(unsigned int slot, ULong64_t firstEntry)
+   {
+      auto &slotData = fSlots[slot];
+      const auto chunkIt = std::upper_bound(fChunkBegins.begin(), fChunkBegins.end(), firstEntry);
+      slotData.fChunk = std::distance(fChunkBegins.begin(), chunkIt) - 1;
+      const auto &fileName = fData->fChunks[slotData.fChunk].fFileName;
+      if (!fileName.empty())
+         OpenSpillFile(slotData, fileName, std::index_sequence_for<ColTypes...>());
+   }
+
+   void Finalise()
+   {
+      // release the spill files, they might be removed before the next event loop
+      for (auto &slotData : fSlots) {
+         slotData.fTree = nullptr;
+         slotData.fFile.reset();
+         slotData.fFileName.clear();
+      }
+   }
+
+   std::string GetLabel() { return "CacheDS"; }
+};
+
+} // namespace RDF
+} // namespace Internal
+} // namespace ROOT
+
+#endif
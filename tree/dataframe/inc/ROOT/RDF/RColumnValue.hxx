@@ -11,6 +11,7 @@
 #ifndef ROOT_RCOLUMNVALUE
 #define ROOT_RCOLUMNVALUE
 
+#include <ROOT/RDF/RBatch.hxx>
 #include <ROOT/RDF/RCustomColumnBase.hxx>
 #include <ROOT/RDF/Utils.hxx> // IsRVec_t, TypeID2TypeName
 #include <ROOT/RIntegerSequence.hxx>
@@ -22,6 +23,7 @@
 #include <TTreeReaderValue.h>
 #include <TTreeReaderArray.h>
 
+#include <algorithm> // std::find
 #include <cstring> // strcmp
 #include <initializer_list>
 #include <limits>
@@ -57,9 +59,14 @@ TTree branch or from a temporary column respectively.
 
 RDataFrame nodes can store tuples of RColumnValues and retrieve an updated
 value for the column via the `Get` method.
+
+When the event loop runs in batched mode, nodes retrieve the values of the entries of a batch that pass their upstream
+filters via GetBatchValues instead. The values of tree branches are then copied in a buffer, for those entries only.
+The values of data-source columns are copied in a buffer, entry by entry, while the event loop fills the batch (see
+RBatch). The values of temporary columns are computed for the whole batch at once.
 **/
 template <typename T>
-class R__CLING_PTRCHECK(off) RColumnValue {
+class R__CLING_PTRCHECK(off) RColumnValue : public RBatchLoaderBase {
 // R__CLING_PTRCHECK is disabled because all pointers are hand-crafted by RDF.
 
    using MustUseRVec_t = IsRVec_t<T>;
@@ -74,8 +81,11 @@ class R__CLING_PTRCHECK(off) RColumnValue {
    enum class EColumnKind { kTree, kCustomColumn, kDataSource, kInvalid };
    // Set to the correct value by MakeProxy or SetTmpColumn
    EColumnKind fColumnKind = EColumnKind::kInvalid;
-   /// The slot this value belongs to. Only needed when querying custom column values, it is set in `SetTmpColumn`.
+   /// The slot this value belongs to. Only needed when querying custom column values or profiling the reading of
+   /// tree columns, it is set in `SetTmpColumn` or `MakeProxy`.
    unsigned int fSlot = std::numeric_limits<unsigned int>::max();
+   /// Non-owning ptr to the profile of the reads of a tree column. Null unless the event loop is profiled.
+   RNodeProfile *fIOProfile = nullptr;
 
    // Each element of the following stacks will be in use by a _single task_.
    // Each task will push one element when it starts and pop it when it ends.
@@ -98,6 +108,34 @@ class R__CLING_PTRCHECK(off) RColumnValue {
    /// If MustUseRVec, i.e. we are reading an array, we return a reference to this RVec to clients
    RVec<ColumnValue_t> fRVec;
    bool fCopyWarningPrinted = false;
+   /// The values of the entries of the current batch, for tree and data-source columns in batched mode
+   RBatchValues_t<T> fBatchValues;
+   /// The id of the batch whose values of a tree column are in fBatchValues
+   ULong64_t fLoadedBatch = RBatch::kInvalidId;
+   /// The entries of the batch whose values of a tree column are in fBatchValues
+   RBatchMask_t fIsLoaded;
+
+   /// Whether the values can be copied in the buffer of a batch
+   template <typename U>
+   using IsBatchCopyable =
+      std::integral_constant<bool, std::is_default_constructible<U>::value && std::is_copy_constructible<U>::value &&
+                                      std::is_copy_assignable<U>::value>;
+
+   template <typename U = T, typename std::enable_if<IsBatchCopyable<U>::value, int>::type = 0>
+   void LoadImpl(std::size_t i, Long64_t entry)
+   {
+      if (fBatchValues.size() <= i)
+         fBatchValues.resize(i + 1);
+      fBatchValues[i] = Get(entry);
+   }
+
+   template <typename U = T, typename std::enable_if<!IsBatchCopyable<U>::value, int>::type = 0>
+   void LoadImpl(std::size_t, Long64_t)
+   {
+      throw std::runtime_error("RColumnValue: the values of type " + TypeID2TypeName(typeid(T)) +
+                               " cannot be copied in the buffers of a batch, the event loop cannot run in "
+                               "batched mode");
+   }
 
 public:
    RColumnValue(){};
@@ -135,12 +173,19 @@ public:
          throw std::runtime_error(errMsg);
       }
 
+      auto batch = RBatch::GetCurrent();
       if (customColumn->IsDataSourceColumn()) {
          fColumnKind = EColumnKind::kDataSource;
          fDSValuePtr = static_cast<T **>(customColumn->GetValuePtr(slot));
+         if (batch)
+            batch->AddLoader(this);
       } else {
          fColumnKind = EColumnKind::kCustomColumn;
          fCustomValuePtr = static_cast<T *>(customColumn->GetValuePtr(slot));
+         // the buffer of the batch is a RBatchValues_t of the type of the custom column
+         if (batch && diffTypes)
+            throw std::runtime_error("RColumnValue: column \"" + customColumn->GetName() +
+                                     "\" cannot be read as one of its base classes in batched mode");
       }
       fSlot = slot;
    }
@@ -149,6 +194,57 @@ public:
    {
       fColumnKind = EColumnKind::kTree;
       fTreeReader = std::make_unique<TreeReader_t>(*r, bn.c_str());
+      if (auto profiler = RProfiler::GetCurrent()) {
+         fIOProfile = profiler->GetColumnProfile(bn);
+         fSlot = RProfiler::GetCurrentSlot();
+      } else {
+         fIOProfile = nullptr;
+      }
+      fLoadedBatch = RBatch::kInvalidId;
+   }
+
+   /// Copy the value of the current entry at position `i` of the buffer of the batch. Called by RBatch for data-source
+   /// columns, at each entry of the event loop in batched mode.
+   void Load(std::size_t i, Long64_t entry) final { LoadImpl(i, entry); }
+
+   /// Get ready to read the values of a tree column for some entries of the batch, see GetBatchValues. Return false
+   /// for the other kinds of columns.
+   bool PrepareBatch(const RBatch &batch)
+   {
+      if (fColumnKind != EColumnKind::kTree)
+         return false;
+      if (batch.GetId() != fLoadedBatch) {
+         fLoadedBatch = batch.GetId();
+         fIsLoaded.clear();
+         fIsLoaded.resize(batch.GetSize(), 0);
+      }
+      return true;
+   }
+
+   /// Copy the value of a tree column for the i-th entry of the batch in the buffer, unless it is there already,
+   /// moving the reader to the entry if it is not there yet.
+   void LoadBatchEntry(const RBatch &batch, std::size_t i, bool &isReaderAtEntry)
+   {
+      if (fColumnKind != EColumnKind::kTree || fIsLoaded[i])
+         return;
+      if (!isReaderAtEntry) {
+         batch.Seek(i);
+         isReaderAtEntry = true;
+      }
+      LoadImpl(i, batch.GetEntry(i));
+      fIsLoaded[i] = 1;
+   }
+
+   /// Return the values of the entries of the current batch, in batched mode. The values of custom columns are only
+   /// computed for the entries selected by `mask`, the others are left unspecified. The values of tree columns are
+   /// the ones read by GetBatchValues.
+   RBatchValues_t<T> &GetBatch(const RBatch &batch, const RBatchMask_t &mask)
+   {
+      if (fColumnKind == EColumnKind::kCustomColumn) {
+         fCustomColumn->UpdateBatch(fSlot, batch, mask);
+         return *static_cast<RBatchValues_t<T> *>(fCustomColumn->GetBatchValuesPtr(fSlot));
+      }
+      return fBatchValues;
    }
 
    /// This overload is used to return scalar quantities (i.e. types that are not read into a RVec)
@@ -159,6 +255,7 @@ public:
    T &Get(Long64_t entry)
    {
       if (fColumnKind == EColumnKind::kTree) {
+         RProfileScope ioScope(fIOProfile, fSlot);
          return *(fTreeReader->Get());
       } else {
          fCustomColumn->Update(fSlot, entry);
@@ -175,6 +272,7 @@ public:
    T &Get(Long64_t entry)
    {
       if (fColumnKind == EColumnKind::kTree) {
+         RProfileScope ioScope(fIOProfile, fSlot);
          auto &readerArray = *fTreeReader;
          // We only use TTreeReaderArrays to read columns that users flagged as type `RVec`, so we need to check
          // that the branch stores the array as contiguous memory that we can actually wrap in an `RVec`.
@@ -248,6 +346,7 @@ public:
    T &Get(Long64_t entry)
    {
       if (fColumnKind == EColumnKind::kTree) {
+         RProfileScope ioScope(fIOProfile, fSlot);
          auto &readerArray = *fTreeReader;
          const auto readerArraySize = readerArray.GetSize();
          if (readerArraySize > 0) {
@@ -278,6 +377,7 @@ public:
       // See https://github.com/root-project/root/commit/26e8ace6e47de6794ac9ec770c3bbff9b7f2e945
       if (EColumnKind::kTree == fColumnKind) {
          fTreeReader.reset();
+         fIOProfile = nullptr;
       }
    }
 };
@@ -316,6 +416,29 @@ struct TRDFValueTuple<TypeList<BranchTypes...>> {
 template <typename BranchType>
 using RDFValueTuple_t = typename TRDFValueTuple<BranchType>::type;
 
+/// Return the values of the columns of a node for the entries of the batch selected by mask, in batched mode. The
+/// tree columns are read together, entry by entry, so that the reader of the batch is moved to each selected entry at
+/// most once; entries whose values were read for the node before, with another mask, are not read again.
+template <typename... ColTypes>
+std::tuple<RBatchValues_t<ColTypes> &...>
+GetBatchValues(const RBatch &batch, const RBatchMask_t &mask, RColumnValue<ColTypes> &... columns)
+{
+   const bool readsTree[] = {false, columns.PrepareBatch(batch)...};
+   if (std::find(std::begin(readsTree), std::end(readsTree), true) != std::end(readsTree)) {
+      for (std::size_t i = 0; i < mask.size(); ++i) {
+         if (!mask[i])
+            continue;
+         bool isReaderAtEntry = false;
+         // hack to expand a parameter pack without c++17 fold expressions.
+         std::initializer_list<int> expander{(columns.LoadBatchEntry(batch, i, isReaderAtEntry), 0)...};
+         (void)expander; // avoid "unused variable" warnings
+         (void)isReaderAtEntry;
+      }
+   }
+   (void)batch; // for nodes without input columns
+   return std::forward_as_tuple(columns.GetBatch(batch, mask)...);
+}
+
 /// Clear the proxies of a tuple of RColumnValues
 template <typename ValueTuple, std::size_t... S>
 void ResetRDFValueTuple(ValueTuple &values, std::index_sequence<S...>)
@@ -21,6 +21,8 @@
 #include "RtypesCore.h"
 
 #include <deque>
+#include <memory>
+#include <stdexcept>
 #include <type_traits>
 #include <vector>
 
@@ -58,9 +60,17 @@ class RCustomColumn final : public RCustomColumnBase {
    using ValuesPerSlot_t =
       typename std::conditional<std::is_same<ret_type, bool>::value, std::deque<ret_type>, std::vector<ret_type>>::type;
 
+   using BatchValues_t = RDFInternal::RBatchValues_t<ret_type>;
+
    F fExpression;
    const ColumnNames_t fColumnNames;
    ValuesPerSlot_t fLastResults;
+   /// Per slot, the values of the entries of the current batch, in batched mode
+   std::vector<BatchValues_t> fBatchValues;
+   /// Per slot, the entries of the current batch whose value was computed
+   std::vector<RDFInternal::RBatchMask_t> fIsEvaluated;
+   /// Per slot, the entries of the current batch whose value is computed by the ongoing UpdateBatch call
+   std::vector<RDFInternal::RBatchMask_t> fToEvaluate;
 
    std::vector<RDFInternal::RDFValueTuple_t<ColumnTypes_t>> fValues;
 
@@ -94,11 +104,76 @@ class RCustomColumn final : public RCustomColumnBase {
       (void)entry;
    }
 
+   template <std::size_t... S>
+   void UpdateBatchHelper(unsigned int slot, const RDFInternal::RBatch &batch, const RDFInternal::RBatchMask_t &mask,
+                          std::index_sequence<S...>, NoneTag)
+   {
+      auto columns = RDFInternal::GetBatchValues(batch, mask, std::get<S>(fValues[slot])...);
+      auto &values = fBatchValues[slot];
+      for (std::size_t i = 0; i < mask.size(); ++i)
+         if (mask[i])
+            values[i] = fExpression(std::get<S>(columns)[i]...);
+      // silence "unused" warnings in gcc for expressions without input columns
+      (void)batch;
+      (void)columns;
+   }
+
+   template <std::size_t... S>
+   void UpdateBatchHelper(unsigned int slot, const RDFInternal::RBatch &batch, const RDFInternal::RBatchMask_t &mask,
+                          std::index_sequence<S...>, SlotTag)
+   {
+      auto columns = RDFInternal::GetBatchValues(batch, mask, std::get<S>(fValues[slot])...);
+      auto &values = fBatchValues[slot];
+      for (std::size_t i = 0; i < mask.size(); ++i)
+         if (mask[i])
+            values[i] = fExpression(slot, std::get<S>(columns)[i]...);
+      // silence "unused" warnings in gcc for expressions without input columns
+      (void)batch;
+      (void)columns;
+   }
+
+   template <std::size_t... S>
+   void UpdateBatchHelper(unsigned int slot, const RDFInternal::RBatch &batch, const RDFInternal::RBatchMask_t &mask,
+                          std::index_sequence<S...>, SlotAndEntryTag)
+   {
+      auto columns = RDFInternal::GetBatchValues(batch, mask, std::get<S>(fValues[slot])...);
+      auto &values = fBatchValues[slot];
+      for (std::size_t i = 0; i < mask.size(); ++i)
+         if (mask[i])
+            values[i] = fExpression(slot, batch.GetEntry(i), std::get<S>(columns)[i]...);
+      // silence "unused" warnings in gcc for expressions without input columns
+      (void)columns;
+   }
+
+   template <typename G = F, typename std::enable_if<std::is_copy_constructible<G>::value, int>::type = 0>
+   std::shared_ptr<RCustomColumnBase> MakeVariedCopy(const RDFInternal::RBookedCustomColumns &variedColumns)
+   {
+      return std::make_shared<RCustomColumn>(fName, fType, fExpression, fColumnNames, fNSlots, variedColumns,
+                                             fIsDataSourceColumn);
+   }
+
+   template <typename G = F, typename std::enable_if<!std::is_copy_constructible<G>::value, int>::type = 0>
+   std::shared_ptr<RCustomColumnBase> MakeVariedCopy(const RDFInternal::RBookedCustomColumns &)
+   {
+      throw std::runtime_error("Column \"" + fName +
+                               "\" depends on a systematic variation but its expression cannot be copied.");
+   }
+
+protected:
+   std::shared_ptr<RCustomColumnBase> MakeVariedColumn(const std::string &variation) final
+   {
+      auto variedColumns = fCustomColumns.GetVaried(variation);
+      if (!fCustomColumns.IsAnyVaried(fColumnNames, variedColumns))
+         return nullptr;
+      return MakeVariedCopy(variedColumns);
+   }
+
 public:
    RCustomColumn(std::string_view name, std::string_view type, F expression, const ColumnNames_t &columns,
                  unsigned int nSlots, const RDFInternal::RBookedCustomColumns &customColumns, bool isDSColumn = false)
       : RCustomColumnBase(name, type, nSlots, isDSColumn, customColumns), fExpression(std::move(expression)),
-        fColumnNames(columns), fLastResults(fNSlots), fValues(fNSlots), fIsCustomColumn()
+        fColumnNames(columns), fLastResults(fNSlots), fBatchValues(fNSlots), fIsEvaluated(fNSlots),
+        fToEvaluate(fNSlots), fValues(fNSlots), fIsCustomColumn()
    {
       const auto nColumns = fColumnNames.size();
       for (auto i = 0u; i < nColumns; ++i)
@@ -114,6 +189,7 @@ public:
          fIsInitialized[slot] = true;
          RDFInternal::InitRDFValues(slot, fValues[slot], r, fColumnNames, fCustomColumns, TypeInd_t(), fIsCustomColumn);
          fLastCheckedEntry[slot] = -1;
+         fLastCheckedBatch[slot] = RDFInternal::RBatch::kInvalidId;
       }
    }
 
@@ -123,11 +199,42 @@ public:
    {
       if (entry != fLastCheckedEntry[slot]) {
          // evaluate this filter, cache the result
+         RDFInternal::RProfileScope profileScope(fProfile, slot);
          UpdateHelper(slot, entry, TypeInd_t(), ExtraArgsTag{});
          fLastCheckedEntry[slot] = entry;
       }
    }
 
+   void UpdateBatch(unsigned int slot, const RDFInternal::RBatch &batch, const RDFInternal::RBatchMask_t &mask) final
+   {
+      const auto nEntries = batch.GetSize();
+      auto &isEvaluated = fIsEvaluated[slot];
+      if (batch.GetId() != fLastCheckedBatch[slot]) {
+         fLastCheckedBatch[slot] = batch.GetId();
+         isEvaluated.clear();
+         isEvaluated.resize(nEntries, 0);
+         if (fBatchValues[slot].size() < nEntries)
+            fBatchValues[slot].resize(nEntries);
+      }
+
+      // only compute the values of the selected entries that other nodes did not request yet
+      auto &toEvaluate = fToEvaluate[slot];
+      toEvaluate.resize(nEntries);
+      bool anyToEvaluate = false;
+      for (std::size_t i = 0; i < nEntries; ++i) {
+         toEvaluate[i] = mask[i] && !isEvaluated[i];
+         anyToEvaluate = anyToEvaluate || toEvaluate[i];
+         isEvaluated[i] = isEvaluated[i] || mask[i];
+      }
+      if (!anyToEvaluate)
+         return;
+
+      RDFInternal::RProfileScope profileScope(fProfile, slot);
+      UpdateBatchHelper(slot, batch, toEvaluate, TypeInd_t(), ExtraArgsTag{});
+   }
+
+   void *GetBatchValuesPtr(unsigned int slot) final { return static_cast<void *>(&fBatchValues[slot]); }
+
    const std::type_info &GetTypeId() const
    {
       return fIsDataSourceColumn ? typeid(typename std::remove_pointer<ret_type>::type) : typeid(ret_type);
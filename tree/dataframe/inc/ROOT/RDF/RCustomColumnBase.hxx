@@ -12,10 +12,13 @@
 #define ROOT_RCUSTOMCOLUMNBASE
 
 #include "ROOT/RDF/GraphNode.hxx"
+#include "ROOT/RDF/RBatch.hxx"
 #include "ROOT/RDF/RBookedCustomColumns.hxx"
+#include "ROOT/RDF/RProfiler.hxx"
 
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <deque>
 
@@ -36,14 +39,22 @@ protected:
    const unsigned int fNSlots;      ///< number of thread slots used by this node, inherited from parent node.
    const bool fIsDataSourceColumn; ///< does the custom column refer to a data-source column? (or a user-define column?)
    std::vector<Long64_t> fLastCheckedEntry;
+   std::vector<ULong64_t> fLastCheckedBatch; ///< Per slot, the id of the batch of the values computed in batched mode
    /// A unique ID that identifies this custom column.
    /// Used e.g. to distinguish custom columns with the same name in different branches of the computation graph.
    const unsigned int fID = GetNextID();
    RDFInternal::RBookedCustomColumns fCustomColumns;
    std::deque<bool> fIsInitialized; // because vector<bool> is not thread-safe
+   RDFInternal::RNodeProfile fProfile; ///< Time spent evaluating the column expression, if profiling is enabled
+   /// Copies of this column for the systematic variations that affect it (nullptr for the ones that do not)
+   std::unordered_map<std::string, std::shared_ptr<RCustomColumnBase>> fVariedColumns;
 
    static unsigned int GetNextID();
 
+   /// Create a copy of this column that reads its inputs as they are in the given systematic variation.
+   /// Return nullptr if none of the inputs is affected by the variation.
+   virtual std::shared_ptr<RCustomColumnBase> MakeVariedColumn(const std::string &variation) = 0;
+
 public:
    RCustomColumnBase(std::string_view name, std::string_view type, unsigned int nSlots,
                      bool isDSColumn, const RDFInternal::RBookedCustomColumns &customColumns);
@@ -57,10 +68,22 @@ public:
    std::string GetName() const;
    std::string GetTypeName() const;
    virtual void Update(unsigned int slot, Long64_t entry) = 0;
+   /// Compute the values of the entries of the batch selected by `mask`, in batched mode. Values that were computed
+   /// for the batch already, for another node, are not computed again.
+   virtual void
+   UpdateBatch(unsigned int slot, const RDFInternal::RBatch &batch, const RDFInternal::RBatchMask_t &mask) = 0;
+   /// Return the address of the buffer with the values of the current batch of the slot, a RBatchValues_t
+   virtual void *GetBatchValuesPtr(unsigned int slot) = 0;
    virtual void ClearValueReaders(unsigned int slot) = 0;
    bool IsDataSourceColumn() const { return fIsDataSourceColumn; }
+   // overridden by RJittedCustomColumn
+   virtual RDFInternal::RNodeProfile &GetProfile() { return fProfile; }
+   virtual const RDFInternal::RNodeProfile &GetProfile() const { return fProfile; }
    /// Return the unique identifier of this RCustomColumnBase.
    unsigned int GetID() const { return fID; }
+   /// Return the column that takes the place of this one in the given systematic variation, or nullptr if the
+   /// column is not affected by the variation. Varied copies are created once and then shared.
+   std::shared_ptr<RCustomColumnBase> GetVariedColumn(const std::string &variation);
 };
 
 } // ns RDF
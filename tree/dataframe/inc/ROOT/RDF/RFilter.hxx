@@ -18,12 +18,16 @@
 #include "ROOT/RDF/RFilterBase.hxx"
 #include "ROOT/RDF/RLoopManager.hxx"
 #include "ROOT/RIntegerSequence.hxx"
+#include "ROOT/RMakeUnique.hxx"
 #include "ROOT/TypeTraits.hxx"
 #include "RtypesCore.h"
 
 #include <algorithm>
 #include <memory>
+#include <stdexcept>
 #include <string>
+#include <tuple>
+#include <type_traits>
 #include <vector>
 
 namespace ROOT {
@@ -63,6 +67,19 @@ class RFilter final : public RFilterBase {
    /// The nth flag signals whether the nth input column is a custom column or not.
    std::array<bool, ColumnTypes_t::list_size> fIsCustomColumn;
 
+   template <typename F = FilterF, typename std::enable_if<std::is_copy_constructible<F>::value, int>::type = 0>
+   std::unique_ptr<RFilterBase>
+   MakeVariedCopy(std::shared_ptr<PrevDataFrame> prevData, const RDFInternal::RBookedCustomColumns &variedColumns)
+   {
+      return std::make_unique<RFilter>(fFilter, fColumnNames, std::move(prevData), variedColumns);
+   }
+
+   template <typename F = FilterF, typename std::enable_if<!std::is_copy_constructible<F>::value, int>::type = 0>
+   std::unique_ptr<RFilterBase> MakeVariedCopy(std::shared_ptr<PrevDataFrame>, const RDFInternal::RBookedCustomColumns &)
+   {
+      throw std::runtime_error("A filter depends on a systematic variation but its expression cannot be copied.");
+   }
+
 public:
    RFilter(FilterF f, const ColumnNames_t &columns, std::shared_ptr<PrevDataFrame> pd,
            const RDFInternal::RBookedCustomColumns &customColumns, std::string_view name = "")
@@ -104,9 +121,41 @@ public:
       // silence "unused parameter" warnings in gcc
       (void)slot;
       (void)entry;
+      RDFInternal::RProfileScope profileScope(fProfile, slot);
       return fFilter(std::get<S>(fValues[slot]).Get(entry)...);
    }
 
+   const RDFInternal::RBatchMask_t &CheckFiltersBatch(unsigned int slot, const RDFInternal::RBatch &batch) final
+   {
+      auto &mask = fBatchMasks[slot];
+      if (batch.GetId() != fLastCheckedBatch[slot]) {
+         const auto &prevMask = fPrevData.CheckFiltersBatch(slot, batch);
+         mask.resize(batch.GetSize());
+         CheckFilterBatchHelper(slot, batch, prevMask, mask, TypeInd_t());
+         const ULong64_t nPrev = std::count_if(prevMask.begin(), prevMask.end(), [](int m) { return m != 0; });
+         const ULong64_t nPassed = std::count_if(mask.begin(), mask.end(), [](int m) { return m != 0; });
+         fAccepted[slot] += nPassed;
+         fRejected[slot] += nPrev - nPassed;
+         fLastCheckedBatch[slot] = batch.GetId();
+      }
+      return mask;
+   }
+
+   /// Evaluate the filter on the entries of the batch that pass the upstream filters, reading the values of the input
+   /// columns for all those entries at once
+   template <std::size_t... S>
+   void CheckFilterBatchHelper(unsigned int slot, const RDFInternal::RBatch &batch,
+                               const RDFInternal::RBatchMask_t &prevMask, RDFInternal::RBatchMask_t &mask,
+                               std::index_sequence<S...>)
+   {
+      RDFInternal::RProfileScope profileScope(fProfile, slot);
+      auto columns = RDFInternal::GetBatchValues(batch, prevMask, std::get<S>(fValues[slot])...);
+      (void)columns; // avoid "unused variable" warnings for filters without input columns
+      const auto nEntries = batch.GetSize();
+      for (std::size_t i = 0; i < nEntries; ++i)
+         mask[i] = prevMask[i] && fFilter(std::get<S>(columns)[i]...);
+   }
+
    void InitSlot(TTreeReader *r, unsigned int slot) final
    {
       for (auto &bookedBranch : fCustomColumns.GetColumns())
@@ -165,6 +214,17 @@ public:
       ClearValueReaders(slot);
    }
 
+   std::unique_ptr<RFilterBase> MakeVariedFilter(const std::string &variation) final
+   {
+      auto variedPrev = fPrevData.GetVariedNode(variation);
+      auto variedColumns = fCustomColumns.GetVaried(variation);
+      if (!variedPrev && !fCustomColumns.IsAnyVaried(fColumnNames, variedColumns))
+         return nullptr;
+      // varied nodes have the same type as their nominal counterpart
+      auto prevData = variedPrev ? std::static_pointer_cast<PrevDataFrame>(variedPrev) : fPrevDataPtr;
+      return MakeVariedCopy(std::move(prevData), variedColumns);
+   }
+
    std::shared_ptr<RDFGraphDrawing::GraphNode> GetGraph()
    {
       // Recursively call for the previous node.
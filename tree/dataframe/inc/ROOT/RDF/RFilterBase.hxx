@@ -13,10 +13,13 @@
 
 #include "ROOT/RDF/RBookedCustomColumns.hxx"
 #include "ROOT/RDF/RNodeBase.hxx"
+#include "ROOT/RDF/RProfiler.hxx"
 #include "RtypesCore.h"
 #include "TError.h" // R_ASSERT
 
+#include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 class TTreeReader;
@@ -39,10 +42,15 @@ protected:
    std::vector<int> fLastResult = {true}; // std::vector<bool> cannot be used in a MT context safely
    std::vector<ULong64_t> fAccepted = {0};
    std::vector<ULong64_t> fRejected = {0};
+   std::vector<ULong64_t> fLastCheckedBatch;           ///< Per slot, the id of the batch of fBatchMasks
+   std::vector<RDFInternal::RBatchMask_t> fBatchMasks; ///< Per slot, the result of the filter in batched mode
    const std::string fName;
    const unsigned int fNSlots; ///< Number of thread slots used by this node, inherited from parent node.
+   RDFInternal::RNodeProfile fProfile; ///< Time spent evaluating the filter expression, if profiling is enabled
 
    RDFInternal::RBookedCustomColumns fCustomColumns;
+   /// Copies of this filter for the systematic variations that affect it (nullptr for the ones that do not)
+   std::unordered_map<std::string, std::shared_ptr<RNodeBase>> fVariedFilters;
 
 public:
    RFilterBase(RLoopManager *df, std::string_view name, const unsigned int nSlots,
@@ -67,6 +75,13 @@ public:
    virtual void ClearTask(unsigned int slot) = 0;
    virtual void InitNode();
    virtual void AddFilterName(std::vector<std::string> &filters) = 0;
+   // overridden by RJittedFilter
+   virtual RDFInternal::RNodeProfile &GetProfile() { return fProfile; }
+   virtual const RDFInternal::RNodeProfile &GetProfile() const { return fProfile; }
+   std::shared_ptr<RNodeBase> GetVariedNode(const std::string &variation) override;
+   /// Create an unnamed copy of this filter for the given systematic variation, or return nullptr if the filter is not
+   /// affected by the variation. Varied filters do not take part in cut-flow reports.
+   virtual std::unique_ptr<RFilterBase> MakeVariedFilter(const std::string &variation) = 0;
 };
 
 } // ns RDF
@@ -20,10 +20,12 @@
 #include "ROOT/RDF/Utils.hxx"
 #include "ROOT/RIntegerSequence.hxx"
 #include "ROOT/RDF/RLazyDSImpl.hxx"
+#include "ROOT/RCacheOptions.hxx"
 #include "ROOT/RResultPtr.hxx"
 #include "ROOT/RSnapshotOptions.hxx"
 #include "ROOT/RStringView.hxx"
 #include "ROOT/TypeTraits.hxx"
+#include "RConfigure.h" // R__HAS_ROOT7
 #include "RtypesCore.h" // for ULong64_t
 #include "TH1.h"        // For Histo actions
 #include "TH2.h"        // For Histo actions
@@ -31,6 +33,9 @@
 #include "TProfile.h"
 #include "TProfile2D.h"
 #include "TStatistic.h"
+#ifdef R__HAS_ROOT7
+#include "ROOT/RDF/SnapshotRNTupleHelper.hxx"
+#endif
 
 #include <algorithm>
 #include <cstddef>
@@ -424,6 +429,99 @@ public:
       return newInterface;
    }
 
+   // clang-format off
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Register systematic variations for an existing column.
+   /// \param[in] colName The name of the column to vary. It can be a dataset column, a custom column or an alias.
+   /// \param[in] expression Function, lambda expression, functor class or any other callable object producing the varied values. It must return a RVec with one element per variation tag.
+   /// \param[in] inputColumns Names of the columns/branches in input to the expression.
+   /// \param[in] variationTags Names of the variations of the column, e.g. {"down", "up"}.
+   /// \param[in] variationName The name of the systematic variation. The name of the varied column is used if empty.
+   /// \return the first node of the computation graph for which the variations are registered.
+   ///
+   /// In the variation with tag `variationTags[i]`, the column `colName` takes the value of the i-th element of the
+   /// RVec returned by `expression`. Nominal results are not affected. The results of actions booked downstream of
+   /// this node can be retrieved for each variation with ROOT::RDF::Experimental::VariationsFor: all variations are
+   /// then computed in the same event loop as the nominal results. The expression is evaluated once per entry for all
+   /// tags, and only the filters, custom columns and actions that depend on the varied column are evaluated again for
+   /// each variation.
+   ///
+   /// The elements of the returned RVec must have the same type as the column they replace.
+   ///
+   /// ### Example usage:
+   /// ~~~{.cpp}
+   /// auto scale = [](float pt) { return ROOT::RVec<float>{pt * 0.98f, pt * 1.02f}; };
+   /// auto h = df.Vary("pt", scale, {"pt"}, {"down", "up"}, "ptScale").Filter(cut, {"pt"}).Histo1D<float>("pt");
+   /// auto hs = ROOT::RDF::Experimental::VariationsFor(h);
+   /// hs["nominal"]->Draw();
+   /// hs["ptScale:up"]->Draw("SAME");
+   /// ~~~
+   template <typename F>
+   RInterface<Proxied, DS_t> Vary(std::string_view colName, F expression, const ColumnNames_t &inputColumns,
+                                  const std::vector<std::string> &variationTags, std::string_view variationName = "")
+   {
+      using RetType = typename TTraits::CallableTraits<F>::ret_type;
+      static_assert(RDFInternal::IsRVec_t<RetType>::value, "Vary expressions must return a RVec.");
+      using VariedType = typename RetType::value_type;
+      using ColTypes_t = typename TTraits::CallableTraits<F>::arg_types;
+      constexpr auto nColumns = ColTypes_t::list_size;
+
+      const auto variedColName = GetValidatedColumnNames(1, {std::string(colName)})[0];
+      const auto varName = variationName.empty() ? variedColName : std::string(variationName);
+      RDFInternal::CheckVariation(varName, variationTags, fCustomColumns.GetVariationNames());
+
+      const auto validColumnNames = GetValidatedColumnNames(nColumns, inputColumns);
+      auto newCols = CheckAndFillDSColumns(validColumnNames, std::make_index_sequence<nColumns>(), ColTypes_t());
+      const auto nSlots = fLoopManager->GetNSlots();
+
+      // An internal column evaluates the expression once per entry for all tags...
+      const auto allValuesName = "rdfvariation_" + varName + "_";
+      auto allValues = std::make_shared<RDFDetail::RCustomColumn<F>>(
+         allValuesName, RDFInternal::TypeID2TypeName(typeid(RetType)), std::move(expression), validColumnNames,
+         nSlots, newCols);
+      newCols.AddName(allValuesName);
+      newCols.AddColumn(allValues, allValuesName);
+
+      // ...and one column per tag picks its value from there
+      const auto variedTypeName = RDFInternal::TypeID2TypeName(typeid(VariedType));
+      const auto nTags = variationTags.size();
+      for (std::size_t i = 0; i < nTags; ++i) {
+         auto pickValue = [i, nTags](const RetType &values) {
+            if (values.size() != nTags)
+               throw std::runtime_error("The expression passed to Vary returned a RVec of the wrong size.");
+            return values[i];
+         };
+         auto variedColumn = std::make_shared<RDFDetail::RCustomColumn<decltype(pickValue)>>(
+            variedColName, variedTypeName, std::move(pickValue), ColumnNames_t{allValuesName}, nSlots, newCols);
+         newCols.AddVariedColumn(varName + ':' + variationTags[i], variedColName, variedColumn);
+      }
+
+      RInterface<Proxied, DS_t> newInterface(fProxiedPtr, *fLoopManager, std::move(newCols), fDataSource);
+
+      return newInterface;
+   }
+   // clang-format on
+
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Register systematic variations for an existing column.
+   /// \param[in] colName The name of the column to vary.
+   /// \param[in] expression Callable returning a RVec with `nVariations` elements.
+   /// \param[in] inputColumns Names of the columns/branches in input to the expression.
+   /// \param[in] nVariations Number of variations. The variation tags are "0", "1", ..., "nVariations-1".
+   /// \param[in] variationName The name of the systematic variation. The name of the varied column is used if empty.
+   /// \return the first node of the computation graph for which the variations are registered.
+   ///
+   /// Refer to the first overload of this method for the full documentation.
+   template <typename F>
+   RInterface<Proxied, DS_t> Vary(std::string_view colName, F expression, const ColumnNames_t &inputColumns,
+                                  std::size_t nVariations, std::string_view variationName = "")
+   {
+      std::vector<std::string> variationTags;
+      for (std::size_t i = 0; i < nVariations; ++i)
+         variationTags.emplace_back(std::to_string(i));
+      return Vary(colName, std::move(expression), inputColumns, variationTags, variationName);
+   }
+
    ////////////////////////////////////////////////////////////////////////////
    /// \brief Save selected columns to disk, in a new TTree `treename` in file `filename`.
    /// \tparam ColumnTypes variadic list of branch/column types.
@@ -438,6 +536,12 @@ public:
    /// When writing a variable size array through Snapshot, it is required that the column indicating its size is also
    /// written out and it appears before the array in the columnList.
    ///
+   /// When running single-thread over all entries of a TTree (no Filter or Range upstream) and writing a new file, the
+   /// branches of the input TTree that are written unchanged are not read for the input files that have the output
+   /// compression settings: their compressed baskets are copied to the output TTree, as TTree::CloneTree does, and only
+   /// the other columns are re-written. For the other files of a TChain all columns are read and re-written. This
+   /// behaviour can be switched off with RSnapshotOptions::fCloneBaskets.
+   ///
    /// ### Example invocations:
    ///
    /// ~~~{.cpp}
@@ -455,6 +559,16 @@ public:
    /// opts.fLazy = true;
    /// df.Snapshot("outputTree", "outputFile.root", {"x"}, opts);
    /// ~~~
+   ///
+   /// If ROOT is built with root7, setting RSnapshotOptions::fOutputFormat to ESnapshotOutputFormat::kRNTuple writes
+   /// an (experimental) RNTuple named `treename` instead of a TTree. Each processing slot compresses its own clusters,
+   /// which are appended to the file without an intermediate merging step. Only the "RECREATE" mode is supported, and
+   /// the returned RDataFrame reads the ntuple once the event loop has run:
+   /// ~~~{.cpp}
+   /// RSnapshotOptions opts;
+   /// opts.fOutputFormat = ESnapshotOutputFormat::kRNTuple;
+   /// auto ntupleDf = df.Snapshot("outputNTuple", "outputFile.root", {"x", "y"}, opts);
+   /// ~~~
    template <typename... ColumnTypes>
    RResultPtr<RInterface<RLoopManager>>
    Snapshot(std::string_view treename, std::string_view filename, const ColumnNames_t &columnList,
@@ -569,6 +683,7 @@ public:
    /// \brief Save selected columns in memory
    /// \tparam ColumnTypes variadic list of branch/column types.
    /// \param[in] columns to be cached in memory.
+   /// \param[in] options RCacheOptions struct with extra options to limit the memory used by the cache.
    /// \return a `RDataFrame` that wraps the cached dataset.
    ///
    /// This action returns a new `RDataFrame` object, completely detached from
@@ -576,7 +691,15 @@ public:
    /// columns and stores their content in memory for fast, zero-copy subsequent access.
    ///
    /// Use `Cache` if you know you will only need a subset of the (`Filter`ed) data that
-   /// fits in memory and that will be accessed many times.
+   /// will be accessed many times.
+   ///
+   /// By default all cached entries are kept in memory. If RCacheOptions::fMemoryBudget is set, the
+   /// estimated size of the entries kept in memory does not exceed that number of bytes (plus one entry per
+   /// slot). Each processing slot gets an equal share of the budget: once the entries it holds exceed its share, it
+   /// writes them to uncompressed temporary ROOT files in RCacheOptions::fSpillDirectory (the temporary directory of
+   /// the system by default), which are read back by each slot in the event loops over the cached dataset and removed
+   /// when the cached dataset is destroyed.
+   /// Columns must have a dictionary to be written to these files.
    ///
    /// ### Example usage:
    ///
@@ -594,20 +717,26 @@ public:
    /// ~~~{.cpp}
    /// auto cache_all_cols_df = df.Cache(myRegexp);
    /// ~~~
+   ///
+   /// **Keep at most 4 GB of entries in memory, spill the rest to a local scratch area:**
+   /// ~~~{.cpp}
+   /// auto cached_df = df.Cache({"col0", "col1"}, RCacheOptions(4ull << 30, "/scratch"));
+   /// ~~~
    template <typename... ColumnTypes>
-   RInterface<RLoopManager> Cache(const ColumnNames_t &columnList)
+   RInterface<RLoopManager> Cache(const ColumnNames_t &columnList, const RCacheOptions &options = RCacheOptions())
    {
       auto staticSeq = std::make_index_sequence<sizeof...(ColumnTypes)>();
-      return CacheImpl<ColumnTypes...>(columnList, staticSeq);
+      return CacheImpl<ColumnTypes...>(columnList, options, staticSeq);
    }
 
    ////////////////////////////////////////////////////////////////////////////
    /// \brief Save selected columns in memory
    /// \param[in] columns to be cached in memory
+   /// \param[in] options RCacheOptions struct with extra options to limit the memory used by the cache.
    /// \return a `RDataFrame` that wraps the cached dataset.
    ///
    /// See the previous overloads for more information.
-   RInterface<RLoopManager> Cache(const ColumnNames_t &columnList)
+   RInterface<RLoopManager> Cache(const ColumnNames_t &columnList, const RCacheOptions &options = RCacheOptions())
    {
       // Early return: if the list of columns is empty, just return an empty RDF
       // If we proceed, the jitted call will not compile!
@@ -622,7 +751,7 @@ public:
       RInterface<TTraits::TakeFirstParameter_t<decltype(upcastNode)>> upcastInterface(fProxiedPtr, *fLoopManager,
                                                                                       fCustomColumns, fDataSource);
       // build a string equivalent to
-      // "(RInterface<nodetype*>*)(this)->Cache<Ts...>(*(ColumnNames_t*)(&columnList))"
+      // "(RInterface<nodetype*>*)(this)->Cache<Ts...>(*(ColumnNames_t*)(&columnList), *(RCacheOptions*)(&options))"
       RInterface<RLoopManager> resRDF(std::make_shared<ROOT::Detail::RDF::RLoopManager>(0));
       cacheCall << "*reinterpret_cast<ROOT::RDF::RInterface<ROOT::Detail::RDF::RLoopManager>*>("
                 << RDFInternal::PrettyPrintAddr(&resRDF)
@@ -637,7 +766,8 @@ public:
       if (!columnList.empty())
          cacheCall.seekp(-2, cacheCall.cur);                         // remove the last ",
       cacheCall << ">(*reinterpret_cast<std::vector<std::string>*>(" // vector<string> should be ColumnNames_t
-                << RDFInternal::PrettyPrintAddr(&columnList) << "));";
+                << RDFInternal::PrettyPrintAddr(&columnList) << "), *reinterpret_cast<ROOT::RDF::RCacheOptions*>("
+                << RDFInternal::PrettyPrintAddr(&options) << "));";
       // jit cacheCall, return result
       RDFInternal::InterpreterCalc(cacheCall.str(), "Cache");
       return resRDF;
@@ -646,28 +776,32 @@ public:
    ////////////////////////////////////////////////////////////////////////////
    /// \brief Save selected columns in memory
    /// \param[in] columnNameRegexp The regular expression to match the column names to be selected. The presence of a '^' and a '$' at the end of the string is implicitly assumed if they are not specified. The dialect supported is PCRE via the TPRegexp class. An empty string signals the selection of all columns.
+   /// \param[in] options RCacheOptions struct with extra options to limit the memory used by the cache.
    /// \return a `RDataFrame` that wraps the cached dataset.
    ///
    /// The existing columns are matched against the regular expression. If the string provided
    /// is empty, all columns are selected. See the previous overloads for more information.
-   RInterface<RLoopManager> Cache(std::string_view columnNameRegexp = "")
+   RInterface<RLoopManager>
+   Cache(std::string_view columnNameRegexp = "", const RCacheOptions &options = RCacheOptions())
    {
 
       auto selectedColumns = RDFInternal::ConvertRegexToColumns(fCustomColumns, fLoopManager->GetTree(), fDataSource,
                                                                 columnNameRegexp, "Cache");
-      return Cache(selectedColumns);
+      return Cache(selectedColumns, options);
    }
 
    ////////////////////////////////////////////////////////////////////////////
    /// \brief Save selected columns in memory
    /// \param[in] columns to be cached in memory.
+   /// \param[in] options RCacheOptions struct with extra options to limit the memory used by the cache.
    /// \return a `RDataFrame` that wraps the cached dataset.
    ///
    /// See the previous overloads for more information.
-   RInterface<RLoopManager> Cache(std::initializer_list<std::string> columnList)
+   RInterface<RLoopManager>
+   Cache(std::initializer_list<std::string> columnList, const RCacheOptions &options = RCacheOptions())
    {
       ColumnNames_t selectedColumns(columnList);
-      return Cache(selectedColumns);
+      return Cache(selectedColumns, options);
    }
 
    // clang-format off
@@ -779,6 +913,73 @@ public:
       fLoopManager->Run();
    }
 
+   // clang-format off
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Execute a user-defined function on batches of entries (*instant action*)
+   /// \param[in] f Function, lambda expression, functor class or any other callable object taking one `RVec` per column.
+   /// \param[in] columns Names of the columns/branches in input to the user function.
+   ///
+   /// When the event loop runs in batched mode (see SetBatchSize), `f` is invoked once per batch, with one `RVec` per
+   /// column holding the values of the entries of the batch that pass the upstream filters. If the loop is not batched,
+   /// `f` is invoked once per entry, with `RVec`s of size one. Compared to `Foreach`, the user code is called once per
+   /// batch rather than once per entry, and its loops over contiguous values can be vectorized by the compiler.
+   /// The `RVec`s are only valid for the duration of the call.
+   /// Users are responsible for the thread-safety of this callable when executing
+   /// with implicit multi-threading enabled (i.e. ROOT::EnableImplicitMT).
+   ///
+   /// ### Example usage:
+   /// ~~~{.cpp}
+   /// double sum = 0.;
+   /// myDf.SetBatchSize(1024);
+   /// myDf.ForeachBatch([&sum](const RVec<float> &x, const RVec<float> &w) { sum += Sum(x * w); }, {"x", "w"});
+   /// ~~~
+   // clang-format on
+   template <typename F>
+   void ForeachBatch(F f, const ColumnNames_t &columns = {})
+   {
+      using arg_types = typename TTraits::CallableTraits<decltype(f)>::arg_types_nodecay;
+      using ret_type = typename TTraits::CallableTraits<decltype(f)>::ret_type;
+      ForeachBatchSlot(RDFInternal::AddSlotParameter<ret_type>(f, arg_types()), columns);
+   }
+
+   // clang-format off
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Execute a user-defined function requiring a processing slot index on batches of entries (*instant action*)
+   /// \param[in] f Function, lambda expression, functor class or any other callable object taking one `RVec` per column.
+   /// \param[in] columns Names of the columns/branches in input to the user function.
+   ///
+   /// Same as `ForeachBatch`, but the user-defined function takes an extra
+   /// `unsigned int` as its first parameter, the *processing slot index*.
+   /// Each batch only contains entries processed by that slot.
+   ///
+   /// ### Example usage:
+   /// ~~~{.cpp}
+   /// std::vector<double> sums(nSlots, 0.);
+   /// myDf.ForeachBatchSlot([&sums](unsigned int s, const RVec<double> &x) { sums[s] += Sum(x); }, {"x"});
+   /// ~~~
+   // clang-format on
+   template <typename F>
+   void ForeachBatchSlot(F f, const ColumnNames_t &columns = {})
+   {
+      using BatchTypes_t = TypeTraits::RemoveFirstParameter_t<typename TTraits::CallableTraits<F>::arg_types>;
+      using ColTypes_t = typename RDFInternal::BatchColumnTypes<BatchTypes_t>::type;
+      constexpr auto nColumns = ColTypes_t::list_size;
+      static_assert(nColumns > 0, "ForeachBatch requires at least one column.");
+
+      const auto validColumnNames = GetValidatedColumnNames(nColumns, columns);
+
+      auto newColumns = CheckAndFillDSColumns(validColumnNames, std::make_index_sequence<nColumns>(), ColTypes_t());
+
+      using Helper_t = RDFInternal::ForeachBatchSlotHelper<F>;
+      using Action_t = RDFInternal::RAction<Helper_t, Proxied>;
+
+      auto action =
+         std::make_unique<Action_t>(Helper_t(std::move(f)), validColumnNames, fProxiedPtr, std::move(newColumns));
+      fLoopManager->Book(action.get());
+
+      fLoopManager->Run();
+   }
+
    // clang-format off
    ////////////////////////////////////////////////////////////////////////////
    /// \brief Execute a user-defined reduce operation on the values of a column.
@@ -859,6 +1060,8 @@ public:
       using Action_t = RDFInternal::RAction<Helper_t, Proxied>;
       auto action = std::make_unique<Action_t>(Helper_t(cSPtr, nSlots), ColumnNames_t({}), fProxiedPtr,
                                                RDFInternal::RBookedCustomColumns(fCustomColumns));
+      action->SetVariedActionFactory(
+         RDFInternal::MakeVariedHelperActionFactory<Helper_t>(ColumnNames_t({}), cSPtr, nSlots, fProxiedPtr));
       fLoopManager->Book(action.get());
       return MakeResultPtr(cSPtr, *fLoopManager, std::move(action));
    }
@@ -899,6 +1102,8 @@ public:
 
       auto action =
          std::make_unique<Action_t>(Helper_t(valuesPtr, nSlots), validColumnNames, fProxiedPtr, std::move(newColumns));
+      action->SetVariedActionFactory(
+         RDFInternal::MakeVariedHelperActionFactory<Helper_t>(validColumnNames, valuesPtr, nSlots, fProxiedPtr));
       fLoopManager->Book(action.get());
       return MakeResultPtr(valuesPtr, *fLoopManager, std::move(action));
    }
@@ -1806,6 +2011,42 @@ public:
       return MakeResultPtr(rep, *fLoopManager, std::move(action));
    }
 
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Gather the time spent in each node of the computation graph during the event loop (*lazy action*).
+   /// \return the profile report wrapped in a RResultPtr.
+   ///
+   /// Booking a profile report turns on the profiling of the event loop in which it is run: for each filter, custom
+   /// column and action of the computation graph, the wall time spent in its own code and the number of times it was
+   /// called are recorded per processing slot, as well as the time spent reading each input column from the TTree and
+   /// the time spent just-in-time compiling the graph before the event loop. The time of a node does not include the
+   /// time spent in the nodes it depends on, e.g. the time of an action does not include the evaluation of the custom
+   /// columns it reads. Event loops in which no profile report is booked are not profiled and pay no overhead other
+   /// than a branch per node call. Reading from data sources is not profiled column by column.
+   ///
+   /// Nodes that have been profiled are annotated with their number of calls and total time by SaveGraph.
+   ///
+   /// ### Example usage:
+   /// ~~~{.cpp}
+   /// auto h = d.Filter("x > 0", "positive").Define("y", "x * x").Histo1D("y");
+   /// auto profile = d.ProfileReport();
+   /// profile->Print();
+   /// ROOT::RDF::SaveGraph(d, "graph.dot");
+   /// ~~~
+   ///
+   RResultPtr<RProfileReport> ProfileReport()
+   {
+      auto rep = std::make_shared<RProfileReport>();
+      using Helper_t = RDFInternal::ProfileReportHelper;
+      using Action_t = RDFInternal::RAction<Helper_t, Proxied>;
+
+      auto action =
+         std::make_unique<Action_t>(Helper_t(rep, fLoopManager->EnableProfiling()), ColumnNames_t({}), fProxiedPtr,
+                                    RDFInternal::RBookedCustomColumns(fCustomColumns));
+
+      fLoopManager->Book(action.get());
+      return MakeResultPtr(rep, *fLoopManager, std::move(action));
+   }
+
    /////////////////////////////////////////////////////////////////////////////
    /// \brief Returns the names of the available columns
    /// \return the container of column names.
@@ -1976,6 +2217,31 @@ public:
    /// ~~~
    unsigned int GetNRuns() const { return fLoopManager->GetNRuns(); }
 
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Process the entries in batches in the next event loops
+   /// \param[in] batchSize The number of entries that each processing slot processes at once, 1 (the default) to
+   /// process the entries one at a time.
+   ///
+   /// The setting applies to the whole computation graph. In batched mode, each processing slot collects
+   /// `batchSize` consecutive entries, fewer at the end of a cluster of the input tree, then the filters compute which
+   /// entries of the batch pass, the custom columns are evaluated on the selected entries and the actions execute on
+   /// them, one node after the other. Each node reads its input columns for the entries that pass its upstream filters
+   /// only. `ForeachBatch` receives all the selected entries of a batch in a single call.
+   ///
+   /// Note that:
+   /// - the columns of a data source are read for every entry, even the ones only used downstream of a filter;
+   /// - event loops with a `Snapshot` process the entries one at a time regardless of this setting;
+   /// - with a ProfileReport, the number of calls of filters, custom columns and actions counts batches;
+   /// - with a `Range`, up to `batchSize - 1` entries past its end are read before the event loop stops.
+   ///
+   /// Example usage:
+   /// ~~~{.cpp}
+   /// ROOT::RDataFrame df("tree", "file.root");
+   /// df.SetBatchSize(256);
+   /// auto h = df.Filter("x > 0").Define("y", "x * x").Histo1D("y");
+   /// ~~~
+   void SetBatchSize(unsigned int batchSize) { fLoopManager->SetBatchSize(batchSize); }
+
    // clang-format off
    ////////////////////////////////////////////////////////////////////////////
    /// \brief Execute a user-defined accumulation operation on the processed column values in each processing slot
@@ -2278,6 +2544,8 @@ private:
 
       auto action = RDFInternal::BuildAction<BranchTypes...>(validColumnNames, r, nSlots, fProxiedPtr, ActionTag{},
                                                              std::move(newColumns));
+      action->SetVariedActionFactory(
+         RDFInternal::MakeVariedActionFactory<BranchTypes...>(validColumnNames, r, nSlots, fProxiedPtr, ActionTag{}));
       fLoopManager->Book(action.get());
       return MakeResultPtr(r, *fLoopManager, std::move(action));
    }
@@ -2390,6 +2658,10 @@ private:
       auto newColumns = CheckAndFillDSColumns(validCols, std::index_sequence_for<ColumnTypes...>(),
                                               TTraits::TypeList<ColumnTypes...>());
 
+      if (options.fOutputFormat == ROOT::RDF::ESnapshotOutputFormat::kRNTuple)
+         return SnapshotRNTupleImpl<ColumnTypes...>(treename, filename, validCols, columnList, options,
+                                                    std::move(newColumns));
+
       const std::string fullTreename(treename);
       // split name into directory and treename if needed
       const auto lastSlash = treename.rfind('/');
@@ -2405,8 +2677,16 @@ private:
          // single-thread snapshot
          using Helper_t = RDFInternal::SnapshotHelper<ColumnTypes...>;
          using Action_t = RDFInternal::RAction<Helper_t, Proxied>;
-         actionPtr.reset(new Action_t(Helper_t(filename, dirname, treename, validCols, columnList, options), validCols,
-                                      fProxiedPtr, std::move(newColumns)));
+         // if all entries of the input tree are written, the baskets of unchanged branches can be copied as they are
+         auto *tree = fLoopManager->GetTree();
+         const auto isCloned =
+            static_cast<::ROOT::Detail::RDF::RNodeBase *>(fProxiedPtr.get()) == fLoopManager && !fDataSource
+               ? RDFInternal::FindClonableBranches(tree, validCols, RDFInternal::ReplaceDotWithUnderscore(columnList),
+                                                   fCustomColumns, options)
+               : std::vector<bool>();
+         actionPtr.reset(new Action_t(Helper_t(filename, dirname, treename, validCols, columnList, options, tree,
+                                               isCloned),
+                                      validCols, fProxiedPtr, std::move(newColumns)));
       } else {
          // multi-thread snapshot
          using Helper_t = RDFInternal::SnapshotHelperMT<ColumnTypes...>;
@@ -2422,10 +2702,82 @@ private:
                                            std::move(actionPtr));
    }
 
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Implementation of snapshot to an RNTuple
+   template <typename... ColumnTypes>
+   RResultPtr<RInterface<RLoopManager>>
+   SnapshotRNTupleImpl(std::string_view ntupleName, std::string_view filename, const ColumnNames_t &validCols,
+                       const ColumnNames_t &columnList, const RSnapshotOptions &options,
+                       RDFInternal::RBookedCustomColumns &&newColumns)
+   {
+#ifdef R__HAS_ROOT7
+      if (std::string_view::npos != ntupleName.find('/'))
+         throw std::invalid_argument("Snapshot: an RNTuple cannot be written in a subdirectory of the output file.");
+      using AllWritable_t = std::integral_constant<
+         bool, RDFInternal::TEvalAnd<RDFInternal::IsRNTupleWritable<ColumnTypes>::value...>::value>;
+      return BookSnapshotRNTuple<ColumnTypes...>(ntupleName, filename, validCols, columnList, options,
+                                                 std::move(newColumns), AllWritable_t());
+#else
+      (void)ntupleName;
+      (void)filename;
+      (void)validCols;
+      (void)columnList;
+      (void)options;
+      (void)newColumns;
+      throw std::runtime_error("Snapshot: writing an RNTuple requires ROOT to be built with root7=ON.");
+#endif
+   }
+
+#ifdef R__HAS_ROOT7
+   /// The ntuple can only be read back once it has been written, so the returned RDataFrame is a placeholder that is
+   /// replaced by one reading the ntuple at the end of the event loop.
+   template <typename... ColumnTypes>
+   RResultPtr<RInterface<RLoopManager>>
+   BookSnapshotRNTuple(std::string_view ntupleName, std::string_view filename, const ColumnNames_t &validCols,
+                       const ColumnNames_t &columnList, const RSnapshotOptions &options,
+                       RDFInternal::RBookedCustomColumns &&newColumns, std::true_type /*allWritable*/)
+   {
+      auto snapshotRDF = std::make_shared<RInterface<RLoopManager>>(std::make_shared<RLoopManager>(0));
+      const std::string ntupleNameStr(ntupleName);
+      const std::string fileNameStr(filename);
+      auto onWritten = [snapshotRDF, ntupleNameStr, fileNameStr]() {
+         *snapshotRDF = RInterface<RLoopManager>(RDFInternal::MakeNTupleLoopManager(ntupleNameStr, fileNameStr));
+      };
+
+      using Helper_t = RDFInternal::SnapshotRNTupleHelper<ColumnTypes...>;
+      using Action_t = RDFInternal::RAction<Helper_t, Proxied>;
+      std::unique_ptr<RDFInternal::RActionBase> actionPtr(
+         new Action_t(Helper_t(fLoopManager->GetNSlots(), filename, ntupleName, columnList, options, onWritten),
+                      validCols, fProxiedPtr, std::move(newColumns)));
+      fLoopManager->Book(actionPtr.get());
+
+      auto snapshotRDFResPtr = MakeResultPtr(snapshotRDF, *fLoopManager, std::move(actionPtr));
+      if (!options.fLazy)
+         *snapshotRDFResPtr;
+      return snapshotRDFResPtr;
+   }
+
+   template <typename... ColumnTypes>
+   RResultPtr<RInterface<RLoopManager>>
+   BookSnapshotRNTuple(std::string_view, std::string_view, const ColumnNames_t &validCols, const ColumnNames_t &,
+                       const RSnapshotOptions &, RDFInternal::RBookedCustomColumns &&, std::false_type /*allWritable*/)
+   {
+      const bool isWritable[] = {RDFInternal::IsRNTupleWritable<ColumnTypes>::value...};
+      const std::string typeNames[] = {RDFInternal::TypeID2TypeName(typeid(ColumnTypes))...};
+      std::string msg = "Snapshot: the following columns cannot be written to an RNTuple:";
+      for (std::size_t i = 0; i < validCols.size(); ++i) {
+         if (!isWritable[i])
+            msg += " \"" + validCols[i] + "\" (" + (typeNames[i].empty() ? "unknown type" : typeNames[i]) + ")";
+      }
+      throw std::runtime_error(msg);
+   }
+#endif
+
    ////////////////////////////////////////////////////////////////////////////
    /// \brief Implementation of cache
    template <typename... BranchTypes, std::size_t... S>
-   RInterface<RLoopManager> CacheImpl(const ColumnNames_t &columnList, std::index_sequence<S...> s)
+   RInterface<RLoopManager>
+   CacheImpl(const ColumnNames_t &columnList, const RCacheOptions &options, std::index_sequence<S...> s)
    {
       // Check at compile time that the columns types are copy constructible
       constexpr bool areCopyConstructible =
@@ -2436,6 +2788,9 @@ private:
       // in memory!
       RDFInternal::CheckTypesAndPars(sizeof...(BranchTypes), columnList.size());
 
+      if (options.fMemoryBudget > 0)
+         return CacheWithBudgetImpl<BranchTypes...>(columnList, options);
+
       auto colHolders = std::make_tuple(Take<BranchTypes>(columnList[S])...);
       auto ds = std::make_unique<RLazyDS<BranchTypes...>>(std::make_pair(columnList[S], std::get<S>(colHolders))...);
 
@@ -2446,6 +2801,28 @@ private:
       return cachedRDF;
    }
 
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Implementation of cache with a memory budget: entries beyond the budget are spilled to disk
+   template <typename... BranchTypes>
+   RInterface<RLoopManager> CacheWithBudgetImpl(const ColumnNames_t &columnList, const RCacheOptions &options)
+   {
+      const auto validCols = GetValidatedColumnNames(columnList.size(), columnList);
+      auto newColumns = CheckAndFillDSColumns(validCols, std::index_sequence_for<BranchTypes...>(),
+                                              TTraits::TypeList<BranchTypes...>());
+
+      using Data_t = RDFInternal::RCachedData<BranchTypes...>;
+      using Helper_t = RDFInternal::CacheHelper<BranchTypes...>;
+      using Action_t = RDFInternal::RAction<Helper_t, Proxied>;
+      auto dataPtr = std::make_shared<Data_t>();
+      auto action = std::make_unique<Action_t>(Helper_t(dataPtr, validCols, options, fLoopManager->GetNSlots()),
+                                               validCols, fProxiedPtr, std::move(newColumns));
+      fLoopManager->Book(action.get());
+      auto resultPtr = MakeResultPtr(dataPtr, *fLoopManager, std::move(action));
+
+      auto ds = std::make_unique<RDFInternal::RCacheDS<BranchTypes...>>(resultPtr, columnList);
+      return RInterface<RLoopManager>(std::make_shared<RLoopManager>(std::move(ds), columnList));
+   }
+
 protected:
    RInterface(const std::shared_ptr<Proxied> &proxied, RLoopManager &lm,
               const RDFInternal::RBookedCustomColumns &columns, RDataSource *ds)
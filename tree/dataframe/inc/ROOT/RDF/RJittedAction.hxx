@@ -16,6 +16,8 @@
 #include "RtypesCore.h"
 
 #include <memory>
+#include <string>
+#include <vector>
 
 class TTreeReader;
 
@@ -47,6 +49,8 @@ public:
    void SetAction(std::unique_ptr<RActionBase> a) { fConcreteAction = std::move(a); }
 
    void Run(unsigned int slot, Long64_t entry) final;
+   void RunBatch(unsigned int slot, const RBatch &batch) final;
+   bool CanRunBatches() const final;
    void Initialize() final;
    void InitSlot(TTreeReader *r, unsigned int slot) final;
    void TriggerChildrenCount() final;
@@ -56,9 +60,14 @@ public:
    bool HasRun() const final;
    void SetHasRun() final;
    void ClearValueReaders(unsigned int slot) final;
+   void SetUpProfiling(RProfiler *profiler) final;
 
    std::shared_ptr<GraphDrawing::GraphNode> GetGraph();
 
+   std::vector<std::string> GetVariations() const final;
+   std::unique_ptr<RActionBase>
+   MakeVariedAction(const std::string &variation, std::shared_ptr<void> &variedResult) final;
+
    // Helper for RMergeableValue
    std::unique_ptr<ROOT::Detail::RDF::RMergeableValueBase> GetMergeableValue() const final;
 };
@@ -31,6 +31,9 @@ namespace RDF {
 class RJittedCustomColumn : public RCustomColumnBase {
    std::unique_ptr<RCustomColumnBase> fConcreteCustomColumn = nullptr;
 
+protected:
+   std::shared_ptr<RCustomColumnBase> MakeVariedColumn(const std::string &variation) final;
+
 public:
    RJittedCustomColumn(std::string_view name, std::string_view type, unsigned int nSlots)
       : RCustomColumnBase(name, type, nSlots, /*isDSColumn=*/false, RDFInternal::RBookedCustomColumns())
@@ -43,7 +46,11 @@ public:
    void *GetValuePtr(unsigned int slot) final;
    const std::type_info &GetTypeId() const final;
    void Update(unsigned int slot, Long64_t entry) final;
+   void UpdateBatch(unsigned int slot, const RDFInternal::RBatch &batch, const RDFInternal::RBatchMask_t &mask) final;
+   void *GetBatchValuesPtr(unsigned int slot) final;
    void ClearValueReaders(unsigned int slot) final;
+   RDFInternal::RNodeProfile &GetProfile() final;
+   const RDFInternal::RNodeProfile &GetProfile() const final;
 };
 
 } // ns RDF
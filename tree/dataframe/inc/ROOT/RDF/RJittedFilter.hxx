@@ -47,6 +47,7 @@ public:
 
    void InitSlot(TTreeReader *r, unsigned int slot) final;
    bool CheckFilters(unsigned int slot, Long64_t entry) final;
+   const RDFInternal::RBatchMask_t &CheckFiltersBatch(unsigned int slot, const RDFInternal::RBatch &batch) final;
    void Report(ROOT::RDF::RCutFlowReport &) const final;
    void PartialReport(ROOT::RDF::RCutFlowReport &) const final;
    void FillReport(ROOT::RDF::RCutFlowReport &) const final;
@@ -59,6 +60,9 @@ public:
    void InitNode() final;
    void AddFilterName(std::vector<std::string> &filters) final;
    void ClearTask(unsigned int slot) final;
+   RDFInternal::RNodeProfile &GetProfile() final;
+   const RDFInternal::RNodeProfile &GetProfile() const final;
+   std::unique_ptr<RFilterBase> MakeVariedFilter(const std::string &variation) final;
    std::shared_ptr<RDFGraphDrawing::GraphNode> GetGraph();
 };
 
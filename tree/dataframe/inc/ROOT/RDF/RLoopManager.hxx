@@ -11,6 +11,7 @@
 #ifndef ROOT_RLOOPMANAGER
 #define ROOT_RLOOPMANAGER
 
+#include "ROOT/RDF/RBatch.hxx"
 #include "ROOT/RDF/RNodeBase.hxx"
 #include "ROOT/RDF/NodesUtils.hxx"
 
@@ -35,6 +36,7 @@ ColumnNames_t GetBranchNames(TTree &t, bool allowDuplicates = true);
 
 class RActionBase;
 class GraphNode;
+class RProfiler;
 
 namespace GraphDrawing {
 class GraphCreatorHelper;
@@ -113,6 +115,11 @@ class RLoopManager : public RNodeBase {
    std::vector<TCallback> fCallbacks;                      ///< Registered callbacks
    std::vector<TOneTimeCallback> fCallbacksOnce; ///< Registered callbacks to invoke just once before running the loop
    unsigned int fNRuns{0}; ///< Number of event loops run
+   /// Profiler of the next event loop. Non-null only if a ProfileReport has been booked.
+   std::shared_ptr<RDFInternal::RProfiler> fProfiler;
+   unsigned int fBatchSize{1}; ///< Number of entries that each slot processes at once, see SetBatchSize
+   bool fIsBatched{false};     ///< Whether the current event loop runs in batched mode
+   std::vector<RDFInternal::RBatch> fBatches; ///< The current batch of each slot, in batched mode
 
    /// Cache of the tree/chain branch names. Never access directy, always use GetBranchNames().
    ColumnNames_t fValidBranchNames;
@@ -125,8 +132,10 @@ class RLoopManager : public RNodeBase {
    void RunDataSourceMT();
    void RunDataSource();
    void RunAndCheckFilters(unsigned int slot, Long64_t entry);
+   void RunBatch(unsigned int slot);
    void InitNodeSlots(TTreeReader *r, unsigned int slot);
    void InitNodes();
+   void SetUpProfiling();
    void CleanUpNodes();
    void CleanUpTask(unsigned int slot);
    void EvalChildrenCounts();
@@ -154,6 +163,11 @@ public:
    void Book(RRangeBase *rangePtr);
    void Deregister(RRangeBase *rangePtr);
    bool CheckFilters(unsigned int, Long64_t) final;
+   /// End of recursive chain of calls: all the entries of the batch are selected
+   const RDFInternal::RBatchMask_t &CheckFiltersBatch(unsigned int, const RDFInternal::RBatch &batch) final
+   {
+      return batch.GetMask();
+   }
    unsigned int GetNSlots() const { return fNSlots; }
    void Report(ROOT::RDF::RCutFlowReport &rep) const final;
    /// End of recursive chain of calls, does nothing
@@ -166,9 +180,14 @@ public:
    const std::map<std::string, std::string> &GetAliasMap() const { return fAliasColumnNameMap; }
    void RegisterCallback(ULong64_t everyNEvents, std::function<void(unsigned int)> &&f);
    unsigned int GetNRuns() const { return fNRuns; }
+   void SetBatchSize(unsigned int batchSize);
+   unsigned int GetBatchSize() const { return fBatchSize; }
+   std::shared_ptr<RDFInternal::RProfiler> EnableProfiling();
 
    /// End of recursive chain of calls, does nothing
    void AddFilterName(std::vector<std::string> &) {}
+   /// The head node reads the dataset, which systematic variations do not change
+   std::shared_ptr<RNodeBase> GetVariedNode(const std::string &) final { return nullptr; }
    /// For each booked filter, returns either the name or "Unnamed Filter"
    std::vector<std::string> GetFiltersNames();
 
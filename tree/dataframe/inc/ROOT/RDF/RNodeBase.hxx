@@ -11,6 +11,7 @@
 #ifndef ROOT_RDFNODEBASE
 #define ROOT_RDFNODEBASE
 
+#include "ROOT/RDF/RBatch.hxx"
 #include "RtypesCore.h"
 
 #include <memory>
@@ -48,12 +49,20 @@ public:
    RNodeBase(RLoopManager *lm = nullptr) : fLoopManager(lm) {}
    virtual ~RNodeBase() {}
    virtual bool CheckFilters(unsigned int, Long64_t) = 0;
+   /// Return the mask of the entries of the batch that pass this node and the ones upstream of it, in batched mode.
+   /// The mask is computed once per batch, and then cached until the next batch of the slot.
+   virtual const ROOT::Internal::RDF::RBatchMask_t &
+   CheckFiltersBatch(unsigned int slot, const ROOT::Internal::RDF::RBatch &batch) = 0;
    virtual void Report(ROOT::RDF::RCutFlowReport &) const = 0;
    virtual void PartialReport(ROOT::RDF::RCutFlowReport &) const = 0;
    virtual void IncrChildrenCount() = 0;
    virtual void StopProcessing() = 0;
    virtual void AddFilterName(std::vector<std::string> &filters) = 0;
    virtual std::shared_ptr<ROOT::Internal::RDF::GraphDrawing::GraphNode> GetGraph() = 0;
+   /// Return the node that takes the place of this one in the given systematic variation, or nullptr if neither this
+   /// node nor the nodes upstream of it are affected by the variation.
+   /// Varied copies have the same dynamic type as the node they are a copy of.
+   virtual std::shared_ptr<RNodeBase> GetVariedNode(const std::string &variation) = 0;
 
    virtual void ResetChildrenCount()
    {
@@ -0,0 +1,84 @@
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RPROFILEREPORT
+#define ROOT_RPROFILEREPORT
+
+#include "ROOT/RStringView.hxx"
+#include "RtypesCore.h"
+
+#include <string>
+#include <vector>
+
+namespace ROOT {
+
+namespace Internal {
+namespace RDF {
+class RProfiler;
+} // End NS RDF
+} // End NS Internal
+
+namespace RDF {
+
+/// The profile of a node of the computation graph, or of the readers of an input column, during an event loop.
+/// Times are wall times in seconds. The time of a node does not include the time spent in the nodes it calls, e.g. the
+/// time of an action does not include the evaluation of the custom columns it reads.
+class RNodeProfileInfo {
+   friend class RProfileReport;
+   friend class ROOT::Internal::RDF::RProfiler;
+
+public:
+   enum class EKind { kFilter, kDefine, kAction, kColumnRead };
+
+private:
+   EKind fKind;
+   std::string fName;
+   std::vector<ULong64_t> fCalls; ///< Number of calls, per slot
+   std::vector<double> fTimes;    ///< Wall time, per slot
+   RNodeProfileInfo(EKind kind, const std::string &name, std::vector<ULong64_t> &&calls, std::vector<double> &&times)
+      : fKind(kind), fName(name), fCalls(std::move(calls)), fTimes(std::move(times))
+   {
+   }
+
+public:
+   EKind GetKind() const { return fKind; }
+   std::string GetKindName() const;
+   const std::string &GetName() const { return fName; }
+   unsigned int GetNSlots() const { return fCalls.size(); }
+   ULong64_t GetCalls(unsigned int slot) const { return fCalls[slot]; }
+   double GetTime(unsigned int slot) const { return fTimes[slot]; }
+   ULong64_t GetTotalCalls() const;
+   double GetTotalTime() const;
+};
+
+class RProfileReport {
+   friend class ROOT::Internal::RDF::RProfiler;
+
+private:
+   std::vector<RNodeProfileInfo> fNodes;
+   double fJitTime = 0.;
+   void AddNode(RNodeProfileInfo &&ni) { fNodes.emplace_back(std::move(ni)); }
+   void SetJitTime(double jitTime) { fJitTime = jitTime; }
+
+public:
+   using const_iterator = typename std::vector<RNodeProfileInfo>::const_iterator;
+   void Print();
+   /// Return the profile of the first node with the given name: the name of a filter, of a custom column, of an action
+   /// (e.g. "Histo1D") or of an input column.
+   const RNodeProfileInfo &operator[](std::string_view nodeName);
+   const RNodeProfileInfo &At(std::string_view nodeName) { return operator[](nodeName); }
+   /// Return the time spent just-in-time compiling the computation graph before the event loop, in seconds.
+   double GetJitTime() const { return fJitTime; }
+   const_iterator begin() const { return fNodes.begin(); }
+   const_iterator end() const { return fNodes.end(); }
+};
+
+} // End NS RDF
+} // End NS ROOT
+
+#endif
@@ -0,0 +1,171 @@
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RDF_RPROFILER
+#define ROOT_RDF_RPROFILER
+
+#include "ROOT/RDF/RProfileReport.hxx"
+#include "RtypesCore.h"
+
+#include <chrono>
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uintptr_t
+#include <map>
+#include <new>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace ROOT {
+namespace Internal {
+namespace RDF {
+
+/// Size of the blocks of memory that threads must not share, to avoid false sharing
+constexpr std::size_t kCacheLineSize = 64;
+
+/// Allocator of over-aligned types: std::allocator only honours their alignment from C++17 on.
+/// The address of the allocated block is stored right before the aligned storage.
+template <typename T>
+class RAlignedAllocator {
+public:
+   using value_type = T;
+
+   RAlignedAllocator() = default;
+   template <typename U>
+   RAlignedAllocator(const RAlignedAllocator<U> &)
+   {
+   }
+
+   T *allocate(std::size_t n)
+   {
+      auto block = ::operator new(n * sizeof(T) + alignof(T) + sizeof(void *));
+      auto address = reinterpret_cast<std::uintptr_t>(block) + sizeof(void *);
+      address = (address + alignof(T) - 1) & ~static_cast<std::uintptr_t>(alignof(T) - 1);
+      reinterpret_cast<void **>(address)[-1] = block;
+      return reinterpret_cast<T *>(address);
+   }
+
+   void deallocate(T *p, std::size_t) { ::operator delete(reinterpret_cast<void **>(p)[-1]); }
+
+   template <typename U>
+   bool operator==(const RAlignedAllocator<U> &) const
+   {
+      return true;
+   }
+   template <typename U>
+   bool operator!=(const RAlignedAllocator<U> &) const
+   {
+      return false;
+   }
+};
+
+/// Per-slot wall time and number of calls of a node of the computation graph.
+/// Counters are only updated while the profile is enabled, i.e. during event loops that book a ProfileReport.
+class RNodeProfile {
+   /// The counters of a slot, on their own cache line to avoid false sharing between threads
+   struct alignas(kCacheLineSize) RSlotCounters {
+      ULong64_t fTime = 0ull;  ///< Cumulative wall time, in nanoseconds
+      ULong64_t fCalls = 0ull; ///< Number of calls
+   };
+
+   std::vector<RSlotCounters, RAlignedAllocator<RSlotCounters>> fSlots;
+   bool fEnabled = false;
+
+public:
+   RNodeProfile(unsigned int nSlots) : fSlots(nSlots) {}
+
+   bool IsEnabled() const { return fEnabled; }
+   void SetEnabled(bool enabled) { fEnabled = enabled; }
+   void Add(unsigned int slot, ULong64_t time)
+   {
+      fSlots[slot].fTime += time;
+      ++fSlots[slot].fCalls;
+   }
+   void Reset();
+   unsigned int GetNSlots() const { return fSlots.size(); }
+   ULong64_t GetTime(unsigned int slot) const { return fSlots[slot].fTime; }
+   ULong64_t GetCalls(unsigned int slot) const { return fSlots[slot].fCalls; }
+   ULong64_t GetTotalTime() const;
+   ULong64_t GetTotalCalls() const;
+};
+
+/// Measure the wall time spent in a scope and add it to a RNodeProfile, if the profile is enabled.
+/// Scopes can be nested (e.g. an action reading a custom column): the time spent in nested scopes is subtracted, so
+/// that each node only accounts for the time spent in its own code.
+class RProfileScope {
+   RNodeProfile *fProfile = nullptr;
+   unsigned int fSlot = 0u;
+   std::chrono::steady_clock::time_point fStart;
+   ULong64_t fOuterNestedTime = 0ull; ///< Time spent in scopes nested in the enclosing one, before this one started
+
+   void Start();
+   void Stop();
+
+public:
+   RProfileScope(RNodeProfile *profile, unsigned int slot)
+   {
+      if (profile && profile->IsEnabled()) {
+         fProfile = profile;
+         fSlot = slot;
+         Start();
+      }
+   }
+   RProfileScope(RNodeProfile &profile, unsigned int slot) : RProfileScope(&profile, slot) {}
+   RProfileScope(const RProfileScope &) = delete;
+   RProfileScope &operator=(const RProfileScope &) = delete;
+   ~RProfileScope()
+   {
+      if (fProfile)
+         Stop();
+   }
+};
+
+/// Collect the profiles of the nodes that take part in an event loop, and the time spent reading each input column
+/// and just-in-time compiling the computation graph. Owned by the RLoopManager for the duration of an event loop
+/// during which a ProfileReport is booked.
+class RProfiler {
+   using EKind = ROOT::RDF::RNodeProfileInfo::EKind;
+
+   struct RNodeEntry {
+      EKind fKind;
+      std::string fName;
+      RNodeProfile *fProfile; ///< Non-owning, the node outlives the event loop
+   };
+
+   const unsigned int fNSlots;
+   std::vector<RNodeEntry> fNodes;
+   /// The profiles of the input columns, by column name. Each column has a single profile, shared by all its readers.
+   std::map<std::string, std::unique_ptr<RNodeProfile>> fColumnProfiles;
+   std::mutex fColumnProfilesMutex;
+   double fJitTime = 0.; ///< Time spent in RLoopManager::Jit, in seconds
+
+public:
+   RProfiler(unsigned int nSlots) : fNSlots(nSlots) {}
+   RProfiler(const RProfiler &) = delete;
+   RProfiler &operator=(const RProfiler &) = delete;
+
+   /// Register the profile of a node, reset it and enable it. Return false if the profile was already registered.
+   bool AddNode(EKind kind, const std::string &name, RNodeProfile &profile);
+   /// Return the profile of the readers of the given input column, enabled. Thread-safe.
+   RNodeProfile *GetColumnProfile(const std::string &colName);
+   void AddJitTime(double seconds) { fJitTime += seconds; }
+   void FillReport(ROOT::RDF::RProfileReport &report);
+
+   /// Set the profiler of the task that is being set up on this thread, and its slot. Readers of input columns that
+   /// are created while the task is set up are profiled with it. A null profiler disables the profiling of readers.
+   static void SetCurrent(RProfiler *profiler, unsigned int slot);
+   static RProfiler *GetCurrent();
+   static unsigned int GetCurrentSlot();
+};
+
+} // namespace RDF
+} // namespace Internal
+} // namespace ROOT
+
+#endif // ROOT_RDF_RPROFILER
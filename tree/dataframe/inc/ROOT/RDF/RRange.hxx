@@ -16,6 +16,8 @@
 #include "RtypesCore.h"
 
 #include <memory>
+#include <string>
+#include <unordered_map>
 
 namespace ROOT {
 
@@ -36,6 +38,8 @@ template <typename PrevData>
 class RRange final : public RRangeBase {
    const std::shared_ptr<PrevData> fPrevDataPtr;
    PrevData &fPrevData;
+   /// Copies of this range for the systematic variations that affect it (nullptr for the ones that do not)
+   std::unordered_map<std::string, std::shared_ptr<RNodeBase>> fVariedRanges;
 
 public:
    RRange(unsigned int start, unsigned int stop, unsigned int stride, std::shared_ptr<PrevData> pd)
@@ -75,6 +79,32 @@ public:
       return fLastResult;
    }
 
+   /// Same logic as CheckFilters, applied in order to the entries of the batch that pass the upstream filters
+   const ROOT::Internal::RDF::RBatchMask_t &
+   CheckFiltersBatch(unsigned int slot, const ROOT::Internal::RDF::RBatch &batch) final
+   {
+      if (batch.GetId() != fLastCheckedBatch) {
+         const auto &prevMask = fPrevData.CheckFiltersBatch(slot, batch);
+         const auto nEntries = batch.GetSize();
+         fBatchMask.resize(nEntries);
+         for (std::size_t i = 0; i < nEntries; ++i) {
+            if (fHasStopped || !prevMask[i]) {
+               fBatchMask[i] = 0;
+               continue;
+            }
+            ++fNProcessedEntries;
+            fBatchMask[i] = !(fNProcessedEntries <= fStart || (fStop > 0 && fNProcessedEntries > fStop) ||
+                              (fStride != 1 && fNProcessedEntries % fStride != 0));
+            if (fNProcessedEntries == fStop) {
+               fHasStopped = true;
+               fPrevData.StopProcessing();
+            }
+         }
+         fLastCheckedBatch = batch.GetId();
+      }
+      return fBatchMask;
+   }
+
    // recursive chain of `Report`s
    // RRange simply forwards these calls to the previous node
    void Report(ROOT::RDF::RCutFlowReport &rep) const final { fPrevData.PartialReport(rep); }
@@ -98,6 +128,23 @@ public:
 
    /// This function must be defined by all nodes, but only the filters will add their name
    void AddFilterName(std::vector<std::string> &filters) { fPrevData.AddFilterName(filters); }
+
+   /// A range is affected by a systematic variation if any of the filters upstream of it is
+   std::shared_ptr<RNodeBase> GetVariedNode(const std::string &variation) final
+   {
+      const auto it = fVariedRanges.find(variation);
+      if (it != fVariedRanges.end())
+         return it->second;
+      std::shared_ptr<RRange> variedRange;
+      if (auto variedPrev = fPrevData.GetVariedNode(variation)) {
+         // varied nodes have the same type as their nominal counterpart
+         variedRange =
+            std::make_shared<RRange>(fStart, fStop, fStride, std::static_pointer_cast<PrevData>(variedPrev));
+         fLoopManager->Book(variedRange.get());
+      }
+      fVariedRanges[variation] = variedRange;
+      return variedRange;
+   }
    std::shared_ptr<RDFGraphDrawing::GraphNode> GetGraph()
    {
       // TODO: Ranges node have no information about custom columns, hence it is not possible now
@@ -38,6 +38,8 @@ protected:
    bool fLastResult{true};
    ULong64_t fNProcessedEntries{0};
    bool fHasStopped{false};    ///< True if the end of the range has been reached
+   ULong64_t fLastCheckedBatch{ROOT::Internal::RDF::RBatch::kInvalidId}; ///< The id of the batch of fBatchMask
+   ROOT::Internal::RDF::RBatchMask_t fBatchMask;                          ///< The result of the range in batched mode
    const unsigned int fNSlots; ///< Number of thread slots used by this node, inherited from parent node.
 
    void ResetCounters();
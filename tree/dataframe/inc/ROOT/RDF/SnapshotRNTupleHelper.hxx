@@ -0,0 +1,224 @@
+/**
+ \file ROOT/RDF/SnapshotRNTupleHelper.hxx
+ \ingroup dataframe
+ \date 2020-10
+*/
+
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RDF_SNAPSHOTRNTUPLEHELPER
+#define ROOT_RDF_SNAPSHOTRNTUPLEHELPER
+
+#include "Compression.h"
+#include "ROOT/RDF/ActionHelpers.hxx" // RActionImpl, ReplaceDotWithUnderscore
+#include "ROOT/RDF/Utils.hxx"
+#include "ROOT/RIntegerSequence.hxx"
+#include "ROOT/RNTuple.hxx"
+#include "ROOT/RNTupleModel.hxx"
+#include "ROOT/RNTupleOptions.hxx"
+#include "ROOT/RSnapshotOptions.hxx"
+#include "ROOT/RStringView.hxx"
+#include "ROOT/RVec.hxx"
+#include "RtypesCore.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/// \cond HIDDEN_SYMBOLS
+
+namespace ROOT {
+namespace Internal {
+namespace RDF {
+
+/// Whether columns of type T can be written to an RNTuple: classes are written through their dictionary, while only
+/// some fundamental types have an RField specialization. The ROOT typedefs are covered by the specializations below,
+/// except for ULong64_t, which can be a different type than std::uint64_t, and Long64_t, which has no RField.
+template <typename T>
+struct IsRNTupleWritable
+   : std::integral_constant<bool, std::is_class<T>::value || std::is_same<T, ULong64_t>::value> {};
+template <>
+struct IsRNTupleWritable<bool> : std::true_type {};
+template <>
+struct IsRNTupleWritable<float> : std::true_type {};
+template <>
+struct IsRNTupleWritable<double> : std::true_type {};
+template <>
+struct IsRNTupleWritable<std::uint8_t> : std::true_type {};
+template <>
+struct IsRNTupleWritable<std::int32_t> : std::true_type {};
+template <>
+struct IsRNTupleWritable<std::uint32_t> : std::true_type {};
+template <>
+struct IsRNTupleWritable<std::uint64_t> : std::true_type {};
+template <typename T>
+struct IsRNTupleWritable<ROOT::VecOps::RVec<T>> : IsRNTupleWritable<T> {};
+template <typename T>
+struct IsRNTupleWritable<std::vector<T>> : IsRNTupleWritable<T> {};
+
+/// The type of the RNTuple field that stores a column of type T. ULong64_t columns, such as rdfentry_, are stored in
+/// std::uint64_t fields.
+template <typename T>
+struct RNTupleFieldType {
+   using type = typename std::conditional<std::is_same<T, ULong64_t>::value, std::uint64_t, T>::type;
+};
+template <typename T>
+struct RNTupleFieldType<ROOT::VecOps::RVec<T>> {
+   using type = ROOT::VecOps::RVec<typename RNTupleFieldType<T>::type>;
+};
+template <typename T>
+struct RNTupleFieldType<std::vector<T>> {
+   using type = std::vector<typename RNTupleFieldType<T>::type>;
+};
+template <typename T>
+using RNTupleFieldType_t = typename RNTupleFieldType<T>::type;
+
+/// Copy a column value into the value of its RNTuple field, converting the elements of collections if the field
+/// type differs from the column type
+template <typename F, typename T>
+void AssignRNTupleValue(F &field, const T &value)
+{
+   field = value;
+}
+
+template <typename T>
+void AssignRNTupleValue(T &field, const T &value)
+{
+   field = value;
+}
+
+template <typename T>
+void AssignRNTupleValue(ROOT::VecOps::RVec<T> &field, const ROOT::VecOps::RVec<T> &value)
+{
+   field = value;
+}
+
+template <typename F, typename T>
+void AssignRNTupleValue(ROOT::VecOps::RVec<F> &field, const ROOT::VecOps::RVec<T> &value)
+{
+   field.resize(value.size());
+   for (std::size_t i = 0; i < value.size(); ++i)
+      AssignRNTupleValue(field[i], value[i]);
+}
+
+template <typename T>
+void AssignRNTupleValue(std::vector<T> &field, const std::vector<T> &value)
+{
+   field = value;
+}
+
+template <typename F, typename T>
+void AssignRNTupleValue(std::vector<F> &field, const std::vector<T> &value)
+{
+   field.resize(value.size());
+   for (std::size_t i = 0; i < value.size(); ++i)
+      AssignRNTupleValue(field[i], value[i]);
+}
+
+/// Snapshot helper that writes an RNTuple instead of a TTree. Every slot fills the ntuple through its own
+/// RNTupleFillContext: pages are compressed in the filling thread and whole clusters are appended to the file by the
+/// RNTupleParallelWriter, so that, differently from SnapshotHelperMT, no intermediate in-memory files are merged.
+template <typename... ColTypes>
+class SnapshotRNTupleHelper : public RActionImpl<SnapshotRNTupleHelper<ColTypes...>> {
+   const unsigned int fNSlots;
+   std::string fFileName;
+   std::string fNTupleName;
+   const ColumnNames_t fOutputFieldNames;
+   const RSnapshotOptions fOptions;
+   std::function<void()> fOnWritten; // called once the ntuple has been written and the output file closed
+   std::unique_ptr<ROOT::Experimental::RNTupleParallelWriter> fWriter;
+   std::vector<std::unique_ptr<ROOT::Experimental::RNTupleFillContext>> fContexts; // one per slot
+   std::vector<std::vector<void *>> fValuePtrs; // per-slot addresses of the values of the default entry of each context
+
+   template <std::size_t... S>
+   void SetValues(unsigned int slot, ColTypes &... values, std::index_sequence<S...>)
+   {
+      std::initializer_list<int> expander{
+         (AssignRNTupleValue(*static_cast<RNTupleFieldType_t<ColTypes> *>(fValuePtrs[slot][S]), values), 0)...};
+      (void)expander;
+   }
+
+   template <std::size_t... S>
+   std::vector<void *> GetValuePtrs(ROOT::Experimental::RNTupleModel &model, std::index_sequence<S...>)
+   {
+      return {static_cast<void *>(model.Get<RNTupleFieldType_t<ColTypes>>(fOutputFieldNames[S]))...};
+   }
+
+   template <std::size_t... S>
+   std::unique_ptr<ROOT::Experimental::RNTupleModel> MakeModel(std::index_sequence<S...>)
+   {
+      auto model = ROOT::Experimental::RNTupleModel::Create();
+      std::initializer_list<int> expander{
+         (model->MakeField<RNTupleFieldType_t<ColTypes>>(fOutputFieldNames[S]), 0)...};
+      (void)expander;
+      return model;
+   }
+
+public:
+   using ColumnTypes_t = TypeList<ColTypes...>;
+   SnapshotRNTupleHelper(unsigned int nSlots, std::string_view filename, std::string_view ntupleName,
+                         const ColumnNames_t &bnames, const RSnapshotOptions &options, std::function<void()> onWritten)
+      : fNSlots(nSlots), fFileName(filename), fNTupleName(ntupleName),
+        fOutputFieldNames(ReplaceDotWithUnderscore(bnames)), fOptions(options), fOnWritten(std::move(onWritten))
+   {
+      if (fOptions.fMode != "RECREATE" && fOptions.fMode != "recreate")
+         throw std::invalid_argument("Snapshot: RNTuple output only supports the \"RECREATE\" file mode.");
+   }
+   SnapshotRNTupleHelper(const SnapshotRNTupleHelper &) = delete;
+   SnapshotRNTupleHelper(SnapshotRNTupleHelper &&) = default;
+
+   void InitTask(TTreeReader *, unsigned int) {}
+
+   void Exec(unsigned int slot, ColTypes &... values)
+   {
+      SetValues(slot, values..., std::index_sequence_for<ColTypes...>());
+      fContexts[slot]->Fill();
+   }
+
+   void Initialize()
+   {
+      ROOT::Experimental::RNTupleWriteOptions writeOptions;
+      writeOptions.SetCompression(
+         ROOT::CompressionSettings(fOptions.fCompressionAlgorithm, fOptions.fCompressionLevel));
+      fWriter = ROOT::Experimental::RNTupleParallelWriter::Recreate(MakeModel(std::index_sequence_for<ColTypes...>()),
+                                                                    fNTupleName, fFileName, writeOptions);
+      // Fill contexts are cheap compared to the pages they accumulate, so we create them upfront instead of in InitTask
+      fContexts.clear();
+      fValuePtrs.clear();
+      for (auto slot = 0u; slot < fNSlots; ++slot) {
+         fContexts.emplace_back(fWriter->CreateFillContext());
+         fValuePtrs.emplace_back(GetValuePtrs(*fContexts.back()->GetModel(), std::index_sequence_for<ColTypes...>()));
+      }
+   }
+
+   void Finalize()
+   {
+      // the fill contexts commit their last cluster when destructed, and must go before the writer
+      fContexts.clear();
+      fValuePtrs.clear();
+      fWriter.reset();
+      if (fOnWritten)
+         fOnWritten();
+   }
+
+   std::string GetActionName() { return "Snapshot"; }
+};
+
+} // end of NS RDF
+} // end of NS Internal
+} // end of NS ROOT
+
+/// \endcond
+
+#endif
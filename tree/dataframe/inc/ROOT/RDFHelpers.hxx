@@ -15,6 +15,7 @@
 
 #include <ROOT/RDataFrame.hxx>
 #include <ROOT/RDF/GraphUtils.hxx>
+#include <ROOT/RResultHandle.hxx>
 #include <ROOT/RIntegerSequence.hxx>
 #include <ROOT/TypeTraits.hxx>
 
@@ -23,6 +24,7 @@
 #include <type_traits>
 #include <vector>
 #include <memory>
+#include <string>
 #include <fstream>
 #include <iostream>
 
@@ -146,6 +148,48 @@ RNode AsRNode(NodeType node)
    return node;
 }
 
+// clang-format off
+/// Trigger the event loops of multiple RDataFrames concurrently.
+/// \param[in] handles A vector of RResultHandles, possibly belonging to different computation graphs
+/// \return The number of distinct event loops that were run
+///
+/// The event loops of the computation graphs that the results belong to are started at once. With implicit
+/// multi-threading enabled, the tasks of all event loops are scheduled in the same task arena, so that threads which
+/// are done with one computation graph pick up work from the others. This is beneficial e.g. when processing many small
+/// datasets, each with its own RDataFrame, which on their own would not keep all cores busy.
+/// Each event loop runs at most once even if several handles refer to the same computation graph; results that are
+/// already available are skipped. Without implicit multi-threading, the event loops run one after the other.
+/// \code
+/// std::vector<ROOT::RDF::RResultHandle> handles;
+/// for (const auto &sample : samples)
+///    handles.emplace_back(ROOT::RDataFrame("events", sample).Histo1D<float>("pt"));
+/// ROOT::RDF::RunGraphs(handles);
+/// \endcode
+// clang-format on
+unsigned int RunGraphs(std::vector<RResultHandle> handles);
+
+namespace Experimental {
+
+// clang-format off
+/// Set the directory of the on-disk cache for jitted Filter and Define expressions. An empty string disables the cache.
+///
+/// When the cache is enabled, the string expressions passed to Filter and Define that are not in the cache yet are
+/// jitted as usual and, after the event loop, compiled together with the corresponding computation graph nodes into
+/// shared libraries stored in this directory. Entries are keyed by the expression, the types of the columns it uses,
+/// the ROOT version and the compiler, so that later event loops and processes running the same analysis load the
+/// compiled code and skip just-in-time compilation altogether. Expressions that cannot be compiled outside of the
+/// interpreter (e.g. because they call functions that were only declared to the interpreter) keep being jitted as
+/// usual; processes started within a day of a failed compilation do not try again. Libraries that do not belong to the
+/// current user or that can be modified by other users are not loaded.
+/// The initial value is taken from the `ROOT_RDF_JITCACHE` environment variable, if set.
+// clang-format on
+void SetJitCacheDir(const std::string &dir);
+
+/// Return the directory of the on-disk cache for jitted expressions, empty if the cache is disabled
+const std::string &GetJitCacheDir();
+
+} // namespace Experimental
+
 } // namespace RDF
 } // namespace ROOT
 #endif
@@ -23,6 +23,7 @@
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 namespace ROOT {
@@ -33,7 +34,10 @@ class REntry;
 
 
 class RNTupleDS final : public ROOT::RDF::RDataSource {
-   /// Clones of the first reader, one for each slot
+   /// The cluster-aligned entry ranges are sized such that there are about that many ranges per slot
+   static constexpr unsigned kNRangesPerSlot = 4;
+
+   /// Clones of the first reader, one for each slot, each with its own page source
    std::vector<std::unique_ptr<ROOT::Experimental::RNTupleReader>> fReaders;
    std::vector<std::unique_ptr<ROOT::Experimental::REntry>> fEntries;
    /// The raw pointers wrapped by the RValue items of fEntries
@@ -42,6 +46,8 @@ class RNTupleDS final : public ROOT::RDF::RDataSource {
    bool fHasSeenAllRanges = false;
    std::vector<std::string> fColumnNames;
    std::vector<std::string> fColumnTypes;
+   /// Clusters that are excluded by SelectClusters() and thus not part of the entry ranges
+   std::unordered_set<std::uint64_t> fSkippedClusterIds;
 
 public:
    explicit RNTupleDS(std::unique_ptr<ROOT::Experimental::RNTupleReader> ntuple);
@@ -51,6 +57,10 @@ public:
    bool HasColumn(std::string_view colName) const final;
    std::string GetTypeName(std::string_view colName) const final;
    std::vector<std::pair<ULong64_t, ULong64_t>> GetEntryRanges() final;
+   /// Restricts the entry ranges to the clusters that may contain values of the given column within [min, max]
+   /// according to the ntuple's column statistics.  Subsequent calls further restrict the selected clusters.
+   /// The entries of the selected clusters still need to be filtered by a corresponding Filter().
+   void SelectClusters(std::string_view colName, double min, double max);
 
    bool SetEntry(unsigned int slot, ULong64_t entry) final;
 
@@ -0,0 +1,117 @@
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RRESULTHANDLE
+#define ROOT_RRESULTHANDLE
+
+#include "ROOT/RResultPtr.hxx"
+#include "ROOT/RDF/RLoopManager.hxx"
+#include "ROOT/RDF/RActionBase.hxx"
+#include "ROOT/RDF/Utils.hxx" // TypeID2TypeName
+
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+namespace ROOT {
+namespace RDF {
+
+class RResultHandle;
+unsigned int RunGraphs(std::vector<RResultHandle> handles);
+
+/**
+\class ROOT::RDF::RResultHandle
+\ingroup dataframe
+\brief A type-erased version of RResultPtr.
+
+RResultHandle can be constructed from any RResultPtr and it gives access to the same result, but its type is not part
+of the type of the handle. This makes it possible to store results of different types, possibly produced by different
+RDataFrame computation graphs, in the same collection, e.g. to pass them to ROOT::RDF::RunGraphs.
+~~~{.cpp}
+std::vector<ROOT::RDF::RResultHandle> handles;
+handles.emplace_back(df1.Count());
+handles.emplace_back(df2.Histo1D<double>("x"));
+ROOT::RDF::RunGraphs(handles);
+auto count = handles[0].GetValue<ULong64_t>();
+~~~
+*/
+class RResultHandle {
+   ROOT::Detail::RDF::RLoopManager *fLoopManager = nullptr; ///< Non-owning pointer to the RLoopManager of the result
+   std::shared_ptr<void> fObjPtr;                            ///< Type-erased shared pointer to the result
+   std::shared_ptr<ROOT::Internal::RDF::RActionBase> fActionPtr; ///< Action that produces the result
+   const std::type_info *fType = nullptr;                     ///< Type of the result
+
+   friend unsigned int RunGraphs(std::vector<RResultHandle> handles);
+
+   /// Throw if the handle is empty or if the requested type does not match the type of the result
+   void CheckType(const std::type_info &type) const
+   {
+      if (!fObjPtr)
+         throw std::runtime_error("Trying to access the result of an empty RResultHandle.");
+      if (*fType != type) {
+         std::stringstream ss;
+         ss << "Got the type " << ROOT::Internal::RDF::TypeID2TypeName(type)
+            << " but the RResultHandle refers to a result of type " << ROOT::Internal::RDF::TypeID2TypeName(*fType)
+            << ".";
+         throw std::runtime_error(ss.str());
+      }
+   }
+
+   /// Trigger the event loop of the computation graph this result belongs to, if the result is not ready yet
+   void TriggerRun()
+   {
+      if (!fActionPtr->HasRun())
+         fLoopManager->Run();
+   }
+
+public:
+   RResultHandle() = default;
+   template <typename T>
+   RResultHandle(const RResultPtr<T> &resultPtr)
+      : fLoopManager(resultPtr.fLoopManager), fObjPtr(resultPtr.fObjPtr), fActionPtr(resultPtr.fActionPtr),
+        fType(&typeid(T))
+   {
+   }
+
+   RResultHandle(const RResultHandle &) = default;
+   RResultHandle(RResultHandle &&) = default;
+   RResultHandle &operator=(const RResultHandle &) = default;
+   RResultHandle &operator=(RResultHandle &&) = default;
+
+   explicit operator bool() const { return bool(fObjPtr); }
+
+   /// Return true if the result has already been produced, without triggering the event loop
+   bool IsReady() const { return fActionPtr && fActionPtr->HasRun(); }
+
+   /// Get a pointer to the result, triggering the event loop if needed. T must be the type of the result.
+   template <typename T>
+   T *Get()
+   {
+      CheckType(typeid(T));
+      TriggerRun();
+      return static_cast<T *>(fObjPtr.get());
+   }
+
+   /// Get a const reference to the result, triggering the event loop if needed. T must be the type of the result.
+   template <typename T>
+   const T &GetValue()
+   {
+      return *Get<T>();
+   }
+
+   bool operator==(const RResultHandle &rhs) const { return fObjPtr == rhs.fObjPtr; }
+   bool operator!=(const RResultHandle &rhs) const { return fObjPtr != rhs.fObjPtr; }
+};
+
+} // namespace RDF
+} // namespace ROOT
+
+#endif // ROOT_RRESULTHANDLE
@@ -17,8 +17,11 @@
 #include "ROOT/TypeTraits.hxx"
 #include "TError.h" // Warning
 
+#include <map>
 #include <memory>
 #include <functional>
+#include <stdexcept>
+#include <string>
 
 namespace ROOT {
 namespace Internal {
@@ -33,6 +36,14 @@ namespace RDF {
 // Fwd decl for MakeResultPtr
 template <typename T>
 class RResultPtr;
+
+class RResultHandle;
+
+namespace Experimental {
+// Fwd decl for VariationsFor
+template <typename T>
+std::map<std::string, RResultPtr<T>> VariationsFor(RResultPtr<T> resPtr);
+} // namespace Experimental
 } // namespace RDF
 
 namespace Detail {
@@ -100,8 +111,10 @@ class RResultPtr {
    template <class T1>
    friend bool operator!=(std::nullptr_t lhs, const RResultPtr<T1> &rhs);
    friend std::unique_ptr<RDFDetail::RMergeableValue<T>> RDFDetail::GetMergeableValue<T>(RResultPtr<T> &rptr);
+   friend std::map<std::string, RResultPtr<T>> ROOT::RDF::Experimental::VariationsFor<T>(RResultPtr<T> resPtr);
 
    friend class ROOT::Internal::RDF::GraphDrawing::GraphCreatorHelper;
+   friend class ROOT::RDF::RResultHandle;
 
    /// \cond HIDDEN_SYMBOLS
    template <typename V, bool hasBeginEnd = TTraits::HasBeginAndEnd<V>::value>
@@ -387,6 +400,57 @@ std::unique_ptr<RMergeableValue<T>> GetMergeableValue(RResultPtr<T> &rptr)
 }
 } // namespace RDF
 } // namespace Detail
+
+namespace RDF {
+namespace Experimental {
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Book the systematic variations of an RDataFrame result.
+/// \param[in] resPtr The nominal result, whose event loop must not have run yet.
+/// \returns A map from variation names to results. The nominal result is stored under the key "nominal", the varied
+///          ones under "variationName:tag" (see RInterface::Vary).
+///
+/// Varied copies are booked only for the variations that affect the result, i.e. the ones registered upstream of the
+/// action that produces it and that change one of its inputs or one of the filters it depends on. All results in the
+/// map are computed in the same event loop. Cut-flow reports do not include the varied copies of named filters.
+///
+/// Example usage:
+/// ~~~{.cpp}
+/// auto nominal = df.Vary("x", [](double x) { return ROOT::RVec<double>{x - 1, x + 1}; }, {"x"}, {"down", "up"})
+///                  .Filter([](double x) { return x > 0; }, {"x"})
+///                  .Count();
+/// auto counts = ROOT::RDF::Experimental::VariationsFor(nominal);
+/// std::cout << *counts["x:up"] << std::endl;
+/// ~~~
+template <typename T>
+std::map<std::string, RResultPtr<T>> VariationsFor(RResultPtr<T> resPtr)
+{
+   if (!resPtr.fActionPtr)
+      throw std::runtime_error("VariationsFor: the result is not associated to any action.");
+   if (resPtr.fActionPtr->HasRun())
+      throw std::runtime_error("VariationsFor: the result has already been computed, variations must be booked "
+                               "before the event loop runs.");
+
+   auto &lm = *resPtr.fLoopManager;
+   // varied copies of jitted nodes are made from their concrete counterparts
+   lm.Jit();
+
+   std::map<std::string, RResultPtr<T>> results;
+   for (const auto &variation : resPtr.fActionPtr->GetVariations()) {
+      std::shared_ptr<void> variedResult;
+      std::shared_ptr<RDFInternal::RActionBase> variedAction = resPtr.fActionPtr->MakeVariedAction(variation, variedResult);
+      if (!variedAction)
+         continue;
+      lm.Book(variedAction.get());
+      results[variation] =
+         RDFDetail::MakeResultPtr(std::static_pointer_cast<T>(variedResult), lm, std::move(variedAction));
+   }
+   results["nominal"] = std::move(resPtr);
+   return results;
+}
+
+} // namespace Experimental
+} // namespace RDF
 } // namespace ROOT
 
 #endif // ROOT_TRESULTPROXY
@@ -18,6 +18,12 @@
 namespace ROOT {
 
 namespace RDF {
+/// The data format of the dataset written by Snapshot
+enum class ESnapshotOutputFormat {
+   kTTree,  ///< A TTree, written through TTree::Fill (or TBufferMerger in multi-thread event loops)
+   kRNTuple ///< An (experimental) RNTuple, written through an RNTupleParallelWriter; requires ROOT built with root7
+};
+
 /// A collection of options to steer the creation of the dataset on file
 struct RSnapshotOptions {
    using ECAlgo = ROOT::ECompressionAlgorithm;
@@ -37,6 +43,8 @@ struct RSnapshotOptions {
    int fSplitLevel = 99;                       ///< Split level of output tree
    bool fLazy = false;                         ///< Do not start the event loop when Snapshot is called
    bool fOverwriteIfExists = false; ///< If fMode is "UPDATE", overwrite object in output file if it already exists
+   bool fCloneBaskets = true; ///< Copy the compressed baskets of the input branches that are written unchanged
+   ESnapshotOutputFormat fOutputFormat = ESnapshotOutputFormat::kTTree; ///< Data format of the output dataset
 };
 } // ns RDF
 } // ns ROOT
@@ -9,12 +9,44 @@
  *************************************************************************/
 
 #include "ROOT/RDF/RActionBase.hxx"
+#include "ROOT/RDF/RCustomColumnBase.hxx"
 #include "ROOT/RDF/RLoopManager.hxx"
 
+#include <stdexcept>
+
 using namespace ROOT::Internal::RDF;
 
 RActionBase::RActionBase(RLoopManager *lm, const ColumnNames_t &colNames, RBookedCustomColumns &&customColumns)
-   : fLoopManager(lm), fNSlots(lm->GetNSlots()), fColumnNames(colNames), fCustomColumns(std::move(customColumns)) { }
+   : fLoopManager(lm), fNSlots(lm->GetNSlots()), fColumnNames(colNames), fCustomColumns(std::move(customColumns)),
+     fProfile(fNSlots) { }
 
 // outlined to pin virtual table
 RActionBase::~RActionBase() {}
+
+std::unique_ptr<RActionBase> RActionBase::BuildVariedAction(const std::shared_ptr<RNodeBase> &prevNode,
+                                                            RBookedCustomColumns &&variedColumns,
+                                                            std::shared_ptr<void> &variedResult)
+{
+   if (!fVariedActionFactory)
+      throw std::runtime_error("This action depends on a systematic variation but does not support varied results.");
+   return fVariedActionFactory(prevNode, std::move(variedColumns), variedResult);
+}
+
+void RActionBase::SetUpNodeProfiles(RProfiler *profiler, const std::string &actionName)
+{
+   using EKind = ROOT::RDF::RNodeProfileInfo::EKind;
+   auto setUp = [profiler](EKind kind, const std::string &name, RNodeProfile &profile) {
+      if (profiler)
+         profiler->AddNode(kind, name, profile);
+      else
+         profile.SetEnabled(false);
+   };
+
+   setUp(EKind::kAction, actionName, fProfile);
+   for (auto &column : fCustomColumns.GetColumns()) {
+      // implicit and data-source columns are not profiled, as they are not in the computation graph
+      if (GraphDrawing::CheckIfDefaultOrDSColumn(column.first, column.second))
+         continue;
+      setUp(EKind::kDefine, column.first, column.second->GetProfile());
+   }
+}
@@ -0,0 +1,97 @@
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/RDF/RBatch.hxx"
+#include "TEntryList.h"
+#include "TTree.h"
+#include "TTreeReader.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace {
+ROOT::Internal::RDF::RBatch *&GetCurrentBatch()
+{
+   thread_local ROOT::Internal::RDF::RBatch *current = nullptr;
+   return current;
+}
+} // anonymous namespace
+
+namespace ROOT {
+namespace Internal {
+namespace RDF {
+
+constexpr ULong64_t RBatch::kInvalidId;
+
+void RBatch::SetCurrent(RBatch *batch)
+{
+   GetCurrentBatch() = batch;
+}
+
+RBatch *RBatch::GetCurrent()
+{
+   return GetCurrentBatch();
+}
+
+/// Record the entry of the reader of tree columns, which is at the i-th entry of the batch. The first entry of the
+/// batch determines the cluster of the batch.
+void RBatch::AddReaderEntry(std::size_t i)
+{
+   fReaderEntries.emplace_back(fReader->GetCurrentEntry());
+   fPosition = i;
+   if (i == 0) {
+      TTree *tree = fReader->GetTree()->GetTree();
+      auto clusterIter = tree->GetClusterIterator(tree->GetReadEntry());
+      clusterIter();
+      fClusterEnd = std::min(clusterIter.GetNextEntry(), tree->GetEntries());
+   }
+}
+
+/// Whether the next entry of the reader of tree columns is in another cluster or tree than the entries of the batch,
+/// or past the end of its entry list: the batch must then be processed before the reader moves on.
+bool RBatch::IsLastOfCluster() const
+{
+   if (!fReader)
+      return false;
+   TTree *tree = fReader->GetTree()->GetTree();
+   TEntryList *entryList = fReader->GetEntryList();
+   if (!entryList)
+      return tree->GetReadEntry() + 1 >= fClusterEnd;
+   Long64_t next = fReader->GetCurrentEntry() + 1;
+   if (next >= entryList->GetN())
+      return true;
+   if (entryList->GetLists()) {
+      // a TChain with one list per tree, see TTreeReader::SetEntryBase
+      int treeNumber = -1;
+      next = entryList->GetEntryAndTree(next, treeNumber);
+      return treeNumber != fReader->GetTree()->GetTreeNumber() || next >= fClusterEnd;
+   }
+   next = entryList->GetEntry(next) - tree->GetChainOffset();
+   return next < 0 || next >= fClusterEnd;
+}
+
+void RBatch::Seek(std::size_t i) const
+{
+   if (i == fPosition)
+      return;
+   if (fReader->SetEntry(fReaderEntries[i]) != TTreeReader::kEntryValid)
+      throw std::runtime_error("RDataFrame: could not read entry " + std::to_string(fEntries[i]) +
+                               " again to process its batch.");
+   fPosition = i;
+}
+
+/// Move the reader of tree columns back to the last entry of the batch, from which the event loop goes on
+void RBatch::RestoreReader()
+{
+   Seek(fEntries.size() - 1);
+}
+
+} // namespace RDF
+} // namespace Internal
+} // namespace ROOT
@@ -68,6 +68,9 @@ double-quote characters must be represented by a pair of double-quote characters
 The current implementation of RCsvDS reads the entire CSV file content into memory before
 RDataFrame starts processing it. Therefore, before creating a CSV RDataFrame, it is
 important to check both how much memory is available and the size of the CSV file.
+If the file supports memory mapping (e.g. local files on POSIX systems), it is mapped into memory and, if implicit
+multi-threading is enabled, split into chunks of lines that are parsed concurrently. If a lines chunk size is
+specified, the file is instead read progressively, one chunk of lines at a time, by a single thread.
 */
 // clang-format on
 
@@ -75,13 +78,69 @@ important to check both how much memory is available and the size of the CSV fil
 #include <ROOT/TSeq.hxx>
 #include <ROOT/RCsvDS.hxx>
 #include <ROOT/RMakeUnique.hxx>
+#include <ROOT/RRawFile.hxx>
+#include <RConfigure.h> // R__USE_IMT
 #include <TError.h>
+#include <TROOT.h> // IsImplicitMTEnabled
+
+#ifdef R__USE_IMT
+#include <ROOT/TThreadExecutor.hxx>
+#endif
 
 #include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
-#include <sstream>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
 #include <string>
 
+namespace {
+// Number parsers that do not go through streams; they throw, like std::stod and std::stoll, if nothing can be parsed
+double ParseDouble(const std::string &s)
+{
+   char *end = nullptr;
+   const auto d = std::strtod(s.c_str(), &end);
+   if (end == s.c_str())
+      throw std::runtime_error("Cannot convert CSV field \"" + s + "\" to double");
+   return d;
+}
+
+// Unlike std::stoll, the whole field must be an integer in the range of Long64_t
+Long64_t ParseLong64(const std::string &s)
+{
+   auto c = s.c_str();
+   const bool negative = *c == '-';
+   if (*c == '-' || *c == '+')
+      ++c;
+   if (*c < '0' || *c > '9')
+      throw std::runtime_error("Cannot convert CSV field \"" + s + "\" to Long64_t");
+   // The magnitude of the most negative value is one more than the largest positive value
+   const ULong64_t maxValue = static_cast<ULong64_t>(std::numeric_limits<Long64_t>::max()) + negative;
+   ULong64_t l = 0;
+   for (; *c >= '0' && *c <= '9'; ++c) {
+      const unsigned int digit = *c - '0';
+      if (l > (maxValue - digit) / 10)
+         throw std::out_of_range("CSV field \"" + s + "\" is out of the range of Long64_t");
+      l = 10 * l + digit;
+   }
+   if (*c != '\0')
+      throw std::runtime_error("Cannot convert CSV field \"" + s + "\" to Long64_t");
+   return negative ? static_cast<Long64_t>(0 - l) : static_cast<Long64_t>(l);
+}
+
+// Return the position following the first line break found at or after pos, or end if there is none
+std::uint64_t FindNextLine(const char *data, std::uint64_t pos, std::uint64_t end)
+{
+   if (pos >= end)
+      return end;
+   auto lineBreak = static_cast<const char *>(std::memchr(data + pos, '\n', end - pos));
+   return lineBreak ? lineBreak - data + 1 : end;
+}
+} // anonymous namespace
+
 namespace ROOT {
 
 namespace RDF {
@@ -110,41 +169,100 @@ void RCsvDS::FillHeaders(const std::string &line)
    }
 }
 
-void RCsvDS::FillRecord(const std::string &line, Record_t &record)
+// This is called concurrently by FillRecordsFromMap, therefore it must not modify the data members
+void RCsvDS::FillRecord(std::string_view line, Record_t &record)
 {
-   std::istringstream lineStream(line);
-   auto i = 0U;
-
    auto columns = ParseColumns(line);
+   record.reserve(columns.size());
 
+   auto colType = fColTypesList.begin();
    for (auto &col : columns) {
-      auto colType = fColTypes[fHeaders[i]];
+      if (colType == fColTypesList.end())
+         break;
 
-      switch (colType) {
+      switch (*colType) {
       case 'd': {
-         record.emplace_back(new double(std::stod(col)));
+         record.emplace_back(new double(ParseDouble(col)));
          break;
       }
       case 'l': {
-         record.emplace_back(new Long64_t(std::stoll(col)));
+         record.emplace_back(new Long64_t(ParseLong64(col)));
          break;
       }
       case 'b': {
-         auto b = new bool();
-         record.emplace_back(b);
-         std::istringstream is(col);
-         is >> std::boolalpha >> *b;
+         record.emplace_back(new bool(col == "true"));
          break;
       }
       case 's': {
-         record.emplace_back(new std::string(col));
+         record.emplace_back(new std::string(std::move(col)));
          break;
       }
       }
-      ++i;
+      ++colType;
    }
 }
 
+////////////////////////////////////////////////////////////////////////
+/// Read all records of the memory-mapped CSV file into fRecords.
+/// Lines cannot contain line breaks, so the data is cut at arbitrary offsets and every task moves its boundaries to
+/// the next line break: each task finds its lines and parses them independently of the others. Records are kept in
+/// the order of the file.
+void RCsvDS::FillRecordsFromMap()
+{
+   const std::uint64_t dataBegin = fDataPos;
+   const auto fileSize = fCsvFile->GetSize();
+   if (fileSize <= dataBegin)
+      return;
+
+   std::uint64_t mapdOffset = 0;
+   auto unmap = [this, fileSize](void *region) { fCsvFile->Unmap(region, fileSize); };
+   std::unique_ptr<void, decltype(unmap)> region(fCsvFile->Map(fileSize, 0, mapdOffset), unmap);
+   const auto data = static_cast<const char *>(region.get());
+
+   // A few chunks per slot help balancing the load, but chunks should not be too small to be worth a task
+   constexpr std::uint64_t kMinChunkSize = 1024 * 1024;
+   const auto nBytes = fileSize - dataBegin;
+   const auto nChunks =
+      static_cast<unsigned int>(std::max<std::uint64_t>(1, std::min<std::uint64_t>(4 * fNSlots, nBytes / kMinChunkSize)));
+   auto chunkBegin = [&](unsigned int chunk) {
+      if (chunk == 0)
+         return dataBegin;
+      // if the nominal begin of the chunk is the beginning of a line, that line belongs to this chunk
+      return FindNextLine(data, dataBegin + chunk * (nBytes / nChunks) - 1, fileSize);
+   };
+
+   std::vector<std::vector<Record_t>> chunkRecords(nChunks);
+   auto parseChunk = [&](unsigned int chunk) {
+      const auto end = chunk == nChunks - 1 ? fileSize : chunkBegin(chunk + 1);
+      auto &records = chunkRecords[chunk];
+      for (auto begin = chunkBegin(chunk); begin < end;) {
+         const auto next = FindNextLine(data, begin, end);
+         const auto lineEnd = (next == end && data[end - 1] != '\n') ? end : next - 1;
+         if (lineEnd > begin) { // skip empty lines
+            records.emplace_back();
+            FillRecord(std::string_view(data + begin, lineEnd - begin), records.back());
+         }
+         begin = next;
+      }
+   };
+
+#ifdef R__USE_IMT
+   if (ROOT::IsImplicitMTEnabled() && nChunks > 1) {
+      ROOT::TThreadExecutor pool;
+      pool.Foreach(parseChunk, ROOT::TSeqU(nChunks));
+   } else
+#endif
+      for (auto chunk : ROOT::TSeqU(nChunks))
+         parseChunk(chunk);
+
+   std::size_t nRecords = 0;
+   for (const auto &records : chunkRecords)
+      nRecords += records.size();
+   fRecords.reserve(nRecords);
+   for (auto &records : chunkRecords)
+      std::move(records.begin(), records.end(), std::back_inserter(fRecords));
+}
+
 void RCsvDS::GenerateHeaders(size_t size)
 {
    for (size_t i = 0; i < size; ++i) {
@@ -215,7 +333,7 @@ void RCsvDS::InferType(const std::string &col, unsigned int idxCol)
    fColTypesList.push_back(type);
 }
 
-std::vector<std::string> RCsvDS::ParseColumns(const std::string &line)
+std::vector<std::string> RCsvDS::ParseColumns(std::string_view line)
 {
    std::vector<std::string> columns;
 
@@ -226,27 +344,28 @@ std::vector<std::string> RCsvDS::ParseColumns(const std::string &line)
    return columns;
 }
 
-size_t RCsvDS::ParseValue(const std::string &line, std::vector<std::string> &columns, size_t i)
+size_t RCsvDS::ParseValue(std::string_view line, std::vector<std::string> &columns, size_t i)
 {
-   std::stringstream val;
+   std::string val;
    bool quoted = false;
+   const auto size = line.size();
 
-   for (; i < line.size(); ++i) {
+   for (; i < size; ++i) {
       if (line[i] == fDelimiter && !quoted) {
          break;
       } else if (line[i] == '"') {
          // Keep just one quote for escaped quotes, none for the normal quotes
-         if (line[i + 1] != '"') {
+         if (i + 1 == size || line[i + 1] != '"') {
             quoted = !quoted;
          } else {
-            val << line[++i];
+            val += line[++i];
          }
       } else {
-         val << line[i];
+         val += line[i];
       }
    }
 
-   columns.emplace_back(val.str());
+   columns.emplace_back(std::move(val));
 
    return i;
 }
@@ -299,6 +418,15 @@ RCsvDS::RCsvDS(std::string_view fileName, bool readHeaders, char delimiter, Long
       msg += fileName;
       throw std::runtime_error(msg);
    }
+
+   // If the whole file is read at once, it is memory-mapped and parsed in parallel rather than streamed
+   if (-1LL == fLinesChunkSize) {
+      using ROOT::Internal::RRawFile;
+      auto csvFile = RRawFile::Create(fileName);
+      constexpr auto features = RRawFile::kFeatureHasSize | RRawFile::kFeatureHasMmap;
+      if ((csvFile->GetFeatures() & features) == features)
+         fCsvFile = std::move(csvFile);
+   }
 }
 
 void RCsvDS::FreeRecords()
@@ -358,12 +486,18 @@ std::vector<std::pair<ULong64_t, ULong64_t>> RCsvDS::GetEntryRanges()
    auto linesToRead = fLinesChunkSize;
    FreeRecords();
 
-   std::string line;
-   while ((-1LL == fLinesChunkSize || 0 != linesToRead) && std::getline(fStream, line)) {
-      if (line.empty()) continue; // skip empty lines
-      fRecords.emplace_back();
-      FillRecord(line, fRecords.back());
-      --linesToRead;
+   if (fCsvFile) {
+      // the whole file is read at the first call
+      if (0ULL == fEntryRangesRequested)
+         FillRecordsFromMap();
+   } else {
+      std::string line;
+      while ((-1LL == fLinesChunkSize || 0 != linesToRead) && std::getline(fStream, line)) {
+         if (line.empty()) continue; // skip empty lines
+         fRecords.emplace_back();
+         FillRecord(line, fRecords.back());
+         --linesToRead;
+      }
    }
 
    if (gDebug > 0) {
@@ -28,7 +28,7 @@ unsigned int RCustomColumnBase::GetNextID()
 RCustomColumnBase::RCustomColumnBase(std::string_view name, std::string_view type, unsigned int nSlots, bool isDSColumn,
                                      const RDFInternal::RBookedCustomColumns &customColumns)
    : fName(name), fType(type), fNSlots(nSlots), fIsDataSourceColumn(isDSColumn), fLastCheckedEntry(fNSlots, -1),
-     fCustomColumns(customColumns), fIsInitialized(nSlots, false)
+     fLastCheckedBatch(fNSlots, RDFInternal::RBatch::kInvalidId), fCustomColumns(customColumns), fIsInitialized(nSlots, false), fProfile(nSlots)
 {
 }
 
@@ -44,3 +44,13 @@ std::string RCustomColumnBase::GetTypeName() const
 {
    return fType;
 }
+
+std::shared_ptr<RCustomColumnBase> RCustomColumnBase::GetVariedColumn(const std::string &variation)
+{
+   const auto it = fVariedColumns.find(variation);
+   if (it != fVariedColumns.end())
+      return it->second;
+   auto variedColumn = MakeVariedColumn(variation);
+   fVariedColumns[variation] = variedColumn;
+   return variedColumn;
+}
@@ -264,6 +264,65 @@ void ValidateSnapshotOutput(const RSnapshotOptions &opts, const std::string &tre
    }
 }
 
+std::vector<bool> FindClonableBranches(TTree *tree, const ColumnNames_t &inputNames, const ColumnNames_t &outputNames,
+                                       const RBookedCustomColumns &customColumns, const RSnapshotOptions &opts)
+{
+   TString fileMode = opts.fMode;
+   fileMode.ToLower();
+   // baskets are copied as they are: they keep the compression and the cluster structure of the input
+   if (!tree || !opts.fCloneBaskets || fileMode != "recreate" || opts.fAutoFlush != 0 || opts.fSplitLevel != 99 ||
+       tree->GetEntryList())
+      return {};
+
+   // chains only load their first tree on demand. The compression settings and the branches of each tree are checked
+   // by SnapshotHelper when the tree is loaded during the event loop.
+   if (!tree->GetTree() && tree->LoadTree(0) < 0)
+      return {};
+   auto *inputTree = tree->GetTree();
+   if (!inputTree)
+      return {};
+
+   // only the top-level branches of the input tree itself (not of its friends) that are written with the same name.
+   // TClonesArrays may be written as std::vectors, which would not match the baskets of the input branch.
+   const auto nColumns = inputNames.size();
+   std::vector<bool> isClonable(nColumns, false);
+   for (auto i = 0u; i < nColumns; ++i) {
+      auto *branch = static_cast<TBranch *>(inputTree->GetListOfBranches()->FindObject(inputNames[i].c_str()));
+      isClonable[i] = !customColumns.HasName(inputNames[i]) && inputNames[i] == outputNames[i] && branch &&
+                      std::string(branch->GetClassName()) != "TClonesArray";
+   }
+
+   // C arrays of variable size and the branch holding their size must be either both copied or both re-written:
+   // re-written arrays need the size of the current entry, which is not read for copied branches
+   bool changed = true;
+   while (changed) {
+      changed = false;
+      for (auto i = 0u; i < nColumns; ++i) {
+         auto *branch = tree->GetBranch(inputNames[i].c_str());
+         if (!branch)
+            continue;
+         for (auto *leafObj : *branch->GetListOfLeaves()) {
+            auto *leafCount = static_cast<TLeaf *>(leafObj)->GetLeafCount();
+            if (!leafCount)
+               continue;
+            const auto countIt = std::find(inputNames.begin(), inputNames.end(), leafCount->GetBranch()->GetName());
+            const auto countIsClonable =
+               countIt != inputNames.end() && isClonable[std::distance(inputNames.begin(), countIt)];
+            if (isClonable[i] != countIsClonable) {
+               isClonable[i] = false;
+               if (countIt != inputNames.end())
+                  isClonable[std::distance(inputNames.begin(), countIt)] = false;
+               changed = true;
+            }
+         }
+      }
+   }
+
+   if (std::none_of(isClonable.begin(), isClonable.end(), [](bool b) { return b; }))
+      return {};
+   return isClonable;
+}
+
 } // end NS RDF
 } // end NS Internal
 } // end NS ROOT
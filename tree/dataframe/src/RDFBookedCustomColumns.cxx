@@ -1,4 +1,5 @@
 #include "ROOT/RDF/RBookedCustomColumns.hxx"
+#include "ROOT/RDF/RCustomColumnBase.hxx"
 
 namespace ROOT {
 namespace Internal {
@@ -25,6 +26,62 @@ void RBookedCustomColumns::AddName(std::string_view name)
    fCustomColumnsNames = newColsNames;
 }
 
+void RBookedCustomColumns::AddVariedColumn(std::string_view variation, std::string_view colName,
+                                           const std::shared_ptr<RDFDetail::RCustomColumnBase> &column)
+{
+   auto newVariedCols = std::make_shared<RVariedColumnsMap_t>(*fVariedColumns);
+   (*newVariedCols)[std::string(variation)] = std::make_pair(std::string(colName), column);
+   fVariedColumns = newVariedCols;
+}
+
+RBookedCustomColumns::ColumnNames_t RBookedCustomColumns::GetVariationNames() const
+{
+   ColumnNames_t variations;
+   for (const auto &variation : *fVariedColumns)
+      variations.emplace_back(variation.first);
+   return variations;
+}
+
+RBookedCustomColumns RBookedCustomColumns::GetVaried(const std::string &variation) const
+{
+   const auto it = fVariedColumns->find(variation);
+   if (it == fVariedColumns->end())
+      return *this;
+
+   const auto &variedColName = it->second.first;
+   auto newCols = std::make_shared<RCustomColumnBasePtrMap_t>();
+   for (const auto &column : *fCustomColumns) {
+      if (column.first == variedColName)
+         continue;
+      auto variedColumn = column.second->GetVariedColumn(variation);
+      (*newCols)[column.first] = variedColumn ? variedColumn : column.second;
+   }
+   (*newCols)[variedColName] = it->second.second;
+
+   // The varied column might be a dataset column, in which case it becomes a custom column in the variation
+   auto newColsNames = fCustomColumnsNames;
+   if (!HasName(variedColName)) {
+      auto names = std::make_shared<ColumnNames_t>(GetNames());
+      names->emplace_back(variedColName);
+      newColsNames = names;
+   }
+
+   return RBookedCustomColumns(newCols, newColsNames, fVariedColumns);
+}
+
+bool RBookedCustomColumns::IsAnyVaried(const ColumnNames_t &names, const RBookedCustomColumns &varied) const
+{
+   for (const auto &name : names) {
+      const auto variedIt = varied.fCustomColumns->find(name);
+      if (variedIt == varied.fCustomColumns->end())
+         continue;
+      const auto it = fCustomColumns->find(name);
+      if (it == fCustomColumns->end() || it->second != variedIt->second)
+         return true;
+   }
+   return false;
+}
+
 } // namespace RDF
 } // namespace Internal
 } // namespace ROOT
@@ -76,6 +76,14 @@ std::string GraphCreatorHelper::RepresentGraph(RLoopManager *loopManager)
    return FromGraphActionsToDot(leaves);
 }
 
+std::string FormatProfile(const RNodeProfile &profile)
+{
+   const auto calls = profile.GetTotalCalls();
+   if (calls == 0)
+      return "";
+   return TString::Format("\n%llu calls, %.3f ms", calls, 1e-6 * profile.GetTotalTime()).Data();
+}
+
 std::shared_ptr<GraphNode>
 CreateDefineNode(const std::string &columnName, const ROOT::Detail::RDF::RCustomColumnBase *columnPtr)
 {
@@ -88,7 +96,7 @@ CreateDefineNode(const std::string &columnName, const ROOT::Detail::RDF::RCustom
       return duplicateDefine;
    }
 
-   auto node = std::make_shared<GraphNode>("Define\n" + columnName);
+   auto node = std::make_shared<GraphNode>("Define\n" + columnName + FormatProfile(columnPtr->GetProfile()));
    node->SetDefine();
 
    sColumnsMap[columnPtr] = node;
@@ -106,7 +114,7 @@ std::shared_ptr<GraphNode> CreateFilterNode(const ROOT::Detail::RDF::RFilterBase
       return duplicateFilter;
    }
    auto filterName = (filterPtr->HasName() ? filterPtr->GetName() : "Filter");
-   auto node = std::make_shared<GraphNode>(filterName);
+   auto node = std::make_shared<GraphNode>(filterName + FormatProfile(filterPtr->GetProfile()));
 
    sFiltersMap[filterPtr] = node;
    node->SetFilter();
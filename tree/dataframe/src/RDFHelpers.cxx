@@ -0,0 +1,53 @@
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "RConfigure.h" // R__USE_IMT
+#include "ROOT/RDFHelpers.hxx"
+#include "ROOT/RDF/RLoopManager.hxx"
+#include "ROOT/RResultHandle.hxx"
+#include "TROOT.h" // IsImplicitMTEnabled
+
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#endif
+
+#include <algorithm>
+#include <vector>
+
+unsigned int ROOT::RDF::RunGraphs(std::vector<RResultHandle> handles)
+{
+   // Only keep one handle per computation graph, and skip the graphs whose results are already available
+   std::vector<ROOT::Detail::RDF::RLoopManager *> loopManagers;
+   for (auto &h : handles) {
+      if (!h || h.IsReady())
+         continue;
+      if (std::find(loopManagers.begin(), loopManagers.end(), h.fLoopManager) == loopManagers.end())
+         loopManagers.emplace_back(h.fLoopManager);
+   }
+   if (loopManagers.empty())
+      return 0u;
+
+   // Jitting is not thread-safe: a single call declares the code required by all computation graphs, so that the
+   // event loops below do not need to invoke the interpreter
+   loopManagers.front()->Jit();
+
+   auto run = [](ROOT::Detail::RDF::RLoopManager *lm) { lm->Run(); };
+#ifdef R__USE_IMT
+   if (ROOT::IsImplicitMTEnabled()) {
+      // The tasks spawned by each event loop run in the same (global) task arena as the event loops themselves,
+      // so idle threads are filled with work from the other computation graphs
+      ROOT::TThreadExecutor pool;
+      pool.Foreach(run, loopManagers);
+      return loopManagers.size();
+   }
+#endif
+   for (auto lm : loopManagers)
+      run(lm);
+
+   return loopManagers.size();
+}
@@ -455,6 +455,23 @@ void CheckCustomColumn(std::string_view definedCol, TTree *treePtr, const Column
    }
 }
 
+void CheckVariation(const std::string &variationName, const std::vector<std::string> &variationTags,
+                    const ColumnNames_t &variations)
+{
+   if (variationTags.empty()) {
+      const auto msg = "Systematic variation \"" + variationName + "\" must have at least one tag.";
+      throw std::runtime_error(msg);
+   }
+
+   const auto prefix = variationName + ':';
+   for (const auto &variation : variations) {
+      if (variation.compare(0, prefix.size(), prefix) == 0) {
+         const auto msg = "Systematic variation \"" + variationName + "\" is already defined.";
+         throw std::runtime_error(msg);
+      }
+   }
+}
+
 void CheckTypesAndPars(unsigned int nTemplateParams, unsigned int nColumnNames)
 {
    if (nTemplateParams != nColumnNames) {
@@ -548,6 +565,15 @@ void BookFilterJit(const std::shared_ptr<RJittedFilter> &jittedFilter,
       ParseRDFExpression(std::string(expression), branches, customCols.GetNames(), dsColumns, aliasMap);
    const auto exprVarTypes =
       GetValidatedArgTypes(parsedExpr.fUsedCols, customCols, tree, ds, "Filter", /*vector2rvec=*/true);
+
+   if (auto bookFromCache =
+          GetJitCacheFilterBooker(BuildLambdaString(parsedExpr.fExpr, parsedExpr.fVarNames, exprVarTypes))) {
+      // the filter and its lambda were compiled by a previous process, no need to invoke the interpreter
+      bookFromCache(parsedExpr.fUsedCols, std::string(name), MakeWeakOnHeap(jittedFilter), prevNodeOnHeap,
+                    new ROOT::Internal::RDF::RBookedCustomColumns(customCols));
+      return;
+   }
+
    const auto lambdaName = DeclareLambda(parsedExpr.fExpr, parsedExpr.fVarNames, exprVarTypes);
    const auto type = RetTypeOfLambda(lambdaName);
    if (type != "bool")
@@ -595,6 +621,17 @@ std::shared_ptr<RJittedCustomColumn> BookDefineJit(std::string_view name, std::s
       ParseRDFExpression(std::string(expression), branches, customCols.GetNames(), dsColumns, aliasMap);
    const auto exprVarTypes =
       GetValidatedArgTypes(parsedExpr.fUsedCols, customCols, tree, ds, "Define", /*vector2rvec=*/true);
+
+   std::string cachedType;
+   if (auto bookFromCache = GetJitCacheDefineBooker(
+          BuildLambdaString(parsedExpr.fExpr, parsedExpr.fVarNames, exprVarTypes), cachedType)) {
+      // the custom column and its lambda were compiled by a previous process, no need to invoke the interpreter
+      auto jittedCustomColumn = std::make_shared<RDFDetail::RJittedCustomColumn>(name, cachedType, lm.GetNSlots());
+      bookFromCache(parsedExpr.fUsedCols, std::string(name), &lm, MakeWeakOnHeap(jittedCustomColumn),
+                    new RDFInternal::RBookedCustomColumns(customCols), upcastNodeOnHeap);
+      return jittedCustomColumn;
+   }
+
    const auto lambdaName = DeclareLambda(parsedExpr.fExpr, parsedExpr.fVarNames, exprVarTypes);
    const auto type = RetTypeOfLambda(lambdaName);
 
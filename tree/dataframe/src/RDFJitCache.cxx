@@ -0,0 +1,298 @@
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/RDFHelpers.hxx"
+#include "ROOT/RDF/InterfaceUtils.hxx"
+#include "TError.h" // Warning
+#include "TMD5.h"
+#include "TROOT.h"
+#include "TSystem.h"
+
+#include <atomic>
+#include <ctime>
+#include <fstream>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+// The jit cache stores the Filter and Define expressions that RDataFrame would otherwise declare to the interpreter,
+// compiled into shared libraries (with ACLiC) together with the instantiation of the corresponding RDF nodes. Each
+// library is named after a hash of the lambda, the kind of node, the ROOT version and the compiler, and exposes
+// extern "C" entry points so that the nodes can be booked by later processes without invoking the interpreter at all.
+// Booking only looks entries up: expressions missing from the cache are jitted as usual and compiled into the cache
+// after the event loop, outside of the lock, by CompilePendingJitCacheEntries().
+
+namespace {
+
+/// Expressions that failed to compile are retried by processes started after this many seconds
+constexpr long kFailedMarkerLifetime = 24 * 60 * 60;
+
+std::mutex &GetJitCacheMutex()
+{
+   static std::mutex mutex;
+   return mutex;
+}
+
+std::string &JitCacheDir()
+{
+   static std::string dir = [] {
+      const auto env = gSystem->Getenv("ROOT_RDF_JITCACHE");
+      return env ? std::string(env) : std::string();
+   }();
+   return dir;
+}
+
+/// Kind and lambda of the expressions booked with the interpreter that should be added to the cache directory.
+/// Guarded by GetJitCacheMutex().
+std::set<std::pair<std::string, std::string>> &GetPendingEntries()
+{
+   static std::set<std::pair<std::string, std::string>> entries;
+   return entries;
+}
+
+/// Cached entry points of the current cache directory, by key. nullptr values mark expressions that could not be
+/// compiled. Guarded by GetJitCacheMutex().
+std::unordered_map<std::string, void *> &GetLoadedEntries()
+{
+   static std::unordered_map<std::string, void *> entries;
+   return entries;
+}
+
+std::string MakeKey(const std::string &kind, const std::string &lambdaExpr)
+{
+   const std::string content = kind + '\n' + gROOT->GetVersion() + '\n' + gROOT->GetGitCommit() + '\n' +
+                               gSystem->GetBuildCompilerVersion() + '\n' + gSystem->GetMakeSharedLib() + '\n' +
+                               lambdaExpr;
+   TMD5 md5;
+   md5.Update(reinterpret_cast<const UChar_t *>(content.data()), content.size());
+   md5.Final();
+   return std::string("rdfjit_") + md5.AsString();
+}
+
+std::string MakeSource(const std::string &key, const std::string &kind, const std::string &lambdaExpr)
+{
+   std::string code = "// RDataFrame jit cache entry for a " + kind + " expression. Generated, do not edit.\n";
+   code += "#include \"ROOT/RDataFrame.hxx\"\n#include \"ROOT/RVec.hxx\"\n#include \"TMath.h\"\n\n";
+   code += "#include <memory>\n#include <string>\n#include <typeinfo>\n#include <vector>\n\n";
+   code += "namespace {\nauto " + key + "_lambda = " + lambdaExpr + ";\n}\n\n";
+   if (kind == "Filter") {
+      code += "extern \"C\" void " + key +
+              "_book(const std::vector<std::string> &cols, const std::string &name, void *wkJittedFilter, "
+              "void *prevNodeOnHeap, void *customColumns)\n{\n"
+              "   ROOT::Internal::RDF::JitFilterHelper(" +
+              key +
+              "_lambda, cols, name,\n"
+              "      static_cast<std::weak_ptr<ROOT::Detail::RDF::RJittedFilter> *>(wkJittedFilter),\n"
+              "      static_cast<std::shared_ptr<ROOT::Detail::RDF::RNodeBase> *>(prevNodeOnHeap),\n"
+              "      static_cast<ROOT::Internal::RDF::RBookedCustomColumns *>(customColumns));\n}\n";
+   } else {
+      code += "extern \"C\" void " + key +
+              "_rettype(std::string &type)\n{\n"
+              "   using Ret_t = ROOT::TypeTraits::CallableTraits<decltype(" +
+              key +
+              "_lambda)>::ret_type;\n"
+              "   type = ROOT::Internal::RDF::TypeID2TypeName(typeid(Ret_t));\n}\n\n"
+              "extern \"C\" void " +
+              key +
+              "_book(const std::vector<std::string> &cols, const std::string &name, "
+              "ROOT::Detail::RDF::RLoopManager *lm, void *wkJittedCustomCol, void *customColumns, "
+              "void *prevNodeOnHeap)\n{\n"
+              "   ROOT::Internal::RDF::JitDefineHelper(" +
+              key +
+              "_lambda, cols, name, lm,\n"
+              "      static_cast<std::weak_ptr<ROOT::Detail::RDF::RJittedCustomColumn> *>(wkJittedCustomCol),\n"
+              "      static_cast<ROOT::Internal::RDF::RBookedCustomColumns *>(customColumns),\n"
+              "      static_cast<std::shared_ptr<ROOT::Detail::RDF::RNodeBase> *>(prevNodeOnHeap));\n}\n";
+   }
+   return code;
+}
+
+/// Whether a previous process failed to compile the entry recently enough that we should not try again
+bool IsMarkedAsFailed(const std::string &failedMarker)
+{
+   FileStat_t stat;
+   if (gSystem->GetPathInfo(failedMarker.c_str(), stat) != 0)
+      return false;
+   if (std::time(nullptr) - stat.fMtime < kFailedMarkerLifetime)
+      return true;
+   gSystem->Unlink(failedMarker.c_str());
+   return false;
+}
+
+/// Whether the file can be loaded into this process: libraries in the cache directory are only trusted if they belong
+/// to the current user and cannot be modified by anybody else
+bool IsTrustedFile(const std::string &fileName)
+{
+   FileStat_t stat;
+   if (gSystem->GetPathInfo(fileName.c_str(), stat) != 0)
+      return false;
+#ifndef R__WIN32
+   if (stat.fUid != gSystem->GetUid() || (stat.fMode & (kS_IWGRP | kS_IWOTH)))
+      return false;
+#endif
+   return true;
+}
+
+/// Remove the directory and the files in it, e.g. the by-products of ACLiC
+void RemoveDirectory(const std::string &dirName)
+{
+   if (auto dir = gSystem->OpenDirectory(dirName.c_str())) {
+      while (const char *entry = gSystem->GetDirEntry(dir)) {
+         const std::string fileName(entry);
+         if (fileName != "." && fileName != "..")
+            gSystem->Unlink((dirName + "/" + fileName).c_str());
+      }
+      gSystem->FreeDirectory(dir);
+   }
+   gSystem->Unlink(dirName.c_str());
+}
+
+/// Compile the library of the cache entry in a directory private to this call, then move the library and its
+/// dictionary in place, so that concurrent jobs sharing the cache directory never see a partially written library.
+/// The dictionary is moved first: its name is derived from the library name and it is needed to load the library.
+bool CompileJitCacheEntry(const std::string &dir, const std::string &key, const std::string &kind,
+                          const std::string &lambdaExpr)
+{
+   static std::atomic<unsigned int> nCompilations{0};
+   gSystem->mkdir(dir.c_str(), kTRUE);
+   const auto tmpDir =
+      dir + "/" + key + "_" + std::to_string(gSystem->GetPid()) + "_" + std::to_string(nCompilations++);
+   gSystem->mkdir(tmpDir.c_str());
+   const auto tmpBase = tmpDir + "/" + key;
+   const auto src = tmpBase + ".cxx";
+   {
+      std::ofstream out(src);
+      out << MakeSource(key, kind, lambdaExpr);
+   }
+   const std::string soExt = gSystem->GetSoExt();
+   const std::string pcmSuffix = "_ACLiC_dict_rdict.pcm";
+   bool success = gSystem->CompileMacro(src.c_str(), "kOcs", tmpBase.c_str()) &&
+                  !gSystem->AccessPathName((tmpBase + "." + soExt).c_str());
+   if (success) {
+      // whatever the umask, the files must pass IsTrustedFile() to be loaded again
+      if (!gSystem->AccessPathName((tmpBase + pcmSuffix).c_str())) {
+         gSystem->Chmod((tmpBase + pcmSuffix).c_str(), 0644);
+         gSystem->Rename((tmpBase + pcmSuffix).c_str(), (dir + "/" + key + pcmSuffix).c_str());
+      }
+      gSystem->Chmod((tmpBase + "." + soExt).c_str(), 0755);
+      success = gSystem->Rename((tmpBase + "." + soExt).c_str(), (dir + "/" + key + "." + soExt).c_str()) == 0;
+   }
+   RemoveDirectory(tmpDir);
+   return success;
+}
+
+/// Load the cache entry for the given lambda and return the address of the symbol `<key>_<entry>`. Return nullptr if
+/// the cache is disabled, if the entry is not on disk yet (it is then compiled after the event loop) or could not be
+/// compiled, e.g. because it uses functions or types only known to the interpreter: the caller then falls back to the
+/// interpreter.
+void *GetJitCacheEntry(const std::string &kind, const std::string &lambdaExpr, const std::string &entry)
+{
+   std::lock_guard<std::mutex> lock(GetJitCacheMutex());
+   const auto &dir = JitCacheDir();
+   if (dir.empty())
+      return nullptr;
+
+   const auto key = MakeKey(kind, lambdaExpr);
+   const auto symbol = key + "_" + entry;
+   auto &loaded = GetLoadedEntries();
+   const auto it = loaded.find(symbol);
+   if (it != loaded.end())
+      return it->second;
+
+   const auto base = dir + "/" + key;
+   const auto lib = base + "." + gSystem->GetSoExt();
+   const auto pcm = base + "_ACLiC_dict_rdict.pcm";
+   if (gSystem->AccessPathName(lib.c_str())) {
+      // not cached yet: the entry is not marked as loaded so that it is found once it has been compiled
+      if (!IsMarkedAsFailed(base + ".failed"))
+         GetPendingEntries().emplace(kind, lambdaExpr);
+      return nullptr;
+   }
+
+   void *address = nullptr;
+   if (!IsTrustedFile(lib) || (!gSystem->AccessPathName(pcm.c_str()) && !IsTrustedFile(pcm))) {
+      Warning("RDataFrame::Jit", "Not loading %s: jit cache libraries must belong to the current user and must not be "
+              "writable by others. Using the interpreter.", lib.c_str());
+   } else if (gSystem->Load(lib.c_str()) >= 0) {
+      address = reinterpret_cast<void *>(gSystem->DynFindSymbol(lib.c_str(), symbol.c_str()));
+   }
+
+   loaded[symbol] = address;
+   return address;
+}
+
+} // anonymous namespace
+
+namespace ROOT {
+namespace Internal {
+namespace RDF {
+
+void CompilePendingJitCacheEntries()
+{
+   std::string dir;
+   std::set<std::pair<std::string, std::string>> pending;
+   {
+      std::lock_guard<std::mutex> lock(GetJitCacheMutex());
+      dir = JitCacheDir();
+      std::swap(pending, GetPendingEntries());
+   }
+   if (dir.empty())
+      return;
+
+   // compiling takes seconds per expression: other event loops can book their nodes in the meantime
+   for (const auto &entry : pending) {
+      const auto &kind = entry.first;
+      const auto &lambdaExpr = entry.second;
+      const auto key = MakeKey(kind, lambdaExpr);
+      const auto base = dir + "/" + key;
+      if (!gSystem->AccessPathName((base + "." + gSystem->GetSoExt()).c_str()) || IsMarkedAsFailed(base + ".failed"))
+         continue; // compiled or given up on by another event loop or job in the meantime
+      if (!CompileJitCacheEntry(dir, key, kind, lambdaExpr)) {
+         Warning("RDataFrame::Jit", "Could not add the following %s expression to the jit cache in %s:\n%s",
+                 kind.c_str(), dir.c_str(), lambdaExpr.c_str());
+         std::ofstream marker(base + ".failed");
+      }
+   }
+}
+
+JitCacheFilterBooker_t GetJitCacheFilterBooker(const std::string &lambdaExpr)
+{
+   return reinterpret_cast<JitCacheFilterBooker_t>(GetJitCacheEntry("Filter", lambdaExpr, "book"));
+}
+
+JitCacheDefineBooker_t GetJitCacheDefineBooker(const std::string &lambdaExpr, std::string &retType)
+{
+   using RetType_t = void (*)(std::string &);
+   auto getRetType = reinterpret_cast<RetType_t>(GetJitCacheEntry("Define", lambdaExpr, "rettype"));
+   auto book = reinterpret_cast<JitCacheDefineBooker_t>(GetJitCacheEntry("Define", lambdaExpr, "book"));
+   if (!getRetType || !book)
+      return nullptr;
+   getRetType(retType);
+   // types without a name known to ROOT can only be handled by the interpreter
+   return retType.empty() ? nullptr : book;
+}
+
+} // namespace RDF
+} // namespace Internal
+} // namespace ROOT
+
+void ROOT::RDF::Experimental::SetJitCacheDir(const std::string &dir)
+{
+   std::lock_guard<std::mutex> lock(GetJitCacheMutex());
+   JitCacheDir() = dir;
+   // Entries are looked up again in the new directory
+   GetLoadedEntries().clear();
+   GetPendingEntries().clear();
+}
+
+const std::string &ROOT::RDF::Experimental::GetJitCacheDir()
+{
+   return JitCacheDir();
+}
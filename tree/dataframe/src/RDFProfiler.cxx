@@ -0,0 +1,139 @@
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/RDF/RProfiler.hxx"
+#include "ROOT/RDF/RProfileReport.hxx"
+#include "ROOT/RMakeUnique.hxx"
+
+#include <algorithm>
+#include <numeric>
+
+namespace {
+/// Time spent in the profile scopes nested in the innermost open scope of this thread, in nanoseconds
+ULong64_t &GetNestedTime()
+{
+   thread_local ULong64_t nestedTime = 0ull;
+   return nestedTime;
+}
+
+struct RCurrentProfiler {
+   ROOT::Internal::RDF::RProfiler *fProfiler = nullptr;
+   unsigned int fSlot = 0u;
+};
+
+RCurrentProfiler &GetCurrentProfiler()
+{
+   thread_local RCurrentProfiler current;
+   return current;
+}
+} // anonymous namespace
+
+namespace ROOT {
+namespace Internal {
+namespace RDF {
+
+void RNodeProfile::Reset()
+{
+   for (auto &slot : fSlots) {
+      slot.fTime = 0ull;
+      slot.fCalls = 0ull;
+   }
+}
+
+ULong64_t RNodeProfile::GetTotalTime() const
+{
+   return std::accumulate(fSlots.begin(), fSlots.end(), 0ull,
+                          [](ULong64_t t, const RSlotCounters &c) { return t + c.fTime; });
+}
+
+ULong64_t RNodeProfile::GetTotalCalls() const
+{
+   return std::accumulate(fSlots.begin(), fSlots.end(), 0ull,
+                          [](ULong64_t n, const RSlotCounters &c) { return n + c.fCalls; });
+}
+
+void RProfileScope::Start()
+{
+   auto &nestedTime = GetNestedTime();
+   fOuterNestedTime = nestedTime;
+   nestedTime = 0ull;
+   fStart = std::chrono::steady_clock::now();
+}
+
+void RProfileScope::Stop()
+{
+   const auto elapsed = static_cast<ULong64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - fStart).count());
+   auto &nestedTime = GetNestedTime();
+   fProfile->Add(fSlot, elapsed > nestedTime ? elapsed - nestedTime : 0ull);
+   // the enclosing scope, if any, must not account for the time spent in this one
+   nestedTime = fOuterNestedTime + elapsed;
+}
+
+bool RProfiler::AddNode(EKind kind, const std::string &name, RNodeProfile &profile)
+{
+   const auto it =
+      std::find_if(fNodes.begin(), fNodes.end(), [&profile](const RNodeEntry &n) { return n.fProfile == &profile; });
+   if (it != fNodes.end())
+      return false;
+   fNodes.push_back({kind, name, &profile});
+   profile.Reset();
+   profile.SetEnabled(true);
+   return true;
+}
+
+RNodeProfile *RProfiler::GetColumnProfile(const std::string &colName)
+{
+   std::lock_guard<std::mutex> lock(fColumnProfilesMutex);
+   auto &profile = fColumnProfiles[colName];
+   if (!profile) {
+      profile = std::make_unique<RNodeProfile>(fNSlots);
+      profile->SetEnabled(true);
+   }
+   return profile.get();
+}
+
+void RProfiler::FillReport(ROOT::RDF::RProfileReport &report)
+{
+   auto addNode = [&report, this](EKind kind, const std::string &name, const RNodeProfile &profile) {
+      std::vector<ULong64_t> calls(fNSlots);
+      std::vector<double> times(fNSlots);
+      for (auto slot = 0u; slot < fNSlots; ++slot) {
+         calls[slot] = profile.GetCalls(slot);
+         times[slot] = 1e-9 * profile.GetTime(slot);
+      }
+      report.AddNode(ROOT::RDF::RNodeProfileInfo(kind, name, std::move(calls), std::move(times)));
+   };
+
+   for (auto &node : fNodes)
+      addNode(node.fKind, node.fName, *node.fProfile);
+   for (auto &column : fColumnProfiles)
+      addNode(EKind::kColumnRead, column.first, *column.second);
+   report.SetJitTime(fJitTime);
+}
+
+void RProfiler::SetCurrent(RProfiler *profiler, unsigned int slot)
+{
+   auto &current = GetCurrentProfiler();
+   current.fProfiler = profiler;
+   current.fSlot = slot;
+}
+
+RProfiler *RProfiler::GetCurrent()
+{
+   return GetCurrentProfiler().fProfiler;
+}
+
+unsigned int RProfiler::GetCurrentSlot()
+{
+   return GetCurrentProfiler().fSlot;
+}
+
+} // namespace RDF
+} // namespace Internal
+} // namespace ROOT
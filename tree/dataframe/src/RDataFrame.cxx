@@ -70,6 +70,7 @@ Transformations are a way to manipulate the data.
 | [DefineSlotEntry](classROOT_1_1RDF_1_1RInterface.html#a4f17074d5771916e3df18f8458186de7) | Same as `DefineSlot`, but the entry number is passed in addition to the slot number. This is meant as a helper in case some dependency on the entry number needs to be honoured. |
 | [Filter](classROOT_1_1RDF_1_1RInterface.html#a70284a3bedc72b19610aaa91b5007ebd) | Filter the rows of the dataset. |
 | [Range](classROOT_1_1RDF_1_1RInterface.html#a1b36b7868831de2375e061bb06cfc225) | Creates a node that filters entries based on range of entries |
+| [Vary](classROOT_1_1RDF_1_1RInterface.html) | Registers systematic variations of a column. The varied results of downstream actions are retrieved with `ROOT::RDF::Experimental::VariationsFor` and computed in the same event loop as the nominal ones. |
 
 ### Actions
 Actions are a way to produce a result out of the data. Each one is described in more detail in the reference guide.
@@ -85,7 +86,7 @@ produce several different results in one event loop. Instant actions trigger the
 |------------------|-----------------|
 | [Aggregate](classROOT_1_1RDF_1_1RInterface.html#ae540b00addc441f9b504cbae0ef0a24d) | Execute a user-defined accumulation operation on the processed column values. |
 | [Book](classROOT_1_1RDF_1_1RInterface.html#a9b2f61f3333d1669e57055b9ae8be9d9) | Book execution of a custom action using a user-defined helper object. |
-| [Cache](classROOT_1_1RDF_1_1RInterface.html#aaaa0a7bb8eb21315d8daa08c3e25f6c9) | Caches in contiguous memory columns' entries. Custom columns can be cached as well, filtered entries are not cached. Users can specify which columns to save (default is all). |
+| [Cache](classROOT_1_1RDF_1_1RInterface.html#aaaa0a7bb8eb21315d8daa08c3e25f6c9) | Caches in contiguous memory columns' entries. Custom columns can be cached as well, filtered entries are not cached. Users can specify which columns to save (default is all). A memory budget can be set with `RCacheOptions`, in which case the entries beyond it are spilled to temporary files. |
 | [Count](classROOT_1_1RDF_1_1RInterface.html#a37f9e00c2ece7f53fae50b740adc1456) | Return the number of events processed. |
 | [Display](classROOT_1_1RDF_1_1RInterface.html#aee68f4411f16f00a1d46eccb6d296f01) | Obtains the events in the dataset for the requested columns. The method returns a [RDisplay](classROOT_1_1RDF_1_1RDisplay.html) instance which can be queried to get a compressed tabular representation on the standard output or a complete representation as a string. |
 | [Fill](classROOT_1_1RDF_1_1RInterface.html#a0cac4d08297c23d16de81ff25545440a) | Fill a user-defined object with the values of the specified branches, as if by calling `Obj.Fill(branch1, branch2, ...). |
@@ -95,6 +96,7 @@ produce several different results in one event loop. Instant actions trigger the
 | [Mean](classROOT_1_1RDF_1_1RInterface.html#ade6b020284f2f4fe9d3b09246b5f376a) | Return the mean of processed branch values.|
 | [Min](classROOT_1_1RDF_1_1RInterface.html#a7005702189e601972b6d19ecebcdc80c) | Return the minimum of processed branch values. If the type of the column is inferred, the return type is `double`, the type of the column otherwise.|
 | [Profile{1D,2D}](classROOT_1_1RDF_1_1RInterface.html#a8ef7dc16b0e9f7bc9cfbe2d9e5de0cef) | Fill a {one,two}-dimensional profile with the branch values that passed all filters. |
+| [ProfileReport](classROOT_1_1RDF_1_1RInterface.html) | Obtains the wall time spent in each filter, custom column and action of the computation graph, and in reading each input column, during the event loop. The method returns a RProfileReport instance which can be printed or queried programmatically. |
 | [Reduce](classROOT_1_1RDF_1_1RInterface.html#a118e723ae29834df8f2a992ded347354) | Reduce (e.g. sum, merge) entries using the function (lambda, functor...) passed as argument. The function must have signature `T(T,T)` where `T` is the type of the branch. Return the final result of the reduction operation. An optional parameter allows initialization of the result object to non-default values. |
 | [Report](classROOT_1_1RDF_1_1RInterface.html#a94f322531dcb25beb8f53a602e5d6332) | Obtains statistics on how many entries have been accepted and rejected by the filters. See the section on [named filters](#named-filters-and-cutflow-reports) for a more detailed explanation. The method returns a RCutFlowReport instance which can be queried programmatically to get information about the effects of the individual cuts. |
 | [StdDev](classROOT_1_1RDF_1_1RInterface.html#a482c4e4f81fe1e421c016f89cd281572) | Return the unbiased standard deviation of the processed branch values. |
@@ -105,6 +107,7 @@ produce several different results in one event loop. Instant actions trigger the
 |---------------------|-----------------|
 | [Foreach](classROOT_1_1RDF_1_1RInterface.html#ad2822a7ccb8a9afdf3e5b2ea321886ca) | Execute a user-defined function on each entry. Users are responsible for the thread-safety of this lambda when executing with implicit multi-threading enabled. |
 | [ForeachSlot](classROOT_1_1RDF_1_1RInterface.html#a3650ca30aae1ccd0d92bf3d680314129) | Same as `Foreach`, but the user-defined function must take an extra `unsigned int slot` as its first parameter. `slot` will take a different value, `0` to `nThreads - 1`, for each thread of execution. This is meant as a helper in writing thread-safe `Foreach` actions when using `RDataFrame` after `ROOT::EnableImplicitMT()`. `ForeachSlot` works just as well with single-thread execution: in that case `slot` will always be `0`. |
+| [ForeachBatch](classROOT_1_1RDF_1_1RInterface.html) | Execute a user-defined function on batches of entries: the function takes one `RVec` per column, holding the values of the entries of a batch that pass the upstream filters (see [batched processing](#batched-processing)). A `ForeachBatchSlot` variant, taking the processing slot as first parameter, is also available. |
 | [Snapshot](classROOT_1_1RDF_1_1RInterface.html#a233b7723e498967f4340705d2c4db7f8) | Writes processed data-set to disk, in a new `TTree` and `TFile`. Custom columns can be saved as well, filtered entries are not saved. Users can specify which columns to save (default is all). Snapshot, by default, overwrites the output file if it already exists. `Snapshot` can be made *lazy* setting the appropriate flage in the snapshot options.|
 
 
@@ -121,6 +124,7 @@ produce several different results in one event loop. Instant actions trigger the
 | [Display](classROOT_1_1RDF_1_1RInterface.html#a652f9ab3e8d2da9335b347b540a9a941) | Provides an ASCII representation of the columns types and contents of the dataset printable by the user. |
 | [SaveGraph](namespaceROOT_1_1RDF.html#adc17882b283c3d3ba85b1a236197c533) | Store the computation graph of an RDataFrame in graphviz format for easy inspection. |
 | [GetNRuns](classROOT_1_1RDF_1_1RInterface.html#adfb0562a9f7732c3afb123aefa07e0df) | Get the number of event loops run by this RDataFrame instance. |
+| [SetBatchSize](classROOT_1_1RDF_1_1RInterface.html) | Process the entries of the next event loops in batches of the given size, see [batched processing](#batched-processing). |
 
 
 ## <a name="introduction"></a>Introduction
@@ -803,6 +807,11 @@ will create a new column called "pt" the value of which is calculated starting f
 builds a just-in-time compiled function starting from the expression after having deduced the list of necessary branches
 from the names of the variables specified by the user.
 
+Jitting many expressions can take a noticeable time at startup. Jobs that repeatedly run the same analysis can call
+`ROOT::RDF::Experimental::SetJitCacheDir(dir)` (or set the `ROOT_RDF_JITCACHE` environment variable) to compile
+`Filter` and `Define` expressions into shared libraries stored in `dir` after the first event loop, which later
+processes load instead of invoking the interpreter.
+
 #### Custom columns as function of slot and entry number
 
 It is possible to create custom columns also as a function of the processing slot and entry numbers. The methods that can
@@ -856,6 +865,23 @@ will never receive the same slot at the same time.
 This extra parameter might facilitate writing safe parallel code by having each thread write/modify a different
 *processing slot*, e.g. a different element of a list. See [here](#generic-actions) for an example usage of `ForeachSlot`.
 
+### <a name="batched-processing"></a>Batched processing
+By default, each node of the computation graph processes the entries one at a time. After a call to `SetBatchSize(n)`,
+each processing slot instead collects `n` consecutive entries, or fewer at the end of a cluster of the input tree, and
+then every node processes the whole batch: filters compute which entries of the batch pass, custom columns are
+evaluated for the selected entries and actions are executed on them. Each node reads its input columns for the entries
+that pass its upstream filters only. This reduces the overhead of the calls through the computation graph, and
+`ForeachBatch` receives the values of all the selected entries of a batch as `RVec`s, on which loops can be vectorized:
+~~~{.cpp}
+ROOT::RDataFrame df("tree", "file.root");
+df.SetBatchSize(1024);
+double sum = 0.;
+df.Filter("w > 0").ForeachBatch([&sum](const RVec<float> &x, const RVec<float> &w) { sum += Sum(x * w); }, {"x", "w"});
+~~~
+The values of the columns of a data source are copied in the batch for every entry, even if they are only needed
+downstream of a filter.
+Event loops that include a `Snapshot` always process the entries one at a time.
+
 <a name="reference"></a>
 */
 // clang-format on
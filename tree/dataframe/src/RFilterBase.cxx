@@ -10,14 +10,15 @@
 
 #include "ROOT/RDF/RCutFlowReport.hxx"
 #include "ROOT/RDF/RFilterBase.hxx"
+#include "ROOT/RDF/RLoopManager.hxx"
 #include <numeric> // std::accumulate
 
 using namespace ROOT::Detail::RDF;
 
 RFilterBase::RFilterBase(RLoopManager *implPtr, std::string_view name, const unsigned int nSlots,
                          const RDFInternal::RBookedCustomColumns &customColumns)
-   : RNodeBase(implPtr), fLastResult(nSlots), fAccepted(nSlots), fRejected(nSlots), fName(name), fNSlots(nSlots),
-     fCustomColumns(customColumns) {}
+   : RNodeBase(implPtr), fLastResult(nSlots), fAccepted(nSlots), fRejected(nSlots), fBatchMasks(nSlots), fName(name),
+     fNSlots(nSlots), fProfile(nSlots), fCustomColumns(customColumns) {}
 
 // outlined to pin virtual table
 RFilterBase::~RFilterBase() {}
@@ -44,6 +45,19 @@ void RFilterBase::FillReport(ROOT::RDF::RCutFlowReport &rep) const
 void RFilterBase::InitNode()
 {
    fLastCheckedEntry = std::vector<Long64_t>(fNSlots, -1);
+   fLastCheckedBatch = std::vector<ULong64_t>(fNSlots, RDFInternal::RBatch::kInvalidId);
    if (!fName.empty()) // if this is a named filter we care about its report count
       ResetReportCount();
 }
+
+std::shared_ptr<RNodeBase> RFilterBase::GetVariedNode(const std::string &variation)
+{
+   const auto it = fVariedFilters.find(variation);
+   if (it != fVariedFilters.end())
+      return it->second;
+   std::shared_ptr<RFilterBase> variedFilter = MakeVariedFilter(variation);
+   if (variedFilter)
+      fLoopManager->Book(variedFilter.get());
+   fVariedFilters[variation] = variedFilter;
+   return variedFilter;
+}
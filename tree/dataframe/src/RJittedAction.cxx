@@ -15,6 +15,7 @@
 #include "ROOT/RDF/RMergeableValue.hxx"
 #include "TError.h"
 
+using ROOT::Internal::RDF::RBatch;
 using ROOT::Internal::RDF::RJittedAction;
 using ROOT::Detail::RDF::RLoopManager;
 
@@ -26,6 +27,18 @@ void RJittedAction::Run(unsigned int slot, Long64_t entry)
    fConcreteAction->Run(slot, entry);
 }
 
+void RJittedAction::RunBatch(unsigned int slot, const RBatch &batch)
+{
+   R__ASSERT(fConcreteAction != nullptr);
+   fConcreteAction->RunBatch(slot, batch);
+}
+
+bool RJittedAction::CanRunBatches() const
+{
+   R__ASSERT(fConcreteAction != nullptr);
+   return fConcreteAction->CanRunBatches();
+}
+
 void RJittedAction::Initialize()
 {
    R__ASSERT(fConcreteAction != nullptr);
@@ -84,6 +97,12 @@ void RJittedAction::ClearValueReaders(unsigned int slot)
    return fConcreteAction->ClearValueReaders(slot);
 }
 
+void RJittedAction::SetUpProfiling(RProfiler *profiler)
+{
+   R__ASSERT(fConcreteAction != nullptr);
+   fConcreteAction->SetUpProfiling(profiler);
+}
+
 std::shared_ptr<ROOT::Internal::RDF::GraphDrawing::GraphNode> RJittedAction::GetGraph()
 {
    R__ASSERT(fConcreteAction != nullptr);
@@ -99,3 +118,16 @@ std::unique_ptr<ROOT::Detail::RDF::RMergeableValueBase> RJittedAction::GetMergea
    R__ASSERT(fConcreteAction != nullptr);
    return fConcreteAction->GetMergeableValue();
 }
+
+std::vector<std::string> RJittedAction::GetVariations() const
+{
+   R__ASSERT(fConcreteAction != nullptr);
+   return fConcreteAction->GetVariations();
+}
+
+std::unique_ptr<ROOT::Internal::RDF::RActionBase>
+RJittedAction::MakeVariedAction(const std::string &variation, std::shared_ptr<void> &variedResult)
+{
+   R__ASSERT(fConcreteAction != nullptr);
+   return fConcreteAction->MakeVariedAction(variation, variedResult);
+}
@@ -37,8 +37,39 @@ void RJittedCustomColumn::Update(unsigned int slot, Long64_t entry)
    fConcreteCustomColumn->Update(slot, entry);
 }
 
+void RJittedCustomColumn::UpdateBatch(unsigned int slot, const RDFInternal::RBatch &batch,
+                                      const RDFInternal::RBatchMask_t &mask)
+{
+   R__ASSERT(fConcreteCustomColumn != nullptr);
+   fConcreteCustomColumn->UpdateBatch(slot, batch, mask);
+}
+
+void *RJittedCustomColumn::GetBatchValuesPtr(unsigned int slot)
+{
+   R__ASSERT(fConcreteCustomColumn != nullptr);
+   return fConcreteCustomColumn->GetBatchValuesPtr(slot);
+}
+
 void RJittedCustomColumn::ClearValueReaders(unsigned int slot)
 {
    R__ASSERT(fConcreteCustomColumn != nullptr);
    fConcreteCustomColumn->ClearValueReaders(slot);
 }
+
+ROOT::Internal::RDF::RNodeProfile &RJittedCustomColumn::GetProfile()
+{
+   R__ASSERT(fConcreteCustomColumn != nullptr);
+   return fConcreteCustomColumn->GetProfile();
+}
+
+const ROOT::Internal::RDF::RNodeProfile &RJittedCustomColumn::GetProfile() const
+{
+   R__ASSERT(fConcreteCustomColumn != nullptr);
+   return fConcreteCustomColumn->GetProfile();
+}
+
+std::shared_ptr<RCustomColumnBase> RJittedCustomColumn::MakeVariedColumn(const std::string &variation)
+{
+   R__ASSERT(fConcreteCustomColumn != nullptr);
+   return fConcreteCustomColumn->GetVariedColumn(variation);
+}
@@ -12,6 +12,7 @@
 #include "ROOT/RDF/RBookedCustomColumns.hxx"
 #include "ROOT/RDF/RLoopManager.hxx"
 #include "ROOT/RDF/RJittedFilter.hxx"
+#include "ROOT/RMakeUnique.hxx"
 
 using namespace ROOT::Detail::RDF;
 
@@ -35,6 +36,12 @@ bool RJittedFilter::CheckFilters(unsigned int slot, Long64_t entry)
    return fConcreteFilter->CheckFilters(slot, entry);
 }
 
+const RDFInternal::RBatchMask_t &RJittedFilter::CheckFiltersBatch(unsigned int slot, const RDFInternal::RBatch &batch)
+{
+   R__ASSERT(fConcreteFilter != nullptr);
+   return fConcreteFilter->CheckFiltersBatch(slot, batch);
+}
+
 void RJittedFilter::Report(ROOT::RDF::RCutFlowReport &cr) const
 {
    R__ASSERT(fConcreteFilter != nullptr);
@@ -110,6 +117,30 @@ void RJittedFilter::AddFilterName(std::vector<std::string> &filters)
    fConcreteFilter->AddFilterName(filters);
 }
 
+RDFInternal::RNodeProfile &RJittedFilter::GetProfile()
+{
+   R__ASSERT(fConcreteFilter != nullptr);
+   return fConcreteFilter->GetProfile();
+}
+
+const RDFInternal::RNodeProfile &RJittedFilter::GetProfile() const
+{
+   R__ASSERT(fConcreteFilter != nullptr);
+   return fConcreteFilter->GetProfile();
+}
+
+std::unique_ptr<RFilterBase> RJittedFilter::MakeVariedFilter(const std::string &variation)
+{
+   R__ASSERT(fConcreteFilter != nullptr);
+   auto variedConcreteFilter = fConcreteFilter->MakeVariedFilter(variation);
+   if (!variedConcreteFilter)
+      return nullptr;
+   // the varied copy of a jitted filter is a jitted filter as well, so that it can be used in place of this node
+   auto variedFilter = std::make_unique<RJittedFilter>(fLoopManager, "");
+   variedFilter->SetFilter(std::move(variedConcreteFilter));
+   return variedFilter;
+}
+
 std::shared_ptr<RDFGraphDrawing::GraphNode> RJittedFilter::GetGraph()
 {
    if (fConcreteFilter != nullptr) {
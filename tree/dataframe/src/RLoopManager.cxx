@@ -1,8 +1,10 @@
 #include "RConfigure.h" // R__USE_IMT
 #include "ROOT/RDF/GraphNode.hxx"
+#include "ROOT/RDF/InterfaceUtils.hxx" // CompilePendingJitCacheEntries
 #include "ROOT/RDF/RActionBase.hxx"
 #include "ROOT/RDF/RFilterBase.hxx"
 #include "ROOT/RDF/RLoopManager.hxx"
+#include "ROOT/RDF/RProfiler.hxx"
 #include "ROOT/RDF/RRangeBase.hxx"
 #include "ROOT/RDF/RSlotStack.hxx"
 #include "RtypesCore.h" // Long64_t
@@ -19,7 +21,9 @@
 #include "ROOT/TTreeProcessorMT.hxx"
 #endif
 
+#include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <exception>
 #include <functional>
 #include <iostream>
@@ -288,6 +292,7 @@ void RLoopManager::RunEmptySourceMT()
          for (auto currEntry = range.first; currEntry < range.second; ++currEntry) {
             RunAndCheckFilters(slot, currEntry);
          }
+         RunBatch(slot);
       } catch (...) {
          CleanUpTask(slot);
          // Error might throw in experiment frameworks like CMSSW
@@ -312,6 +317,7 @@ void RLoopManager::RunEmptySource()
       for (ULong64_t currEntry = 0; currEntry < fNEmptyEntries && fNStopsReceived < fNChildren; ++currEntry) {
          RunAndCheckFilters(0, currEntry);
       }
+      RunBatch(0u);
    } catch (...) {
       CleanUpTask(0u);
       std::cerr << "RDataFrame::Run: event loop was interrupted\n";
@@ -342,6 +348,7 @@ void RLoopManager::RunTreeProcessorMT()
          while (r.Next()) {
             RunAndCheckFilters(slot, count++);
          }
+         RunBatch(slot);
       } catch (...) {
          CleanUpTask(slot);
          std::cerr << "RDataFrame::Run: event loop was interrupted\n";
@@ -368,6 +375,7 @@ void RLoopManager::RunTreeReader()
       while (r.Next() && fNStopsReceived < fNChildren) {
          RunAndCheckFilters(0, r.GetCurrentEntry());
       }
+      RunBatch(0u);
    } catch (...) {
       CleanUpTask(0u);
       std::cerr << "RDataFrame::Run: event loop was interrupted\n";
@@ -399,6 +407,7 @@ void RLoopManager::RunDataSource()
                }
             }
          }
+         RunBatch(0u);
       } catch (...) {
          CleanUpTask(0u);
          std::cerr << "RDataFrame::Run: event loop was interrupted\n";
@@ -431,6 +440,7 @@ void RLoopManager::RunDataSourceMT()
                RunAndCheckFilters(slot, entry);
             }
          }
+         RunBatch(slot);
       } catch (...) {
          CleanUpTask(slot);
          std::cerr << "RDataFrame::Run: event loop was interrupted\n";
@@ -453,8 +463,17 @@ void RLoopManager::RunDataSourceMT()
 
 /// Execute actions and make sure named filters are called for each event.
 /// Named filters must be called even if the analysis logic would not require it, lest they report confusing results.
+/// In batched mode, the entry is added to the current batch of the slot, which is processed once it is full or once its
+/// cluster of the input tree ends.
 void RLoopManager::RunAndCheckFilters(unsigned int slot, Long64_t entry)
 {
+   if (fIsBatched) {
+      auto &batch = fBatches[slot];
+      batch.AddEntry(entry);
+      if (batch.GetSize() == fBatchSize || batch.IsLastOfCluster())
+         RunBatch(slot);
+      return;
+   }
    for (auto &actionPtr : fBookedActions)
       actionPtr->Run(slot, entry);
    for (auto &namedFilterPtr : fBookedNamedFilters)
@@ -463,6 +482,26 @@ void RLoopManager::RunAndCheckFilters(unsigned int slot, Long64_t entry)
       callback(slot);
 }
 
+/// Process the entries of the current batch of the slot, in batched mode, and start the next batch.
+/// Like RunAndCheckFilters, named filters are checked on all entries. Callbacks are invoked once per entry, after the
+/// actions processed the whole batch. It is called at the end of each task for the last, partially filled, batch.
+void RLoopManager::RunBatch(unsigned int slot)
+{
+   if (!fIsBatched)
+      return;
+   auto &batch = fBatches[slot];
+   if (batch.GetSize() == 0)
+      return;
+   for (auto &actionPtr : fBookedActions)
+      actionPtr->RunBatch(slot, batch);
+   for (auto &namedFilterPtr : fBookedNamedFilters)
+      namedFilterPtr->CheckFiltersBatch(slot, batch);
+   for (std::size_t i = 0; i < batch.GetSize(); ++i)
+      for (auto &callback : fCallbacks)
+         callback(slot);
+   batch.Clear();
+}
+
 /// Build TTreeReaderValues for all nodes
 /// This method loops over all filters, actions and other booked objects and
 /// calls their `InitRDFValues` methods. It is called once per node per slot, before
@@ -470,10 +509,22 @@ void RLoopManager::RunAndCheckFilters(unsigned int slot, Long64_t entry)
 /// a particular slot will be using.
 void RLoopManager::InitNodeSlots(TTreeReader *r, unsigned int slot)
 {
+   // the readers of input columns created for this task are profiled with the profiler of this event loop, if any,
+   // and, in batched mode, fill the buffers of the batch of the slot
+   RDFInternal::RBatch *batch = nullptr;
+   if (fIsBatched) {
+      batch = &fBatches[slot];
+      batch->Reset();
+      batch->SetReader(r);
+   }
+   RDFInternal::RProfiler::SetCurrent(fProfiler.get(), slot);
+   RDFInternal::RBatch::SetCurrent(batch);
    for (auto &ptr : fBookedActions)
       ptr->InitSlot(r, slot);
    for (auto &ptr : fBookedFilters)
       ptr->InitSlot(r, slot);
+   RDFInternal::RBatch::SetCurrent(nullptr);
+   RDFInternal::RProfiler::SetCurrent(nullptr, 0u);
    for (auto &callback : fCallbacksOnce)
       callback(slot);
 }
@@ -491,6 +542,31 @@ void RLoopManager::InitNodes()
       range->InitNode();
    for (auto &ptr : fBookedActions)
       ptr->Initialize();
+   SetUpProfiling();
+}
+
+/// Register the profiles of the nodes that take part in the next event loop with its profiler, if a ProfileReport has
+/// been booked. Otherwise disable the profiling of the nodes, which might have been enabled for a previous event loop.
+void RLoopManager::SetUpProfiling()
+{
+   for (auto &ptr : fBookedActions)
+      ptr->SetUpProfiling(fProfiler.get());
+   for (auto &filter : fBookedFilters) {
+      auto &profile = filter->GetProfile();
+      if (fProfiler)
+         fProfiler->AddNode(ROOT::RDF::RNodeProfileInfo::EKind::kFilter,
+                            filter->HasName() ? filter->GetName() : "Filter", profile);
+      else
+         profile.SetEnabled(false);
+   }
+}
+
+/// Profile the next event loop, and return its profiler. The profiler is released at the end of the event loop.
+std::shared_ptr<RDFInternal::RProfiler> RLoopManager::EnableProfiling()
+{
+   if (!fProfiler)
+      fProfiler = std::make_shared<RDFInternal::RProfiler>(fNSlots);
+   return fProfiler;
 }
 
 /// Perform clean-up operations. To be called at the end of each event loop.
@@ -504,6 +580,7 @@ void RLoopManager::CleanUpNodes()
 
    fRunActions.insert(fRunActions.begin(), fBookedActions.begin(), fBookedActions.end());
    fBookedActions.clear();
+   fProfiler.reset();
 
    // reset children counts
    fNChildren = 0;
@@ -524,17 +601,24 @@ void RLoopManager::CleanUpTask(unsigned int slot)
       ptr->FinalizeSlot(slot);
    for (auto &ptr : fBookedFilters)
       ptr->ClearTask(slot);
+   if (fIsBatched)
+      fBatches[slot].Reset();
 }
 
 /// Add RDF nodes that require just-in-time compilation to the computation graph.
 /// This method also clears the contents of GetCodeToJit().
 void RLoopManager::Jit()
 {
-   const std::string code = std::move(GetCodeToJit());
-   if (code.empty())
+   // GetCodeToJit() is shared by all RLoopManagers: only touch it if there is something to jit, so that event loops
+   // started concurrently by RunGraphs (which jits everything beforehand) do not race on it
+   if (GetCodeToJit().empty())
       return;
+   const std::string code = std::move(GetCodeToJit());
 
+   const auto start = std::chrono::steady_clock::now();
    RDFInternal::InterpreterCalc(code, "RLoopManager::Run");
+   if (fProfiler)
+      fProfiler->AddJitTime(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
 }
 
 /// Trigger counting of number of children nodes for each node of the functional graph.
@@ -559,6 +643,12 @@ void RLoopManager::Run()
 
    Jit();
 
+   // snapshots, for instance, can only process the entries one at a time
+   fIsBatched = fBatchSize > 1 && std::all_of(fBookedActions.begin(), fBookedActions.end(),
+                                              [](RDFInternal::RActionBase *a) { return a->CanRunBatches(); });
+   if (fIsBatched)
+      fBatches.resize(fNSlots);
+
    InitNodes();
 
    switch (fLoopType) {
@@ -572,6 +662,9 @@ void RLoopManager::Run()
 
    CleanUpNodes();
 
+   // the expressions jitted for this event loop that are missing from the jit cache, if enabled, are added to it now
+   RDFInternal::CompilePendingJitCacheEntries();
+
    fNRuns++;
 }
 
@@ -640,6 +733,15 @@ void RLoopManager::ToJitExec(const std::string &code) const
    GetCodeToJit().append(code);
 }
 
+/// Set the number of entries that each slot processes at once in the next event loops, 1 to process the entries one
+/// at a time. See RInterface::SetBatchSize.
+void RLoopManager::SetBatchSize(unsigned int batchSize)
+{
+   if (batchSize == 0u)
+      throw std::invalid_argument("RDataFrame: the size of the batches of entries must be positive.");
+   fBatchSize = batchSize;
+}
+
 void RLoopManager::RegisterCallback(ULong64_t everyNEvents, std::function<void(unsigned int)> &&f)
 {
    if (everyNEvents == 0ull)
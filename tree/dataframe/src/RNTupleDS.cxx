@@ -19,6 +19,8 @@
 
 #include <TError.h>
 
+#include <algorithm>
+#include <stdexcept>
 #include <string>
 #include <vector>
 #include <typeinfo>
@@ -64,27 +66,58 @@ bool RNTupleDS::SetEntry(unsigned int slot, ULong64_t entryIndex)
 
 std::vector<std::pair<ULong64_t, ULong64_t>> RNTupleDS::GetEntryRanges()
 {
-   // TODO(jblomer): use cluster boundaries for the entry ranges
    std::vector<std::pair<ULong64_t, ULong64_t>> ranges;
    if (fHasSeenAllRanges) return ranges;
+   fHasSeenAllRanges = true;
 
-   auto nEntries = fReaders[0]->GetNEntries();
-   const auto chunkSize = nEntries / fNSlots;
-   const auto reminder = 1U == fNSlots ? 0 : nEntries % fNSlots;
-   auto start = 0UL;
-   auto end = 0UL;
-   for (auto i : ROOT::TSeqU(fNSlots)) {
-      start = end;
-      end += chunkSize;
-      ranges.emplace_back(start, end);
-      (void)i;
+   // Ranges consist of whole clusters so that no cluster is read and decompressed by more than one slot
+   const auto &desc = fReaders[0]->GetDescriptor();
+   std::vector<std::pair<ULong64_t, ULong64_t>> clusterRanges;
+   for (DescriptorId_t clusterId = 0; clusterId < desc.GetNClusters(); ++clusterId) {
+      if (fSkippedClusterIds.count(clusterId) > 0)
+         continue;
+      const auto &clusterDesc = desc.GetClusterDescriptor(clusterId);
+      const ULong64_t first = clusterDesc.GetFirstEntryIndex();
+      clusterRanges.emplace_back(first, first + clusterDesc.GetNEntries());
+   }
+   std::sort(clusterRanges.begin(), clusterRanges.end());
+
+   // Merge neighboring clusters into about kNRangesPerSlot ranges per slot for load balancing
+   const ULong64_t nEntries = fReaders[0]->GetNEntries();
+   const ULong64_t nTargetRanges = std::max(1U, fNSlots * kNRangesPerSlot);
+   const ULong64_t targetRangeSize = std::max(1ULL, nEntries / nTargetRanges);
+   for (const auto &clusterRange : clusterRanges) {
+      if (clusterRange.first == clusterRange.second)
+         continue;
+      if (ranges.empty() || (ranges.back().second != clusterRange.first) ||
+          (ranges.back().second - ranges.back().first >= targetRangeSize))
+      {
+         ranges.emplace_back(clusterRange);
+      } else {
+         ranges.back().second = clusterRange.second;
+      }
    }
-   ranges.back().second += reminder;
-   fHasSeenAllRanges = true;
    return ranges;
 }
 
 
+void RNTupleDS::SelectClusters(std::string_view colName, double min, double max)
+{
+   const auto &desc = fReaders[0]->GetDescriptor();
+   auto fieldId = desc.FindFieldId(colName);
+   if (fieldId == kInvalidDescriptorId)
+      throw std::runtime_error("RNTupleDS: cannot select clusters on column \"" + std::string(colName) +
+                               "\", which is not a field of the RNTuple.");
+
+   auto selectedIds = desc.SelectClusterIds(fieldId, min, max);
+   std::unordered_set<DescriptorId_t> selected(selectedIds.begin(), selectedIds.end());
+   for (DescriptorId_t clusterId = 0; clusterId < desc.GetNClusters(); ++clusterId) {
+      if (selected.count(clusterId) == 0)
+         fSkippedClusterIds.insert(clusterId);
+   }
+}
+
+
 std::string RNTupleDS::GetTypeName(std::string_view colName) const
 {
    const auto index = std::distance(
@@ -136,3 +169,19 @@ RDataFrame MakeNTupleDataFrame(std::string_view ntupleName, std::string_view fil
 
 } // ns Experimental
 } // ns ROOT
+
+namespace ROOT {
+namespace Internal {
+namespace RDF {
+
+std::shared_ptr<ROOT::Detail::RDF::RLoopManager> MakeNTupleLoopManager(std::string_view ntupleName,
+                                                                       std::string_view fileName)
+{
+   auto ntuple = ROOT::Experimental::RNTupleReader::Open(ntupleName, fileName);
+   return std::make_shared<ROOT::Detail::RDF::RLoopManager>(
+      std::make_unique<ROOT::Experimental::RNTupleDS>(std::move(ntuple)), ROOT::Detail::RDF::ColumnNames_t{});
+}
+
+} // ns RDF
+} // ns Internal
+} // ns ROOT
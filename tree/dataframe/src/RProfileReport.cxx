@@ -0,0 +1,73 @@
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/RDF/RProfileReport.hxx"
+#include "TString.h" // Printf
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+
+namespace ROOT {
+
+namespace RDF {
+
+std::string RNodeProfileInfo::GetKindName() const
+{
+   switch (fKind) {
+   case EKind::kFilter: return "Filter";
+   case EKind::kDefine: return "Define";
+   case EKind::kAction: return "Action";
+   case EKind::kColumnRead: return "Read";
+   }
+   return "";
+}
+
+ULong64_t RNodeProfileInfo::GetTotalCalls() const
+{
+   return std::accumulate(fCalls.begin(), fCalls.end(), 0ULL);
+}
+
+double RNodeProfileInfo::GetTotalTime() const
+{
+   return std::accumulate(fTimes.begin(), fTimes.end(), 0.);
+}
+
+void RProfileReport::Print()
+{
+   Printf("%-8s %-24s %-12s %-12s %s", "Kind", "Name", "Calls", "Time [s]", "Time/call [ns]");
+   for (auto &&ni : fNodes) {
+      const auto calls = ni.GetTotalCalls();
+      const auto time = ni.GetTotalTime();
+      const auto timePerCall = calls > 0 ? 1e9 * time / calls : 0.;
+      Printf("%-8s %-24s %-12llu %-12.6f %.1f", ni.GetKindName().c_str(), ni.GetName().c_str(), calls, time,
+             timePerCall);
+   }
+   Printf("Jit time: %.6f s", fJitTime);
+}
+
+const RNodeProfileInfo &RProfileReport::operator[](std::string_view nodeName)
+{
+   auto pred = [&nodeName](const RNodeProfileInfo &ni) { return ni.GetName() == nodeName; };
+   const auto niItEnd = fNodes.end();
+   const auto it = std::find_if(fNodes.begin(), niItEnd, pred);
+   if (niItEnd == it) {
+      std::string err = "Cannot find a node called \"";
+      err += nodeName;
+      err += "\". Available nodes are: \n";
+      for (auto &&ni : fNodes) {
+         err += " - " + ni.GetName() + " (" + ni.GetKindName() + ")\n";
+      }
+      throw std::runtime_error(err);
+   }
+   return *it;
+}
+
+} // End NS RDF
+
+} // End NS ROOT
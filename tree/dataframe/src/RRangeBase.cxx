@@ -20,6 +20,7 @@ RRangeBase::RRangeBase(RLoopManager *implPtr, unsigned int start, unsigned int s
 void RRangeBase::ResetCounters()
 {
    fLastCheckedEntry = -1;
+   fLastCheckedBatch = ROOT::Internal::RDF::RBatch::kInvalidId;
    fNProcessedEntries = 0;
    fHasStopped = false;
 }
@@ -8,6 +8,7 @@
 #include "gtest/gtest.h"
 
 #include <algorithm>
+#include <numeric>
 
 using namespace ROOT::RDF;
 using namespace ROOT::VecOps;
@@ -346,3 +347,58 @@ TEST(Cache, Alias)
    auto df4 = df3.Cache({"y"});
    EXPECT_EQ(df4.Sum("y").GetValue(), 3u);
 }
+
+TEST(Cache, MemoryBudget)
+{
+   const auto spillDir = "dataframe_cache_memorybudget";
+   gSystem->mkdir(spillDir);
+   auto countSpillFiles = [&spillDir] {
+      auto nFiles = 0u;
+      auto dir = gSystem->OpenDirectory(spillDir);
+      while (auto entry = gSystem->GetDirEntry(dir))
+         if (TString(entry).EndsWith(".root"))
+            ++nFiles;
+      gSystem->FreeDirectory(dir);
+      return nFiles;
+   };
+
+   {
+      ROOT::RDataFrame df(1000);
+      auto d = df.Define("x", [](ULong64_t e) { return double(e); }, {"rdfentry_"})
+                  .Define("v", [](ULong64_t e) { return RVec<int>(e % 10, int(e)); }, {"rdfentry_"});
+      // a small budget, so that most entries are spilled to disk
+      auto cached = d.Cache<double, RVec<int>>({"x", "v"}, RCacheOptions(1024, spillDir));
+      EXPECT_EQ(countSpillFiles(), 0u); // Cache is lazy
+
+      auto checkEntry = [](ULong64_t e, double x, const RVec<int> &v) {
+         EXPECT_EQ(double(e), x);
+         EXPECT_EQ(e % 10, v.size());
+         EXPECT_TRUE(All(v == int(e)));
+      };
+      cached.Foreach(checkEntry, {"rdfentry_", "x", "v"});
+      EXPECT_EQ(countSpillFiles(), 1u);
+
+      // the spilled entries can be read back any number of times
+      EXPECT_DOUBLE_EQ(*cached.Sum<double>("x"), 499500.);
+      EXPECT_EQ(*cached.Count(), 1000ull);
+
+      // jitted
+      auto cachedj = d.Cache({"x"}, RCacheOptions(1024, spillDir));
+      EXPECT_DOUBLE_EQ(*cachedj.Sum<double>("x"), 499500.);
+      EXPECT_EQ(countSpillFiles(), 2u);
+   }
+
+   // spill files are removed together with the cached dataset
+   EXPECT_EQ(countSpillFiles(), 0u);
+   gSystem->Unlink(spillDir);
+}
+
+TEST(Cache, MemoryBudgetFitsInMemory)
+{
+   ROOT::RDataFrame df(100);
+   auto cached = df.Define("x", [](ULong64_t e) { return int(e); }, {"rdfentry_"})
+                    .Cache<int>({"x"}, RCacheOptions(1ull << 30));
+   std::vector<int> expected(100);
+   std::iota(expected.begin(), expected.end(), 0);
+   EXPECT_EQ(*cached.Take<int>("x"), expected);
+}
@@ -2,9 +2,12 @@
 #include <ROOT/RDFHelpers.hxx>
 #include <ROOT/RVec.hxx>
 #include <TSystem.h>
+#include "ROOTUnitTestSupport.h"
 
 #include <algorithm>
 #include <deque>
+#include <map>
+#include <string>
 #include <vector>
 
 #include "gtest/gtest.h"
@@ -275,3 +278,127 @@ TEST(RDFHelpers, SaveGraphToFile)
 
    gSystem->Unlink(outFileName);
 }
+
+void RunGraphsTest()
+{
+   std::vector<ROOT::RDataFrame> dfs;
+   for (auto i = 0u; i < 4u; ++i)
+      dfs.emplace_back(10 * (i + 1));
+
+   std::vector<RResultPtr<ULong64_t>> counts;
+   std::vector<RResultHandle> handles;
+   for (auto &df : dfs) {
+      counts.emplace_back(df.Count());
+      auto sum = df.Define("x", [](ULong64_t e) { return double(e); }, {"rdfentry_"}).Sum<double>("x");
+      handles.emplace_back(counts.back());
+      handles.emplace_back(sum);
+   }
+
+   // one event loop per computation graph, even if several handles belong to the same graph
+   EXPECT_EQ(4u, RunGraphs(handles));
+   for (auto i = 0u; i < 4u; ++i) {
+      EXPECT_EQ(1u, dfs[i].GetNRuns());
+      EXPECT_TRUE(handles[2 * i].IsReady());
+      EXPECT_EQ(10u * (i + 1), *counts[i]);
+      const auto n = 10. * (i + 1);
+      EXPECT_DOUBLE_EQ(n * (n - 1) / 2., handles[2 * i + 1].GetValue<double>());
+   }
+
+   // results are already available, nothing to run
+   EXPECT_EQ(0u, RunGraphs(handles));
+   EXPECT_THROW(handles[0].GetValue<double>(), std::runtime_error);
+}
+
+TEST(RDFHelpers, RunGraphs)
+{
+   RunGraphsTest();
+}
+
+#ifdef R__USE_IMT
+TEST(RDFHelpers, RunGraphsMT)
+{
+   ROOT::EnableImplicitMT(4);
+   RunGraphsTest();
+   ROOT::DisableImplicitMT();
+}
+#endif
+
+// Return the names of the files in the given directory, without "." and ".."
+std::vector<std::string> GetFileNames(const std::string &dirName)
+{
+   std::vector<std::string> fileNames;
+   auto dir = gSystem->OpenDirectory(dirName.c_str());
+   if (!dir)
+      return fileNames;
+   while (const char *entry = gSystem->GetDirEntry(dir)) {
+      const std::string fileName(entry);
+      if (fileName != "." && fileName != "..")
+         fileNames.emplace_back(fileName);
+   }
+   gSystem->FreeDirectory(dir);
+   return fileNames;
+}
+
+bool EndsWith(const std::string &str, const std::string &suffix)
+{
+   return str.size() > suffix.size() && str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+TEST(RDFHelpers, JitCache)
+{
+   const std::string cacheDir = "rdfjitcache_test";
+   const auto removeCacheDir = [&cacheDir] {
+      for (const auto &fileName : GetFileNames(cacheDir))
+         gSystem->Unlink((cacheDir + "/" + fileName).c_str());
+      gSystem->Unlink(cacheDir.c_str());
+   };
+   removeCacheDir();
+   ROOT::RDF::Experimental::SetJitCacheDir(cacheDir);
+   EXPECT_EQ(cacheDir, ROOT::RDF::Experimental::GetJitCacheDir());
+
+   auto df = ROOT::RDataFrame(10).Define("x", "double(rdfentry_)").Filter("x > 4.5");
+   auto sum = df.Sum<double>("x");
+   EXPECT_DOUBLE_EQ(35., *sum);
+
+   // the compiled expressions are now in the cache directory; the by-products of the compilation are removed
+   const std::string soExt = std::string(".") + gSystem->GetSoExt();
+   std::map<std::string, Long_t> libInodes;
+   for (const auto &fileName : GetFileNames(cacheDir)) {
+      if (EndsWith(fileName, soExt)) {
+         FileStat_t stat;
+         ASSERT_EQ(0, gSystem->GetPathInfo((cacheDir + "/" + fileName).c_str(), stat));
+         libInodes[fileName] = stat.fIno;
+      } else {
+         EXPECT_TRUE(EndsWith(fileName, "_rdict.pcm")) << "unexpected file in the jit cache: " << fileName;
+      }
+   }
+   EXPECT_EQ(2u, libInodes.size());
+
+   // setting the directory again drops the entries known to this process, so the expressions are booked from the
+   // libraries on disk rather than compiled again
+   ROOT::RDF::Experimental::SetJitCacheDir(cacheDir);
+   auto sum2 = ROOT::RDataFrame(10).Define("x", "double(rdfentry_)").Filter("x > 4.5").Sum<double>("x");
+   EXPECT_DOUBLE_EQ(35., *sum2);
+   for (const auto &lib : libInodes) {
+      FileStat_t stat;
+      ASSERT_EQ(0, gSystem->GetPathInfo((cacheDir + "/" + lib.first).c_str(), stat));
+      EXPECT_EQ(lib.second, stat.fIno) << lib.first << " was compiled again";
+   }
+
+   // libraries that other users could modify are not loaded, the interpreter is used instead
+   EXPECT_EQ(5ull, *ROOT::RDataFrame(10).Filter("rdfentry_ % 2 == 0").Count());
+   std::string filterLib;
+   for (const auto &fileName : GetFileNames(cacheDir))
+      if (EndsWith(fileName, soExt) && libInodes.count(fileName) == 0)
+         filterLib = cacheDir + "/" + fileName;
+   ASSERT_FALSE(filterLib.empty());
+   gSystem->Chmod(filterLib.c_str(), 0666);
+   ROOT::RDF::Experimental::SetJitCacheDir(cacheDir);
+   ROOT_EXPECT_WARNING(auto count = ROOT::RDataFrame(10).Filter("rdfentry_ % 2 == 0").Count();
+                       EXPECT_EQ(5ull, *count), "RDataFrame::Jit",
+                       "Not loading " + filterLib + ": jit cache libraries must belong to the current user and must "
+                       "not be writable by others. Using the interpreter.");
+
+   ROOT::RDF::Experimental::SetJitCacheDir("");
+   removeCacheDir();
+}
@@ -1,5 +1,7 @@
 #include "TRandom.h"
+#include "TTree.h"
 #include "ROOT/RDataFrame.hxx"
+#include "ROOT/RDFHelpers.hxx"
 #include "ROOT/TSeq.hxx"
 #include "gtest/gtest.h"
 
@@ -97,3 +99,108 @@ TEST(RDataFrameReport, ActionLazyness)
    EXPECT_TRUE(hasRun);
 
 }
+
+TEST(RDataFrameProfileReport, CallsPerNode)
+{
+   ROOT::RDataFrame d(16);
+   auto sum = d.Define("x", [](ULong64_t e) { return double(e); }, {"rdfentry_"})
+                 .Filter([](double x) { return int(x) % 2 == 0; }, {"x"}, "even")
+                 .Sum<double>("x");
+   auto profile = d.ProfileReport();
+   EXPECT_DOUBLE_EQ(*sum, 56.);
+
+   using EKind = ROOT::RDF::RNodeProfileInfo::EKind;
+   auto &rep = *profile;
+   EXPECT_EQ(rep["even"].GetKind(), EKind::kFilter);
+   EXPECT_EQ(rep["even"].GetTotalCalls(), 16ull);
+   EXPECT_EQ(rep["x"].GetKind(), EKind::kDefine);
+   EXPECT_EQ(rep["x"].GetTotalCalls(), 16ull);
+   EXPECT_EQ(rep["Sum"].GetKind(), EKind::kAction);
+   EXPECT_EQ(rep["Sum"].GetTotalCalls(), 8ull);
+   for (auto &&node : rep) {
+      EXPECT_GE(node.GetTotalTime(), 0.);
+      EXPECT_EQ(node.GetNSlots(), d.GetNSlots());
+   }
+   EXPECT_ANY_THROW(rep["NonExisting"]) << "No exception thrown when trying to get a non-existing node.\n";
+
+   testing::internal::CaptureStdout();
+   rep.Print();
+   std::string output = testing::internal::GetCapturedStdout();
+   EXPECT_NE(output.find("even"), std::string::npos);
+   EXPECT_NE(output.find("Jit time"), std::string::npos);
+
+   // profiled nodes are annotated in the graph
+   const auto graph = ROOT::RDF::SaveGraph(d);
+   EXPECT_NE(graph.find("16 calls"), std::string::npos);
+   EXPECT_NE(graph.find("8 calls"), std::string::npos);
+}
+
+TEST(RDataFrameProfileReport, ColumnReads)
+{
+   TTree t("t", "t");
+   int i = 0;
+   t.Branch("i", &i);
+   for (i = 0; i < 10; ++i)
+      t.Fill();
+
+   ROOT::RDataFrame d(t);
+   auto sum = d.Sum<int>("i");
+   auto profile = d.ProfileReport();
+   EXPECT_EQ(*sum, 45);
+   EXPECT_EQ((*profile)["i"].GetKind(), ROOT::RDF::RNodeProfileInfo::EKind::kColumnRead);
+   EXPECT_EQ((*profile)["i"].GetTotalCalls(), 10ull);
+}
+
+TEST(RDataFrameProfileReport, ColumnReadsInBatches)
+{
+   TTree t("t", "t");
+   int i = 0, j = 0;
+   t.Branch("i", &i);
+   t.Branch("j", &j);
+   for (i = 0; i < 10; ++i) {
+      j = 2 * i;
+      t.Fill();
+   }
+
+   // columns are only read for the entries that pass the upstream filters
+   ROOT::RDataFrame d(t);
+   d.SetBatchSize(4);
+   auto even = d.Filter([](int x) { return x % 2 == 0; }, {"i"});
+   auto sum = even.Sum<int>("j");
+   auto none = even.Filter([](int x) { return x < 0; }, {"i"}).Sum<int>("j");
+   auto profile = d.ProfileReport();
+   EXPECT_EQ(*sum, 40);
+   EXPECT_EQ(*none, 0);
+   EXPECT_EQ((*profile)["i"].GetTotalCalls(), 15ull);
+   EXPECT_EQ((*profile)["j"].GetTotalCalls(), 5ull);
+}
+
+TEST(RDataFrameProfileReport, JittedNodes)
+{
+   ROOT::RDataFrame d(4);
+   auto c = d.Define("y", "rdfentry_ * 2").Filter("y > 2", "jitted").Count();
+   auto profile = d.ProfileReport();
+   EXPECT_EQ(*c, 2ull);
+   EXPECT_EQ((*profile)["jitted"].GetTotalCalls(), 4ull);
+   EXPECT_EQ((*profile)["y"].GetTotalCalls(), 4ull);
+   EXPECT_GT(profile->GetJitTime(), 0.);
+}
+
+TEST(RDataFrameProfileReport, OnlyProfiledLoops)
+{
+   ROOT::RDataFrame d(4);
+   auto dd = d.Define("x", [] { return 1; });
+   auto profile = dd.ProfileReport();
+   auto c1 = dd.Filter([](int x) { return x > 0; }, {"x"}, "f").Count();
+   EXPECT_EQ(*c1, 4ull);
+   EXPECT_EQ((*profile)["f"].GetTotalCalls(), 4ull);
+
+   // the next event loop is not profiled: the counters of the previous one are kept
+   auto c2 = dd.Filter([](int x) { return x > 0; }, {"x"}, "g").Count();
+   EXPECT_EQ(*c2, 4ull);
+   EXPECT_EQ((*profile)["f"].GetTotalCalls(), 4ull);
+   EXPECT_ANY_THROW((*profile)["g"]);
+   const auto graph = ROOT::RDF::SaveGraph(d);
+   EXPECT_NE(graph.find("label=\"g\""), std::string::npos);
+   EXPECT_NE(graph.find("f\n4 calls"), std::string::npos);
+}
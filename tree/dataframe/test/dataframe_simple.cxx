@@ -15,6 +15,8 @@
 #include <algorithm> // std::sort
 #include <array>
 #include <chrono>
+#include <mutex>
+#include <numeric>
 #include <thread>
 #include <set>
 #include <random>
@@ -522,6 +524,106 @@ TEST_P(RDFSimpleTests, Reduce)
    EXPECT_EQ(*r3, true);
 }
 
+TEST_P(RDFSimpleTests, ForeachBatch)
+{
+   const auto nEntries = 1000u;
+   RDataFrame df(nEntries);
+   df.SetBatchSize(64);
+   auto d = df.Define("x", [](ULong64_t e) { return double(e); }, {"rdfentry_"})
+               .Define("v", [](double x) { return RVec<int>(int(x) % 3, 1); }, {"x"});
+   auto filtered = d.Filter([](double x) { return x >= 100; }, {"x"});
+
+   std::vector<double> sums(NSLOTS, 0.);
+   std::vector<ULong64_t> counts(NSLOTS, 0ull);
+   std::vector<std::size_t> maxBatchSizes(NSLOTS, 0u);
+   filtered.ForeachBatchSlot(
+      [&](unsigned int slot, const RVec<double> &x, const RVec<RVec<int>> &v) {
+         EXPECT_EQ(x.size(), v.size());
+         for (auto i : ROOT::TSeqU(x.size()))
+            EXPECT_EQ(v[i].size(), std::size_t(int(x[i]) % 3));
+         sums[slot] += Sum(x);
+         counts[slot] += x.size();
+         maxBatchSizes[slot] = std::max(maxBatchSizes[slot], x.size());
+      },
+      {"x", "v"});
+   // only entries that pass the filter are in the batches
+   EXPECT_EQ(std::accumulate(counts.begin(), counts.end(), 0ull), nEntries - 100);
+   EXPECT_DOUBLE_EQ(std::accumulate(sums.begin(), sums.end(), 0.), (nEntries * (nEntries - 1) - 100 * 99) / 2.);
+   EXPECT_EQ(*std::max_element(maxBatchSizes.begin(), maxBatchSizes.end()), 64u);
+
+   ULong64_t count = 0ull;
+   std::mutex m;
+   filtered.ForeachBatch(
+      [&](const RVec<double> &x) {
+         std::lock_guard<std::mutex> lock(m);
+         count += x.size();
+      },
+      {"x"});
+   EXPECT_EQ(count, nEntries - 100);
+
+   // if the event loop is not batched, the entries are passed one at a time
+   count = 0ull;
+   RDataFrame unbatched(10);
+   unbatched.Define("x", [] { return 1.; }).ForeachBatch(
+      [&](const RVec<double> &x) {
+         std::lock_guard<std::mutex> lock(m);
+         EXPECT_EQ(x.size(), 1u);
+         count += x.size();
+      },
+      {"x"});
+   EXPECT_EQ(count, 10ull);
+
+   EXPECT_THROW(df.SetBatchSize(0), std::invalid_argument);
+}
+
+TEST_P(RDFSimpleTests, BatchedEventLoop)
+{
+   const auto fileName = "dataframe_simple_batches.root";
+   const auto treeName = "t";
+   FillTree(fileName, treeName, 1000);
+
+   // the results must not depend on the size of the batches
+   auto run = [&](unsigned int batchSize) {
+      RDataFrame df(treeName, fileName);
+      df.SetBatchSize(batchSize);
+      auto even = df.Define("even", [](double b1) { return int(b1) % 2 == 0; }, {"b1"});
+      auto sel = even.Filter([](bool e) { return e; }, {"even"}, "even");
+      auto sumB1 = sel.Sum<double>("b1");
+      auto sizeB4 = sel.Define("s", [](const RVec<int> &b4) { return b4.size(); }, {"b4"}).Sum<std::size_t>("s");
+      auto count = sel.Filter([](double b1) { return b1 > 500; }, {"b1"}).Count();
+      auto hist = even.Histo1D<double>({"h", "h", 10, 0, 1000}, "b1");
+      auto report = df.Report();
+      std::vector<double> values{*sumB1, double(*sizeB4), double(*count), hist->GetMean(), hist->GetEntries()};
+      for (auto &&cut : *report)
+         values.emplace_back(cut.GetPass());
+      EXPECT_EQ(df.GetNRuns(), 1u);
+      return values;
+   };
+   const auto expected = run(1u);
+   const std::vector<double> values{249500., 500., 249., 499.5, 1000., 500.};
+   EXPECT_EQ(expected, values);
+   EXPECT_EQ(run(64u), expected);
+   EXPECT_EQ(run(5000u), expected);
+
+   // ranges select the same entries in batched mode
+   if (!GetParam()) {
+      auto runRange = [&](unsigned int batchSize) {
+         RDataFrame df(treeName, fileName);
+         df.SetBatchSize(batchSize);
+         auto ranged = df.Range(10, 200, 3);
+         auto count = ranged.Count();
+         auto sum = ranged.Sum<double>("b1");
+         return std::make_pair(*count, *sum);
+      };
+      const auto rangeExpected = runRange(1u);
+      EXPECT_EQ(rangeExpected.first, 63ull);
+      EXPECT_DOUBLE_EQ(rangeExpected.second, 6552.);
+      EXPECT_EQ(runRange(64u), rangeExpected);
+   }
+
+   gSystem->Unlink(fileName);
+}
+
 TEST_P(RDFSimpleTests, Aggregate)
 {
    auto d = RDataFrame(5).DefineSlotEntry("x", [](unsigned int, ULong64_t e) { return static_cast<int>(e) + 1; });
@@ -1,12 +1,15 @@
 #include "ROOTUnitTestSupport.h"
 #include "ROOT/RDataFrame.hxx"
 #include "ROOT/TSeq.hxx"
+#include "TBranch.h"
+#include "TChain.h"
 #include "TFile.h"
 #include "TROOT.h"
 #include "TSystem.h"
 #include <TInterpreter.h>
 #include "TTree.h"
 #include "gtest/gtest.h"
+#include <algorithm>
 #include <limits>
 #include <memory>
 using namespace ROOT;         // RDataFrame
@@ -731,6 +734,207 @@ TEST(RDFSnapshotMore, CompositeTypeWithNameClash)
    gSystem->Unlink(fname);
 }
 
+TEST(RDFSnapshotMore, CloneBaskets)
+{
+   const auto treename = "t";
+   const auto fname = "snap_clonebaskets.root";
+   const auto outfname = "out_snap_clonebaskets.root";
+   {
+      TFile f(fname, "RECREATE");
+      TTree t(treename, treename);
+      double x;
+      int n;
+      float arr[4];
+      // small baskets, so that copied and re-written branches have a different number of baskets
+      t.Branch("x", &x, "x/D", 256);
+      t.Branch("n", &n, "n/I", 256);
+      t.Branch("arr", arr, "arr[n]/F", 256);
+      t.SetAutoFlush(250);
+      for (auto i : ROOT::TSeqI(1000)) {
+         x = i;
+         n = i % 4;
+         for (auto j : ROOT::TSeqI(n))
+            arr[j] = i + j;
+         t.Fill();
+      }
+      t.Write();
+   }
+
+   auto nBaskets = [&](const char *fileName, const char *branchName) {
+      TFile f(fileName);
+      return f.Get<TTree>(treename)->GetBranch(branchName)->GetWriteBasket();
+   };
+
+   RDataFrame df(treename, fname);
+   auto out = df.Define("y", [](double x) { return 2 * x; }, {"x"})
+                 .Snapshot<double, int, RVec<float>, double>(treename, outfname, {"x", "n", "arr", "y"});
+   // the baskets of the unchanged branches are copied as they are
+   EXPECT_EQ(nBaskets(outfname, "x"), nBaskets(fname, "x"));
+   EXPECT_EQ(nBaskets(outfname, "arr"), nBaskets(fname, "arr"));
+   {
+      TFile f(outfname);
+      auto t = f.Get<TTree>(treename);
+      // the re-written branch follows the clusters of the input tree
+      auto y = t->GetBranch("y");
+      const auto basketEntries = y->GetBasketEntry();
+      for (Long64_t clusterStart : {250, 500, 750}) {
+         EXPECT_NE(basketEntries + y->GetWriteBasket(),
+                   std::find(basketEntries, basketEntries + y->GetWriteBasket(), clusterStart))
+            << "no basket of y starts at entry " << clusterStart;
+      }
+      // the totals of the tree account for the copied and the re-written baskets
+      Long64_t zipBytes = 0;
+      for (auto branch : TRangeDynCast<TBranch>(t->GetListOfBranches()))
+         zipBytes += branch->GetZipBytes();
+      EXPECT_EQ(zipBytes, t->GetZipBytes());
+   }
+   auto check = [](ULong64_t e, double x, int n, const RVec<float> &arr, double y) {
+      EXPECT_EQ(x, e);
+      EXPECT_EQ(y, 2 * e);
+      EXPECT_EQ(n, int(e % 4));
+      EXPECT_EQ(arr.size(), e % 4);
+      for (auto j : ROOT::TSeqU(arr.size()))
+         EXPECT_EQ(arr[j], e + j);
+   };
+   out->Foreach(check, {"rdfentry_", "x", "n", "arr", "y"});
+   EXPECT_EQ(*out->Count(), 1000ull);
+
+   // with a Filter, all columns are re-written
+   auto outFiltered = df.Filter([](double x) { return x < 500; }, {"x"}).Snapshot<double>(treename, outfname, {"x"});
+   EXPECT_EQ(*outFiltered->Count(), 500ull);
+   EXPECT_DOUBLE_EQ(*outFiltered->Max<double>("x"), 499.);
+
+   // copying baskets can be switched off
+   RSnapshotOptions opts;
+   opts.fCloneBaskets = false;
+   df.Snapshot<double>(treename, outfname, {"x"}, opts);
+   EXPECT_NE(nBaskets(outfname, "x"), nBaskets(fname, "x"));
+
+   gSystem->Unlink(fname);
+   gSystem->Unlink(outfname);
+}
+
+TEST(RDFSnapshotMore, CloneBasketsChain)
+{
+   const auto treename = "t";
+   const auto outfname = "out_snap_clonebasketschain.root";
+   const std::vector<std::string> fnames{"snap_clonebasketschain1.root", "snap_clonebasketschain2.root",
+                                         "snap_clonebasketschain3.root"};
+   // the second file does not have the output compression settings: its entries are read and re-written
+   const RSnapshotOptions defaultOpts;
+   const auto outCompression =
+      ROOT::CompressionSettings(defaultOpts.fCompressionAlgorithm, defaultOpts.fCompressionLevel);
+   const std::vector<int> compressions{outCompression, outCompression + 1, outCompression};
+   for (auto f : ROOT::TSeqU(fnames.size())) {
+      TFile file(fnames[f].c_str(), "RECREATE", "", compressions[f]);
+      TTree t(treename, treename);
+      double x;
+      t.Branch("x", &x, "x/D", 256);
+      t.SetAutoFlush(100);
+      for (auto i : ROOT::TSeqI(300)) {
+         x = 300 * f + i;
+         t.Fill();
+      }
+      t.Write();
+   }
+
+   TChain chain(treename);
+   for (const auto &fname : fnames)
+      chain.Add(fname.c_str());
+   auto out = RDataFrame(chain)
+                 .Define("y", [](double x) { return 2 * x; }, {"x"})
+                 .Snapshot<double, double>(treename, outfname, {"x", "y"});
+   EXPECT_EQ(*out->Count(), 900ull);
+   out->Foreach(
+      [](ULong64_t e, double x, double y) {
+         EXPECT_EQ(x, e);
+         EXPECT_EQ(y, 2 * e);
+      },
+      {"rdfentry_", "x", "y"});
+
+   // the baskets of the first and the last file are copied as they are
+   auto basketEntries = [&](const std::string &fileName, Long64_t offset) {
+      TFile file(fileName.c_str());
+      auto x = file.Get<TTree>(treename)->GetBranch("x");
+      std::vector<Long64_t> entries;
+      for (auto b : ROOT::TSeqI(x->GetWriteBasket()))
+         if (x->GetBasketEntry()[b] >= offset && x->GetBasketEntry()[b] < offset + 300)
+            entries.emplace_back(x->GetBasketEntry()[b] - offset);
+      return entries;
+   };
+   EXPECT_EQ(basketEntries(fnames[0], 0), basketEntries(outfname, 0));
+   EXPECT_EQ(basketEntries(fnames[2], 0), basketEntries(outfname, 600));
+
+   for (const auto &fname : fnames)
+      gSystem->Unlink(fname.c_str());
+   gSystem->Unlink(outfname);
+}
+
+#ifdef R__HAS_ROOT7
+void WriteAndReadRNTuple(const char *fname)
+{
+   RSnapshotOptions opts;
+   opts.fOutputFormat = ESnapshotOutputFormat::kRNTuple;
+   auto out = RDataFrame(1000)
+                 .Define("x", [](ULong64_t e) { return double(e); }, {"rdfentry_"})
+                 .Define("n", [](double x) { return int(x) % 4; }, {"x"})
+                 .Define("v", [](double x, int n) { return RVec<float>(n, x); }, {"x", "n"})
+                 .Snapshot<double, int, RVec<float>>("ntuple", fname, {"x", "n", "v"}, opts);
+
+   auto check = [](double x, int n, const RVec<float> &v) {
+      EXPECT_EQ(n, int(x) % 4);
+      EXPECT_EQ(v.size(), std::size_t(n));
+      for (auto e : v)
+         EXPECT_EQ(e, x);
+   };
+   out->Foreach(check, {"x", "n", "v"});
+   EXPECT_EQ(*out->Count(), 1000ull);
+   // entries might be written out of order by different slots, but all of them are there
+   EXPECT_DOUBLE_EQ(*out->Sum<double>("x"), 999. * 1000. / 2.);
+
+   // only RECREATE is supported
+   opts.fMode = "UPDATE";
+   EXPECT_THROW(RDataFrame(1).Define("x", [] { return 1.; }).Snapshot<double>("ntuple", fname, {"x"}, opts),
+                std::invalid_argument);
+
+   gSystem->Unlink(fname);
+}
+
+TEST(RDFSnapshotMore, RNTuple)
+{
+   WriteAndReadRNTuple("snap_rntuple.root");
+}
+
+TEST(RDFSnapshotMore, RNTupleROOTTypedefs)
+{
+   const auto fname = "snap_rntuple_typedefs.root";
+   RSnapshotOptions opts;
+   opts.fOutputFormat = ESnapshotOutputFormat::kRNTuple;
+   // ULong64_t columns, like rdfentry_, are stored as std::uint64_t fields
+   auto out = RDataFrame(10)
+                 .Define("entry", [](ULong64_t e) { return e; }, {"rdfentry_"})
+                 .Define("entries", [](ULong64_t e) { return RVec<ULong64_t>(e % 3, e); }, {"rdfentry_"})
+                 .Snapshot<ULong64_t, RVec<ULong64_t>>("ntuple", fname, {"entry", "entries"}, opts);
+   auto check = [](std::uint64_t entry, const RVec<std::uint64_t> &entries) {
+      EXPECT_EQ(entries.size(), entry % 3);
+      for (auto e : entries)
+         EXPECT_EQ(e, entry);
+   };
+   out->Foreach(check, {"entry", "entries"});
+   EXPECT_EQ(*out->Sum<std::uint64_t>("entry"), 45ull);
+
+   // there is no RField for Long64_t, the error names the column
+   try {
+      RDataFrame(1).Define("l", [] { return Long64_t(1); }).Snapshot<Long64_t>("ntuple", fname, {"l"}, opts);
+      FAIL() << "Long64_t columns should not be writable to an RNTuple";
+   } catch (const std::runtime_error &err) {
+      EXPECT_NE(std::string(err.what()).find("\"l\" (Long64_t)"), std::string::npos) << err.what();
+   }
+
+   gSystem->Unlink(fname);
+}
+#endif // R__HAS_ROOT7
+
 /********* MULTI THREAD TESTS ***********/
 #ifdef R__USE_IMT
 TEST_F(RDFSnapshotMT, Snapshot_update_diff_treename)
@@ -989,5 +1193,13 @@ TEST(RDFSnapshotMore, TClonesArrayMT)
    ReadWriteTClonesArray();
 }
 
+#ifdef R__HAS_ROOT7
+TEST(RDFSnapshotMore, RNTupleMT)
+{
+   TIMTEnabler _(4);
+   WriteAndReadRNTuple("snap_rntuple_mt.root");
+}
+#endif // R__HAS_ROOT7
+
 #endif // R__USE_IMT
 
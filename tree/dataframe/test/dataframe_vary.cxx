@@ -0,0 +1,103 @@
+#include "ROOT/RDataFrame.hxx"
+#include "ROOT/RVec.hxx"
+#include "TH1D.h"
+
+#include "gtest/gtest.h"
+
+#include <stdexcept>
+
+using ROOT::RDataFrame;
+using ROOT::RDF::Experimental::VariationsFor;
+using ROOT::VecOps::RVec;
+
+// 10 entries, with x = 0, 1, ..., 9
+class RDFVary : public ::testing::Test {
+protected:
+   RDFVary() : fRDF(10) {}
+   ROOT::RDF::RNode GetRDF()
+   {
+      return fRDF.Define("x", [](ULong64_t e) { return double(e); }, {"rdfentry_"});
+   }
+
+private:
+   RDataFrame fRDF;
+};
+
+auto shiftX = [](double x) { return RVec<double>{x - 1., x + 1.}; };
+
+TEST_F(RDFVary, Sum)
+{
+   auto sum = GetRDF().Vary("x", shiftX, {"x"}, {"down", "up"}).Sum<double>("x");
+   auto sums = VariationsFor(sum);
+   EXPECT_EQ(3u, sums.size());
+   EXPECT_DOUBLE_EQ(45., *sums["nominal"]);
+   EXPECT_DOUBLE_EQ(35., *sums["x:down"]);
+   EXPECT_DOUBLE_EQ(55., *sums["x:up"]);
+   EXPECT_DOUBLE_EQ(45., *sum);
+}
+
+TEST_F(RDFVary, DefineAndFilter)
+{
+   auto df = GetRDF();
+   auto count = df.Vary("x", shiftX, {"x"}, {"down", "up"}, "shift")
+                   .Define("y", [](double x) { return 2. * x; }, {"x"})
+                   .Filter([](double y) { return y > 10.; }, {"y"})
+                   .Count();
+   auto counts = VariationsFor(count);
+   EXPECT_EQ(3u, counts.size());
+   EXPECT_EQ(4u, *counts["nominal"]);
+   EXPECT_EQ(3u, *counts["shift:down"]);
+   EXPECT_EQ(5u, *counts["shift:up"]);
+   // all variations are computed in the same event loop
+   EXPECT_EQ(1u, df.GetNRuns());
+}
+
+TEST_F(RDFVary, JittedFilterAndRange)
+{
+   auto df = GetRDF().Vary("x", shiftX, {"x"}, 2);
+   auto entries = df.Filter("x > 5").Range(2).Take<ULong64_t>("rdfentry_");
+   auto variedEntries = VariationsFor(entries);
+   EXPECT_EQ(std::vector<ULong64_t>({6u, 7u}), *variedEntries["nominal"]);
+   EXPECT_EQ(std::vector<ULong64_t>({7u, 8u}), *variedEntries["x:0"]);
+   EXPECT_EQ(std::vector<ULong64_t>({5u, 6u}), *variedEntries["x:1"]);
+}
+
+TEST_F(RDFVary, Histo1D)
+{
+   auto h = GetRDF().Vary("x", shiftX, {"x"}, {"down", "up"}).Histo1D<double>({"h", "h", 20, -5., 15.}, "x");
+   auto hs = VariationsFor(h);
+   EXPECT_DOUBLE_EQ(4.5, hs["nominal"]->GetMean());
+   EXPECT_DOUBLE_EQ(3.5, hs["x:down"]->GetMean());
+   EXPECT_DOUBLE_EQ(5.5, hs["x:up"]->GetMean());
+   EXPECT_EQ(20, hs["x:up"]->GetNbinsX());
+   EXPECT_EQ(10, hs["x:up"]->GetEntries());
+}
+
+TEST_F(RDFVary, UnaffectedResult)
+{
+   auto df = GetRDF().Vary("x", shiftX, {"x"}, {"down", "up"});
+   auto count = df.Count();
+   auto entries = df.Take<ULong64_t>("rdfentry_");
+   EXPECT_EQ(1u, VariationsFor(count).size());
+   EXPECT_EQ(1u, VariationsFor(entries).size());
+
+   // variations registered downstream of the action inputs do not affect them
+   auto sum = GetRDF().Sum<double>("x");
+   EXPECT_EQ(1u, VariationsFor(sum).size());
+}
+
+TEST_F(RDFVary, Errors)
+{
+   auto df = GetRDF().Vary("x", shiftX, {"x"}, {"down", "up"});
+   EXPECT_THROW(df.Vary("x", shiftX, {"x"}, {"a", "b"}), std::runtime_error);
+   EXPECT_THROW(df.Vary("x", shiftX, {"x"}, std::vector<std::string>{}, "noTags"), std::runtime_error);
+   EXPECT_THROW(df.Vary("doesNotExist", shiftX, {"x"}, {"a", "b"}), std::runtime_error);
+
+   auto sum = df.Sum<double>("x");
+   sum.GetValue();
+   EXPECT_THROW(VariationsFor(sum), std::runtime_error);
+
+   auto wrongSize = GetRDF().Vary("x", shiftX, {"x"}, {"a", "b", "c"}).Sum<double>("x");
+   auto wrongSizes = VariationsFor(wrongSize);
+   EXPECT_THROW(*wrongSizes["x:a"], std::runtime_error);
+}
@@ -2,10 +2,14 @@
 #include <ROOT/RCsvDS.hxx>
 #include <ROOT/TSeq.hxx>
 #include <TROOT.h>
+#include <TSystem.h>
 
 #include <gtest/gtest.h>
 
+#include <fstream>
 #include <iostream>
+#include <limits>
+#include <stdexcept>
 
 using namespace ROOT::RDF;
 
@@ -182,6 +186,68 @@ TEST(RCsvDS, ProgressiveReadingRDF)
    EXPECT_EQ(6U, *c2);
 }
 
+// Large enough to be split in several chunks when memory-mapped
+void WriteLargeCsv(const char *fname, unsigned int nLines)
+{
+   std::ofstream f(fname);
+   f << "i,x,name,even\n";
+   for (auto i : ROOT::TSeqU(nLines)) {
+      f << i << ',' << i << ".5,\"name, " << i << "\"," << (i % 2 == 0 ? "true" : "false") << '\n';
+      if (i % 1000 == 0)
+         f << '\n'; // empty lines are skipped
+   }
+}
+
+void CheckLargeCsv(const char *fname, unsigned int nLines)
+{
+   auto df = ROOT::RDF::MakeCsvDataFrame(fname);
+   auto is = df.Take<Long64_t>("i");
+   auto sumX = df.Sum<double>("x");
+   auto nEven = df.Filter([](bool even) { return even; }, {"even"}).Count();
+   auto nWrongNames = df.Filter([](Long64_t i, const std::string &name) { return name != "name, " + std::to_string(i); },
+                                {"i", "name"})
+                         .Count();
+
+   ASSERT_EQ(nLines, is->size());
+   // records are in the order of the file
+   for (auto i : ROOT::TSeqU(nLines))
+      EXPECT_EQ(i, (*is)[i]);
+   EXPECT_DOUBLE_EQ(nLines * (nLines - 1) / 2. + nLines * 0.5, *sumX);
+   EXPECT_EQ((nLines + 1) / 2, *nEven);
+   EXPECT_EQ(0u, *nWrongNames);
+}
+
+TEST(RCsvDS, LargeFile)
+{
+   const auto fname = "RCsvDS_test_large.csv";
+   const auto nLines = 100000u;
+   WriteLargeCsv(fname, nLines);
+   CheckLargeCsv(fname, nLines);
+   gSystem->Unlink(fname);
+}
+
+TEST(RCsvDS, Long64Fields)
+{
+   const auto fname = "RCsvDS_test_long64.csv";
+   auto checkMinMax = [&](const char *field) {
+      {
+         std::ofstream f(fname);
+         f << "l\n-9223372036854775808\n9223372036854775807\n" << field << '\n';
+      }
+      auto df = ROOT::RDF::MakeCsvDataFrame(fname);
+      auto min = df.Min<Long64_t>("l");
+      auto max = df.Max<Long64_t>("l");
+      EXPECT_EQ(std::numeric_limits<Long64_t>::min(), *min);
+      EXPECT_EQ(std::numeric_limits<Long64_t>::max(), *max);
+   };
+   checkMinMax("+12");
+   // the column is inferred as Long64_t from the first line, later fields that do not fit are errors
+   EXPECT_THROW(checkMinMax("12abc"), std::runtime_error);
+   EXPECT_THROW(checkMinMax("9223372036854775808"), std::out_of_range);
+   EXPECT_THROW(checkMinMax("-9223372036854775809"), std::out_of_range);
+   gSystem->Unlink(fname);
+}
+
 #ifndef NDEBUG
 
 TEST(RCsvDS, SetNSlotsTwice)
@@ -276,6 +342,17 @@ TEST(RCsvDS, FromARDFWithJittingMT)
    EXPECT_EQ(40, *min);
 }
 
+TEST(RCsvDS, LargeFileMT)
+{
+   ROOT::EnableImplicitMT(4);
+   const auto fname = "RCsvDS_test_large_mt.csv";
+   const auto nLines = 100000u;
+   WriteLargeCsv(fname, nLines);
+   CheckLargeCsv(fname, nLines);
+   gSystem->Unlink(fname);
+   ROOT::DisableImplicitMT();
+}
+
 TEST(RCsvDS, ProgressiveReadingRDFMT)
 {
    // Even chunks
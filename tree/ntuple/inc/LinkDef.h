@@ -23,6 +23,7 @@
 #pragma link C++ class ROOT::Experimental::RVectorField-;
 #pragma link C++ class ROOT::Experimental::RNTupleReader-;
 #pragma link C++ class ROOT::Experimental::RNTupleWriter-;
+#pragma link C++ class ROOT::Experimental::RNTupleParallelWriter-;
 #pragma link C++ class ROOT::Experimental::RNTupleModel-;
 
 #pragma link C++ class ROOT::Experimental::RNTuple+;
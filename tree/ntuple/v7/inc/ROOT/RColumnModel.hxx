@@ -48,6 +48,14 @@ enum class EColumnType {
    kInt64,
    kInt32,
    kInt16,
+   // Split variants of the above types: the bytes of the elements of a page are reordered such that first all the
+   // least significant bytes are stored, then all the second bytes, etc.  The on-disk element size is unchanged but
+   // the result usually compresses better.  Index columns are in addition delta and zigzag encoded.
+   kSplitIndex,
+   kSplitReal64,
+   kSplitReal32,
+   kSplitInt64,
+   kSplitInt32,
 };
 
 // clang-format off
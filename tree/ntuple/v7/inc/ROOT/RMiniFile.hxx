@@ -139,8 +139,9 @@ private:
       TFile *fFile = nullptr;
       /// Low-level writing using a TFile
       void Write(const void *buffer, size_t nbytes, std::int64_t offset);
-      /// Writes an RBlob opaque key with the provided buffer as data record and returns the offset of the record
-      std::uint64_t WriteKey(const void *buffer, size_t nbytes, size_t len);
+      /// Writes an RBlob opaque key with the provided buffer as data record and returns the offset of the record.
+      /// The key reserves alignment - 1 extra bytes, which are used to start the record at a multiple of alignment.
+      std::uint64_t WriteKey(const void *buffer, size_t nbytes, size_t len, size_t alignment = 1);
       operator bool() const { return fFile; }
    };
 
@@ -162,12 +163,14 @@ private:
       /// Writes bytes in the open stream, either at fFilePos or at the given offset
       void Write(const void *buffer, size_t nbytes, std::int64_t offset = -1);
       /// Writes a TKey including the data record, given by buffer, into fFile; returns the file offset to the payload.
-      /// The payload is already compressed
+      /// The payload is already compressed.  The title is padded with blanks such that the payload starts at a
+      /// multiple of alignment.
       std::uint64_t WriteKey(const void *buffer, std::size_t nbytes, std::size_t len, std::int64_t offset = -1,
                              std::uint64_t directoryOffset = 100,
                              const std::string &className = "",
                              const std::string &objectName = "",
-                             const std::string &title = "");
+                             const std::string &title = "",
+                             std::size_t alignment = 1);
       operator bool() const { return fFile; }
    };
 
@@ -215,8 +218,9 @@ public:
    std::uint64_t WriteNTupleHeader(const void *data, size_t nbytes, size_t lenHeader);
    /// Writes the compressed footer and registeres its location; lenFooter is the size of the uncompressed footer.
    std::uint64_t WriteNTupleFooter(const void *data, size_t nbytes, size_t lenFooter);
-   /// Writes a new record as an RBlob key into the file
-   std::uint64_t WriteBlob(const void *data, size_t nbytes, size_t len);
+   /// Writes a new record as an RBlob key into the file.  The record is placed at a file offset that is a multiple of
+   /// alignment, so that a memory mapping of the file yields a suitably aligned buffer for the record.
+   std::uint64_t WriteBlob(const void *data, size_t nbytes, size_t len, size_t alignment = 1);
    /// Writes the RNTuple key to the file so that the header and footer keys can be found
    void Commit();
 };
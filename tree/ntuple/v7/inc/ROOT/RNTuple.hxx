@@ -16,6 +16,7 @@
 #ifndef ROOT7_RNTuple
 #define ROOT7_RNTuple
 
+#include <RConfigure.h> // for R__USE_IMT
 #include <ROOT/RConfig.hxx> // for R__unlikely
 #include <ROOT/RNTupleMetrics.hxx>
 #include <ROOT/RNTupleModel.hxx>
@@ -27,19 +28,44 @@
 
 #include <iterator>
 #include <memory>
+#include <mutex>
 #include <sstream>
 #include <utility>
+#include <vector>
 
 namespace ROOT {
 namespace Experimental {
 
 class REntry;
 class RNTupleModel;
+class TTaskGroup;
 
 namespace Detail {
 class RPageSink;
 class RPageSource;
-}
+
+#ifdef R__USE_IMT
+// clang-format off
+/**
+\class ROOT::Experimental::Detail::RNTupleImtTaskScheduler
+\ingroup NTuple
+\brief Runs the page (de)compression tasks of a page storage in the IMT thread pool
+*/
+// clang-format on
+class RNTupleImtTaskScheduler : public RPageStorage::RTaskScheduler {
+private:
+   std::unique_ptr<TTaskGroup> fTaskGroup;
+
+public:
+   RNTupleImtTaskScheduler();
+   virtual ~RNTupleImtTaskScheduler();
+   void Reset() final;
+   void AddTask(const std::function<void(void)> &taskFunc) final;
+   void Wait() final;
+};
+#endif
+
+} // namespace Detail
 
 
 /**
@@ -74,6 +100,8 @@ Individual fields can be read as well by instantiating a tree view.
 // clang-format on
 class RNTupleReader {
 private:
+   /// Decompresses pages in parallel if requested by the read options; needs to be destructed after fSource
+   std::unique_ptr<Detail::RPageStorage::RTaskScheduler> fUnzipTasks;
    std::unique_ptr<Detail::RPageSource> fSource;
    /// Needs to be destructed before fSource
    std::unique_ptr<RNTupleModel> fModel;
@@ -85,6 +113,8 @@ private:
 
    void ConnectModel(const RNTupleModel &model);
    RNTupleReader *GetDisplayReader();
+   /// Attaches the page source and sets up the task scheduler and the metrics
+   void InitPageSource();
 
 public:
    // Browse through the entries
@@ -157,6 +187,11 @@ public:
    }
 
    RNTupleGlobalRange GetEntryRange() { return RNTupleGlobalRange(0, GetNEntries()); }
+   /// Returns the entry ranges of the clusters that may contain entries with values of the given field within
+   /// [min, max], according to the column statistics (see RNTupleWriteOptions::SetUseColumnStatistics()).
+   /// The entries of the other clusters cannot pass the selection, so that they need not be read.
+   /// For collection fields, the selection refers to the collection size.
+   std::vector<RNTupleGlobalRange> GetEntryRanges(std::string_view fieldName, double min, double max);
 
    /// Provides access to an individual field that can contain either a scalar value or a collection, e.g.
    /// GetView<double>("particles.pt") or GetView<std::vector<double>>("particle").  It can as well be the index
@@ -188,15 +223,25 @@ An output ntuple can be filled with entries. The caller has to make sure that th
 is not modified for the time of the Fill() call. The fill call serializes the C++ object into the column format and
 writes data into the corresponding column page buffers.  Writing of the buffers to storage is deferred and can be
 triggered by Flush() or by destructing the ntuple.  On I/O errors, an exception is thrown.
+
+Clusters are committed automatically every 64000 entries or, if an approximate cluster size is given in the write
+options, once the compressed size of their pages reaches it.  The page size and the memory budget for pages that are
+buffered by the page sink are set in the write options, too.
 */
 // clang-format on
 class RNTupleWriter {
 private:
    static constexpr NTupleSize_t kDefaultClusterSizeEntries = 64000;
+   /// With a cluster size target, clusters are committed at the latest when their number of entries reaches the
+   /// range of ClusterSize_t
+   static constexpr NTupleSize_t kMaxClusterSizeEntries = ClusterSize_t::ValueType(-1) - 1;
+   /// Compresses pages in parallel if requested by the write options; needs to be destructed after fSink
+   std::unique_ptr<Detail::RPageStorage::RTaskScheduler> fZipTasks;
    std::unique_ptr<Detail::RPageSink> fSink;
    /// Needs to be destructed before fSink
    std::unique_ptr<RNTupleModel> fModel;
-   NTupleSize_t fClusterSizeEntries;
+   /// Taken from the write options of the page sink; zero if clusters are committed every kDefaultClusterSizeEntries
+   std::uint64_t fApproxZippedClusterSize;
    NTupleSize_t fLastCommitted;
    NTupleSize_t fNEntries;
 
@@ -219,13 +264,113 @@ public:
          value.GetField()->Append(value);
       }
       fNEntries++;
-      if ((fNEntries % fClusterSizeEntries) == 0)
+      if (fApproxZippedClusterSize == 0) {
+         if ((fNEntries % kDefaultClusterSizeEntries) == 0)
+            CommitCluster();
+      } else if ((fSink->GetNBytesZippedCluster() >= fApproxZippedClusterSize) ||
+                 ((fNEntries - fLastCommitted) == kMaxClusterSizeEntries)) {
          CommitCluster();
+      }
    }
    /// Ensure that the data from the so far seen Fill calls has been written to storage
    void CommitCluster();
 };
 
+class RNTupleParallelWriter;
+
+// clang-format off
+/**
+\class ROOT::Experimental::RNTupleFillContext
+\ingroup NTuple
+\brief A thread-local context to fill entries into an RNTupleParallelWriter
+
+Every fill context has its own copy of the model, its own entries, and its own page buffers.  The pages are sealed
+(packed and compressed) in the filling thread.  Complete clusters are handed over to the parallel writer, which
+appends them to the ntuple in the order in which they are committed.  The fill context needs to be destructed before
+the parallel writer it has been created from.
+*/
+// clang-format on
+class RNTupleFillContext {
+   friend class RNTupleParallelWriter;
+
+private:
+   static constexpr NTupleSize_t kDefaultClusterSizeEntries = 64000;
+   static constexpr NTupleSize_t kMaxClusterSizeEntries = ClusterSize_t::ValueType(-1) - 1;
+   std::unique_ptr<Detail::RPageSink> fSink;
+   /// Needs to be destructed before fSink
+   std::unique_ptr<RNTupleModel> fModel;
+   std::uint64_t fApproxZippedClusterSize;
+   std::uint64_t fPageBufferBudget;
+   NTupleSize_t fLastCommitted = 0;
+   NTupleSize_t fNEntries = 0;
+
+   RNTupleFillContext(std::unique_ptr<RNTupleModel> model, std::unique_ptr<Detail::RPageSink> sink);
+
+public:
+   RNTupleFillContext(const RNTupleFillContext&) = delete;
+   RNTupleFillContext& operator=(const RNTupleFillContext&) = delete;
+   ~RNTupleFillContext();
+
+   /// The model is a clone of the parallel writer's model; its default entry is private to this fill context
+   RNTupleModel *GetModel() { return fModel.get(); }
+
+   void Fill() { Fill(*fModel->GetDefaultEntry()); }
+   void Fill(REntry &entry) {
+      for (auto& value : entry) {
+         value.GetField()->Append(value);
+      }
+      fNEntries++;
+      // The fill context buffers the sealed pages of the whole cluster.  Commit the cluster before another round of
+      // full pages of all the columns could exceed the page buffer budget.
+      if (fSink->GetNBytesBuffered() + fSink->GetNBytesHeadPages() > fPageBufferBudget) {
+         CommitCluster();
+      } else if (fApproxZippedClusterSize == 0) {
+         if ((fNEntries - fLastCommitted) == kDefaultClusterSizeEntries)
+            CommitCluster();
+      } else if ((fSink->GetNBytesZippedCluster() >= fApproxZippedClusterSize) ||
+                 ((fNEntries - fLastCommitted) == kMaxClusterSizeEntries)) {
+         CommitCluster();
+      }
+   }
+   /// Seals the open pages and appends the cluster to the parallel writer's ntuple
+   void CommitCluster();
+};
+
+// clang-format off
+/**
+\class ROOT::Experimental::RNTupleParallelWriter
+\ingroup NTuple
+\brief An RNTuple that is filled concurrently by several threads
+
+Every thread creates its own RNTupleFillContext and fills entries through it.  The parallel writer owns the page sink
+of the ntuple.  The fill contexts commit whole clusters to the page sink while holding a lock, so that the only
+serialized part is writing out the already compressed pages.  Entries of different fill contexts are not
+interleaved within a cluster, but the order of the clusters from different contexts is not deterministic.
+*/
+// clang-format on
+class RNTupleParallelWriter {
+private:
+   std::mutex fSinkMutex;
+   std::unique_ptr<Detail::RPageSink> fSink;
+   /// The model is used to create the ntuple schema and as a template for the models of the fill contexts.
+   /// Needs to be destructed before fSink.
+   std::unique_ptr<RNTupleModel> fModel;
+
+public:
+   static std::unique_ptr<RNTupleParallelWriter> Recreate(std::unique_ptr<RNTupleModel> model,
+                                                          std::string_view ntupleName,
+                                                          std::string_view storage,
+                                                          const RNTupleWriteOptions &options = RNTupleWriteOptions());
+   RNTupleParallelWriter(std::unique_ptr<RNTupleModel> model, std::unique_ptr<Detail::RPageSink> sink);
+   RNTupleParallelWriter(const RNTupleParallelWriter&) = delete;
+   RNTupleParallelWriter& operator=(const RNTupleParallelWriter&) = delete;
+   /// Writes the ntuple meta-data; all fill contexts must have been destructed before
+   ~RNTupleParallelWriter();
+
+   /// Thread-safe; the returned context must only be used by a single thread at a time
+   std::unique_ptr<RNTupleFillContext> CreateFillContext();
+};
+
 // clang-format off
 /**
 \class ROOT::Experimental::RCollectionNTuple
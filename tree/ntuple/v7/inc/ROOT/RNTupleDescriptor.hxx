@@ -162,6 +162,38 @@ public:
       }
    };
 
+   /// Optional summary of the values of a particular column in a particular cluster.  For offset columns, the
+   /// statistics refer to the collection sizes.  Clusters whose statistics show that none of the values can satisfy a
+   /// selection can be skipped without reading them.
+   struct RColumnStatistics {
+      /// Column statistics are only recorded if enabled in the write options and for numerical columns
+      bool fIsValid = false;
+      /// Lower and upper bound of the column values; NaN values are ignored
+      double fMin = 0.0;
+      double fMax = 0.0;
+      /// For offset columns, the number of empty collections
+      std::uint64_t fNEmpty = 0;
+
+      bool operator==(const RColumnStatistics &other) const {
+         return fIsValid == other.fIsValid && fMin == other.fMin && fMax == other.fMax && fNEmpty == other.fNEmpty;
+      }
+
+      /// Returns false if none of the column values can be within [min, max]
+      bool MayOverlap(double min, double max) const { return !fIsValid || ((fMin <= max) && (fMax >= min)); }
+
+      void Merge(const RColumnStatistics &other) {
+         if (!other.fIsValid)
+            return;
+         if (!fIsValid) {
+            *this = other;
+            return;
+         }
+         fMin = std::min(fMin, other.fMin);
+         fMax = std::max(fMax, other.fMax);
+         fNEmpty += other.fNEmpty;
+      }
+   };
+
    /// The window of element indexes of a particular column in a particular cluster
    struct RColumnRange {
       DescriptorId_t fColumnId = kInvalidDescriptorId;
@@ -172,13 +204,12 @@ public:
       /// The usual format for ROOT compression settings (see Compression.h).
       /// The pages of a particular column in a particular cluster are all compressed with the same settings.
       std::int64_t fCompressionSettings = 0;
-
-      // TODO(jblomer): we perhaps want to store summary information, such as average, min/max, etc.
-      // Should this be done on the field level?
+      RColumnStatistics fStatistics;
 
       bool operator==(const RColumnRange &other) const {
          return fColumnId == other.fColumnId && fFirstElementIndex == other.fFirstElementIndex &&
-                fNElements == other.fNElements && fCompressionSettings == other.fCompressionSettings;
+                fNElements == other.fNElements && fCompressionSettings == other.fCompressionSettings &&
+                fStatistics == other.fStatistics;
       }
 
       bool Contains(NTupleSize_t index) const {
@@ -449,6 +480,10 @@ public:
    DescriptorId_t FindClusterId(DescriptorId_t columnId, NTupleSize_t index) const;
    DescriptorId_t FindNextClusterId(DescriptorId_t clusterId) const;
    DescriptorId_t FindPrevClusterId(DescriptorId_t clusterId) const;
+   /// Returns the ids of the clusters, sorted by their first entry, that may contain values of the given field within
+   /// [min, max] according to the statistics of the field's principal column.  For collection fields, the selection
+   /// refers to the collection sizes.  Clusters without column statistics are always selected.
+   std::vector<DescriptorId_t> SelectClusterIds(DescriptorId_t fieldId, double min, double max) const;
 
    /// Re-create the C++ model from the stored meta-data
    std::unique_ptr<RNTupleModel> GenerateModel() const;
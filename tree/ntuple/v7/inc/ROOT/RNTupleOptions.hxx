@@ -18,6 +18,9 @@
 
 #include <Compression.h>
 
+#include <cstddef>
+#include <cstdint>
+
 namespace ROOT {
 namespace Experimental {
 
@@ -44,8 +47,33 @@ All page sink classes need to support the common options.
 */
 // clang-format on
 class RNTupleWriteOptions {
+public:
+  static constexpr std::size_t kDefaultPageBufferBudget = 256 * 1024 * 1024;
+
+private:
   int fCompression{RCompressionSetting::EDefaults::kUseAnalysis};
   ENTupleContainerFormat fContainerFormat{ENTupleContainerFormat::kTFile};
+  /// If set and implicit multi-threading is enabled, pages are compressed asynchronously as tasks in the IMT pool.
+  /// The sealed pages are written in order when the cluster is committed.
+  bool fUseParallelCompression{false};
+  /// If set, integer, floating point, and index columns are stored in their split variants, e.g. kSplitReal32
+  /// instead of kReal32.  Split columns usually compress better at the cost of an extra pass on packing/unpacking.
+  bool fUseSplitEncoding{false};
+  /// If set, the page sink records the value range of numerical columns for every cluster.  Readers can use the
+  /// statistics to skip clusters that cannot contain entries passing a range selection.
+  bool fUseColumnStatistics{false};
+  /// If set, the writer commits a cluster as soon as the compressed size of its pages reaches this value.  For pages
+  /// that are still being compressed, the compressed size is estimated from the compression ratio of the previous
+  /// clusters.  If zero, a cluster is committed every 64000 entries.
+  std::size_t fApproxZippedClusterSize{0};
+  /// If set, the capacity of the page buffers into which the columns are filled; pages are committed when they are
+  /// full.  If zero, the page buffers hold 10000 elements.
+  std::size_t fApproxUnzippedPageSize{0};
+  /// Upper limit for the memory of the page buffers held by the page sink: the open page of every column and the
+  /// committed pages that are not yet written to storage, e.g. pages waiting for parallel compression.  Before the
+  /// limit is reached, the sink writes out the buffered pages or, if it buffers whole clusters, the writer commits
+  /// the cluster.  Creating the sink fails if the open pages of the columns alone exceed the limit.
+  std::size_t fPageBufferBudget{kDefaultPageBufferBudget};
 
 public:
   int GetCompression() const { return fCompression; }
@@ -56,6 +84,22 @@ public:
 
   ENTupleContainerFormat GetContainerFormat() const { return fContainerFormat; }
   void SetContainerFormat(ENTupleContainerFormat val) { fContainerFormat = val; }
+
+  bool GetUseParallelCompression() const { return fUseParallelCompression; }
+  void SetUseParallelCompression(bool val) { fUseParallelCompression = val; }
+
+  bool GetUseSplitEncoding() const { return fUseSplitEncoding; }
+  void SetUseSplitEncoding(bool val) { fUseSplitEncoding = val; }
+
+  bool GetUseColumnStatistics() const { return fUseColumnStatistics; }
+  void SetUseColumnStatistics(bool val) { fUseColumnStatistics = val; }
+
+  std::size_t GetApproxZippedClusterSize() const { return fApproxZippedClusterSize; }
+  void SetApproxZippedClusterSize(std::size_t val) { fApproxZippedClusterSize = val; }
+  std::size_t GetApproxUnzippedPageSize() const { return fApproxUnzippedPageSize; }
+  void SetApproxUnzippedPageSize(std::size_t val) { fApproxUnzippedPageSize = val; }
+  std::size_t GetPageBufferBudget() const { return fPageBufferBudget; }
+  void SetPageBufferBudget(std::size_t val) { fPageBufferBudget = val; }
 };
 
 
@@ -76,12 +120,35 @@ public:
       kDefault = kOn,
    };
 
+   static constexpr std::uint64_t kDefaultMaxReadGap = 256 * 1024;
+   static constexpr std::uint64_t kDefaultMaxReadRequestSize = 32 * 1024 * 1024;
+
 private:
    EClusterCache fClusterCache = EClusterCache::kDefault;
+   /// When loading a cluster, pages that are at most this many bytes apart on storage are fetched by a single
+   /// read request.  The page source may choose a smaller gap in order to limit the number of extra bytes read.
+   std::uint64_t fMaxReadGap = kDefaultMaxReadGap;
+   /// Coalesced read requests do not grow beyond this size.  Larger pages are still read in a single request.
+   std::uint64_t fMaxReadRequestSize = kDefaultMaxReadRequestSize;
+   /// If set and implicit multi-threading is enabled, the pages of a cluster are decompressed in parallel when the
+   /// cluster is first accessed.  Requires the cluster cache.
+   bool fUseParallelDecompression = false;
+   /// If set and the file supports memory mapping, the page source maps the file into memory.  Uncompressed pages
+   /// whose on-disk representation equals the in-memory representation then point directly into the mapped file
+   /// instead of being copied into heap buffers.  Useful for uncompressed ntuples on fast local storage.
+   bool fUseMmap = false;
 
 public:
    EClusterCache GetClusterCache() const { return fClusterCache; }
    void SetClusterCache(EClusterCache val) { fClusterCache = val; }
+   std::uint64_t GetMaxReadGap() const { return fMaxReadGap; }
+   void SetMaxReadGap(std::uint64_t val) { fMaxReadGap = val; }
+   std::uint64_t GetMaxReadRequestSize() const { return fMaxReadRequestSize; }
+   void SetMaxReadRequestSize(std::uint64_t val) { fMaxReadRequestSize = val; }
+   bool GetUseParallelDecompression() const { return fUseParallelDecompression; }
+   void SetUseParallelDecompression(bool val) { fUseParallelDecompression = val; }
+   bool GetUseMmap() const { return fUseMmap; }
+   void SetUseMmap(bool val) { fUseMmap = val; }
 };
 
 } // namespace Experimental
@@ -18,8 +18,10 @@
 
 #include <ROOT/RField.hxx>
 #include <ROOT/RNTupleUtil.hxx>
+#include <ROOT/RSpan.hxx>
 #include <ROOT/RStringView.hxx>
 
+#include <algorithm>
 #include <iterator>
 #include <memory>
 #include <type_traits>
@@ -145,7 +147,8 @@ The view owns a field and its underlying columns in order to fill an ntuple valu
 accessed by index. For top-level fields, the index refers to the entry number. Fields that are part of
 nested collections have global index numbers that are derived from their parent indexes.
 
-Fields of simple types with a Map() method will use that and thus expose zero-copy access.
+Fields of simple types with a Map() method will use that and thus expose zero-copy access.  For these fields, MapV()
+provides bulk access to consecutive values as a span into the page buffer, e.g. for vectorized processing.
 */
 // clang-format on
 template <typename T>
@@ -204,6 +207,25 @@ public:
       fField.Read(clusterIndex, &fValue);
       return *fValue.Get<T>();
    }
+
+   /// Returns up to maxSize consecutive values starting at globalIndex.  The span points directly into the buffer of
+   /// the page containing globalIndex and ends at the page boundary, so it can be shorter than maxSize.  It remains
+   /// valid until the next access through the view.
+   template <typename C = T>
+   typename std::enable_if_t<Internal::IsMappable<FieldT>::value, std::span<const C>>
+   MapV(NTupleSize_t globalIndex, NTupleSize_t maxSize) {
+      NTupleSize_t nItems;
+      auto values = fField.MapV(globalIndex, nItems);
+      return std::span<const C>(values, std::min(nItems, maxSize));
+   }
+
+   template <typename C = T>
+   typename std::enable_if_t<Internal::IsMappable<FieldT>::value, std::span<const C>>
+   MapV(const RClusterIndex &clusterIndex, NTupleSize_t maxSize) {
+      NTupleSize_t nItems;
+      auto values = fField.MapV(clusterIndex, nItems);
+      return std::span<const C>(values, std::min(nItems, maxSize));
+   }
 };
 
 
@@ -212,6 +234,9 @@ public:
 \class ROOT::Experimental::RNTupleViewCollection
 \ingroup NTuple
 \brief A view for a collection, that can itself generate new ntuple views for its nested fields.
+
+The inherited MapV() returns spans of the collection's offsets, i.e. the cluster-relative end index of every
+collection's items.
 */
 // clang-format on
 class RNTupleViewCollection : public RNTupleView<ClusterSize_t> {
@@ -119,6 +119,47 @@ public:
    }
 
    const void *GetZipBuffer() { return fZipBuffer->data(); }
+
+   /// Returns the size of the compressed data, which is written into the provided output buffer.  The output buffer
+   /// needs to be at least as large as the input buffer.  Input buffers that do not compress are copied verbatim.
+   /// Unlike the other overloads, this version does not use the zip buffer and thus can be called concurrently.
+   static size_t Zip(const void *from, size_t nbytes, int compression, void *to) {
+      R__ASSERT(from != nullptr);
+      R__ASSERT(to != nullptr);
+
+      auto cxLevel = compression % 100;
+      if ((cxLevel == 0) || (nbytes == 0)) {
+         memcpy(to, from, nbytes);
+         return nbytes;
+      }
+
+      auto cxAlgorithm = static_cast<ROOT::RCompressionSetting::EAlgorithm::EValues>(compression / 100);
+      unsigned int nZipBlocks = 1 + (nbytes - 1) / kMAXZIPBUF;
+      char *source = const_cast<char *>(static_cast<const char *>(from));
+      char *target = static_cast<char *>(to);
+      int szRemaining = nbytes;
+      size_t szZipData = 0;
+      for (unsigned int i = 0; i < nZipBlocks; ++i) {
+         int szSource = std::min(static_cast<int>(kMAXZIPBUF), szRemaining);
+         int szTarget = nbytes - szZipData;
+         int szOutBlock = 0;
+         R__zipMultipleAlgorithm(cxLevel, &szSource, source, &szTarget, target, &szOutBlock, cxAlgorithm);
+         R__ASSERT(szOutBlock >= 0);
+         if ((szOutBlock == 0) || (szOutBlock >= szSource)) {
+            // Uncompressible block, we have to store the entire input data stream uncompressed
+            memcpy(to, from, nbytes);
+            return nbytes;
+         }
+
+         target += szOutBlock;
+         szZipData += szOutBlock;
+         source += szSource;
+         szRemaining -= szSource;
+      }
+      R__ASSERT(szRemaining == 0);
+      R__ASSERT(szZipData < nbytes);
+      return szZipData;
+   }
 };
 
 
@@ -144,6 +185,22 @@ public:
     * The block is uncompressed iff nbytes == dataLen.
     */
    void operator() (const void *from, size_t nbytes, size_t dataLen, void *to) {
+      Unzip(from, nbytes, dataLen, to);
+   }
+
+   /**
+    * In-place decompression via unzip buffer
+    */
+   void operator() (void *fromto, size_t nbytes, size_t dataLen) {
+      R__ASSERT(dataLen <= kMAXZIPBUF);
+      operator()(fromto, nbytes, dataLen, fUnzipBuffer->data());
+      memcpy(fromto, fUnzipBuffer->data(), dataLen);
+   }
+
+   /**
+    * Like the operator() with an output buffer but does not use the unzip buffer and can thus be called concurrently.
+    */
+   static void Unzip(const void *from, size_t nbytes, size_t dataLen, void *to) {
       if (dataLen == nbytes) {
          memcpy(to, from, nbytes);
          return;
@@ -173,15 +230,6 @@ public:
       } while (szRemaining > 0);
       R__ASSERT(szRemaining == 0);
    }
-
-   /**
-    * In-place decompression via unzip buffer
-    */
-   void operator() (void *fromto, size_t nbytes, size_t dataLen) {
-      R__ASSERT(dataLen <= kMAXZIPBUF);
-      operator()(fromto, nbytes, dataLen, fUnzipBuffer->data());
-      memcpy(fromto, fUnzipBuffer->data(), dataLen);
-   }
 };
 
 } // namespace Detail
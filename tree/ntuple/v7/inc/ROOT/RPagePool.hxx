@@ -58,11 +58,17 @@ public:
    RPagePool() = default;
    RPagePool(const RPagePool&) = delete;
    RPagePool& operator =(const RPagePool&) = delete;
-   ~RPagePool() = default;
+   /// Frees the preloaded pages that have never been used
+   ~RPagePool();
 
    /// Adds a new page to the pool together with the function to free its space. Upon registration,
    /// the page pool takes ownership of the page's memory. The new page has its reference counter set to 1.
    void RegisterPage(const RPage &page, const RPageDeleter &deleter);
+   /// Like RegisterPage() but the reference counter is initialized to 0.  Preloaded pages, e.g. pages that are
+   /// decompressed ahead of use, are freed when they are returned after their first use or when they are evicted.
+   void PreloadPage(const RPage &page, const RPageDeleter &deleter);
+   /// Frees all the pages of the given cluster that are not in use
+   void Evict(DescriptorId_t clusterId);
    /// Tries to find the page corresponding to column and index in the cache. If the page is found, its reference
    /// counter is increased
    RPage GetPage(ColumnId_t columnId, NTupleSize_t globalIndex);
@@ -0,0 +1,78 @@
+/// \file ROOT/RPageSinkBuf.hxx
+/// \ingroup NTuple ROOT7
+/// \date 2020-08-03
+/// \warning This is part of the ROOT 7 prototype! It will change without notice. It might trigger earthquakes. Feedback
+/// is welcome!
+
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT7_RPageSinkBuf
+#define ROOT7_RPageSinkBuf
+
+#include <ROOT/RPageStorage.hxx>
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace ROOT {
+namespace Experimental {
+namespace Detail {
+
+class RPageAllocatorHeap;
+
+// clang-format off
+/**
+\class ROOT::Experimental::Detail::RPageSinkBuf
+\ingroup NTuple
+\brief Page sink that seals pages in memory and passes them on to another sink cluster by cluster
+
+The buffered sink is used by the fill contexts of the RNTupleParallelWriter.  Pages are packed and compressed in the
+thread that fills them.  On CommitCluster(), the sealed pages of the cluster are committed to the inner sink as a new
+cluster while holding the inner sink's lock.  The buffered sink and the inner sink need to be created from
+models with the same fields so that their column ids correspond to each other.
+*/
+// clang-format on
+class RPageSinkBuf : public RPageSink {
+private:
+   /// A sealed page and, unless the sealed page points to it, the memory backing it
+   struct RBufferedPage {
+      std::unique_ptr<unsigned char[]> fBuffer;
+      RSealedPage fSealedPage;
+   };
+
+   RPageSink &fInnerSink;
+   std::mutex &fInnerSinkLock;
+   std::unique_ptr<RPageAllocatorHeap> fPageAllocator;
+   /// The sealed pages of the open cluster, indexed by column id
+   std::vector<std::vector<RBufferedPage>> fBufferedPages;
+
+protected:
+   void CreateImpl(const RNTupleModel &model) final;
+   RClusterDescriptor::RLocator CommitPageImpl(ColumnHandle_t columnHandle, const RPage &page) final;
+   RClusterDescriptor::RLocator CommitSealedPageImpl(DescriptorId_t columnId, const RSealedPage &sealedPage) final;
+   RClusterDescriptor::RLocator CommitClusterImpl(NTupleSize_t nEntries) final;
+   void CommitDatasetImpl() final {}
+
+public:
+   /// The inner sink must have been created already and needs to outlive the buffered sink
+   RPageSinkBuf(RPageSink &innerSink, std::mutex &innerSinkLock);
+   RPageSinkBuf(const RPageSinkBuf&) = delete;
+   RPageSinkBuf& operator=(const RPageSinkBuf&) = delete;
+   virtual ~RPageSinkBuf();
+
+   RPage ReservePage(ColumnHandle_t columnHandle, std::size_t nElements = 0) final;
+   void ReleasePage(RPage &page) final;
+};
+
+} // namespace Detail
+} // namespace Experimental
+} // namespace ROOT
+
+#endif
@@ -25,6 +25,7 @@
 
 #include <atomic>
 #include <cstddef>
+#include <functional>
 #include <memory>
 #include <unordered_set>
 
@@ -38,6 +39,7 @@ namespace Detail {
 
 class RCluster;
 class RColumn;
+class RColumnElementBase;
 class RPagePool;
 class RFieldBase;
 class RNTupleMetrics;
@@ -58,8 +60,23 @@ an ntuple.  Concrete implementations can use a TFile, a raw file, an object stor
 */
 // clang-format on
 class RPageStorage {
+public:
+   /// The interface of a task scheduler to schedule page (de)compression tasks
+   class RTaskScheduler {
+   public:
+      virtual ~RTaskScheduler() = default;
+      /// Start a new set of tasks
+      virtual void Reset() = 0;
+      /// Take a callable that represents a task
+      virtual void AddTask(const std::function<void(void)> &taskFunc) = 0;
+      /// Blocks until all scheduled tasks finished
+      virtual void Wait() = 0;
+   };
+
 protected:
    std::string fNTupleName;
+   /// For parallel (de)compression of pages; not owned.  If unset, pages are processed sequentially.
+   RTaskScheduler *fTaskScheduler = nullptr;
 
 public:
    explicit RPageStorage(std::string_view name);
@@ -69,6 +86,7 @@ public:
 
    /// Whether the concrete implementation is a sink or a source
    virtual EPageStorageType GetType() = 0;
+   const std::string &GetNTupleName() const { return fNTupleName; }
 
    struct RColumnHandle {
       DescriptorId_t fId = kInvalidDescriptorId;
@@ -94,6 +112,8 @@ public:
 
    /// Returns an empty metrics.  Page storage implementations usually have their own metrics.
    virtual RNTupleMetrics &GetMetrics();
+
+   void SetTaskScheduler(RTaskScheduler *taskScheduler) { fTaskScheduler = taskScheduler; }
 };
 
 // clang-format off
@@ -108,6 +128,28 @@ up to the given entry number are committed.
 */
 // clang-format on
 class RPageSink : public RPageStorage {
+public:
+   /// A packed and compressed page, ready to be written to storage.  The sealed page does not own its buffer.
+   struct RSealedPage {
+      const void *fBuffer = nullptr;
+      std::uint32_t fSize = 0;
+      std::uint32_t fNElements = 0;
+
+      RSealedPage() = default;
+      RSealedPage(const void *b, std::uint32_t s, std::uint32_t n) : fBuffer(b), fSize(s), fNElements(n) {}
+   };
+
+private:
+   /// The in-memory value type of a column with respect to collecting column statistics
+   enum class EStatisticsType { kNone, kBool, kUInt8, kInt32, kUInt32, kInt64, kUInt64, kReal32, kReal64, kOffset };
+
+   /// Indexed by column id; empty if column statistics are disabled
+   std::vector<EStatisticsType> fStatisticsTypes;
+   /// For offset columns, the last offset of the previous page in the open cluster.  Indexed by column id.
+   std::vector<ClusterSize_t::ValueType> fLastOffsets;
+
+   void UpdateStatistics(DescriptorId_t columnId, const RPage &page);
+
 protected:
    RNTupleWriteOptions fOptions;
 
@@ -122,19 +164,42 @@ protected:
    /// Keeps track of the written pages in the currently open cluster. Indexed by column id.
    std::vector<RClusterDescriptor::RPageRange> fOpenPageRanges;
    RNTupleDescriptorBuilder fDescriptorBuilder;
+   /// Uncompressed size of the pages committed to the currently open cluster
+   std::uint64_t fNBytesUnzippedCluster = 0;
+   /// Compressed size of the pages committed to the currently open cluster.  For pages whose compression is still
+   /// pending (indicated by an empty locator from CommitPageImpl), the size is estimated from the previous clusters.
+   std::uint64_t fNBytesZippedCluster = 0;
+   /// Uncompressed and compressed size of all the committed clusters
+   std::uint64_t fNBytesUnzippedTotal = 0;
+   std::uint64_t fNBytesZippedTotal = 0;
+   /// The in-memory element size of the columns, needed to account for the uncompressed size of sealed pages.
+   /// Indexed by column id.
+   std::vector<std::size_t> fElementSizes;
+   /// Memory of the pages reserved by ReservePage() and not yet released, i.e. the open pages of the columns
+   std::size_t fNBytesHeadPages = 0;
+   /// Memory of the committed pages that the sink holds until it writes them, e.g. pages waiting for compression
+   std::size_t fNBytesBuffered = 0;
+
+   /// The number of elements of a page reserved with the default size
+   std::size_t GetNElementsPerPage(std::size_t elementSize) const;
 
    virtual void CreateImpl(const RNTupleModel &model) = 0;
    virtual RClusterDescriptor::RLocator CommitPageImpl(ColumnHandle_t columnHandle, const RPage &page) = 0;
+   virtual RClusterDescriptor::RLocator CommitSealedPageImpl(DescriptorId_t columnId, const RSealedPage &sealedPage) = 0;
    virtual RClusterDescriptor::RLocator CommitClusterImpl(NTupleSize_t nEntries) = 0;
    virtual void CommitDatasetImpl() = 0;
 
 public:
+   /// Page size used if the write options do not set an approximate page size
+   static constexpr std::size_t kDefaultElementsPerPage = 10000;
+
    RPageSink(std::string_view ntupleName, const RNTupleWriteOptions &options);
    virtual ~RPageSink();
    /// Guess the concrete derived page source from the file name (location)
    static std::unique_ptr<RPageSink> Create(std::string_view ntupleName, std::string_view location,
                                             const RNTupleWriteOptions &options = RNTupleWriteOptions());
    EPageStorageType GetType() final { return EPageStorageType::kSink; }
+   const RNTupleWriteOptions &GetWriteOptions() const { return fOptions; }
 
    ColumnHandle_t AddColumn(DescriptorId_t fieldId, const RColumn &column) final;
    void DropColumn(ColumnHandle_t /*columnHandle*/) final {}
@@ -145,14 +210,33 @@ public:
    void Create(RNTupleModel &model);
    /// Write a page to the storage. The column must have been added before.
    void CommitPage(ColumnHandle_t columnHandle, const RPage &page);
+   /// Write a page that has already been packed and compressed, e.g. by the page sink of another thread.  The column
+   /// ids of this sink and of the sink that sealed the page must correspond to each other.
+   void CommitSealedPage(DescriptorId_t columnId, const RSealedPage &sealedPage);
+   /// Merge column statistics collected elsewhere, e.g. by the page sink that sealed the pages committed by
+   /// CommitSealedPage(), into the statistics of the open cluster
+   void CommitColumnStatistics(DescriptorId_t columnId, const RClusterDescriptor::RColumnStatistics &statistics);
    /// Finalize the current cluster and create a new one for the following data.
    void CommitCluster(NTupleSize_t nEntries);
+   /// The number of entries in the committed clusters
+   NTupleSize_t GetNEntries() const { return fPrevClusterNEntries; }
+   /// The (partially estimated) compressed size of the pages committed so far to the open cluster
+   std::uint64_t GetNBytesZippedCluster() const { return fNBytesZippedCluster; }
+   std::uint64_t GetNBytesUnzippedCluster() const { return fNBytesUnzippedCluster; }
+   /// The memory of the open pages of the columns
+   std::size_t GetNBytesHeadPages() const { return fNBytesHeadPages; }
+   /// The memory of the committed pages that are not yet written; does not include the open pages of the columns
+   std::size_t GetNBytesBuffered() const { return fNBytesBuffered; }
    /// Finalize the current cluster and the entrire data set.
    void CommitDataset() { CommitDatasetImpl(); }
 
    /// Get a new, empty page for the given column that can be filled with up to nElements.  If nElements is zero,
    /// the page sink picks an appropriate size.
    virtual RPage ReservePage(ColumnHandle_t columnHandle, std::size_t nElements = 0) = 0;
+
+   /// Packs and compresses the page into buf, which needs to be large enough to hold the packed page.  If the page
+   /// needs neither packing nor compression, the returned sealed page points directly to the page buffer.
+   static RSealedPage SealPage(const RPage &page, const RColumnElementBase &element, int compression, void *buf);
 };
 
 // clang-format off
@@ -188,6 +272,7 @@ public:
    virtual std::unique_ptr<RPageSource> Clone() const = 0;
 
    EPageStorageType GetType() final { return EPageStorageType::kSource; }
+   const RNTupleReadOptions &GetReadOptions() const { return fOptions; }
    const RNTupleDescriptor &GetDescriptor() const { return fDescriptor; }
    ColumnHandle_t AddColumn(DescriptorId_t fieldId, const RColumn &column) final;
    void DropColumn(ColumnHandle_t columnHandle) final;
@@ -26,6 +26,7 @@
 #include <cstdio>
 #include <memory>
 #include <string>
+#include <vector>
 
 class TFile;
 
@@ -54,9 +55,6 @@ The written file can be either in ROOT format or in RNTuple bare format.
 */
 // clang-format on
 class RPageSinkFile : public RPageSink {
-public:
-   static constexpr std::size_t kDefaultElementsPerPage = 10000;
-
 private:
    RNTupleMetrics fMetrics;
    std::unique_ptr<RPageAllocatorHeap> fPageAllocator;
@@ -69,9 +67,34 @@ private:
    /// Helper for zipping keys and header / footer; comprises a 16MB zip buffer
    RNTupleCompressor fCompressor;
 
+   /// A page of the currently open cluster that is compressed by a task and written on CommitClusterImpl() or
+   /// earlier, if the pending pages exceed the page buffer budget
+   struct RPendingPage {
+      DescriptorId_t fColumnId = kInvalidDescriptorId;
+      /// Index of the page in the column's open page range, used to fill in the locator once the page is written
+      std::size_t fPageIdx = 0;
+      std::size_t fPackedBytes = 0;
+      std::size_t fZippedBytes = 0;
+      /// Alignment of the record in the file if the page is stored uncompressed, for memory mapping
+      std::size_t fAlignment = 1;
+      /// Owns the packed copy of the page until the compression task released it
+      std::unique_ptr<unsigned char[]> fPackedBuffer;
+      std::unique_ptr<unsigned char[]> fZippedBuffer;
+   };
+   /// Pages waiting for their compression task, in the order in which they were committed.  The memory held by their
+   /// buffers is accounted for in fNBytesBuffered.
+   std::vector<std::unique_ptr<RPendingPage>> fPendingPages;
+
+   /// Copies and packs the page and hands it to the task scheduler for compression.  The returned locator
+   /// is a placeholder that gets updated on CommitClusterImpl().
+   RClusterDescriptor::RLocator CommitPageAsync(ColumnHandle_t columnHandle, const RPage &page);
+   /// Waits for the compression tasks of the pending pages and writes them in order
+   void WritePendingPages();
+
 protected:
    void CreateImpl(const RNTupleModel &model) final;
    RClusterDescriptor::RLocator CommitPageImpl(ColumnHandle_t columnHandle, const RPage &page) final;
+   RClusterDescriptor::RLocator CommitSealedPageImpl(DescriptorId_t columnId, const RSealedPage &sealedPage) final;
    RClusterDescriptor::RLocator CommitClusterImpl(NTupleSize_t nEntries) final;
    void CommitDatasetImpl() final;
 
@@ -126,6 +149,7 @@ private:
       RNTupleAtomicCounter &fNClusterLoaded;
       RNTuplePlainCounter  &fNPageLoaded;
       RNTuplePlainCounter  &fNPagePopulated;
+      RNTuplePlainCounter  &fNPageMapped;
       RNTupleAtomicCounter &fTimeWallRead;
       RNTuplePlainCounter  &fTimeWallUnzip;
       RNTupleTickCounter<RNTupleAtomicCounter> &fTimeCpuRead;
@@ -149,10 +173,25 @@ private:
    Internal::RMiniFileReader fReader;
    /// The cluster pool asynchronously preloads the next few clusters
    std::unique_ptr<RClusterPool> fClusterPool;
+   /// The cluster whose pages have been decompressed in parallel and preloaded into the page pool
+   DescriptorId_t fUnzippedClusterId = kInvalidDescriptorId;
+   /// The columns of fUnzippedClusterId whose pages have been preloaded
+   ColumnSet_t fUnzippedColumns;
+   /// If memory mapping is requested by the read options, the mapping of the entire file
+   unsigned char *fMmapBase = nullptr;
+   std::uint64_t fMmapSize = 0;
 
    RPageSourceFile(std::string_view ntupleName, const RNTupleReadOptions &options);
    RPage PopulatePageFromCluster(ColumnHandle_t columnHandle, const RClusterDescriptor &clusterDescriptor,
                                  ClusterSize_t::ValueType clusterIndex);
+   /// Uses the task scheduler to decompress and unpack the pages of the active columns of the given cluster.
+   /// The resulting pages are preloaded into the page pool.  Pages of the previously unzipped cluster
+   /// that have not been used by now are evicted from the page pool.
+   void UnzipCluster(const RCluster &cluster);
+   /// Returns a page that points into the memory mapped file or a null page if the page needs to be copied, e.g. because
+   /// it is compressed or because its on-disk representation differs from the in-memory representation
+   RPage MapPageFromFile(ColumnHandle_t columnHandle, const RClusterDescriptor &clusterDescriptor,
+                         const RClusterDescriptor::RPageRange::RPageInfo &pageInfo, NTupleSize_t firstInPage);
 
 protected:
    RNTupleDescriptor AttachImpl() final;
@@ -21,6 +21,24 @@
 
 #include <iostream>
 
+namespace {
+
+/// Returns the split counterpart of a column type, or the type itself if there is no split encoding for it
+ROOT::Experimental::EColumnType GetSplitColumnType(ROOT::Experimental::EColumnType type)
+{
+   using ROOT::Experimental::EColumnType;
+   switch (type) {
+   case EColumnType::kIndex: return EColumnType::kSplitIndex;
+   case EColumnType::kReal64: return EColumnType::kSplitReal64;
+   case EColumnType::kReal32: return EColumnType::kSplitReal32;
+   case EColumnType::kInt64: return EColumnType::kSplitInt64;
+   case EColumnType::kInt32: return EColumnType::kSplitInt32;
+   default: return type;
+   }
+}
+
+} // anonymous namespace
+
 ROOT::Experimental::Detail::RColumn::RColumn(const RColumnModel& model, std::uint32_t index)
    : fModel(model), fIndex(index), fPageSink(nullptr), fPageSource(nullptr), fHeadPage(), fNElements(0),
      fCurrentPage(),
@@ -45,12 +63,24 @@ void ROOT::Experimental::Detail::RColumn::Connect(DescriptorId_t fieldId, RPageS
    switch (pageStorage->GetType()) {
    case EPageStorageType::kSink:
       fPageSink = static_cast<RPageSink*>(pageStorage); // the page sink initializes fHeadPage on AddColumn
+      if (fPageSink->GetWriteOptions().GetUseSplitEncoding()) {
+         auto splitType = GetSplitColumnType(fModel.GetType());
+         if (splitType != fModel.GetType())
+            SetOnDiskModel(RColumnModel(splitType, fModel.GetIsSorted()));
+      }
       fHandleSink = fPageSink->AddColumn(fieldId, *this);
       fHeadPage = fPageSink->ReservePage(fHandleSink);
       break;
    case EPageStorageType::kSource:
       fPageSource = static_cast<RPageSource*>(pageStorage);
       fHandleSource = fPageSource->AddColumn(fieldId, *this);
+      {
+         const auto &onDiskModel = fPageSource->GetDescriptor().GetColumnDescriptor(fHandleSource.fId).GetModel();
+         if (!(onDiskModel == fModel)) {
+            R__ASSERT(onDiskModel.GetType() == GetSplitColumnType(fModel.GetType()));
+            SetOnDiskModel(onDiskModel);
+         }
+      }
       fNElements = fPageSource->GetNElements(fHandleSource);
       fColumnIdSource = fPageSource->GetColumnId(fHandleSource);
       break;
@@ -59,6 +89,14 @@ void ROOT::Experimental::Detail::RColumn::Connect(DescriptorId_t fieldId, RPageS
    }
 }
 
+void ROOT::Experimental::Detail::RColumn::SetOnDiskModel(const RColumnModel &model)
+{
+   auto element = RColumnElementBase::Generate(model.GetType());
+   R__ASSERT(element->GetSize() == fElement->GetSize());
+   fModel = model;
+   fElement = std::move(element);
+}
+
 void ROOT::Experimental::Detail::RColumn::Flush()
 {
    if (fHeadPage.GetSize() == 0) return;
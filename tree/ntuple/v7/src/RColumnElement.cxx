@@ -20,31 +20,69 @@
 #include <algorithm>
 #include <bitset>
 #include <cstdint>
+#include <memory>
 
-ROOT::Experimental::Detail::RColumnElementBase
+namespace {
+
+/// Byte-splits count elements of N bytes each: the k-th byte of all the elements is stored contiguously.  The loops
+/// have a compile-time stride and no dependencies between iterations so that the compiler can vectorize them.
+template <std::size_t N>
+void SplitPack(unsigned char *dst, const unsigned char *src, std::size_t count)
+{
+   for (std::size_t b = 0; b < N; ++b) {
+      unsigned char *splitArray = dst + b * count;
+      for (std::size_t i = 0; i < count; ++i)
+         splitArray[i] = src[i * N + b];
+   }
+}
+
+/// Inverse of SplitPack()
+template <std::size_t N>
+void SplitUnpack(unsigned char *dst, const unsigned char *src, std::size_t count)
+{
+   for (std::size_t b = 0; b < N; ++b) {
+      const unsigned char *splitArray = src + b * count;
+      for (std::size_t i = 0; i < count; ++i)
+         dst[i * N + b] = splitArray[i];
+   }
+}
+
+} // anonymous namespace
+
+std::unique_ptr<ROOT::Experimental::Detail::RColumnElementBase>
 ROOT::Experimental::Detail::RColumnElementBase::Generate(EColumnType type) {
    switch (type) {
    case EColumnType::kReal32:
-      return RColumnElement<float, EColumnType::kReal32>(nullptr);
+      return std::make_unique<RColumnElement<float, EColumnType::kReal32>>(nullptr);
    case EColumnType::kReal64:
-      return RColumnElement<double, EColumnType::kReal64>(nullptr);
+      return std::make_unique<RColumnElement<double, EColumnType::kReal64>>(nullptr);
    case EColumnType::kByte:
-      return RColumnElement<std::uint8_t, EColumnType::kByte>(nullptr);
+      return std::make_unique<RColumnElement<std::uint8_t, EColumnType::kByte>>(nullptr);
    case EColumnType::kInt32:
-      return RColumnElement<std::int32_t, EColumnType::kInt32>(nullptr);
+      return std::make_unique<RColumnElement<std::int32_t, EColumnType::kInt32>>(nullptr);
    case EColumnType::kInt64:
-      return RColumnElement<std::int64_t, EColumnType::kInt64>(nullptr);
+      return std::make_unique<RColumnElement<std::int64_t, EColumnType::kInt64>>(nullptr);
    case EColumnType::kBit:
-      return RColumnElement<bool, EColumnType::kBit>(nullptr);
+      return std::make_unique<RColumnElement<bool, EColumnType::kBit>>(nullptr);
    case EColumnType::kIndex:
-      return RColumnElement<ClusterSize_t, EColumnType::kIndex>(nullptr);
+      return std::make_unique<RColumnElement<ClusterSize_t, EColumnType::kIndex>>(nullptr);
    case EColumnType::kSwitch:
-      return RColumnElement<RColumnSwitch, EColumnType::kSwitch>(nullptr);
+      return std::make_unique<RColumnElement<RColumnSwitch, EColumnType::kSwitch>>(nullptr);
+   case EColumnType::kSplitIndex:
+      return std::make_unique<RColumnElement<ClusterSize_t, EColumnType::kSplitIndex>>(nullptr);
+   case EColumnType::kSplitReal64:
+      return std::make_unique<RColumnElement<double, EColumnType::kSplitReal64>>(nullptr);
+   case EColumnType::kSplitReal32:
+      return std::make_unique<RColumnElement<float, EColumnType::kSplitReal32>>(nullptr);
+   case EColumnType::kSplitInt64:
+      return std::make_unique<RColumnElement<std::int64_t, EColumnType::kSplitInt64>>(nullptr);
+   case EColumnType::kSplitInt32:
+      return std::make_unique<RColumnElement<std::int32_t, EColumnType::kSplitInt32>>(nullptr);
    default:
       R__ASSERT(false);
    }
    // never here
-   return RColumnElementBase();
+   return nullptr;
 }
 
 void ROOT::Experimental::Detail::RColumnElement<bool, ROOT::Experimental::EColumnType::kBit>::Pack(
@@ -80,3 +118,110 @@ void ROOT::Experimental::Detail::RColumnElement<bool, ROOT::Experimental::EColum
       }
    }
 }
+
+void ROOT::Experimental::Detail::RColumnElement<float, ROOT::Experimental::EColumnType::kSplitReal32>::Pack(
+  void *dst, void *src, std::size_t count) const
+{
+   SplitPack<4>(reinterpret_cast<unsigned char *>(dst), reinterpret_cast<unsigned char *>(src), count);
+}
+
+void ROOT::Experimental::Detail::RColumnElement<float, ROOT::Experimental::EColumnType::kSplitReal32>::Unpack(
+  void *dst, void *src, std::size_t count) const
+{
+   SplitUnpack<4>(reinterpret_cast<unsigned char *>(dst), reinterpret_cast<unsigned char *>(src), count);
+}
+
+void ROOT::Experimental::Detail::RColumnElement<double, ROOT::Experimental::EColumnType::kSplitReal64>::Pack(
+  void *dst, void *src, std::size_t count) const
+{
+   SplitPack<8>(reinterpret_cast<unsigned char *>(dst), reinterpret_cast<unsigned char *>(src), count);
+}
+
+void ROOT::Experimental::Detail::RColumnElement<double, ROOT::Experimental::EColumnType::kSplitReal64>::Unpack(
+  void *dst, void *src, std::size_t count) const
+{
+   SplitUnpack<8>(reinterpret_cast<unsigned char *>(dst), reinterpret_cast<unsigned char *>(src), count);
+}
+
+void ROOT::Experimental::Detail::RColumnElement<std::int32_t, ROOT::Experimental::EColumnType::kSplitInt32>::Pack(
+  void *dst, void *src, std::size_t count) const
+{
+   SplitPack<4>(reinterpret_cast<unsigned char *>(dst), reinterpret_cast<unsigned char *>(src), count);
+}
+
+void ROOT::Experimental::Detail::RColumnElement<std::int32_t, ROOT::Experimental::EColumnType::kSplitInt32>::Unpack(
+  void *dst, void *src, std::size_t count) const
+{
+   SplitUnpack<4>(reinterpret_cast<unsigned char *>(dst), reinterpret_cast<unsigned char *>(src), count);
+}
+
+void ROOT::Experimental::Detail::RColumnElement<std::uint32_t, ROOT::Experimental::EColumnType::kSplitInt32>::Pack(
+  void *dst, void *src, std::size_t count) const
+{
+   SplitPack<4>(reinterpret_cast<unsigned char *>(dst), reinterpret_cast<unsigned char *>(src), count);
+}
+
+void ROOT::Experimental::Detail::RColumnElement<std::uint32_t, ROOT::Experimental::EColumnType::kSplitInt32>::Unpack(
+  void *dst, void *src, std::size_t count) const
+{
+   SplitUnpack<4>(reinterpret_cast<unsigned char *>(dst), reinterpret_cast<unsigned char *>(src), count);
+}
+
+void ROOT::Experimental::Detail::RColumnElement<std::int64_t, ROOT::Experimental::EColumnType::kSplitInt64>::Pack(
+  void *dst, void *src, std::size_t count) const
+{
+   SplitPack<8>(reinterpret_cast<unsigned char *>(dst), reinterpret_cast<unsigned char *>(src), count);
+}
+
+void ROOT::Experimental::Detail::RColumnElement<std::int64_t, ROOT::Experimental::EColumnType::kSplitInt64>::Unpack(
+  void *dst, void *src, std::size_t count) const
+{
+   SplitUnpack<8>(reinterpret_cast<unsigned char *>(dst), reinterpret_cast<unsigned char *>(src), count);
+}
+
+void ROOT::Experimental::Detail::RColumnElement<std::uint64_t, ROOT::Experimental::EColumnType::kSplitInt64>::Pack(
+  void *dst, void *src, std::size_t count) const
+{
+   SplitPack<8>(reinterpret_cast<unsigned char *>(dst), reinterpret_cast<unsigned char *>(src), count);
+}
+
+void ROOT::Experimental::Detail::RColumnElement<std::uint64_t, ROOT::Experimental::EColumnType::kSplitInt64>::Unpack(
+  void *dst, void *src, std::size_t count) const
+{
+   SplitUnpack<8>(reinterpret_cast<unsigned char *>(dst), reinterpret_cast<unsigned char *>(src), count);
+}
+
+void ROOT::Experimental::Detail::RColumnElement<ROOT::Experimental::ClusterSize_t,
+                                                ROOT::Experimental::EColumnType::kSplitIndex>::Pack(
+  void *dst, void *src, std::size_t count) const
+{
+   // Offsets are monotonic within a cluster; their differences are small and, after zigzag encoding, leave the
+   // higher bytes mostly zero.  The first element of the page is stored relative to zero.
+   auto indexArray = reinterpret_cast<ClusterSize_t *>(src);
+   auto splitArray = reinterpret_cast<unsigned char *>(dst);
+   ClusterSize_t::ValueType prev = 0;
+   for (std::size_t i = 0; i < count; ++i) {
+      const auto delta = static_cast<std::int32_t>(indexArray[i].fValue - prev);
+      const auto zigzag = (static_cast<std::uint32_t>(delta) << 1) ^ static_cast<std::uint32_t>(delta >> 31);
+      prev = indexArray[i].fValue;
+      for (std::size_t b = 0; b < sizeof(zigzag); ++b)
+         splitArray[b * count + i] = (zigzag >> (8 * b)) & 0xff;
+   }
+}
+
+void ROOT::Experimental::Detail::RColumnElement<ROOT::Experimental::ClusterSize_t,
+                                                ROOT::Experimental::EColumnType::kSplitIndex>::Unpack(
+  void *dst, void *src, std::size_t count) const
+{
+   auto indexArray = reinterpret_cast<ClusterSize_t *>(dst);
+   auto splitArray = reinterpret_cast<unsigned char *>(src);
+   ClusterSize_t::ValueType prev = 0;
+   for (std::size_t i = 0; i < count; ++i) {
+      std::uint32_t zigzag = 0;
+      for (std::size_t b = 0; b < sizeof(zigzag); ++b)
+         zigzag |= static_cast<std::uint32_t>(splitArray[b * count + i]) << (8 * b);
+      const auto delta = (zigzag >> 1) ^ (0U - (zigzag & 1));
+      prev += delta;
+      indexArray[i] = prev;
+   }
+}
@@ -1041,7 +1041,8 @@ std::uint64_t ROOT::Experimental::Internal::RNTupleFileWriter::RFileSimple::Writ
    std::uint64_t directoryOffset,
    const std::string &className,
    const std::string &objectName,
-   const std::string &title)
+   const std::string &title,
+   std::size_t alignment)
 {
    if (offset < 0)
       offset = fFilePos;
@@ -1050,6 +1051,11 @@ std::uint64_t ROOT::Experimental::Internal::RNTupleFileWriter::RFileSimple::Writ
    RTFString strTitle{title};
 
    RTFKey key(offset, directoryOffset, strClass, strObject, strTitle, len, nbytes);
+   const auto misalignment = (offset + key.fKeyLen) % alignment;
+   if (misalignment != 0) {
+      strTitle = RTFString(title + std::string(alignment - misalignment, ' '));
+      key = RTFKey(offset, directoryOffset, strClass, strObject, strTitle, len, nbytes);
+   }
    Write(&key, key.fKeyHeaderSize, offset);
    Write(&strClass, strClass.GetSize());
    Write(&strObject, strObject.GetSize());
@@ -1076,17 +1082,25 @@ void ROOT::Experimental::Internal::RNTupleFileWriter::RFileProper::Write(
 
 
 std::uint64_t ROOT::Experimental::Internal::RNTupleFileWriter::RFileProper::WriteKey(
-   const void *buffer, size_t nbytes, size_t len)
+   const void *buffer, size_t nbytes, size_t len, size_t alignment)
 {
    std::uint64_t offsetKey;
    RKeyBlob keyBlob(fFile);
-   keyBlob.Reserve(nbytes, &offsetKey);
+   keyBlob.Reserve(nbytes + alignment - 1, &offsetKey);
 
    auto offset = offsetKey;
    RTFString strClass{kBlobClassName};
    RTFString strObject;
    RTFString strTitle;
    RTFKey keyHeader(offset, offset, strClass, strObject, strTitle, len, nbytes);
+   // Move the record to the next multiple of alignment by padding the title.  The remaining reserved bytes trail
+   // the record, so that the key still spans the reserved space.
+   const auto padding = (alignment - (offset + keyHeader.fKeyLen) % alignment) % alignment;
+   const auto trailing = alignment - 1 - padding;
+   if (alignment > 1) {
+      strTitle = RTFString(std::string(padding, ' '));
+      keyHeader = RTFKey(offset, offset, strClass, strObject, strTitle, len, nbytes + trailing);
+   }
 
    Write(&keyHeader, keyHeader.fKeyHeaderSize, offset);
    offset += keyHeader.fKeyHeaderSize;
@@ -1098,6 +1112,10 @@ std::uint64_t ROOT::Experimental::Internal::RNTupleFileWriter::RFileProper::Writ
    offset += strTitle.GetSize();
    auto offsetData = offset;
    Write(buffer, nbytes, offset);
+   if (trailing > 0) {
+      const std::string zeros(trailing, '\0');
+      Write(zeros.data(), trailing, offset + nbytes);
+   }
 
    return offsetData;
 }
@@ -1212,18 +1230,24 @@ void ROOT::Experimental::Internal::RNTupleFileWriter::Commit()
 }
 
 
-std::uint64_t ROOT::Experimental::Internal::RNTupleFileWriter::WriteBlob(const void *data, size_t nbytes, size_t len)
+std::uint64_t
+ROOT::Experimental::Internal::RNTupleFileWriter::WriteBlob(const void *data, size_t nbytes, size_t len, size_t alignment)
 {
    std::uint64_t offset;
    if (fFileSimple) {
       if (fIsBare) {
+         const auto misalignment = fFileSimple.fFilePos % alignment;
+         if (misalignment != 0) {
+            const std::string zeros(alignment - misalignment, '\0');
+            fFileSimple.Write(zeros.data(), zeros.size());
+         }
          offset = fFileSimple.fFilePos;
          fFileSimple.Write(data, nbytes);
       } else {
-         offset = fFileSimple.WriteKey(data, nbytes, len, -1, 100, kBlobClassName);
+         offset = fFileSimple.WriteKey(data, nbytes, len, -1, 100, kBlobClassName, "", "", alignment);
       }
    } else {
-      offset = fFileProper.WriteKey(data, nbytes, len);
+      offset = fFileProper.WriteKey(data, nbytes, len, alignment);
    }
    return offset;
 }
@@ -17,6 +17,7 @@
 
 #include "ROOT/RFieldVisitor.hxx"
 #include "ROOT/RNTupleModel.hxx"
+#include "ROOT/RPageSinkBuf.hxx"
 #include "ROOT/RPageStorage.hxx"
 
 #include <algorithm>
@@ -29,6 +30,41 @@
 #include <utility>
 
 #include <TError.h>
+#include <TROOT.h> // for IsImplicitMTEnabled()
+
+#ifdef R__USE_IMT
+#include <ROOT/TTaskGroup.hxx>
+#endif
+
+
+#ifdef R__USE_IMT
+ROOT::Experimental::Detail::RNTupleImtTaskScheduler::RNTupleImtTaskScheduler()
+{
+   Reset();
+}
+
+ROOT::Experimental::Detail::RNTupleImtTaskScheduler::~RNTupleImtTaskScheduler()
+{
+}
+
+void ROOT::Experimental::Detail::RNTupleImtTaskScheduler::Reset()
+{
+   fTaskGroup = std::make_unique<TTaskGroup>();
+}
+
+void ROOT::Experimental::Detail::RNTupleImtTaskScheduler::AddTask(const std::function<void(void)> &taskFunc)
+{
+   fTaskGroup->Run(taskFunc);
+}
+
+void ROOT::Experimental::Detail::RNTupleImtTaskScheduler::Wait()
+{
+   fTaskGroup->Wait();
+}
+#endif
+
+
+//------------------------------------------------------------------------------
 
 
 void ROOT::Experimental::RNTupleReader::ConnectModel(const RNTupleModel &model) {
@@ -43,6 +79,18 @@ void ROOT::Experimental::RNTupleReader::ConnectModel(const RNTupleModel &model)
    }
 }
 
+void ROOT::Experimental::RNTupleReader::InitPageSource()
+{
+#ifdef R__USE_IMT
+   if (IsImplicitMTEnabled() && fSource->GetReadOptions().GetUseParallelDecompression()) {
+      fUnzipTasks = std::make_unique<Detail::RNTupleImtTaskScheduler>();
+      fSource->SetTaskScheduler(fUnzipTasks.get());
+   }
+#endif
+   fSource->Attach();
+   fMetrics.ObserveMetrics(fSource->GetMetrics());
+}
+
 ROOT::Experimental::RNTupleReader::RNTupleReader(
    std::unique_ptr<ROOT::Experimental::RNTupleModel> model,
    std::unique_ptr<ROOT::Experimental::Detail::RPageSource> source)
@@ -50,9 +98,8 @@ ROOT::Experimental::RNTupleReader::RNTupleReader(
    , fModel(std::move(model))
    , fMetrics("RNTupleReader")
 {
-   fSource->Attach();
+   InitPageSource();
    ConnectModel(*fModel);
-   fMetrics.ObserveMetrics(fSource->GetMetrics());
 }
 
 ROOT::Experimental::RNTupleReader::RNTupleReader(std::unique_ptr<ROOT::Experimental::Detail::RPageSource> source)
@@ -60,8 +107,7 @@ ROOT::Experimental::RNTupleReader::RNTupleReader(std::unique_ptr<ROOT::Experimen
    , fModel(nullptr)
    , fMetrics("RNTupleReader")
 {
-   fSource->Attach();
-   fMetrics.ObserveMetrics(fSource->GetMetrics());
+   InitPageSource();
 }
 
 ROOT::Experimental::RNTupleReader::~RNTupleReader()
@@ -94,6 +140,31 @@ ROOT::Experimental::RNTupleModel *ROOT::Experimental::RNTupleReader::GetModel()
    return fModel.get();
 }
 
+std::vector<ROOT::Experimental::RNTupleGlobalRange>
+ROOT::Experimental::RNTupleReader::GetEntryRanges(std::string_view fieldName, double min, double max)
+{
+   const auto &desc = fSource->GetDescriptor();
+   auto fieldId = desc.FindFieldId(fieldName);
+   if (fieldId == kInvalidDescriptorId)
+      throw RException(R__FAIL("no field named '" + std::string(fieldName) + "' in RNTuple '" + desc.GetName() + "'"));
+
+   std::vector<RNTupleGlobalRange> result;
+   NTupleSize_t start = 0;
+   NTupleSize_t end = 0;
+   for (auto clusterId : desc.SelectClusterIds(fieldId, min, max)) {
+      const auto &clusterDesc = desc.GetClusterDescriptor(clusterId);
+      if (clusterDesc.GetFirstEntryIndex() != end) {
+         if (end > start)
+            result.emplace_back(start, end);
+         start = clusterDesc.GetFirstEntryIndex();
+      }
+      end = clusterDesc.GetFirstEntryIndex() + clusterDesc.GetNEntries();
+   }
+   if (end > start)
+      result.emplace_back(start, end);
+   return result;
+}
+
 void ROOT::Experimental::RNTupleReader::PrintInfo(const ENTupleInfo what, std::ostream &output)
 {
    // TODO(lesimon): In a later version, these variables may be defined by the user or the ideal width may be read out from the terminal.
@@ -212,10 +283,16 @@ ROOT::Experimental::RNTupleWriter::RNTupleWriter(
    std::unique_ptr<ROOT::Experimental::Detail::RPageSink> sink)
    : fSink(std::move(sink))
    , fModel(std::move(model))
-   , fClusterSizeEntries(kDefaultClusterSizeEntries)
+   , fApproxZippedClusterSize(fSink->GetWriteOptions().GetApproxZippedClusterSize())
    , fLastCommitted(0)
    , fNEntries(0)
 {
+#ifdef R__USE_IMT
+   if (IsImplicitMTEnabled() && fSink->GetWriteOptions().GetUseParallelCompression()) {
+      fZipTasks = std::make_unique<Detail::RNTupleImtTaskScheduler>();
+      fSink->SetTaskScheduler(fZipTasks.get());
+   }
+#endif
    fSink->Create(*fModel.get());
 }
 
@@ -250,6 +327,72 @@ void ROOT::Experimental::RNTupleWriter::CommitCluster()
 //------------------------------------------------------------------------------
 
 
+ROOT::Experimental::RNTupleFillContext::RNTupleFillContext(std::unique_ptr<RNTupleModel> model,
+                                                           std::unique_ptr<Detail::RPageSink> sink)
+   : fSink(std::move(sink))
+   , fModel(std::move(model))
+   , fApproxZippedClusterSize(fSink->GetWriteOptions().GetApproxZippedClusterSize())
+   , fPageBufferBudget(fSink->GetWriteOptions().GetPageBufferBudget())
+{
+   fSink->Create(*fModel.get());
+}
+
+ROOT::Experimental::RNTupleFillContext::~RNTupleFillContext()
+{
+   CommitCluster();
+}
+
+void ROOT::Experimental::RNTupleFillContext::CommitCluster()
+{
+   if (fNEntries == fLastCommitted) return;
+   for (auto& field : *fModel->GetFieldZero()) {
+      field.Flush();
+      field.CommitCluster();
+   }
+   fSink->CommitCluster(fNEntries);
+   fLastCommitted = fNEntries;
+}
+
+
+//------------------------------------------------------------------------------
+
+
+ROOT::Experimental::RNTupleParallelWriter::RNTupleParallelWriter(std::unique_ptr<RNTupleModel> model,
+                                                                 std::unique_ptr<Detail::RPageSink> sink)
+   : fSink(std::move(sink))
+   , fModel(std::move(model))
+{
+   fSink->Create(*fModel.get());
+}
+
+ROOT::Experimental::RNTupleParallelWriter::~RNTupleParallelWriter()
+{
+   fSink->CommitDataset();
+}
+
+std::unique_ptr<ROOT::Experimental::RNTupleParallelWriter> ROOT::Experimental::RNTupleParallelWriter::Recreate(
+   std::unique_ptr<RNTupleModel> model,
+   std::string_view ntupleName,
+   std::string_view storage,
+   const RNTupleWriteOptions &options)
+{
+   return std::make_unique<RNTupleParallelWriter>(std::move(model),
+                                                  Detail::RPageSink::Create(ntupleName, storage, options));
+}
+
+std::unique_ptr<ROOT::Experimental::RNTupleFillContext> ROOT::Experimental::RNTupleParallelWriter::CreateFillContext()
+{
+   std::lock_guard<std::mutex> guard(fSinkMutex);
+   auto model = std::unique_ptr<RNTupleModel>(fModel->Clone());
+   auto sink = std::make_unique<Detail::RPageSinkBuf>(*fSink, fSinkMutex);
+   // Cannot use std::make_unique because the constructor is private
+   return std::unique_ptr<RNTupleFillContext>(new RNTupleFillContext(std::move(model), std::move(sink)));
+}
+
+
+//------------------------------------------------------------------------------
+
+
 ROOT::Experimental::RCollectionNTuple::RCollectionNTuple(std::unique_ptr<REntry> defaultEntry)
    : fOffset(0), fDefaultEntry(std::move(defaultEntry))
 {
@@ -353,6 +353,46 @@ std::uint32_t DeserializeColumnRange(const void *buffer,
    return 20;
 }
 
+std::uint32_t SerializeDouble(double val, void *buffer)
+{
+   std::uint64_t bits;
+   static_assert(sizeof(bits) == sizeof(val), "unsupported double representation");
+   memcpy(&bits, &val, sizeof(bits));
+   return SerializeUInt64(bits, buffer);
+}
+
+std::uint32_t DeserializeDouble(const void *buffer, double *val)
+{
+   std::uint64_t bits;
+   auto size = DeserializeUInt64(buffer, &bits);
+   memcpy(val, &bits, sizeof(bits));
+   return size;
+}
+
+std::uint32_t SerializeColumnStatistics(const ROOT::Experimental::RClusterDescriptor::RColumnStatistics &val,
+   void *buffer)
+{
+   if (buffer != nullptr) {
+      auto pos = reinterpret_cast<unsigned char *>(buffer);
+      // The column id is stored in SerializeClusterSummary()
+      pos += SerializeDouble(val.fMin, pos);
+      pos += SerializeDouble(val.fMax, pos);
+      pos += SerializeUInt64(val.fNEmpty, pos);
+   }
+   return 24;
+}
+
+std::uint32_t DeserializeColumnStatistics(const void *buffer,
+   ROOT::Experimental::RClusterDescriptor::RColumnStatistics *statistics)
+{
+   auto bytes = reinterpret_cast<const unsigned char *>(buffer);
+   bytes += DeserializeDouble(bytes, &statistics->fMin);
+   bytes += DeserializeDouble(bytes, &statistics->fMax);
+   bytes += DeserializeUInt64(bytes, &statistics->fNEmpty);
+   statistics->fIsValid = true;
+   return 24;
+}
+
 std::uint32_t SerializePageInfo(const ROOT::Experimental::RClusterDescriptor::RPageRange::RPageInfo &val, void *buffer)
 {
    // To keep the cluster footers small, we don't put a frame around individual page infos.
@@ -444,7 +484,8 @@ std::uint32_t SerializeColumn(const ROOT::Experimental::RColumnDescriptor &val,
    return size;
 }
 
-std::uint32_t SerializeClusterSummary(const ROOT::Experimental::RClusterDescriptor &val, void *buffer)
+std::uint32_t SerializeClusterSummary(const ROOT::Experimental::RClusterDescriptor &val,
+   const std::vector<ROOT::Experimental::DescriptorId_t> &columnIds, void *buffer)
 {
    auto base = reinterpret_cast<unsigned char *>((buffer != nullptr) ? buffer : 0);
    auto pos = base;
@@ -460,6 +501,21 @@ std::uint32_t SerializeClusterSummary(const ROOT::Experimental::RClusterDescript
    pos += SerializeUInt64(val.GetNEntries(), *where);
    pos += SerializeLocator(val.GetLocator(), *where);
 
+   // The column statistics are appended to the cluster summary so that readers unaware of them can skip them
+   std::uint32_t nStatistics = 0;
+   for (auto columnId : columnIds) {
+      if (val.GetColumnRange(columnId).fStatistics.fIsValid)
+         nStatistics++;
+   }
+   pos += SerializeUInt32(nStatistics, *where);
+   for (auto columnId : columnIds) {
+      const auto &statistics = val.GetColumnRange(columnId).fStatistics;
+      if (!statistics.fIsValid)
+         continue;
+      pos += SerializeUInt64(columnId, *where);
+      pos += SerializeColumnStatistics(statistics, *where);
+   }
+
    auto size = pos - base;
    SerializeUInt32(size, ptrSize);
    return size;
@@ -577,10 +633,14 @@ std::uint32_t ROOT::Experimental::RNTupleDescriptor::SerializeFooter(void* buffe
       RNTupleDescriptor::kFrameVersionCurrent, RNTupleDescriptor::kFrameVersionMin, *where, &ptrSize);
    pos += SerializeUInt64(0, *where); // reserved; can be at some point used, e.g., for compression flags
 
+   std::vector<DescriptorId_t> columnIds;
+   for (const auto& column : fColumnDescriptors)
+      columnIds.emplace_back(column.first);
+
    pos += SerializeUInt64(fClusterDescriptors.size(), *where);
    for (const auto& cluster : fClusterDescriptors) {
       pos += SerializeUuid(fOwnUuid, *where); // in order to verify that header and footer belong together
-      pos += SerializeClusterSummary(cluster.second, *where);
+      pos += SerializeClusterSummary(cluster.second, columnIds, *where);
 
       pos += SerializeUInt32(fColumnDescriptors.size(), *where);
       for (const auto& column : fColumnDescriptors) {
@@ -729,6 +789,26 @@ ROOT::Experimental::RNTupleDescriptor::FindPrevClusterId(DescriptorId_t clusterI
 }
 
 
+std::vector<ROOT::Experimental::DescriptorId_t>
+ROOT::Experimental::RNTupleDescriptor::SelectClusterIds(DescriptorId_t fieldId, double min, double max) const
+{
+   auto columnId = FindColumnId(fieldId, 0);
+   std::vector<DescriptorId_t> result;
+   for (const auto &cd : fClusterDescriptors) {
+      if (columnId != kInvalidDescriptorId &&
+          !cd.second.GetColumnRange(columnId).fStatistics.MayOverlap(min, max))
+      {
+         continue;
+      }
+      result.emplace_back(cd.first);
+   }
+   std::sort(result.begin(), result.end(), [this](DescriptorId_t a, DescriptorId_t b) {
+      return GetClusterDescriptor(a).GetFirstEntryIndex() < GetClusterDescriptor(b).GetFirstEntryIndex();
+   });
+   return result;
+}
+
+
 std::unique_ptr<ROOT::Experimental::RNTupleModel> ROOT::Experimental::RNTupleDescriptor::GenerateModel() const
 {
    auto model = std::make_unique<RNTupleModel>();
@@ -851,6 +931,18 @@ void ROOT::Experimental::RNTupleDescriptorBuilder::AddClustersFromFooter(void* f
       pos += DeserializeLocator(pos, &locator);
       SetClusterLocator(clusterId, locator);
 
+      // Column statistics are only present in ntuples written by newer versions
+      std::unordered_map<DescriptorId_t, RClusterDescriptor::RColumnStatistics> statistics;
+      if (pos < clusterBase + frameSize) {
+         std::uint32_t nStatistics;
+         pos += DeserializeUInt32(pos, &nStatistics);
+         for (std::uint32_t j = 0; j < nStatistics; ++j) {
+            std::uint64_t columnId;
+            pos += DeserializeUInt64(pos, &columnId);
+            pos += DeserializeColumnStatistics(pos, &statistics[columnId]);
+         }
+      }
+
       pos = clusterBase + frameSize;
 
       std::uint32_t nColumns;
@@ -862,6 +954,9 @@ void ROOT::Experimental::RNTupleDescriptorBuilder::AddClustersFromFooter(void* f
          RClusterDescriptor::RColumnRange columnRange;
          columnRange.fColumnId = columnId;
          pos += DeserializeColumnRange(pos, &columnRange);
+         auto itrStatistics = statistics.find(columnId);
+         if (itrStatistics != statistics.end())
+            columnRange.fStatistics = itrStatistics->second;
          AddClusterColumnRange(clusterId, columnRange);
 
          RClusterDescriptor::RPageRange pageRange;
@@ -20,6 +20,14 @@
 
 #include <cstdlib>
 
+ROOT::Experimental::Detail::RPagePool::~RPagePool()
+{
+   for (unsigned i = 0; i < fPages.size(); ++i) {
+      if (fReferences[i] == 0)
+         fDeleters[i](fPages[i]);
+   }
+}
+
 void ROOT::Experimental::Detail::RPagePool::RegisterPage(const RPage &page, const RPageDeleter &deleter)
 {
    fPages.emplace_back(page);
@@ -27,6 +35,32 @@ void ROOT::Experimental::Detail::RPagePool::RegisterPage(const RPage &page, cons
    fDeleters.emplace_back(deleter);
 }
 
+void ROOT::Experimental::Detail::RPagePool::PreloadPage(const RPage &page, const RPageDeleter &deleter)
+{
+   fPages.emplace_back(page);
+   fReferences.emplace_back(0);
+   fDeleters.emplace_back(deleter);
+}
+
+void ROOT::Experimental::Detail::RPagePool::Evict(DescriptorId_t clusterId)
+{
+   for (unsigned i = 0; i < fPages.size(); ) {
+      if ((fReferences[i] > 0) || (fPages[i].GetClusterInfo().GetId() != clusterId)) {
+         ++i;
+         continue;
+      }
+
+      unsigned int N = fPages.size();
+      fDeleters[i](fPages[i]);
+      fPages[i] = fPages[N-1];
+      fReferences[i] = fReferences[N-1];
+      fDeleters[i] = fDeleters[N-1];
+      fPages.resize(N-1);
+      fReferences.resize(N-1);
+      fDeleters.resize(N-1);
+   }
+}
+
 void ROOT::Experimental::Detail::RPagePool::ReturnPage(const RPage& page)
 {
    if (page.IsNull()) return;
@@ -54,7 +88,6 @@ ROOT::Experimental::Detail::RPage ROOT::Experimental::Detail::RPagePool::GetPage
 {
    unsigned int N = fPages.size();
    for (unsigned int i = 0; i < N; ++i) {
-      if (fReferences[i] == 0) continue;
       if (fPages[i].GetColumnId() != columnId) continue;
       if (!fPages[i].Contains(globalIndex)) continue;
       fReferences[i]++;
@@ -68,7 +101,6 @@ ROOT::Experimental::Detail::RPage ROOT::Experimental::Detail::RPagePool::GetPage
 {
    unsigned int N = fPages.size();
    for (unsigned int i = 0; i < N; ++i) {
-      if (fReferences[i] == 0) continue;
       if (fPages[i].GetColumnId() != columnId) continue;
       if (!fPages[i].Contains(clusterIndex)) continue;
       fReferences[i]++;
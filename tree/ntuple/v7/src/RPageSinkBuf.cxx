@@ -0,0 +1,109 @@
+/// \file RPageSinkBuf.cxx
+/// \ingroup NTuple ROOT7
+/// \date 2020-08-03
+/// \warning This is part of the ROOT 7 prototype! It will change without notice. It might trigger earthquakes. Feedback
+/// is welcome!
+
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include <ROOT/RColumn.hxx>
+#include <ROOT/RColumnElement.hxx>
+#include <ROOT/RPageAllocator.hxx>
+#include <ROOT/RPageSinkBuf.hxx>
+
+#include <cstring>
+#include <utility>
+
+ROOT::Experimental::Detail::RPageSinkBuf::RPageSinkBuf(RPageSink &innerSink, std::mutex &innerSinkLock)
+   : RPageSink(innerSink.GetNTupleName(), innerSink.GetWriteOptions())
+   , fInnerSink(innerSink)
+   , fInnerSinkLock(innerSinkLock)
+   , fPageAllocator(std::make_unique<RPageAllocatorHeap>())
+{
+}
+
+ROOT::Experimental::Detail::RPageSinkBuf::~RPageSinkBuf()
+{
+}
+
+void ROOT::Experimental::Detail::RPageSinkBuf::CreateImpl(const RNTupleModel & /* model */)
+{
+   fBufferedPages.resize(fLastColumnId);
+}
+
+ROOT::Experimental::RClusterDescriptor::RLocator
+ROOT::Experimental::Detail::RPageSinkBuf::CommitPageImpl(ColumnHandle_t columnHandle, const RPage &page)
+{
+   RBufferedPage bufferedPage;
+   // The packed page is never larger than the in-memory page; compression falls back to a verbatim copy
+   bufferedPage.fBuffer = std::unique_ptr<unsigned char[]>(new unsigned char[page.GetSize()]);
+   bufferedPage.fSealedPage =
+      SealPage(page, *columnHandle.fColumn->GetElement(), fOptions.GetCompression(), bufferedPage.fBuffer.get());
+   // The column reuses its page buffer after the commit
+   if (bufferedPage.fSealedPage.fBuffer != bufferedPage.fBuffer.get()) {
+      memcpy(bufferedPage.fBuffer.get(), bufferedPage.fSealedPage.fBuffer, bufferedPage.fSealedPage.fSize);
+      bufferedPage.fSealedPage.fBuffer = bufferedPage.fBuffer.get();
+   }
+   // Only the size of the locator is meaningful; it lets the base class keep track of the cluster size
+   RClusterDescriptor::RLocator result;
+   result.fBytesOnStorage = bufferedPage.fSealedPage.fSize;
+   fNBytesBuffered += page.GetSize();
+   fBufferedPages[columnHandle.fId].emplace_back(std::move(bufferedPage));
+   return result;
+}
+
+ROOT::Experimental::RClusterDescriptor::RLocator
+ROOT::Experimental::Detail::RPageSinkBuf::CommitSealedPageImpl(DescriptorId_t columnId, const RSealedPage &sealedPage)
+{
+   RBufferedPage bufferedPage;
+   bufferedPage.fBuffer = std::unique_ptr<unsigned char[]>(new unsigned char[sealedPage.fSize]);
+   memcpy(bufferedPage.fBuffer.get(), sealedPage.fBuffer, sealedPage.fSize);
+   bufferedPage.fSealedPage = RSealedPage(bufferedPage.fBuffer.get(), sealedPage.fSize, sealedPage.fNElements);
+   fNBytesBuffered += sealedPage.fSize;
+   fBufferedPages[columnId].emplace_back(std::move(bufferedPage));
+   RClusterDescriptor::RLocator result;
+   result.fBytesOnStorage = sealedPage.fSize;
+   return result;
+}
+
+ROOT::Experimental::RClusterDescriptor::RLocator
+ROOT::Experimental::Detail::RPageSinkBuf::CommitClusterImpl(ROOT::Experimental::NTupleSize_t nEntries)
+{
+   {
+      std::lock_guard<std::mutex> guard(fInnerSinkLock);
+      for (DescriptorId_t columnId = 0; columnId < fBufferedPages.size(); ++columnId) {
+         for (const auto &bufferedPage : fBufferedPages[columnId])
+            fInnerSink.CommitSealedPage(columnId, bufferedPage.fSealedPage);
+         fInnerSink.CommitColumnStatistics(columnId, fOpenColumnRanges[columnId].fStatistics);
+      }
+      fInnerSink.CommitCluster(fInnerSink.GetNEntries() + (nEntries - fPrevClusterNEntries));
+   }
+
+   for (auto &pages : fBufferedPages)
+      pages.clear();
+   fNBytesBuffered = 0;
+   // The buffered sink does not store anything itself
+   return RClusterDescriptor::RLocator();
+}
+
+ROOT::Experimental::Detail::RPage
+ROOT::Experimental::Detail::RPageSinkBuf::ReservePage(ColumnHandle_t columnHandle, std::size_t nElements)
+{
+   auto elementSize = columnHandle.fColumn->GetElement()->GetSize();
+   if (nElements == 0)
+      nElements = GetNElementsPerPage(elementSize);
+   fNBytesHeadPages += nElements * elementSize;
+   return fPageAllocator->NewPage(columnHandle.fId, elementSize, nElements);
+}
+
+void ROOT::Experimental::Detail::RPageSinkBuf::ReleasePage(RPage &page)
+{
+   fNBytesHeadPages -= page.GetCapacity() * page.GetElementSize();
+   fPageAllocator->DeletePage(page);
+}
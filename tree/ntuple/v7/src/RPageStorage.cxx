@@ -16,9 +16,12 @@
 #include <ROOT/RPageStorage.hxx>
 #include <ROOT/RPageStorageFile.hxx>
 #include <ROOT/RColumn.hxx>
+#include <ROOT/RColumnElement.hxx>
+#include <ROOT/RError.hxx>
 #include <ROOT/RField.hxx>
 #include <ROOT/RNTupleMetrics.hxx>
 #include <ROOT/RNTupleModel.hxx>
+#include <ROOT/RNTupleZip.hxx>
 #include <ROOT/RPagePool.hxx>
 #include <ROOT/RPageStorageFile.hxx>
 #include <ROOT/RStringView.hxx>
@@ -26,9 +29,51 @@
 #include <Compression.h>
 #include <TError.h>
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <type_traits>
 #include <unordered_map>
 #include <utility>
 
+namespace {
+
+/// Converts a column value to a bound of the column statistics.  64bit integers that cannot be represented exactly
+/// are rounded outwards so that the statistics never exclude actual values.
+template <typename T>
+double ToBound(T val, double direction)
+{
+   auto result = static_cast<double>(val);
+   if (std::is_integral<T>::value && (sizeof(T) == 8) && (std::abs(result) >= 9007199254740992.0))
+      result = std::nextafter(result, direction);
+   return result;
+}
+
+template <typename T>
+void UpdateMinMax(const void *buffer, std::size_t nElements,
+                  ROOT::Experimental::RClusterDescriptor::RColumnStatistics &statistics)
+{
+   auto values = reinterpret_cast<const T *>(buffer);
+   auto min = std::numeric_limits<T>::max();
+   auto max = std::numeric_limits<T>::lowest();
+   for (std::size_t i = 0; i < nElements; ++i) {
+      // Written such that NaN values are skipped
+      if (values[i] < min)
+         min = values[i];
+      if (values[i] > max)
+         max = values[i];
+   }
+
+   ROOT::Experimental::RClusterDescriptor::RColumnStatistics pageStatistics;
+   pageStatistics.fIsValid = true;
+   pageStatistics.fMin = ToBound(min, -HUGE_VAL);
+   pageStatistics.fMax = ToBound(max, HUGE_VAL);
+   statistics.Merge(pageStatistics);
+}
+
+} // anonymous namespace
+
 
 ROOT::Experimental::Detail::RPageStorage::RPageStorage(std::string_view name) : fNTupleName(name)
 {
@@ -118,10 +163,19 @@ ROOT::Experimental::Detail::RPageSink::AddColumn(DescriptorId_t fieldId, const R
 {
    auto columnId = fLastColumnId++;
    fDescriptorBuilder.AddColumn(columnId, fieldId, column.GetVersion(), column.GetModel(), column.GetIndex());
+   fElementSizes.emplace_back(column.GetElement()->GetSize());
    return ColumnHandle_t{columnId, &column};
 }
 
 
+std::size_t ROOT::Experimental::Detail::RPageSink::GetNElementsPerPage(std::size_t elementSize) const
+{
+   if (fOptions.GetApproxUnzippedPageSize() == 0)
+      return kDefaultElementsPerPage;
+   return std::max(std::size_t(1), fOptions.GetApproxUnzippedPageSize() / elementSize);
+}
+
+
 void ROOT::Experimental::Detail::RPageSink::Create(RNTupleModel &model)
 {
    fDescriptorBuilder.SetNTuple(fNTupleName, model.GetDescription(), "undefined author",
@@ -140,6 +194,11 @@ void ROOT::Experimental::Detail::RPageSink::Create(RNTupleModel &model)
       Detail::RFieldFuse::Connect(fLastFieldId, *this, f); // issues in turn one or several calls to AddColumn()
       fieldPtr2Id[&f] = fLastFieldId++;
    }
+   if (fNBytesHeadPages > fOptions.GetPageBufferBudget()) {
+      throw RException(R__FAIL("the open pages of the " + std::to_string(fLastColumnId) + " columns require " +
+                               std::to_string(fNBytesHeadPages) + " bytes, more than the page buffer budget of " +
+                               std::to_string(fOptions.GetPageBufferBudget()) + " bytes"));
+   }
 
    auto nColumns = fLastColumnId;
    for (DescriptorId_t i = 0; i < nColumns; ++i) {
@@ -154,12 +213,101 @@ void ROOT::Experimental::Detail::RPageSink::Create(RNTupleModel &model)
       fOpenPageRanges.emplace_back(std::move(pageRange));
    }
 
+   if (fOptions.GetUseColumnStatistics()) {
+      const auto &descriptor = fDescriptorBuilder.GetDescriptor();
+      for (DescriptorId_t i = 0; i < nColumns; ++i) {
+         const auto &columnDesc = descriptor.GetColumnDescriptor(i);
+         const auto &fieldDesc = descriptor.GetFieldDescriptor(columnDesc.GetFieldId());
+         const auto &typeName = fieldDesc.GetTypeName();
+         // Integer columns do not record their signedness, so we take it from the field type
+         auto type = EStatisticsType::kNone;
+         switch (columnDesc.GetModel().GetType()) {
+         case EColumnType::kIndex:
+         case EColumnType::kSplitIndex:
+            if (fieldDesc.GetStructure() == ENTupleStructure::kCollection || typeName == "std::string")
+               type = EStatisticsType::kOffset;
+            break;
+         case EColumnType::kBit: type = EStatisticsType::kBool; break;
+         case EColumnType::kByte:
+            if (typeName == "std::uint8_t")
+               type = EStatisticsType::kUInt8;
+            break;
+         case EColumnType::kReal64:
+         case EColumnType::kSplitReal64: type = EStatisticsType::kReal64; break;
+         case EColumnType::kReal32:
+         case EColumnType::kSplitReal32: type = EStatisticsType::kReal32; break;
+         case EColumnType::kInt64:
+         case EColumnType::kSplitInt64:
+            if (typeName == "std::int64_t")
+               type = EStatisticsType::kInt64;
+            else if (typeName == "std::uint64_t")
+               type = EStatisticsType::kUInt64;
+            break;
+         case EColumnType::kInt32:
+         case EColumnType::kSplitInt32:
+            if (typeName == "std::int32_t")
+               type = EStatisticsType::kInt32;
+            else if (typeName == "std::uint32_t")
+               type = EStatisticsType::kUInt32;
+            break;
+         default: break;
+         }
+         fStatisticsTypes.emplace_back(type);
+      }
+      fLastOffsets.resize(nColumns, 0);
+   }
+
    CreateImpl(model);
 }
 
 
+void ROOT::Experimental::Detail::RPageSink::UpdateStatistics(DescriptorId_t columnId, const RPage &page)
+{
+   auto &statistics = fOpenColumnRanges[columnId].fStatistics;
+   auto buffer = page.GetBuffer();
+   auto nElements = page.GetNElements();
+   if (nElements == 0)
+      return;
+
+   switch (fStatisticsTypes[columnId]) {
+   case EStatisticsType::kBool: UpdateMinMax<bool>(buffer, nElements, statistics); break;
+   case EStatisticsType::kUInt8: UpdateMinMax<std::uint8_t>(buffer, nElements, statistics); break;
+   case EStatisticsType::kInt32: UpdateMinMax<std::int32_t>(buffer, nElements, statistics); break;
+   case EStatisticsType::kUInt32: UpdateMinMax<std::uint32_t>(buffer, nElements, statistics); break;
+   case EStatisticsType::kInt64: UpdateMinMax<std::int64_t>(buffer, nElements, statistics); break;
+   case EStatisticsType::kUInt64: UpdateMinMax<std::uint64_t>(buffer, nElements, statistics); break;
+   case EStatisticsType::kReal32: UpdateMinMax<float>(buffer, nElements, statistics); break;
+   case EStatisticsType::kReal64: UpdateMinMax<double>(buffer, nElements, statistics); break;
+   case EStatisticsType::kOffset: {
+      // The offsets are cluster-relative end indexes of the collections; the statistics refer to the sizes
+      auto offsets = reinterpret_cast<const ClusterSize_t *>(buffer);
+      auto lastOffset = fLastOffsets[columnId];
+      RClusterDescriptor::RColumnStatistics pageStatistics;
+      pageStatistics.fIsValid = true;
+      pageStatistics.fMin = std::numeric_limits<double>::max();
+      pageStatistics.fMax = 0.0;
+      for (std::size_t i = 0; i < nElements; ++i) {
+         auto size = static_cast<double>(offsets[i] - lastOffset);
+         pageStatistics.fMin = std::min(pageStatistics.fMin, size);
+         pageStatistics.fMax = std::max(pageStatistics.fMax, size);
+         if (offsets[i] == lastOffset)
+            pageStatistics.fNEmpty++;
+         lastOffset = offsets[i];
+      }
+      fLastOffsets[columnId] = lastOffset;
+      statistics.Merge(pageStatistics);
+      break;
+   }
+   default: break;
+   }
+}
+
+
 void ROOT::Experimental::Detail::RPageSink::CommitPage(ColumnHandle_t columnHandle, const RPage &page)
 {
+   if (!fStatisticsTypes.empty())
+      UpdateStatistics(columnHandle.fId, page);
+
    auto locator = CommitPageImpl(columnHandle, page);
 
    auto columnId = columnHandle.fId;
@@ -168,6 +316,62 @@ void ROOT::Experimental::Detail::RPageSink::CommitPage(ColumnHandle_t columnHand
    pageInfo.fNElements = page.GetNElements();
    pageInfo.fLocator = locator;
    fOpenPageRanges[columnId].fPageInfos.emplace_back(pageInfo);
+
+   fNBytesUnzippedCluster += page.GetSize();
+   if ((locator.fBytesOnStorage > 0) || (page.GetSize() == 0)) {
+      fNBytesZippedCluster += locator.fBytesOnStorage;
+   } else if (fNBytesUnzippedTotal > 0) {
+      fNBytesZippedCluster += page.GetSize() * fNBytesZippedTotal / fNBytesUnzippedTotal;
+   } else {
+      fNBytesZippedCluster += page.GetSize();
+   }
+}
+
+
+void ROOT::Experimental::Detail::RPageSink::CommitSealedPage(DescriptorId_t columnId, const RSealedPage &sealedPage)
+{
+   auto locator = CommitSealedPageImpl(columnId, sealedPage);
+
+   fOpenColumnRanges[columnId].fNElements += sealedPage.fNElements;
+   RClusterDescriptor::RPageRange::RPageInfo pageInfo;
+   pageInfo.fNElements = sealedPage.fNElements;
+   pageInfo.fLocator = locator;
+   fOpenPageRanges[columnId].fPageInfos.emplace_back(pageInfo);
+
+   fNBytesUnzippedCluster += sealedPage.fNElements * fElementSizes[columnId];
+   fNBytesZippedCluster += sealedPage.fSize;
+}
+
+
+ROOT::Experimental::Detail::RPageSink::RSealedPage
+ROOT::Experimental::Detail::RPageSink::SealPage(const RPage &page, const RColumnElementBase &element,
+                                                int compression, void *buf)
+{
+   unsigned char *pageBuf = reinterpret_cast<unsigned char *>(page.GetBuffer());
+   bool isAdoptedBuffer = true;
+   auto packedBytes = page.GetSize();
+
+   if (!element.IsMappable()) {
+      packedBytes = (page.GetNElements() * element.GetBitsOnStorage() + 7) / 8;
+      pageBuf = new unsigned char[packedBytes];
+      isAdoptedBuffer = false;
+      element.Pack(pageBuf, page.GetBuffer(), page.GetNElements());
+   }
+
+   if ((compression == 0) && isAdoptedBuffer)
+      return RSealedPage(pageBuf, packedBytes, page.GetNElements());
+
+   auto zippedBytes = RNTupleCompressor::Zip(pageBuf, packedBytes, compression, buf);
+   if (!isAdoptedBuffer)
+      delete[] pageBuf;
+   return RSealedPage(buf, zippedBytes, page.GetNElements());
+}
+
+
+void ROOT::Experimental::Detail::RPageSink::CommitColumnStatistics(
+   DescriptorId_t columnId, const RClusterDescriptor::RColumnStatistics &statistics)
+{
+   fOpenColumnRanges[columnId].fStatistics.Merge(statistics);
 }
 
 
@@ -183,7 +387,19 @@ void ROOT::Experimental::Detail::RPageSink::CommitCluster(ROOT::Experimental::NT
       fDescriptorBuilder.AddClusterColumnRange(fLastClusterId, range);
       range.fFirstElementIndex += range.fNElements;
       range.fNElements = 0;
+      range.fStatistics = RClusterDescriptor::RColumnStatistics();
+   }
+   std::fill(fLastOffsets.begin(), fLastOffsets.end(), 0);
+   // By now, the locators of all the pages of the cluster are final
+   fNBytesZippedCluster = 0;
+   for (const auto &range : fOpenPageRanges) {
+      for (const auto &pageInfo : range.fPageInfos)
+         fNBytesZippedCluster += pageInfo.fLocator.fBytesOnStorage;
    }
+   fNBytesUnzippedTotal += fNBytesUnzippedCluster;
+   fNBytesZippedTotal += fNBytesZippedCluster;
+   fNBytesUnzippedCluster = 0;
+   fNBytesZippedCluster = 0;
    for (auto &range : fOpenPageRanges) {
       RClusterDescriptor::RPageRange fullRange;
       std::swap(fullRange, range);
@@ -15,6 +15,7 @@
 
 #include <ROOT/RCluster.hxx>
 #include <ROOT/RClusterPool.hxx>
+#include <ROOT/RColumnElement.hxx>
 #include <ROOT/RField.hxx>
 #include <ROOT/RLogger.hxx>
 #include <ROOT/RNTupleDescriptor.hxx>
@@ -30,6 +31,7 @@
 #include <TError.h>
 
 #include <algorithm>
+#include <cstdint>
 #include <cstdio>
 #include <cstdlib>
 #include <iostream>
@@ -78,6 +80,9 @@ ROOT::Experimental::Detail::RPageSinkFile::RPageSinkFile(std::string_view ntuple
 
 ROOT::Experimental::Detail::RPageSinkFile::~RPageSinkFile()
 {
+   // Compression tasks reference the pending pages
+   if (!fPendingPages.empty())
+      fTaskScheduler->Wait();
 }
 
 
@@ -95,9 +100,79 @@ void ROOT::Experimental::Detail::RPageSinkFile::CreateImpl(const RNTupleModel &
 }
 
 
+ROOT::Experimental::RClusterDescriptor::RLocator
+ROOT::Experimental::Detail::RPageSinkFile::CommitPageAsync(ColumnHandle_t columnHandle, const RPage &page)
+{
+   auto element = columnHandle.fColumn->GetElement();
+   auto pendingPage = std::make_unique<RPendingPage>();
+   pendingPage->fColumnId = columnHandle.fId;
+   pendingPage->fPageIdx = fOpenPageRanges[columnHandle.fId].fPageInfos.size();
+
+   // The page buffer is reused by the column after the commit, so we need to take a copy
+   if (element->IsMappable()) {
+      pendingPage->fAlignment = element->GetSize();
+      pendingPage->fPackedBytes = page.GetSize();
+      pendingPage->fPackedBuffer = std::unique_ptr<unsigned char[]>(new unsigned char[pendingPage->fPackedBytes]);
+      memcpy(pendingPage->fPackedBuffer.get(), page.GetBuffer(), pendingPage->fPackedBytes);
+   } else {
+      pendingPage->fPackedBytes = (page.GetNElements() * element->GetBitsOnStorage() + 7) / 8;
+      pendingPage->fPackedBuffer = std::unique_ptr<unsigned char[]>(new unsigned char[pendingPage->fPackedBytes]);
+      element->Pack(pendingPage->fPackedBuffer.get(), page.GetBuffer(), page.GetNElements());
+   }
+   pendingPage->fZippedBuffer = std::unique_ptr<unsigned char[]>(new unsigned char[pendingPage->fPackedBytes]);
+
+   auto compression = fOptions.GetCompression();
+   auto p = pendingPage.get();
+   fTaskScheduler->AddTask([p, compression]() {
+      p->fZippedBytes =
+         RNTupleCompressor::Zip(p->fPackedBuffer.get(), p->fPackedBytes, compression, p->fZippedBuffer.get());
+      p->fPackedBuffer.reset();
+   });
+   fPendingPages.emplace_back(std::move(pendingPage));
+   fNBytesBuffered += 2 * p->fPackedBytes;
+
+   return RClusterDescriptor::RLocator();
+}
+
+
+void ROOT::Experimental::Detail::RPageSinkFile::WritePendingPages()
+{
+   if (fPendingPages.empty())
+      return;
+
+   fTaskScheduler->Wait();
+   for (const auto &p : fPendingPages) {
+      // Incompressible pages are stored verbatim and can be memory mapped on reading
+      const auto alignment = (p->fZippedBytes == p->fPackedBytes) ? p->fAlignment : 1;
+      auto offsetData = fWriter->WriteBlob(p->fZippedBuffer.get(), p->fZippedBytes, p->fPackedBytes, alignment);
+      fClusterMinOffset = std::min(offsetData, fClusterMinOffset);
+      fClusterMaxOffset = std::max(offsetData + p->fZippedBytes, fClusterMaxOffset);
+
+      auto &locator = fOpenPageRanges[p->fColumnId].fPageInfos[p->fPageIdx].fLocator;
+      locator.fPosition = offsetData;
+      locator.fBytesOnStorage = p->fZippedBytes;
+   }
+   fPendingPages.clear();
+   fNBytesBuffered = 0;
+   fTaskScheduler->Reset();
+}
+
+
 ROOT::Experimental::RClusterDescriptor::RLocator
 ROOT::Experimental::Detail::RPageSinkFile::CommitPageImpl(ColumnHandle_t columnHandle, const RPage &page)
 {
+   if (fTaskScheduler && (fOptions.GetCompression() != 0)) {
+      // The pending page takes a packed and a zipped copy of the page.  Flush the pending pages before the copies
+      // would exceed the memory budget.  This needs to happen before the new page is added because its locator only
+      // appears in the open page range after CommitPageImpl() returns.
+      const auto budget = fOptions.GetPageBufferBudget();
+      if (fNBytesHeadPages + fNBytesBuffered + 2 * page.GetSize() > budget)
+         WritePendingPages();
+      if (fNBytesHeadPages + 2 * page.GetSize() <= budget)
+         return CommitPageAsync(columnHandle, page);
+      // Otherwise there is no room for a copy of the page; compress it synchronously using the zip buffer
+   }
+
    unsigned char *buffer = reinterpret_cast<unsigned char *>(page.GetBuffer());
    bool isAdoptedBuffer = true;
    auto packedBytes = page.GetSize();
@@ -120,7 +195,9 @@ ROOT::Experimental::Detail::RPageSinkFile::CommitPageImpl(ColumnHandle_t columnH
       isAdoptedBuffer = true;
    }
 
-   auto offsetData = fWriter->WriteBlob(buffer, zippedBytes, packedBytes);
+   // Uncompressed pages of mappable elements are aligned in the file such that they can be memory mapped
+   const auto alignment = (isMappable && (zippedBytes == packedBytes)) ? element->GetSize() : 1;
+   auto offsetData = fWriter->WriteBlob(buffer, zippedBytes, packedBytes, alignment);
    fClusterMinOffset = std::min(offsetData, fClusterMinOffset);
    fClusterMaxOffset = std::max(offsetData + zippedBytes, fClusterMaxOffset);
 
@@ -134,9 +211,34 @@ ROOT::Experimental::Detail::RPageSinkFile::CommitPageImpl(ColumnHandle_t columnH
 }
 
 
+ROOT::Experimental::RClusterDescriptor::RLocator
+ROOT::Experimental::Detail::RPageSinkFile::CommitSealedPageImpl(DescriptorId_t columnId, const RSealedPage &sealedPage)
+{
+   // Keep pages that are compressed in parallel in front of the sealed page, so that the pages remain in order
+   WritePendingPages();
+
+   const auto element =
+      RColumnElementBase::Generate(fDescriptorBuilder.GetDescriptor().GetColumnDescriptor(columnId).GetModel().GetType());
+   const auto packedBytes = (sealedPage.fNElements * element->GetBitsOnStorage() + 7) / 8;
+
+   const auto alignment =
+      (element->IsMappable() && (sealedPage.fSize == packedBytes)) ? element->GetSize() : 1;
+   auto offsetData = fWriter->WriteBlob(sealedPage.fBuffer, sealedPage.fSize, packedBytes, alignment);
+   fClusterMinOffset = std::min(offsetData, fClusterMinOffset);
+   fClusterMaxOffset = std::max(offsetData + sealedPage.fSize, fClusterMaxOffset);
+
+   RClusterDescriptor::RLocator result;
+   result.fPosition = offsetData;
+   result.fBytesOnStorage = sealedPage.fSize;
+   return result;
+}
+
+
 ROOT::Experimental::RClusterDescriptor::RLocator
 ROOT::Experimental::Detail::RPageSinkFile::CommitClusterImpl(ROOT::Experimental::NTupleSize_t /* nEntries */)
 {
+   WritePendingPages();
+
    RClusterDescriptor::RLocator result;
    result.fPosition = fClusterMinOffset;
    result.fBytesOnStorage = fClusterMaxOffset - fClusterMinOffset;
@@ -164,14 +266,16 @@ void ROOT::Experimental::Detail::RPageSinkFile::CommitDatasetImpl()
 ROOT::Experimental::Detail::RPage
 ROOT::Experimental::Detail::RPageSinkFile::ReservePage(ColumnHandle_t columnHandle, std::size_t nElements)
 {
-   if (nElements == 0)
-      nElements = kDefaultElementsPerPage;
    auto elementSize = columnHandle.fColumn->GetElement()->GetSize();
+   if (nElements == 0)
+      nElements = GetNElementsPerPage(elementSize);
+   fNBytesHeadPages += nElements * elementSize;
    return fPageAllocator->NewPage(columnHandle.fId, elementSize, nElements);
 }
 
 void ROOT::Experimental::Detail::RPageSinkFile::ReleasePage(RPage &page)
 {
+   fNBytesHeadPages -= page.GetCapacity() * page.GetElementSize();
    fPageAllocator->DeletePage(page);
 }
 
@@ -216,6 +320,7 @@ ROOT::Experimental::Detail::RPageSourceFile::RPageSourceFile(std::string_view nt
                                                    "number of partial clusters preloaded from storage"),
       *fMetrics.MakeCounter<RNTuplePlainCounter*> ("nPageLoaded", "", "number of pages loaded from storage"),
       *fMetrics.MakeCounter<RNTuplePlainCounter*> ("nPagePopulated", "", "number of populated pages"),
+      *fMetrics.MakeCounter<RNTuplePlainCounter*> ("nPageMapped", "", "number of pages mapped from the file"),
       *fMetrics.MakeCounter<RNTupleAtomicCounter*>("timeWallRead", "ns", "wall clock time spent reading"),
       *fMetrics.MakeCounter<RNTuplePlainCounter*> ("timeWallUnzip", "ns", "wall clock time spent decompressing"),
       *fMetrics.MakeCounter<RNTupleTickCounter<RNTupleAtomicCounter>*>("timeCpuRead", "ns", "CPU time spent reading"),
@@ -237,6 +342,8 @@ ROOT::Experimental::Detail::RPageSourceFile::RPageSourceFile(std::string_view nt
 
 ROOT::Experimental::Detail::RPageSourceFile::~RPageSourceFile()
 {
+   if (fMmapBase)
+      fFile->Unmap(fMmapBase, fMmapSize);
 }
 
 
@@ -257,10 +364,45 @@ ROOT::Experimental::RNTupleDescriptor ROOT::Experimental::Detail::RPageSourceFil
    fDecompressor(zipBuffer.get(), ntpl.fNBytesFooter, ntpl.fLenFooter, buffer.get());
    descBuilder.AddClustersFromFooter(buffer.get());
 
+   if (fOptions.GetUseMmap() && (fFile->GetFeatures() & ROOT::Internal::RRawFile::kFeatureHasMmap) && !fMmapBase) {
+      fMmapSize = fFile->GetSize();
+      std::uint64_t mapdOffset;
+      fMmapBase = reinterpret_cast<unsigned char *>(fFile->Map(fMmapSize, 0, mapdOffset));
+      R__ASSERT(mapdOffset == 0);
+   }
+
    return descBuilder.MoveDescriptor();
 }
 
 
+ROOT::Experimental::Detail::RPage ROOT::Experimental::Detail::RPageSourceFile::MapPageFromFile(
+   ColumnHandle_t columnHandle, const RClusterDescriptor &clusterDescriptor,
+   const RClusterDescriptor::RPageRange::RPageInfo &pageInfo, NTupleSize_t firstInPage)
+{
+   const auto element = columnHandle.fColumn->GetElement();
+   const auto elementSize = element->GetSize();
+   const auto pageSize = elementSize * pageInfo.fNElements;
+   if (!element->IsMappable() || (pageInfo.fLocator.fBytesOnStorage != pageSize))
+      return RPage();
+   if (pageInfo.fLocator.fPosition + pageSize > fMmapSize)
+      return RPage();
+   auto pageBuffer = fMmapBase + pageInfo.fLocator.fPosition;
+   // The page buffer is accessed through pointers to the element type
+   if (reinterpret_cast<std::uintptr_t>(pageBuffer) % elementSize != 0)
+      return RPage();
+
+   const auto columnId = columnHandle.fId;
+   const auto clusterId = clusterDescriptor.GetId();
+   const auto indexOffset = clusterDescriptor.GetColumnRange(columnId).fFirstElementIndex;
+   auto newPage = fPageAllocator->NewPage(columnId, pageBuffer, elementSize, pageInfo.fNElements);
+   newPage.SetWindow(indexOffset + firstInPage, RPage::RClusterInfo(clusterId, indexOffset));
+   // The memory is owned by the mapping, so that releasing the page only drops the reference in the page pool
+   fPagePool->RegisterPage(newPage, RPageDeleter([](const RPage & /*page*/, void * /*userData*/) {}, nullptr));
+   fCounters->fNPageMapped.Inc();
+   return newPage;
+}
+
+
 ROOT::Experimental::Detail::RPage ROOT::Experimental::Detail::RPageSourceFile::PopulatePageFromCluster(
    ColumnHandle_t columnHandle, const RClusterDescriptor &clusterDescriptor, ClusterSize_t::ValueType clusterIndex)
 {
@@ -268,8 +410,6 @@ ROOT::Experimental::Detail::RPage ROOT::Experimental::Detail::RPageSourceFile::P
    const auto clusterId = clusterDescriptor.GetId();
    const auto &pageRange = clusterDescriptor.GetPageRange(columnId);
 
-   fCounters->fNPagePopulated.Inc();
-
    // TODO(jblomer): binary search
    RClusterDescriptor::RPageRange::RPageInfo pageInfo;
    decltype(clusterIndex) firstInPage = 0;
@@ -285,6 +425,28 @@ ROOT::Experimental::Detail::RPage ROOT::Experimental::Detail::RPageSourceFile::P
    R__ASSERT(firstInPage <= clusterIndex);
    R__ASSERT((firstInPage + pageInfo.fNElements) > clusterIndex);
 
+   if (fMmapBase) {
+      auto mappedPage = MapPageFromFile(columnHandle, clusterDescriptor, pageInfo, firstInPage);
+      if (!mappedPage.IsNull())
+         return mappedPage;
+   }
+
+   const bool useClusterCache = fOptions.GetClusterCache() != RNTupleReadOptions::EClusterCache::kOff;
+   if (useClusterCache) {
+      if (!fCurrentCluster || (fCurrentCluster->GetId() != clusterId) || !fCurrentCluster->ContainsColumn(columnId))
+         fCurrentCluster = fClusterPool->GetCluster(clusterId, fActiveColumns);
+      R__ASSERT(fCurrentCluster->ContainsColumn(columnId));
+
+      if (fTaskScheduler) {
+         UnzipCluster(*fCurrentCluster);
+         auto cachedPage = fPagePool->GetPage(columnId, RClusterIndex(clusterId, clusterIndex));
+         if (!cachedPage.IsNull())
+            return cachedPage;
+      }
+   }
+
+   fCounters->fNPagePopulated.Inc();
+
    const auto element = columnHandle.fColumn->GetElement();
    const auto elementSize = element->GetSize();
 
@@ -293,13 +455,10 @@ ROOT::Experimental::Detail::RPage ROOT::Experimental::Detail::RPageSourceFile::P
    const auto pageSize = elementSize * pageInfo.fNElements;
 
    auto pageBuffer = new unsigned char[bytesPacked];
-   if (fOptions.GetClusterCache() == RNTupleReadOptions::EClusterCache::kOff) {
+   if (!useClusterCache) {
       fReader.ReadBuffer(pageBuffer, bytesOnStorage, pageInfo.fLocator.fPosition);
       fCounters->fNPageLoaded.Inc();
    } else {
-      if (!fCurrentCluster || (fCurrentCluster->GetId() != clusterId) || !fCurrentCluster->ContainsColumn(columnId))
-         fCurrentCluster = fClusterPool->GetCluster(clusterId, fActiveColumns);
-      R__ASSERT(fCurrentCluster->ContainsColumn(columnId));
       ROnDiskPage::Key key(columnId, pageNo);
       auto onDiskPage = fCurrentCluster->GetOnDiskPage(key);
       R__ASSERT(onDiskPage);
@@ -332,6 +491,96 @@ ROOT::Experimental::Detail::RPage ROOT::Experimental::Detail::RPageSourceFile::P
 }
 
 
+void ROOT::Experimental::Detail::RPageSourceFile::UnzipCluster(const RCluster &cluster)
+{
+   const auto clusterId = cluster.GetId();
+   if (clusterId != fUnzippedClusterId) {
+      if (fUnzippedClusterId != kInvalidDescriptorId)
+         fPagePool->Evict(fUnzippedClusterId);
+      fUnzippedClusterId = clusterId;
+      fUnzippedColumns.clear();
+   }
+
+   struct RUnzipItem {
+      DescriptorId_t fColumnId = kInvalidDescriptorId;
+      const RColumnElementBase *fElement = nullptr;
+      const ROnDiskPage *fOnDiskPage = nullptr;
+      ClusterSize_t::ValueType fNElements = 0;
+      NTupleSize_t fIndexOffset = 0;
+      NTupleSize_t fFirstInPage = 0;
+      /// Set by the unzip task
+      unsigned char *fBuffer = nullptr;
+   };
+
+   const auto &clusterDescriptor = fDescriptor.GetClusterDescriptor(clusterId);
+   std::vector<std::unique_ptr<RColumnElementBase>> elements;
+   std::vector<RUnzipItem> items;
+   for (auto columnId : fActiveColumns) {
+      if (!cluster.ContainsColumn(columnId) || (fUnzippedColumns.count(columnId) > 0))
+         continue;
+      fUnzippedColumns.insert(columnId);
+
+      elements.emplace_back(
+         RColumnElementBase::Generate(fDescriptor.GetColumnDescriptor(columnId).GetModel().GetType()));
+      const auto indexOffset = clusterDescriptor.GetColumnRange(columnId).fFirstElementIndex;
+      NTupleSize_t pageNo = 0;
+      NTupleSize_t firstInPage = 0;
+      for (const auto &pi : clusterDescriptor.GetPageRange(columnId).fPageInfos) {
+         RUnzipItem item;
+         item.fColumnId = columnId;
+         item.fElement = elements.back().get();
+         item.fOnDiskPage = cluster.GetOnDiskPage(ROnDiskPage::Key(columnId, pageNo));
+         R__ASSERT(item.fOnDiskPage);
+         R__ASSERT(item.fOnDiskPage->GetSize() == pi.fLocator.fBytesOnStorage);
+         item.fNElements = pi.fNElements;
+         item.fIndexOffset = indexOffset;
+         item.fFirstInPage = firstInPage;
+         items.emplace_back(item);
+         firstInPage += pi.fNElements;
+         ++pageNo;
+      }
+   }
+   if (items.empty())
+      return;
+
+   fTaskScheduler->Reset();
+   for (auto &item : items) {
+      fTaskScheduler->AddTask([&item]() {
+         const auto bytesPacked = (item.fElement->GetBitsOnStorage() * item.fNElements + 7) / 8;
+         auto pageBuffer = new unsigned char[bytesPacked];
+         RNTupleDecompressor::Unzip(item.fOnDiskPage->GetAddress(), item.fOnDiskPage->GetSize(), bytesPacked,
+                                    pageBuffer);
+         if (!item.fElement->IsMappable()) {
+            auto unpackedBuffer = new unsigned char[item.fElement->GetSize() * item.fNElements];
+            item.fElement->Unpack(unpackedBuffer, pageBuffer, item.fNElements);
+            delete[] pageBuffer;
+            pageBuffer = unpackedBuffer;
+         }
+         item.fBuffer = pageBuffer;
+      });
+   }
+   {
+      RNTuplePlainTimer timer(fCounters->fTimeWallUnzip, fCounters->fTimeCpuUnzip);
+      fTaskScheduler->Wait();
+   }
+
+   for (const auto &item : items) {
+      const auto bytesPacked = (item.fElement->GetBitsOnStorage() * item.fNElements + 7) / 8;
+      if (item.fOnDiskPage->GetSize() != bytesPacked)
+         fCounters->fSzUnzip.Add(bytesPacked);
+
+      auto newPage = fPageAllocator->NewPage(item.fColumnId, item.fBuffer, item.fElement->GetSize(), item.fNElements);
+      newPage.SetWindow(item.fIndexOffset + item.fFirstInPage, RPage::RClusterInfo(clusterId, item.fIndexOffset));
+      fPagePool->PreloadPage(newPage,
+         RPageDeleter([](const RPage &page, void * /*userData*/)
+         {
+            RPageAllocatorFile::DeletePage(page);
+         }, nullptr));
+   }
+   fCounters->fNPagePopulated.Add(items.size());
+}
+
+
 ROOT::Experimental::Detail::RPage ROOT::Experimental::Detail::RPageSourceFile::PopulatePage(
    ColumnHandle_t columnHandle, NTupleSize_t globalIndex)
 {
@@ -400,7 +649,7 @@ ROOT::Experimental::Detail::RPageSourceFile::LoadCluster(DescriptorId_t clusterI
 
    // Collect the page necessary page meta-data and sum up the total size of the compressed and packed pages
    std::vector<ROnDiskPageLocator> onDiskPages;
-   auto activeSize = 0;
+   std::uint64_t activeSize = 0;
    for (auto columnId : columns) {
       const auto &pageRange = clusterDesc.GetPageRange(columnId);
       NTupleSize_t pageNo = 0;
@@ -438,6 +687,9 @@ ROOT::Experimental::Detail::RPageSourceFile::LoadCluster(DescriptorId_t clusterI
          break;
       gapCut = g;
    }
+   // The user-provided limits take precedence over the heuristics
+   gapCut = std::min<std::uint64_t>(gapCut, fOptions.GetMaxReadGap());
+   const auto maxRequestSize = fOptions.GetMaxReadRequestSize();
 
    // Prepare the input vector for the RRawFile::ReadV() call
    struct RReadRequest {
@@ -458,7 +710,7 @@ ROOT::Experimental::Detail::RPageSourceFile::LoadCluster(DescriptorId_t clusterI
       R__ASSERT(s.fOffset >= readUpTo);
       auto overhead = s.fOffset - readUpTo;
       szPayload += s.fSize;
-      if (overhead <= gapCut) {
+      if ((req.fSize > 0) && (overhead <= gapCut) && (req.fSize + overhead + s.fSize <= maxRequestSize)) {
          szOverhead += overhead;
          s.fBufPos = reinterpret_cast<intptr_t>(req.fBuffer) + req.fSize + overhead;
          req.fSize += overhead + s.fSize;
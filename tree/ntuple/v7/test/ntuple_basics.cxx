@@ -212,6 +212,81 @@ TEST(RNTuple, Clusters)
    EXPECT_EQ(24.0, (*rdFourVec)[1]);
 }
 
+TEST(RNTuple, ColumnStatistics)
+{
+   FileRaii fileGuard("test_ntuple_column_statistics.root");
+
+   auto modelWrite = RNTupleModel::Create();
+   auto wrPt = modelWrite->MakeField<float>("pt");
+   auto wrId = modelWrite->MakeField<std::uint64_t>("id");
+   auto wrJets = modelWrite->MakeField<std::vector<float>>("jets");
+   auto wrTag = modelWrite->MakeField<std::string>("tag", "xyz");
+
+   RNTupleWriteOptions options;
+   options.SetUseColumnStatistics(true);
+   {
+      auto ntuple = RNTupleWriter::Recreate(std::move(modelWrite), "myNTuple", fileGuard.GetPath(), options);
+      // Cluster i has pt values in [10 * i, 10 * i + 9] and i jets per entry
+      for (unsigned int i = 0; i < 4; ++i) {
+         wrJets->assign(i, 1.0);
+         for (unsigned int j = 0; j < 10; ++j) {
+            *wrPt = 10 * i + j;
+            *wrId = std::numeric_limits<std::uint64_t>::max() - j;
+            ntuple->Fill();
+         }
+         ntuple->CommitCluster();
+      }
+   }
+
+   auto ntuple = RNTupleReader::Open("myNTuple", fileGuard.GetPath());
+   const auto &desc = ntuple->GetDescriptor();
+   ASSERT_EQ(4U, desc.GetNClusters());
+   const auto &stats = desc.GetClusterDescriptor(1).GetColumnRange(
+      desc.FindColumnId(desc.FindFieldId("pt"), 0)).fStatistics;
+   EXPECT_TRUE(stats.fIsValid);
+   EXPECT_EQ(10.0, stats.fMin);
+   EXPECT_EQ(19.0, stats.fMax);
+   const auto &statsJets = desc.GetClusterDescriptor(0).GetColumnRange(
+      desc.FindColumnId(desc.FindFieldId("jets"), 0)).fStatistics;
+   EXPECT_TRUE(statsJets.fIsValid);
+   EXPECT_EQ(0.0, statsJets.fMax);
+   EXPECT_EQ(10U, statsJets.fNEmpty);
+   // 64bit integers are rounded outwards
+   const auto &statsId = desc.GetClusterDescriptor(0).GetColumnRange(
+      desc.FindColumnId(desc.FindFieldId("id"), 0)).fStatistics;
+   EXPECT_TRUE(statsId.fIsValid);
+   EXPECT_LE(statsId.fMin, static_cast<double>(std::numeric_limits<std::uint64_t>::max() - 9));
+   EXPECT_GE(statsId.fMax, static_cast<double>(std::numeric_limits<std::uint64_t>::max()));
+   // The characters of strings have no statistics
+   EXPECT_FALSE(desc.GetClusterDescriptor(0).GetColumnRange(
+      desc.FindColumnId(desc.FindFieldId("tag"), 1)).fStatistics.fIsValid);
+
+   auto ranges = ntuple->GetEntryRanges("pt", 15.0, 25.0);
+   ASSERT_EQ(1U, ranges.size());
+   EXPECT_EQ(10U, *ranges[0].begin());
+   EXPECT_EQ(30U, *ranges[0].end());
+
+   ranges = ntuple->GetEntryRanges("jets", 2.0, 2.0);
+   ASSERT_EQ(1U, ranges.size());
+   EXPECT_EQ(20U, *ranges[0].begin());
+   EXPECT_EQ(30U, *ranges[0].end());
+
+   ranges = ntuple->GetEntryRanges("jets", 0.0, 0.0);
+   ASSERT_EQ(1U, ranges.size());
+   EXPECT_EQ(0U, *ranges[0].begin());
+   EXPECT_EQ(10U, *ranges[0].end());
+
+   EXPECT_TRUE(ntuple->GetEntryRanges("pt", 100.0, 200.0).empty());
+   EXPECT_EQ(1U, ntuple->GetEntryRanges("pt", 0.0, 200.0).size());
+
+   try {
+      ntuple->GetEntryRanges("eta", 0.0, 1.0);
+      FAIL() << "selecting on an unknown field should throw";
+   } catch (const RException &err) {
+      EXPECT_THAT(err.what(), testing::HasSubstr("no field named 'eta'"));
+   }
+}
+
 
 TEST(RNTupleModel, EnforceValidFieldNames)
 {
@@ -53,7 +53,12 @@ TEST(RNTuple, Descriptor)
    columnRange.fColumnId = 3;
    columnRange.fFirstElementIndex = 100;
    columnRange.fNElements = 1000;
+   columnRange.fStatistics.fIsValid = true;
+   columnRange.fStatistics.fMin = 0.0;
+   columnRange.fStatistics.fMax = 10.0;
+   columnRange.fStatistics.fNEmpty = 50;
    descBuilder.AddClusterColumnRange(1, columnRange);
+   columnRange.fStatistics = ROOT::Experimental::RClusterDescriptor::RColumnStatistics();
    ROOT::Experimental::RClusterDescriptor::RPageRange pageRange2;
    pageRange2.fColumnId = 3;
    pageInfo.fNElements = 1000;
@@ -125,6 +130,12 @@ TEST(RNTuple, Descriptor)
    EXPECT_EQ(DescriptorId_t(1), reference.FindClusterId(3, 100));
    EXPECT_EQ(ROOT::Experimental::kInvalidDescriptorId, reference.FindClusterId(3, 40000));
 
+   // Cluster #0 has no column statistics and thus cannot be excluded
+   EXPECT_EQ(std::vector<DescriptorId_t>({0, 1}), reference.SelectClusterIds(42, 5.0, 20.0));
+   EXPECT_EQ(std::vector<DescriptorId_t>({0}), reference.SelectClusterIds(42, 11.0, 20.0));
+   EXPECT_EQ(std::vector<DescriptorId_t>({0}), reco.GetDescriptor().SelectClusterIds(42, -2.0, -1.0));
+   EXPECT_EQ(50U, reco.GetDescriptor().GetClusterDescriptor(1).GetColumnRange(3).fStatistics.fNEmpty);
+
    delete[] footerBuffer;
    delete[] headerBuffer;
 }
@@ -66,6 +66,111 @@ TEST(RNTuple, RealWorld1)
 }
 
 
+#ifdef R__USE_IMT
+TEST(RNTuple, ParallelCompression)
+{
+   FileRaii fileGuard("test_ntuple_parallel_compression.root");
+
+   auto modelWrite = RNTupleModel::Create();
+   auto wrEnergy = modelWrite->MakeField<double>("energy");
+   auto wrTimes  = modelWrite->MakeField<std::vector<float>>("times");
+
+   ROOT::EnableImplicitMT();
+   TRandom3 rnd(42);
+   double chksumWrite = 0.0;
+   {
+      RNTupleWriteOptions options;
+      options.SetUseParallelCompression(true);
+      // Flush the pending pages several times per cluster
+      options.SetPageBufferBudget(1024 * 1024);
+      auto ntuple = RNTupleWriter::Recreate(std::move(modelWrite), "myNTuple", fileGuard.GetPath(), options);
+      constexpr unsigned int nEvents = 100000;
+      for (unsigned int i = 0; i < nEvents; ++i) {
+         *wrEnergy = rnd.Rndm();
+         chksumWrite += *wrEnergy;
+         wrTimes->resize(i % 10);
+         for (auto &t : *wrTimes) {
+            t = rnd.Rndm();
+            chksumWrite += t;
+         }
+         ntuple->Fill();
+         if (i % 30000 == 0)
+            ntuple->CommitCluster();
+      }
+   }
+
+   // Read back once sequentially and once with parallel decompression
+   for (bool parallelUnzip : {false, true}) {
+      RNTupleReadOptions options;
+      options.SetUseParallelDecompression(parallelUnzip);
+      auto ntuple = RNTupleReader::Open("myNTuple", fileGuard.GetPath(), options);
+      EXPECT_LT(1U, ntuple->GetDescriptor().GetNClusters());
+      auto rdEnergy = ntuple->GetModel()->GetDefaultEntry()->Get<double>("energy");
+      auto rdTimes  = ntuple->GetModel()->GetDefaultEntry()->Get<std::vector<float>>("times");
+      double chksumRead = 0.0;
+      for (auto entryId : *ntuple) {
+         ntuple->LoadEntry(entryId);
+         chksumRead += *rdEnergy;
+         for (auto t : *rdTimes)
+            chksumRead += t;
+      }
+      EXPECT_EQ(chksumRead, chksumWrite);
+   }
+   ROOT::DisableImplicitMT();
+}
+#endif
+
+
+TEST(RNTuple, ParallelWriter)
+{
+   FileRaii fileGuard("test_ntuple_parallel_writer.root");
+
+   auto model = RNTupleModel::Create();
+   model->MakeField<std::uint64_t>("id");
+   model->MakeField<std::vector<float>>("values");
+
+   constexpr unsigned int nThreads = 4;
+   constexpr unsigned int nEventsPerThread = 50000;
+   {
+      RNTupleWriteOptions options;
+      // Likely several clusters per thread
+      options.SetApproxZippedClusterSize(128 * 1024);
+      auto writer = RNTupleParallelWriter::Recreate(std::move(model), "myNTuple", fileGuard.GetPath(), options);
+      std::vector<std::thread> threads;
+      for (unsigned int t = 0; t < nThreads; ++t) {
+         threads.emplace_back([&writer, t]() {
+            auto fillContext = writer->CreateFillContext();
+            auto entry = fillContext->GetModel()->GetDefaultEntry();
+            auto id = entry->Get<std::uint64_t>("id");
+            auto values = entry->Get<std::vector<float>>("values");
+            for (unsigned int i = 0; i < nEventsPerThread; ++i) {
+               *id = t * nEventsPerThread + i;
+               values->assign(i % 5, static_cast<float>(i));
+               fillContext->Fill();
+            }
+         });
+      }
+      for (auto &thread : threads)
+         thread.join();
+   }
+
+   auto ntuple = RNTupleReader::Open("myNTuple", fileGuard.GetPath());
+   EXPECT_EQ(nThreads * nEventsPerThread, ntuple->GetNEntries());
+   EXPECT_LE(nThreads, ntuple->GetDescriptor().GetNClusters());
+   auto rdId = ntuple->GetModel()->GetDefaultEntry()->Get<std::uint64_t>("id");
+   auto rdValues = ntuple->GetModel()->GetDefaultEntry()->Get<std::vector<float>>("values");
+   std::vector<bool> seen(nThreads * nEventsPerThread, false);
+   for (auto entryId : *ntuple) {
+      ntuple->LoadEntry(entryId);
+      ASSERT_LT(*rdId, seen.size());
+      EXPECT_FALSE(seen[*rdId]);
+      seen[*rdId] = true;
+      const auto i = *rdId % nEventsPerThread;
+      EXPECT_EQ(std::vector<float>(i % 5, static_cast<float>(i)), *rdValues);
+   }
+}
+
+
 // Stress test the asynchronous cluster pool by a deliberately unfavourable read pattern
 TEST(RNTuple, RandomAccess)
 {
@@ -32,3 +32,68 @@ TEST(Packing, Bitfield)
       EXPECT_EQ(b9[i], e9[i]);
    }
 }
+
+TEST(Packing, Split)
+{
+   ROOT::Experimental::Detail::RColumnElement<float, ROOT::Experimental::EColumnType::kSplitReal32> element(nullptr);
+   element.Pack(nullptr, nullptr, 0);
+   element.Unpack(nullptr, nullptr, 0);
+
+   float f3[] = {1.0, 2.0, -3.0};
+   unsigned char c12[12];
+   element.Pack(c12, f3, 3);
+   // The most significant bytes (sign and exponent) of the three floats are stored last
+   EXPECT_EQ(0x3f, c12[9]);
+   EXPECT_EQ(0x40, c12[10]);
+   EXPECT_EQ(0xc0, c12[11]);
+   float e3[] = {0.0, 0.0, 0.0};
+   element.Unpack(e3, c12, 3);
+   for (unsigned i = 0; i < 3; ++i) {
+      EXPECT_EQ(f3[i], e3[i]);
+   }
+
+   ROOT::Experimental::Detail::RColumnElement<std::int64_t, ROOT::Experimental::EColumnType::kSplitInt64>
+      element64(nullptr);
+   std::int64_t i5[] = {0, -1, 1, std::numeric_limits<std::int64_t>::min(), std::numeric_limits<std::int64_t>::max()};
+   unsigned char c40[40];
+   element64.Pack(c40, i5, 5);
+   std::int64_t e5[5];
+   element64.Unpack(e5, c40, 5);
+   for (unsigned i = 0; i < 5; ++i) {
+      EXPECT_EQ(i5[i], e5[i]);
+   }
+}
+
+TEST(Packing, SplitIndex)
+{
+   ROOT::Experimental::Detail::RColumnElement<ClusterSize_t, ROOT::Experimental::EColumnType::kSplitIndex>
+      element(nullptr);
+   element.Pack(nullptr, nullptr, 0);
+   element.Unpack(nullptr, nullptr, 0);
+
+   ClusterSize_t i4[] = {ClusterSize_t(10), ClusterSize_t(12), ClusterSize_t(12), ClusterSize_t(1000000)};
+   unsigned char c16[16];
+   element.Pack(c16, i4, 4);
+   // Zigzag encoded deltas 10, 2, 0, 999988
+   EXPECT_EQ(20, c16[0]);
+   EXPECT_EQ(4, c16[1]);
+   EXPECT_EQ(0, c16[2]);
+   EXPECT_EQ(0, c16[12]);
+   EXPECT_EQ(0, c16[13]);
+   EXPECT_EQ(0, c16[14]);
+   ClusterSize_t e4[4];
+   element.Unpack(e4, c16, 4);
+   for (unsigned i = 0; i < 4; ++i) {
+      EXPECT_EQ(i4[i], e4[i]);
+   }
+
+   // Decreasing values are only expected for non-sorted index columns but need to be preserved anyway
+   ClusterSize_t i2[] = {ClusterSize_t(7), ClusterSize_t(3)};
+   unsigned char c8[8];
+   element.Pack(c8, i2, 2);
+   EXPECT_EQ(7, c8[1]);
+   ClusterSize_t e2[2];
+   element.Unpack(e2, c8, 2);
+   EXPECT_EQ(7U, e2[0]);
+   EXPECT_EQ(3U, e2[1]);
+}
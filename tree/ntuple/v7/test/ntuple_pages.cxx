@@ -55,3 +55,42 @@ TEST(Pages, Pool)
    page = pool.GetPage(1, 55);
    EXPECT_TRUE(page.IsNull());
 }
+
+TEST(Pages, PoolPreload)
+{
+   unsigned int nCallDeleter = 0;
+   auto fnDeleter = [&nCallDeleter](const RPage & /*page*/, void * /*userData*/) { nCallDeleter++; };
+   unsigned char memory[3];
+
+   {
+      RPagePool pool;
+      std::array<RPage, 3> pages;
+      for (unsigned i = 0; i < 3; ++i) {
+         pages[i] = RPage(1, &memory[i], 1, 1);
+         EXPECT_NE(nullptr, pages[i].TryGrow(1));
+         // Pages 0 and 1 belong to cluster 0, page 2 belongs to cluster 1
+         pages[i].SetWindow(i, RPage::RClusterInfo(i / 2, 2 * (i / 2)));
+         pool.PreloadPage(pages[i], RPageDeleter(fnDeleter));
+      }
+
+      // A preloaded page is freed after its first use
+      auto page = pool.GetPage(1, 0);
+      EXPECT_FALSE(page.IsNull());
+      pool.ReturnPage(page);
+      EXPECT_EQ(1U, nCallDeleter);
+      EXPECT_TRUE(pool.GetPage(1, 0).IsNull());
+
+      // Pages in use are not evicted
+      page = pool.GetPage(1, 1);
+      EXPECT_FALSE(page.IsNull());
+      pool.Evict(0);
+      EXPECT_EQ(1U, nCallDeleter);
+      pool.ReturnPage(page);
+      EXPECT_EQ(2U, nCallDeleter);
+
+      pool.Evict(0);
+      EXPECT_EQ(2U, nCallDeleter);
+   }
+   // Destructing the pool frees the unused page of cluster 1
+   EXPECT_EQ(3U, nCallDeleter);
+}
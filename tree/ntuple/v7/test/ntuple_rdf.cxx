@@ -27,3 +27,83 @@ TEST(RNTuple, RDF)
    auto rdf = ROOT::Experimental::MakeNTupleDataFrame("myNTuple", fileGuard.GetPath());
    EXPECT_EQ(42.0, *rdf.Min("pt"));
 }
+
+TEST(RNTuple, RDFClusterRanges)
+{
+   FileRaii fileGuard("test_ntuple_rdf_cluster_ranges.root");
+
+   auto modelWrite = RNTupleModel::Create();
+   auto wrPt = modelWrite->MakeField<float>("pt");
+   {
+      auto ntuple = RNTupleWriter::Recreate(std::move(modelWrite), "myNTuple", fileGuard.GetPath());
+      for (unsigned int i = 0; i < 1000; ++i) {
+         *wrPt = i;
+         ntuple->Fill();
+         if ((i + 1) % 100 == 0)
+            ntuple->CommitCluster();
+      }
+   }
+
+   ROOT::Experimental::RNTupleDS ds(RNTupleReader::Open("myNTuple", fileGuard.GetPath()));
+   ds.SetNSlots(2);
+   ds.Initialise();
+   auto ranges = ds.GetEntryRanges();
+   EXPECT_LT(1U, ranges.size());
+   ULong64_t expectedStart = 0;
+   for (const auto &r : ranges) {
+      EXPECT_EQ(expectedStart, r.first);
+      EXPECT_EQ(0U, r.second % 100);
+      EXPECT_LT(r.first, r.second);
+      expectedStart = r.second;
+   }
+   EXPECT_EQ(1000U, expectedStart);
+   EXPECT_TRUE(ds.GetEntryRanges().empty());
+
+   ROOT::EnableImplicitMT(4);
+   auto rdf = ROOT::Experimental::MakeNTupleDataFrame("myNTuple", fileGuard.GetPath());
+   EXPECT_EQ(1000U, *rdf.Count());
+   EXPECT_DOUBLE_EQ(999. * 1000. / 2., *rdf.Sum<float>("pt"));
+   ROOT::DisableImplicitMT();
+}
+
+TEST(RNTuple, RDFSelectClusters)
+{
+   FileRaii fileGuard("test_ntuple_rdf_select_clusters.root");
+
+   auto modelWrite = RNTupleModel::Create();
+   auto wrPt = modelWrite->MakeField<float>("pt");
+   RNTupleWriteOptions options;
+   options.SetUseColumnStatistics(true);
+   {
+      auto ntuple = RNTupleWriter::Recreate(std::move(modelWrite), "myNTuple", fileGuard.GetPath(), options);
+      for (unsigned int i = 0; i < 1000; ++i) {
+         *wrPt = i;
+         ntuple->Fill();
+         if ((i + 1) % 100 == 0)
+            ntuple->CommitCluster();
+      }
+   }
+
+   auto ds = std::make_unique<ROOT::Experimental::RNTupleDS>(RNTupleReader::Open("myNTuple", fileGuard.GetPath()));
+   try {
+      ds->SelectClusters("eta", 0.0, 1.0);
+      FAIL() << "selecting clusters on an unknown column should throw";
+   } catch (const std::runtime_error &err) {
+      EXPECT_THAT(err.what(), testing::HasSubstr("column \"eta\""));
+   }
+   ds->SelectClusters("pt", 150.0, 450.0);
+   ds->SelectClusters("pt", 420.0, 800.0);
+   ds->SetNSlots(1);
+   ds->Initialise();
+   auto ranges = ds->GetEntryRanges();
+   ASSERT_FALSE(ranges.empty());
+   EXPECT_EQ(400U, ranges.front().first);
+   EXPECT_EQ(500U, ranges.back().second);
+
+   auto dsRdf = std::make_unique<ROOT::Experimental::RNTupleDS>(RNTupleReader::Open("myNTuple", fileGuard.GetPath()));
+   dsRdf->SelectClusters("pt", 150.0, 450.0);
+   ROOT::RDataFrame rdf(std::move(dsRdf));
+   auto filtered = rdf.Filter([](float pt) { return pt >= 150.0 && pt <= 450.0; }, {"pt"});
+   EXPECT_EQ(301U, *filtered.Count());
+   EXPECT_EQ(400U, *rdf.Count());
+}
@@ -70,3 +70,220 @@ TEST(RNTuple, Extended)
    }
    EXPECT_EQ(chksumRead, chksumWrite);
 }
+
+TEST(RNTuple, SplitEncoding)
+{
+   FileRaii fileGuard("test_ntuple_split_encoding.root");
+
+   auto model = RNTupleModel::Create();
+   auto wrPt = model->MakeField<float>("pt");
+   auto wrE = model->MakeField<double>("E");
+   auto wrId = model->MakeField<std::int32_t>("id");
+   auto wrTracks = model->MakeField<std::vector<std::uint64_t>>("tracks");
+
+   {
+      RNTupleWriteOptions options;
+      options.SetUseSplitEncoding(true);
+      auto ntuple = RNTupleWriter::Recreate(std::move(model), "f", fileGuard.GetPath(), options);
+      for (unsigned int i = 0; i < 1000; ++i) {
+         *wrPt = i * 0.5;
+         *wrE = i * 0.25;
+         *wrId = 500 - static_cast<std::int32_t>(i);
+         wrTracks->resize(i % 5, i);
+         ntuple->Fill();
+         if (i == 500)
+            ntuple->CommitCluster();
+      }
+   }
+
+   auto ntuple = RNTupleReader::Open("f", fileGuard.GetPath());
+   const auto &desc = ntuple->GetDescriptor();
+   EXPECT_EQ(EColumnType::kSplitReal32,
+      desc.GetColumnDescriptor(desc.FindColumnId(desc.FindFieldId("pt"), 0)).GetModel().GetType());
+   EXPECT_EQ(EColumnType::kSplitIndex,
+      desc.GetColumnDescriptor(desc.FindColumnId(desc.FindFieldId("tracks"), 0)).GetModel().GetType());
+
+   auto rdPt = ntuple->GetModel()->GetDefaultEntry()->Get<float>("pt");
+   auto rdE = ntuple->GetModel()->GetDefaultEntry()->Get<double>("E");
+   auto rdId = ntuple->GetModel()->GetDefaultEntry()->Get<std::int32_t>("id");
+   auto rdTracks = ntuple->GetModel()->GetDefaultEntry()->Get<std::vector<std::uint64_t>>("tracks");
+   for (auto i : *ntuple) {
+      ntuple->LoadEntry(i);
+      EXPECT_EQ(i * 0.5, *rdPt);
+      EXPECT_EQ(i * 0.25, *rdE);
+      EXPECT_EQ(500 - static_cast<std::int32_t>(i), *rdId);
+      EXPECT_EQ(std::vector<std::uint64_t>(i % 5, i), *rdTracks);
+   }
+}
+
+TEST(RNTuple, CoalesceReads)
+{
+   FileRaii fileGuard("test_ntuple_coalesce_reads.root");
+
+   auto model = RNTupleModel::Create();
+   auto wrPx = model->MakeField<float>("px");
+   auto wrPy = model->MakeField<float>("py");
+   constexpr auto kElementsPerPage = RPageSinkFile::kDefaultElementsPerPage;
+   {
+      RNTupleWriteOptions options;
+      options.SetCompression(0);
+      auto ntuple = RNTupleWriter::Recreate(std::move(model), "f", fileGuard.GetPath(), options);
+      // Five pages of px interleaved with five pages of py in a single cluster
+      for (unsigned int i = 0; i < 5 * kElementsPerPage; ++i) {
+         *wrPx = i;
+         *wrPy = -float(i);
+         ntuple->Fill();
+      }
+   }
+
+   auto fnReadPx = [&fileGuard](const RNTupleReadOptions &options, std::int64_t &nRead, std::int64_t &nPageLoaded) {
+      auto ntuple = RNTupleReader::Open("f", fileGuard.GetPath(), options);
+      ntuple->EnableMetrics();
+      auto viewPx = ntuple->GetView<float>("px");
+      float sum = 0.0;
+      for (auto i : ntuple->GetEntryRange())
+         sum += viewPx(i);
+      nRead = ntuple->GetMetrics().GetCounter("RNTupleReader.RPageSourceFile.nRead")->GetValueAsInt();
+      nPageLoaded = ntuple->GetMetrics().GetCounter("RNTupleReader.RPageSourceFile.nPageLoaded")->GetValueAsInt();
+      return sum;
+   };
+
+   std::int64_t nRead = 0;
+   std::int64_t nPageLoaded = 0;
+   RNTupleReadOptions options;
+   auto sumCoalesced = fnReadPx(options, nRead, nPageLoaded);
+   EXPECT_EQ(5, nPageLoaded);
+   EXPECT_EQ(1, nRead);
+
+   options.SetMaxReadGap(0);
+   EXPECT_EQ(sumCoalesced, fnReadPx(options, nRead, nPageLoaded));
+   EXPECT_EQ(5, nPageLoaded);
+   EXPECT_EQ(5, nRead);
+
+   options.SetMaxReadGap(RNTupleReadOptions::kDefaultMaxReadGap);
+   // Leave some slack for the key headers between the pages
+   options.SetMaxReadRequestSize(3 * kElementsPerPage * sizeof(float) + 1000);
+   EXPECT_EQ(sumCoalesced, fnReadPx(options, nRead, nPageLoaded));
+   EXPECT_EQ(5, nPageLoaded);
+   EXPECT_EQ(3, nRead);
+}
+
+TEST(RNTuple, MmapPages)
+{
+   FileRaii fileGuard("test_ntuple_mmap_pages.root");
+
+   auto model = RNTupleModel::Create();
+   auto wrPx = model->MakeField<float>("px");
+   auto wrTag = model->MakeField<std::string>("tag");
+   constexpr auto kElementsPerPage = RPageSinkFile::kDefaultElementsPerPage;
+   {
+      RNTupleWriteOptions options;
+      options.SetCompression(0);
+      auto ntuple = RNTupleWriter::Recreate(std::move(model), "f", fileGuard.GetPath(), options);
+      for (unsigned int i = 0; i < 5 * kElementsPerPage; ++i) {
+         *wrPx = i;
+         *wrTag = std::to_string(i);
+         ntuple->Fill();
+      }
+   }
+
+   RNTupleReadOptions options;
+   options.SetUseMmap(true);
+   auto ntuple = RNTupleReader::Open("f", fileGuard.GetPath(), options);
+   ntuple->EnableMetrics();
+   auto viewPx = ntuple->GetView<float>("px");
+   auto viewTag = ntuple->GetView<std::string>("tag");
+   for (auto i : ntuple->GetEntryRange()) {
+      EXPECT_EQ(float(i), viewPx(i));
+      EXPECT_EQ(std::to_string(i), viewTag(i));
+   }
+   auto nPageMapped =
+      ntuple->GetMetrics().GetCounter("RNTupleReader.RPageSourceFile.nPageMapped")->GetValueAsInt();
+   auto nPagePopulated =
+      ntuple->GetMetrics().GetCounter("RNTupleReader.RPageSourceFile.nPagePopulated")->GetValueAsInt();
+   // The uncompressed pages are aligned in the file, so that all of them are mapped
+   const auto &desc = ntuple->GetDescriptor();
+   std::int64_t nPages = 0;
+   for (std::uint64_t i = 0; i < desc.GetNClusters(); ++i) {
+      for (std::uint64_t columnId = 0; columnId < desc.GetNColumns(); ++columnId)
+         nPages += desc.GetClusterDescriptor(i).GetPageRange(columnId).fPageInfos.size();
+   }
+   EXPECT_LT(5, nPages);
+   EXPECT_EQ(0, nPagePopulated);
+   EXPECT_EQ(nPages, nPageMapped);
+}
+
+TEST(RNTuple, ClusterAndPageSizes)
+{
+   FileRaii fileGuard("test_ntuple_cluster_page_sizes.root");
+
+   auto model = RNTupleModel::Create();
+   auto wrPt = model->MakeField<float>("pt");
+   {
+      RNTupleWriteOptions options;
+      options.SetCompression(0);
+      options.SetApproxUnzippedPageSize(2500 * sizeof(float));
+      options.SetApproxZippedClusterSize(10 * 2500 * sizeof(float));
+      auto ntuple = RNTupleWriter::Recreate(std::move(model), "f", fileGuard.GetPath(), options);
+      for (unsigned int i = 0; i < 100000; ++i) {
+         *wrPt = i;
+         ntuple->Fill();
+      }
+   }
+
+   auto ntuple = RNTupleReader::Open("f", fileGuard.GetPath());
+   const auto &desc = ntuple->GetDescriptor();
+   EXPECT_EQ(4U, desc.GetNClusters());
+   const auto columnId = desc.FindColumnId(desc.FindFieldId("pt"), 0);
+   for (unsigned i = 0; i < 4; ++i) {
+      // Full pages are committed on the next fill, so a cluster can contain an extra page with a single element
+      const auto &clusterDesc = desc.GetClusterDescriptor(i);
+      EXPECT_NEAR(25000, clusterDesc.GetNEntries(), 3);
+      const auto &pageInfos = clusterDesc.GetPageRange(columnId).fPageInfos;
+      EXPECT_LE(10U, pageInfos.size());
+      for (unsigned j = 0; j < pageInfos.size() - 1; ++j)
+         EXPECT_EQ(2500U, pageInfos[j].fNElements);
+   }
+
+   auto viewPt = ntuple->GetView<float>("pt");
+   for (auto i : ntuple->GetEntryRange())
+      EXPECT_EQ(static_cast<float>(i), viewPt(i));
+}
+
+TEST(RNTuple, PageBufferBudget)
+{
+   FileRaii fileGuard("test_ntuple_page_buffer_budget.root");
+
+   {
+      auto model = RNTupleModel::Create();
+      auto wrPt = model->MakeField<float>("pt");
+      auto wrEta = model->MakeField<float>("eta");
+      RNTupleWriteOptions options;
+      // The open pages of the two columns alone need twice the budget
+      options.SetPageBufferBudget(RPageSinkFile::kDefaultElementsPerPage * sizeof(float));
+      try {
+         RNTupleWriter::Recreate(std::move(model), "f", fileGuard.GetPath(), options);
+         FAIL() << "the open pages should exceed the page buffer budget";
+      } catch (const RException& err) {
+         EXPECT_THAT(err.what(), testing::HasSubstr("page buffer budget"));
+      }
+   }
+
+   // Without a cluster size target, clusters are committed every 64000 entries
+   {
+      auto model = RNTupleModel::Create();
+      auto wrPt = model->MakeField<float>("pt");
+      auto ntuple = RNTupleWriter::Recreate(std::move(model), "f", fileGuard.GetPath());
+      for (unsigned int i = 0; i < 100000; ++i) {
+         *wrPt = i;
+         ntuple->Fill();
+      }
+   }
+   auto ntuple = RNTupleReader::Open("f", fileGuard.GetPath());
+   const auto &desc = ntuple->GetDescriptor();
+   EXPECT_EQ(2U, desc.GetNClusters());
+   EXPECT_EQ(64000U, desc.GetClusterDescriptor(0).GetNEntries());
+   const auto columnId = desc.FindColumnId(desc.FindFieldId("pt"), 0);
+   EXPECT_EQ(RPageSinkFile::kDefaultElementsPerPage,
+             desc.GetClusterDescriptor(0).GetPageRange(columnId).fPageInfos[0].fNElements);
+}
@@ -121,3 +121,50 @@ TEST(RNTuple, Composable)
    }
    EXPECT_EQ(8, nEv);
 }
+
+TEST(RNTuple, ViewBulk)
+{
+   FileRaii fileGuard("test_ntuple_view_bulk.root");
+
+   auto model = RNTupleModel::Create();
+   auto fieldPt = model->MakeField<float>("pt");
+   auto fieldJets = model->MakeField<std::vector<float>>("jets");
+
+   RNTupleWriteOptions options;
+   options.SetApproxUnzippedPageSize(64 * sizeof(float));
+   {
+      auto ntuple = RNTupleWriter::Recreate(std::move(model), "myNTuple", fileGuard.GetPath(), options);
+      for (unsigned int i = 0; i < 1000; ++i) {
+         *fieldPt = i;
+         fieldJets->assign(i % 3, i);
+         ntuple->Fill();
+         if (i == 499)
+            ntuple->CommitCluster();
+      }
+   }
+
+   auto ntuple = RNTupleReader::Open("myNTuple", fileGuard.GetPath());
+   auto viewPt = ntuple->GetView<float>("pt");
+   NTupleSize_t nEntries = ntuple->GetNEntries();
+   NTupleSize_t i = 0;
+   while (i < nEntries) {
+      auto span = viewPt.MapV(i, nEntries - i);
+      ASSERT_LT(0U, span.size());
+      EXPECT_GE(64U, span.size());
+      for (auto pt : span) {
+         EXPECT_EQ(static_cast<float>(i), pt);
+         i++;
+      }
+   }
+   EXPECT_EQ(nEntries, i);
+   EXPECT_EQ(5U, viewPt.MapV(0, 5).size());
+
+   auto viewJets = ntuple->GetViewCollection("jets");
+   auto offsets = viewJets.MapV(ROOT::Experimental::RClusterIndex(1, 0), 6);
+   ASSERT_EQ(6U, offsets.size());
+   // The second cluster starts at entry 500 with 500 % 3 == 2 items
+   EXPECT_EQ(2U, offsets[0]);
+   EXPECT_EQ(2U, offsets[1]);
+   EXPECT_EQ(3U, offsets[2]);
+   EXPECT_EQ(5U, offsets[3]);
+}
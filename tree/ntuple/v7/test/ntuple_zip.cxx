@@ -84,3 +84,21 @@ TEST(RNTupleZip, Large)
    decompressor(zipBuffer.get(), szZip, N, unzipBuffer.get());
    EXPECT_EQ(data, std::string(unzipBuffer.get(), N));
 }
+
+
+TEST(RNTupleZip, ZipToBuffer)
+{
+   std::string data(1000, 'x');
+   auto zipBuffer = std::make_unique<unsigned char[]>(data.length());
+   auto szZipped = RNTupleCompressor::Zip(data.data(), data.length(), 505, zipBuffer.get());
+   EXPECT_LT(szZipped, data.length());
+   auto unzipBuffer = std::make_unique<char[]>(data.length());
+   RNTupleDecompressor()(zipBuffer.get(), szZipped, data.length(), unzipBuffer.get());
+   EXPECT_EQ(data, std::string(unzipBuffer.get(), data.length()));
+
+   // Uncompressible input is copied verbatim
+   char X = 'x';
+   unsigned char Y = 0;
+   EXPECT_EQ(1U, RNTupleCompressor::Zip(&X, 1, 505, &Y));
+   EXPECT_EQ('x', Y);
+}
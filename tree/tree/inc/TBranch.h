@@ -31,6 +31,9 @@
 #include "Compression.h"
 #include "ROOT/TIOFeatures.hxx"
 
+#include <memory>
+#include <vector>
+
 class TTree;
 class TBasket;
 class TBranchElement;
@@ -50,6 +53,8 @@ class TBulkBranchRead;
 }
 namespace Internal {
 class TBranchIMTHelper; ///< A helper class for managing IMT work during TTree:Fill operations.
+struct TBranchZstdDictionary; ///< The zstd dictionary of a branch, see ROOT::Experimental::EIOFeatures::kZstdDictionary.
+class RZstdDictionary;
 }
 }
 
@@ -73,6 +78,7 @@ public:
    Int_t GetBulkEntries(Long64_t evt, TBuffer &user_buf);
    Int_t GetEntriesSerialized(Long64_t evt, TBuffer &user_buf);
    Int_t GetEntriesSerialized(Long64_t evt, TBuffer &user_buf, TBuffer *count_buf);
+   Int_t GetBulkEntries(Long64_t evt, TBuffer &user_buf, TBuffer &count_buf, std::vector<Int_t> &offsets);
    Bool_t SupportsBulkRead() const;
 
 private:
@@ -90,6 +96,7 @@ class TBranch : public TNamed , public TAttFill {
    using TIOFeatures = ROOT::TIOFeatures;
 
 protected:
+   friend class TBasket;
    friend class TTreeCache;
    friend class TTreeCloner;
    friend class TTree;
@@ -137,6 +144,8 @@ protected:
    Int_t      *fBasketBytes;      ///<[fMaxBaskets] Length of baskets on file
    Long64_t   *fBasketEntry;      ///<[fMaxBaskets] Table of first entry in each basket
    Long64_t   *fBasketSeek;       ///<[fMaxBaskets] Addresses of baskets on file
+   Long64_t    fZstdDictSeek;     ///<  Address on file of the zstd dictionary of the baskets, 0 if there is none
+   Int_t       fZstdDictBytes;    ///<  Length on file of the zstd dictionary of the baskets
    TTree      *fTree;             ///<! Pointer to Tree header
    TBranch    *fMother;           ///<! Pointer to top-level parent branch in the tree.
    TBranch    *fParent;           ///<! Pointer to parent branch.
@@ -153,6 +162,8 @@ protected:
    using CacheInfo_t = ROOT::Internal::TBranchCacheInfo;
    CacheInfo_t fCacheInfo;        ///<! Hold info about which basket are in the cache and if they have been retrieved from the cache.
 
+   std::unique_ptr<ROOT::Internal::TBranchZstdDictionary> fZstdDict; ///<! zstd dictionary being trained, or trained or read
+
    typedef void (TBranch::*ReadLeaves_t)(TBuffer &b);
    ReadLeaves_t fReadLeaves;      ///<! Pointer to the ReadLeaves implementation to use.
    typedef void (TBranch::*FillLeaves_t)(TBuffer &b);
@@ -172,6 +183,11 @@ protected:
 
    TString  GetRealFileName() const;
 
+   const ROOT::Internal::RZstdDictionary *GetZstdDictionary();
+   const ROOT::Internal::RZstdDictionary *TrainZstdDictionary(const char *buffer, Int_t size);
+   void     SetZstdDictionary(const std::vector<char> &content);
+   void     WriteZstdDictionary(TFile *file);
+
    virtual void SetAddressImpl(void *addr, Bool_t /* implied */) { SetAddress(addr); }
 
 private:
@@ -180,6 +196,9 @@ private:
    Int_t    GetBulkEntries(Long64_t, TBuffer&);
    Int_t    GetEntriesSerialized(Long64_t N, TBuffer& user_buf) {return GetEntriesSerialized(N, user_buf, nullptr);}
    Int_t    GetEntriesSerialized(Long64_t, TBuffer&, TBuffer*);
+   Int_t    GetBulkEntries(Long64_t, TBuffer&, TBuffer&, std::vector<Int_t>&);
+   EDataType GetBulkVectorType() const;
+   Bool_t   ReadBasketVectors(TBasket &basket, Int_t N, EDataType type, TBuffer *count_buf);
    Int_t    FillEntryBuffer(TBasket* basket,TBuffer* buf, Int_t& lnew);
    Int_t    WriteBasketImpl(TBasket* basket, Int_t where, ROOT::Internal::TBranchIMTHelper *);
    TBranch(const TBranch&) = delete;             // not implemented
@@ -288,7 +307,7 @@ public:
 
    static  void      ResetCount();
 
-   ClassDef(TBranch, 13); // Branch descriptor
+   ClassDef(TBranch, 14); // Branch descriptor
 };
 
 //______________________________________________________________________________
@@ -316,6 +335,7 @@ namespace Internal {
 inline Int_t  TBulkBranchRead::GetBulkEntries(Long64_t evt, TBuffer& user_buf) { return fParent.GetBulkEntries(evt, user_buf); }
 inline Int_t  TBulkBranchRead::GetEntriesSerialized(Long64_t evt, TBuffer& user_buf) { return fParent.GetEntriesSerialized(evt, user_buf); }
 inline Int_t  TBulkBranchRead::GetEntriesSerialized(Long64_t evt, TBuffer& user_buf, TBuffer* count_buf) { return fParent.GetEntriesSerialized(evt, user_buf, count_buf); }
+inline Int_t  TBulkBranchRead::GetBulkEntries(Long64_t evt, TBuffer& user_buf, TBuffer& count_buf, std::vector<Int_t>& offsets) { return fParent.GetBulkEntries(evt, user_buf, count_buf, offsets); }
 inline Bool_t TBulkBranchRead::SupportsBulkRead() const { return fParent.SupportsBulkRead(); }
 
 }  // Internal
@@ -23,6 +23,7 @@
 
 #include "TFileCacheRead.h"
 
+#include <memory>
 #include <vector>
 
 class TTree;
@@ -104,6 +105,12 @@ protected:
 
    std::unique_ptr<MissCache> fMissCache; ///<! Cache contents for misses
 
+   // Read-ahead of the next cluster range in a background thread, see SetReadAhead.
+   Double_t fReadAheadFraction{0};        ///<! Fraction of the current cluster range after which the next is read ahead
+   Int_t fNReadAhead{0};                  ///<! Number of cluster ranges read ahead and then used
+   struct ReadAhead;
+   std::unique_ptr<ReadAhead> fReadAhead; ///<! Next cluster range, being read or read ahead
+
 private:
    TTreeCache(const TTreeCache &) = delete; ///< this class cannot be copied
    TTreeCache &operator=(const TTreeCache &) = delete;
@@ -124,6 +131,14 @@ private:
    TBranch *CalculateMissEntries(Long64_t, int, bool);    ///< Given an file read, try to determine the corresponding branch.
    Bool_t   ProcessMiss(Long64_t pos, int len); ///<! Given a file read not in the miss cache, handle (possibly) loading the data.
 
+   // These functions implement the read-ahead of the next cluster range.
+   Double_t GetConfiguredReadAhead() const;
+   Int_t    GetFillSizeLimit() const; ///< Maximum size of the baskets loaded in one go, halved if reading ahead.
+   Bool_t   CanReadAhead() const;
+   void     StartReadAhead();         ///< Start reading ahead the next cluster range, if the current one is mostly used.
+   Bool_t   InstallReadAhead(Long64_t entry); ///< Make the cluster range read ahead the current one, if it contains entry.
+   void     DiscardReadAhead();       ///< Wait for the read-ahead in flight, if any, and drop its content.
+
 public:
 
    TTreeCache();
@@ -131,6 +146,7 @@ public:
    virtual ~TTreeCache();
    virtual Int_t        AddBranch(TBranch *b, Bool_t subgbranches = kFALSE);
    virtual Int_t        AddBranch(const char *branch, Bool_t subbranches = kFALSE);
+   virtual void         Close(Option_t *option="");
    virtual Int_t        DropBranch(TBranch *b, Bool_t subbranches = kFALSE);
    virtual Int_t        DropBranch(const char *branch, Bool_t subbranches = kFALSE);
    virtual void         Disable() {fEnabled = kFALSE;}
@@ -144,6 +160,8 @@ public:
    virtual Int_t        GetEntryMax() const {return fEntryMax;}
    static Int_t         GetLearnEntries();
    virtual EPrefillType GetLearnPrefill() const {return fPrefillType;}
+   Double_t             GetReadAhead() const { return fReadAheadFraction; }
+   Int_t                GetNReadAhead() const { return fNReadAhead; }
    Double_t             GetMissEfficiency() const;
    Double_t             GetMissEfficiencyRel() const;
    TTree               *GetTree() const {return fTree;}
@@ -168,6 +186,7 @@ public:
    virtual void         SetLearnPrefill(EPrefillType type = kNoPrefill);
    static void          SetLearnEntries(Int_t n = 10);
    void                 SetOptimizeMisses(Bool_t opt);
+   void                 SetReadAhead(Double_t fraction);
    void                 StartLearningPhase();
    virtual void         StopLearningPhase();
    virtual void         UpdateBranches(TTree *tree);
@@ -106,6 +106,7 @@ public:
    void   CollectBaskets();
    void   CopyMemoryBaskets();
    void   CopyStreamerInfos();
+   void   CopyZstdDictionaries();
    void   CopyProcessIds();
    const char *GetWarning() const { return fWarningMsg; }
    Bool_t Exec();
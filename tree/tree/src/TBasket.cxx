@@ -23,6 +23,7 @@
 #include "TVirtualMutex.h"
 #include "TVirtualPerfStats.h"
 #include "TTimeStamp.h"
+#include "ROOT/RZstdDictionary.hxx"
 #include "ROOT/TIOFeatures.hxx"
 #include "RZip.h"
 
@@ -618,7 +619,17 @@ Int_t TBasket::ReadBasketBuffers(Long64_t pos, Int_t len, TFile *file)
             goto AfterBuffer;
          }
 
-         R__unzip(&nin, rawCompressedObjectBuffer, &nbuf, (unsigned char*) rawUncompressedObjectBuffer, &nout);
+         if (ROOT::Internal::RZstdDictionary::IsCompressedWithDictionary(rawCompressedObjectBuffer)) {
+            auto zstdDict = fBranch->GetZstdDictionary();
+            if (R__unlikely(!zstdDict)) {
+               Error("ReadBasketBuffers", "The basket was compressed with a zstd dictionary that is not available");
+               break;
+            }
+            zstdDict->Decompress(&nin, rawCompressedObjectBuffer, &nbuf, (unsigned char *)rawUncompressedObjectBuffer,
+                                 &nout);
+         } else {
+            R__unzip(&nin, rawCompressedObjectBuffer, &nbuf, (unsigned char *)rawUncompressedObjectBuffer, &nout);
+         }
          if (!nout) break;
          noutot += nout;
          nintot += nin;
@@ -1139,6 +1150,28 @@ Int_t TBasket::WriteBuffer()
    fCycle = fBranch->GetWriteBasket();
    Int_t cxlevel = fBranch->GetCompressionLevel();
    ROOT::RCompressionSetting::EAlgorithm::EValues cxAlgorithm = static_cast<ROOT::RCompressionSetting::EAlgorithm::EValues>(fBranch->GetCompressionAlgorithm());
+   // Baskets of zstd-compressed branches requesting it are compressed with the dictionary of the branch, once it is
+   // trained on the first baskets. Only the baskets that use the dictionary carry the IO bit.
+   const UChar_t zstdDictBit = static_cast<UChar_t>(TBasket::EIOBits::kZstdDictionary);
+   const ROOT::Internal::RZstdDictionary *zstdDict = nullptr;
+   fIOBits &= ~zstdDictBit;
+   if (cxlevel > 0 && cxAlgorithm == ROOT::RCompressionSetting::EAlgorithm::kZSTD &&
+       (fBranch->GetIOFeatures().GetFeatures() & zstdDictBit)) {
+#ifdef R__USE_IMT
+      sentry.unlock();
+#endif  // R__USE_IMT
+      zstdDict = fBranch->TrainZstdDictionary(fBufferRef->Buffer() + fKeylen, fObjlen);
+#ifdef R__USE_IMT
+      sentry.lock();
+#endif  // R__USE_IMT
+      if (zstdDict) {
+         fBranch->WriteZstdDictionary(file);
+         if (fBranch->fZstdDictSeek)
+            fIOBits |= zstdDictBit;
+         else
+            zstdDict = nullptr;
+      }
+   }
    if (cxlevel > 0) {
       Int_t nbuffers = 1 + (fObjlen - 1) / kMAXZIPBUF;
       Int_t buflen = fKeylen + fObjlen + 9 * nbuffers + 28; //add 28 bytes in case object is placed in a deleted gap
@@ -1165,7 +1198,10 @@ Int_t TBasket::WriteBuffer()
          // NOTE this is declared with C linkage, so it shouldn't except.  Also, when
          // USE_IMT is defined, we are guaranteed that the compression buffer is unique per-branch.
          // (see fCompressedBufferRef in constructor).
-         R__zipMultipleAlgorithm(cxlevel, &bufmax, objbuf, &bufmax, bufcur, &nout, cxAlgorithm);
+         if (zstdDict)
+            zstdDict->Compress(cxlevel, &bufmax, objbuf, &bufmax, bufcur, &nout);
+         else
+            R__zipMultipleAlgorithm(cxlevel, &bufmax, objbuf, &bufmax, bufcur, &nout, cxAlgorithm);
 #ifdef R__USE_IMT
          sentry.lock();
 #endif  // R__USE_IMT
@@ -1175,6 +1211,7 @@ Int_t TBasket::WriteBuffer()
          // buffer is larger than the input. In this case, we write the original uncompressed buffer
          if (nout == 0 || nout >= fObjlen) {
             nout = fObjlen;
+            fIOBits &= ~zstdDictBit;
             // We used to delete fBuffer here, we no longer want to since
             // the buffer (held by fCompressedBufferRef) might be re-used later.
             fBuffer = fBufferRef->Buffer();
@@ -17,12 +17,14 @@
 #include "Compression.h"
 #include "TBasket.h"
 #include "TBranchBrowsable.h"
+#include "TBranchElement.h"
 #include "TBrowser.h"
 #include "TBuffer.h"
 #include "TClass.h"
 #include "TBufferFile.h"
 #include "TClonesArray.h"
 #include "TFile.h"
+#include "TKey.h"
 #include "TLeaf.h"
 #include "TLeafB.h"
 #include "TLeafC.h"
@@ -42,6 +44,7 @@
 #include "TTree.h"
 #include "TTreeCache.h"
 #include "TTreeCacheUnzip.h"
+#include "TVirtualCollectionProxy.h"
 #include "TVirtualMutex.h"
 #include "TVirtualPad.h"
 #include "TVirtualPerfStats.h"
@@ -50,8 +53,10 @@
 
 #include "TBranchIMTHelper.h"
 
+#include "ROOT/RZstdDictionary.hxx"
 #include "ROOT/TIOFeatures.hxx"
 
+#include <algorithm>
 #include <atomic>
 #include <cstddef>
 #include <cstring>
@@ -60,6 +65,41 @@
 
 Int_t TBranch::fgCount = 0;
 
+/// The zstd dictionary of a branch: the samples collected from its first baskets until the dictionary is trained,
+/// then the dictionary itself.
+struct ROOT::Internal::TBranchZstdDictionary {
+   std::vector<char> fSamples;           ///< Pieces of the uncompressed baskets, one after the other
+   std::vector<std::size_t> fSampleSizes; ///< Size of each piece in fSamples
+   Int_t fNBaskets = 0;                   ///< Number of baskets sampled
+   Bool_t fDone = kFALSE;                 ///< Whether the training was attempted; it is not retried if it failed
+   std::unique_ptr<ROOT::Internal::RZstdDictionary> fDictionary;
+};
+
+namespace {
+// Train the dictionary of a branch on its first kZstdDictMinBaskets baskets, provided they hold at least
+// kZstdDictMinSamples bytes. Stop collecting after kZstdDictMaxSamples bytes or kZstdDictMaxBaskets baskets.
+constexpr Int_t kZstdDictMinBaskets = 8;
+constexpr Int_t kZstdDictMaxBaskets = 64;
+constexpr std::size_t kZstdDictMinSamples = 32 * 1024;
+constexpr std::size_t kZstdDictMaxSamples = 512 * 1024;
+constexpr std::size_t kZstdDictMaxSize = 32 * 1024;
+
+/// The key holding the zstd dictionary of a branch on file, uncompressed. Its class name, which has no dictionary,
+/// tells TFile::Map and TFile::Recover readers that the key holds neither an object nor a basket.
+class TZstdDictionaryKey : public TKey {
+public:
+   TZstdDictionaryKey(const char *branchName, Int_t nbytes, TFile *file) : TKey(file)
+   {
+      SetName(branchName);
+      SetTitle("zstd dictionary");
+      Build(file, "TZstdDictionary", -1);
+      fKeylen = Sizeof();
+      fObjlen = nbytes;
+      Create(nbytes);
+   }
+};
+} // anonymous namespace
+
 /** \class TBranch
 \ingroup tree
 
@@ -112,6 +152,8 @@ TBranch::TBranch()
 , fBasketBytes(0)
 , fBasketEntry(0)
 , fBasketSeek(0)
+, fZstdDictSeek(0)
+, fZstdDictBytes(0)
 , fTree(0)
 , fMother(0)
 , fParent(0)
@@ -223,6 +265,8 @@ TBranch::TBranch(TTree *tree, const char *name, void *address, const char *leafl
 , fBasketBytes(0)
 , fBasketEntry(0)
 , fBasketSeek(0)
+, fZstdDictSeek(0)
+, fZstdDictBytes(0)
 , fTree(tree)
 , fMother(0)
 , fParent(0)
@@ -277,6 +321,8 @@ TBranch::TBranch(TBranch *parent, const char *name, void *address, const char *l
 , fBasketBytes(0)
 , fBasketEntry(0)
 , fBasketSeek(0)
+, fZstdDictSeek(0)
+, fZstdDictBytes(0)
 , fTree(parent ? parent->GetTree() : 0)
 , fMother(parent ? parent->GetMother() : 0)
 , fParent(parent)
@@ -1400,9 +1446,82 @@ Int_t TBranch::GetBasketAndFirst(TBasket *&basket, Long64_t &first,
 /// This will return true if all the various preconditions necessary hold true
 /// to perform bulk IO (reasonable type, single TLeaf, etc); the bulk IO may
 /// still fail, depending on the contents of the individual TBaskets loaded.
+///
+/// Branches of variable-length arrays and of std::vector of arithmetic types
+/// support bulk IO through GetEntriesSerialized with a count buffer, or
+/// GetBulkEntries with offsets.
 Bool_t TBranch::SupportsBulkRead() const {
    return (fNleaves == 1) &&
-          (static_cast<TLeaf*>(fLeaves.UncheckedAt(0))->GetDeserializeType() != TLeaf::DeserializeType::kDestructive);
+          ((static_cast<TLeaf*>(fLeaves.UncheckedAt(0))->GetDeserializeType() != TLeaf::DeserializeType::kDestructive) ||
+           (GetBulkVectorType() != kOther_t));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// If this branch holds a std::vector of an arithmetic type, streamed as a
+/// whole in each entry, return the type of its elements; return kOther_t
+/// otherwise.
+
+EDataType TBranch::GetBulkVectorType() const
+{
+   if (IsA() != TBranchElement::Class())
+      return kOther_t;
+   auto element = static_cast<const TBranchElement *>(this);
+   if (element->GetType() != 0 || fBranches.GetEntriesFast())
+      return kOther_t;
+   TClass *cl = nullptr;
+   EDataType type = kOther_t;
+   if (const_cast<TBranchElement *>(element)->GetExpectedType(cl, type) || !cl)
+      return kOther_t;
+   TVirtualCollectionProxy *proxy = cl->GetCollectionProxy();
+   if (!proxy || proxy->GetCollectionType() != ROOT::kSTLvector || proxy->GetValueClass() || proxy->HasPointers())
+      return kOther_t;
+   switch (proxy->GetType()) {
+   case kShort_t:
+   case kUShort_t:
+   case kInt_t:
+   case kUInt_t:
+   case kFloat_t:
+   case kDouble_t:
+   case kLong64_t:
+   case kULong64_t: return proxy->GetType();
+   default: return kOther_t;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Remove the headers of the N std::vector entries of the basket, so that
+/// their values are contiguous (and still serialized) from the start of the
+/// basket data. If count_buf is given, the serialized number of values of each
+/// entry is written to it, as for the count branch of a variable-length array.
+///
+/// Returns false if the entries do not have the expected layout.
+
+Bool_t TBranch::ReadBasketVectors(TBasket &basket, Int_t N, EDataType type, TBuffer *count_buf)
+{
+   TBuffer &buf = *basket.GetBufferRef();
+   const Int_t *entryOffset = basket.GetEntryOffset();
+   if (R__unlikely(!entryOffset))
+      return kFALSE;
+   const Int_t size = TDataType::GetDataType(type)->Size();
+   char *dest = buf.Buffer() + basket.GetKeylen();
+   const Int_t countOffset = count_buf ? count_buf->Length() : 0;
+   for (Int_t i = 0; i < N; ++i) {
+      const Int_t end = (i + 1 < N) ? entryOffset[i + 1] : basket.GetLast();
+      buf.SetBufferOffset(entryOffset[i]);
+      buf.ReadVersion();
+      Int_t n;
+      buf >> n;
+      if (R__unlikely(n < 0 || buf.Length() + Long64_t(n) * size != end))
+         return kFALSE;
+      // The destination never overtakes the source: only the headers are dropped.
+      memmove(dest, buf.GetCurrent(), n * size);
+      dest += n * size;
+      if (count_buf)
+         *count_buf << n;
+   }
+   if (count_buf)
+      count_buf->SetBufferOffset(countOffset);
+   return kTRUE;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1488,7 +1607,8 @@ Int_t TBranch::GetEntriesSerialized(Long64_t entry, TBuffer &user_buf, TBuffer *
    // TODO: eventually support multiple leaves.
    if (R__unlikely(fNleaves != 1)) { return -1; }
    TLeaf *leaf = static_cast<TLeaf*>(fLeaves.UncheckedAt(0));
-   if (R__unlikely(leaf->GetDeserializeType() == TLeaf::DeserializeType::kDestructive)) {
+   const EDataType vectorType = GetBulkVectorType();
+   if (R__unlikely(leaf->GetDeserializeType() == TLeaf::DeserializeType::kDestructive && vectorType == kOther_t)) {
       Error("GetEntriesSerialized", "Encountered a branch with destructive deserialization; failing.\n");
       return -1;
    }
@@ -1528,13 +1648,25 @@ Int_t TBranch::GetEntriesSerialized(Long64_t entry, TBuffer &user_buf, TBuffer *
    Int_t N = ((fNextBasketEntry < 0) ? fEntryNumber : fNextBasketEntry) - first;
    //Info("GetEntriesSerialized", "Requesting %d events; fNextBasketEntry=%lld; first=%lld.\n", N, fNextBasketEntry, first);
 
-   if (R__unlikely(!leaf->ReadBasketSerialized(*buf, N))) {
+   if (vectorType != kOther_t) {
+      if (R__unlikely(!ReadBasketVectors(*basket, N, vectorType, count_buf))) {
+         Error("GetEntriesSerialized", "Unexpected layout of the std::vector entries of the basket.\n");
+         return -1;
+      }
+   } else if (R__unlikely(!leaf->ReadBasketSerialized(*buf, N))) {
       Error("GetEntriesSerialized", "Leaf failed to read.\n");
       return -1;
    }
    user_buf.SetBufferOffset(bufbegin);
 
-   if (count_buf) {
+   // As in GetBulkEntries, the memory of the basket now belongs to user_buf.
+   fCurrentBasket = nullptr;
+   fBaskets[fReadBasket] = nullptr;
+   R__ASSERT(fExtraBasket == nullptr && "fExtraBasket should have been set to nullptr by GetFreshBasket");
+   fExtraBasket = basket;
+   basket->DisownBuffer();
+
+   if (count_buf && vectorType == kOther_t) {
       TLeaf *count_leaf = leaf->GetLeafCount();
       if (count_leaf) {
          //printf("Getting leaf count entries.\n");
@@ -1560,6 +1692,92 @@ Int_t TBranch::GetEntriesSerialized(Long64_t entry, TBuffer &user_buf, TBuffer *
    return N;
 }
 
+namespace {
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the N+1 offsets of the values of N entries from their serialized
+/// counts, of type T, each entry holding count * len values.
+
+template <typename T>
+void FillBulkOffsets(char *counts, Int_t N, Int_t len, std::vector<Int_t> &offsets)
+{
+   for (Int_t i = 0; i < N; ++i) {
+      T n;
+      frombuf(counts, &n);
+      offsets[i + 1] = offsets[i] + Int_t(n) * len;
+   }
+}
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read as many events as possible of a branch of variable-length arrays or of
+/// std::vector of an arithmetic type into the given buffer.
+///
+/// Returns -1 in case of a failure.  On success, returns the number N of events
+/// in the buffer.  Their values are contiguous and in host byte order, at
+///
+/// static_cast<T*>(user_buf.GetCurrent())
+///
+/// where T is the type of the values; the values of the i-th event are the
+/// elements [offsets[i], offsets[i+1]) of this array, offsets has N+1 elements.
+/// count_buf holds the basket of the count branch, if any; its leaf may be of
+/// any integer type.
+///
+/// As for GetBulkEntries(Long64_t, TBuffer&), the buffers must not be modified
+/// until they are passed to the next call, and reading must start at the first
+/// entry of a basket.
+
+Int_t TBranch::GetBulkEntries(Long64_t entry, TBuffer &user_buf, TBuffer &count_buf, std::vector<Int_t> &offsets)
+{
+   const Int_t N = GetEntriesSerialized(entry, user_buf, &count_buf);
+   if (R__unlikely(N < 0)) return -1;
+
+   TLeaf *leaf = static_cast<TLeaf*>(fLeaves.UncheckedAt(0));
+   EDataType type = GetBulkVectorType();
+   const Bool_t isVector = type != kOther_t;
+   if (!isVector) {
+      TClass *cl = nullptr;
+      if (R__unlikely(GetExpectedType(cl, type) || cl)) return -1;
+   }
+   TDataType *dataType = TDataType::GetDataType(type);
+   if (R__unlikely(!dataType)) return -1;
+
+   offsets.resize(N + 1);
+   offsets[0] = 0;
+   if (isVector || leaf->GetLeafCount()) {
+      // The counts of std::vector entries are always Int_t, see ReadBasketVectors.
+      EDataType countType = kInt_t;
+      if (!isVector) {
+         TClass *cl = nullptr;
+         if (R__unlikely(leaf->GetLeafCount()->GetBranch()->GetExpectedType(cl, countType) || cl))
+            return -1;
+      }
+      char *counts = count_buf.GetCurrent();
+      const Int_t len = leaf->GetLenStatic();
+      switch (countType) {
+      case kChar_t: FillBulkOffsets<Char_t>(counts, N, len, offsets); break;
+      case kUChar_t: FillBulkOffsets<UChar_t>(counts, N, len, offsets); break;
+      case kShort_t: FillBulkOffsets<Short_t>(counts, N, len, offsets); break;
+      case kUShort_t: FillBulkOffsets<UShort_t>(counts, N, len, offsets); break;
+      case kInt_t: FillBulkOffsets<Int_t>(counts, N, len, offsets); break;
+      case kUInt_t: FillBulkOffsets<UInt_t>(counts, N, len, offsets); break;
+      case kLong64_t: FillBulkOffsets<Long64_t>(counts, N, len, offsets); break;
+      case kULong64_t: FillBulkOffsets<ULong64_t>(counts, N, len, offsets); break;
+      default:
+         Error("GetBulkEntries", "Unsupported type of the count leaf %s.\n", leaf->GetLeafCount()->GetName());
+         return -1;
+      }
+   } else {
+      for (Int_t i = 0; i < N; ++i)
+         offsets[i + 1] = offsets[i] + leaf->GetLenStatic();
+   }
+
+   if (dataType->Size() > 1 && R__unlikely(!user_buf.ByteSwapBuffer(offsets[N], type))) {
+      Error("GetBulkEntries", "Unsupported type of the values.\n");
+      return -1;
+   }
+   return N;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Read all leaves of entry and return total number of bytes read.
 ///
@@ -1949,6 +2167,117 @@ TString TBranch::GetRealFileName() const
    return bFileName;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the zstd dictionary of the baskets of this branch, reading it from the file if needed, or nullptr if the
+/// branch does not have one.
+
+const ROOT::Internal::RZstdDictionary *TBranch::GetZstdDictionary()
+{
+   if (fZstdDict && fZstdDict->fDictionary)
+      return fZstdDict->fDictionary.get();
+   if (fZstdDictSeek == 0)
+      return nullptr;
+
+   TFile *file = GetFile(0);
+   if (!file) {
+      Error("GetZstdDictionary", "Cannot read the zstd dictionary of branch %s: no file", GetName());
+      return nullptr;
+   }
+   std::vector<char> content;
+   {
+      R__LOCKGUARD_IMT(gROOTMutex);
+      TKey key(fZstdDictSeek, fZstdDictBytes, file);
+      if (!key.ReadFile()) {
+         Error("GetZstdDictionary", "Cannot read the zstd dictionary of branch %s at %lld", GetName(), fZstdDictSeek);
+         return nullptr;
+      }
+      char *buffer = key.GetBuffer();
+      key.ReadKeyBuffer(buffer);
+      content.assign(buffer, buffer + key.GetObjlen());
+   }
+   SetZstdDictionary(content);
+   return fZstdDict->fDictionary.get();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Use the given content as zstd dictionary of the baskets written from now on.
+
+void TBranch::SetZstdDictionary(const std::vector<char> &content)
+{
+   if (!fZstdDict)
+      fZstdDict.reset(new ROOT::Internal::TBranchZstdDictionary);
+   fZstdDict->fSamples.clear();
+   fZstdDict->fSampleSizes.clear();
+   fZstdDict->fDone = kTRUE;
+   fZstdDict->fDictionary.reset(new ROOT::Internal::RZstdDictionary(content));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add the uncompressed content of a basket to the samples of the zstd dictionary of this branch, and train
+/// the dictionary once enough baskets were collected.
+/// Return the dictionary to compress this basket with, or nullptr if it is not available (yet).
+
+const ROOT::Internal::RZstdDictionary *TBranch::TrainZstdDictionary(const char *buffer, Int_t size)
+{
+   if (!fZstdDict)
+      fZstdDict.reset(new ROOT::Internal::TBranchZstdDictionary);
+   auto &dict = *fZstdDict;
+   if (dict.fDone)
+      return dict.fDictionary.get();
+
+   for (Int_t pos = 0; pos < size && dict.fSamples.size() < kZstdDictMaxSamples;) {
+      const std::size_t len =
+         std::min<std::size_t>(ROOT::Internal::RZstdDictionary::kMaxSampleSize, static_cast<std::size_t>(size - pos));
+      // zstd does not use samples shorter than 8 bytes
+      if (len >= 8) {
+         dict.fSamples.insert(dict.fSamples.end(), buffer + pos, buffer + pos + len);
+         dict.fSampleSizes.push_back(len);
+      }
+      pos += len;
+   }
+   ++dict.fNBaskets;
+
+   const std::size_t nbytes = dict.fSamples.size();
+   if ((dict.fNBaskets < kZstdDictMinBaskets || nbytes < kZstdDictMinSamples) && nbytes < kZstdDictMaxSamples &&
+       dict.fNBaskets < kZstdDictMaxBaskets)
+      return nullptr;
+
+   dict.fDone = kTRUE;
+   dict.fDictionary = ROOT::Internal::RZstdDictionary::Train(dict.fSamples.data(), dict.fSampleSizes.data(),
+                                                            dict.fSampleSizes.size(),
+                                                            std::min(kZstdDictMaxSize, nbytes / 8));
+   std::vector<char>().swap(dict.fSamples);
+   std::vector<std::size_t>().swap(dict.fSampleSizes);
+   if (!dict.fDictionary && gDebug > 0)
+      Info("TrainZstdDictionary", "Cannot train a zstd dictionary for branch %s, using plain zstd", GetName());
+   return dict.fDictionary.get();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Write the zstd dictionary of this branch to the file, unless it is already there.
+/// The dictionary must be written before the first basket compressed with it.
+
+void TBranch::WriteZstdDictionary(TFile *file)
+{
+   if (fZstdDictSeek != 0 || !fZstdDict || !fZstdDict->fDictionary || !file)
+      return;
+
+   const auto &content = fZstdDict->fDictionary->GetContent();
+   const Int_t nbytes = content.size();
+   TZstdDictionaryKey key(GetName(), nbytes, file);
+   if (key.GetSeekKey() == 0)
+      return;
+   memcpy(key.GetBuffer() + key.GetKeylen(), content.data(), nbytes);
+   const Long64_t seek = key.GetSeekKey();
+   const Int_t keyBytes = key.GetNbytes();
+   if (key.WriteFile(1) < 0) {
+      Error("WriteZstdDictionary", "Cannot write the zstd dictionary of branch %s", GetName());
+      return;
+   }
+   fZstdDictSeek = seek;
+   fZstdDictBytes = keyBytes;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return all elements of one row unpacked in internal array fValues
 /// [Actually just returns 1 (?)]
@@ -2418,6 +2747,10 @@ void TBranch::Reset(Option_t*)
       }
    }
 
+   // The dictionary, if any, is kept and written again to the new file together with the first basket using it.
+   fZstdDictSeek = 0;
+   fZstdDictBytes = 0;
+
    fBaskets.Delete();
    fNBaskets = 0;
 }
@@ -2459,6 +2792,10 @@ void TBranch::ResetAfterMerge(TFileMergeInfo *)
       }
    }
 
+   // The dictionary, if any, is kept and written again to the new file together with the first basket using it.
+   fZstdDictSeek = 0;
+   fZstdDictBytes = 0;
+
    TBasket *reusebasket = (TBasket*)fBaskets[fWriteBasket];
    if (reusebasket) {
       fBaskets[fWriteBasket] = 0;
@@ -2799,6 +3136,7 @@ void TBranch::Streamer(TBuffer& b)
       fCurrentBasket    = 0;
       fFirstBasketEntry = -1;
       fNextBasketEntry  = -1;
+      fZstdDict.reset();
 
       Version_t v = b.ReadVersion(&R__s, &R__c);
       if (v > 9) {
@@ -20,6 +20,7 @@
 - [General Description](#description)
 - [Changes in behaviour](#changesbehaviour)
 - [Self-optimization](#cachemisses)
+- [Read-ahead](#readahead)
 - [Examples of usage](#examples)
 - [Check performance and stats](#checkPerf)
 
@@ -125,6 +126,18 @@ Additionally, on the first miss of an event, we must iterate through all the
 This can be potentially a CPU-expensive operation compared to, e.g., the
 latency of a SSD.  This is why the miss cache is currently disabled by default.
 
+## <a name="readahead"></a>Read-ahead of the next cluster range
+
+The reading of the baskets of the next cluster range can be overlapped with the
+processing of the current one (see the SetReadAhead method). Once the entries
+read cross a configurable fraction of the current cluster range, a background
+thread reads the baskets of the next one into a second buffer, which becomes
+the content of the cache when the reading moves on to the next cluster range.
+The memory used stays within the cache size: each of the two buffers gets half
+of it. This mode is only available for local files and is disabled by default;
+it can be enabled with the TTreeCache.ReadAhead resource or the
+ROOT_TTREECACHE_READAHEAD environment variable, e.g. set to 0.5.
+
 ## <a name="examples"></a>Example usages of TTreeCache
 
 A few use cases are discussed below. A cache may be created with automatic
@@ -295,6 +308,19 @@ myTreeOrChain.GetTree()->PrintCacheStats();
 #include "TVirtualPerfStats.h"
 #include <limits.h>
 
+#include <algorithm>
+#include <cerrno>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+
+#ifndef R__WIN32
+#include <unistd.h>
+#endif
+
 Int_t TTreeCache::fgLearnEntries = 100;
 
 ClassImp(TTreeCache);
@@ -302,7 +328,8 @@ ClassImp(TTreeCache);
 ////////////////////////////////////////////////////////////////////////////////
 /// Default Constructor.
 
-TTreeCache::TTreeCache() : TFileCacheRead(), fPrefillType(GetConfiguredPrefillType())
+TTreeCache::TTreeCache()
+   : TFileCacheRead(), fPrefillType(GetConfiguredPrefillType()), fReadAheadFraction(GetConfiguredReadAhead())
 {
 }
 
@@ -311,7 +338,8 @@ TTreeCache::TTreeCache() : TFileCacheRead(), fPrefillType(GetConfiguredPrefillTy
 
 TTreeCache::TTreeCache(TTree *tree, Int_t buffersize)
    : TFileCacheRead(tree->GetCurrentFile(), buffersize, tree), fEntryMax(tree->GetEntriesFast()), fEntryNext(0),
-     fBrNames(new TList), fTree(tree), fPrefillType(GetConfiguredPrefillType())
+     fBrNames(new TList), fTree(tree), fPrefillType(GetConfiguredPrefillType()),
+     fReadAheadFraction(GetConfiguredReadAhead())
 {
    fEntryNext = fEntryMin + fgLearnEntries;
    Int_t nleaves = tree->GetListOfLeaves()->GetEntries();
@@ -323,6 +351,8 @@ TTreeCache::TTreeCache(TTree *tree, Int_t buffersize)
 
 TTreeCache::~TTreeCache()
 {
+   DiscardReadAhead();
+
    // Informe the TFile that we have been deleted (in case
    // we are deleted explicitly by legacy user code).
    if (fFile) fFile->SetCacheRead(0, fTree);
@@ -1100,6 +1130,362 @@ struct BasketRanges {
 };
 } // Anonymous namespace.
 
+////////////////////////////////////////////////////////////////////////////////
+/// The baskets of the cluster range following the current one, read in a
+/// background thread while the current cluster range is being processed.
+/// They are read into the part of the cache buffer that the current baskets
+/// leave unused, so that the memory used stays within the cache size.
+
+struct TTreeCache::ReadAhead {
+   Long64_t fEntryCurrent{-1};    ///< First entry of the cluster range read ahead
+   Long64_t fEntryNext{-1};       ///< Last entry + 1 of the cluster range read ahead
+   std::vector<Long64_t> fSeek;   ///< Positions of the baskets in the file, sorted and unique
+   std::vector<Int_t> fSeekLen;   ///< Length of the baskets
+   std::vector<std::pair<TBranch *, Int_t>> fBaskets; ///< Branch and basket number of each basket
+   Int_t fOffset{0};              ///< Position of the content of the baskets, one after the other, in fBuffer
+   Int_t fNbytes{0};              ///< Length of the content of the baskets
+   Int_t fReadCalls{0};           ///< Number of reads issued to fill fBuffer
+   std::future<Bool_t> fResult;   ///< Outcome of the reads, valid until the content is installed or dropped
+
+   ~ReadAhead()
+   {
+      if (fResult.valid())
+         fResult.wait();
+   }
+};
+
+namespace {
+////////////////////////////////////////////////////////////////////////////////
+/// Read the `n` blocks at the sorted positions `pos` of the file descriptor `fd`
+/// one after the other into `buf`, merging the reads of adjacent blocks.
+/// Uses positional reads, which do not change the file offset used by the
+/// TFile in the main thread.
+
+Bool_t ReadAheadBlocks(Int_t fd, Long64_t offset, const Long64_t *pos, const Int_t *len, Int_t n, char *buf)
+{
+#ifndef R__WIN32
+   for (Int_t i = 0; i < n;) {
+      Long64_t start = pos[i];
+      size_t nbytes = len[i];
+      for (++i; i < n && pos[i] == start + (Long64_t)nbytes && nbytes < 16000000; ++i)
+         nbytes += len[i];
+      Long64_t at = start + offset;
+      while (nbytes) {
+         ssize_t res = pread(fd, buf, nbytes, at);
+         if (res < 0 && errno == EINTR)
+            continue;
+         if (res <= 0)
+            return kFALSE;
+         buf += res;
+         at += res;
+         nbytes -= res;
+      }
+   }
+   return kTRUE;
+#else
+   (void)fd; (void)offset; (void)pos; (void)len; (void)n; (void)buf;
+   return kFALSE;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Number of reads issued by ReadAheadBlocks.
+
+Int_t CountReadAheadCalls(const Long64_t *pos, const Int_t *len, Int_t n)
+{
+   Int_t calls = 0;
+   for (Int_t i = 0; i < n; ++calls) {
+      Long64_t start = pos[i];
+      Long64_t nbytes = len[i];
+      for (++i; i < n && pos[i] == start + nbytes && nbytes < 16000000; ++i)
+         nbytes += len[i];
+   }
+   return calls;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// The thread issuing the reads ahead of all the TTreeCaches, one after the
+/// other, so that reading ahead does not create a thread per cluster range.
+
+class ReadAheadThread {
+   std::mutex fMutex;
+   std::condition_variable fCondition;
+   std::deque<std::packaged_task<Bool_t()>> fTasks;
+
+   void Run()
+   {
+      while (true) {
+         std::packaged_task<Bool_t()> task;
+         {
+            std::unique_lock<std::mutex> lock(fMutex);
+            fCondition.wait(lock, [this] { return !fTasks.empty(); });
+            task = std::move(fTasks.front());
+            fTasks.pop_front();
+         }
+         task();
+      }
+   }
+
+public:
+   ReadAheadThread() { std::thread([this] { Run(); }).detach(); }
+
+   /// Queue `reads` to be run by the thread, return their outcome.
+   std::future<Bool_t> Submit(std::function<Bool_t()> reads)
+   {
+      std::packaged_task<Bool_t()> task(std::move(reads));
+      auto result = task.get_future();
+      {
+         std::lock_guard<std::mutex> lock(fMutex);
+         fTasks.push_back(std::move(task));
+      }
+      fCondition.notify_one();
+      return result;
+   }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// The thread is started on first use and never stopped: it must outlive all
+/// the caches, including the ones deleted at exit.
+
+ReadAheadThread &GetReadAheadThread()
+{
+   static auto *thread = new ReadAheadThread;
+   return *thread;
+}
+} // Anonymous namespace.
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the read-ahead fraction from the environment or resource variable,
+/// ROOT_TTREECACHE_READAHEAD or TTreeCache.ReadAhead, see SetReadAhead.
+
+Double_t TTreeCache::GetConfiguredReadAhead() const
+{
+   const char *stcp;
+   Double_t fraction = 0;
+
+   if (!(stcp = gSystem->Getenv("ROOT_TTREECACHE_READAHEAD")) || !*stcp) {
+      fraction = gEnv->GetValue("TTreeCache.ReadAhead", 0.);
+   } else {
+      fraction = TString(stcp).Atof();
+   }
+
+   return std::min(std::max(fraction, 0.), 1.);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the maximum size of the baskets that FillBuffer loads at once.
+/// When reading ahead, the cache memory is shared between the current and the
+/// next cluster range.
+
+Int_t TTreeCache::GetFillSizeLimit() const
+{
+   return CanReadAhead() ? fBufferSizeMin / 2 : fBufferSizeMin;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return true if the next cluster range can be read ahead: the file must be a
+/// local, read-only file and the cache must use the synchronous, non-prefetching
+/// mode.
+
+Bool_t TTreeCache::CanReadAhead() const
+{
+#ifdef R__WIN32
+   return kFALSE;
+#else
+   return fReadAheadFraction > 0 && fFile && fFile->IsA() == TFile::Class() && fFile->GetFd() >= 0 &&
+          !fFile->IsWritable() && !fEnablePrefetching && !fAsyncReading && !fIsLearning && fNbranches > 0 &&
+          !fTree->GetEventList();
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Start reading the baskets of the cluster range following the current one in
+/// a background thread, once the entries read have crossed the read-ahead
+/// fraction of the current cluster range. At most once per cluster range.
+
+void TTreeCache::StartReadAhead()
+{
+   if (fEntryCurrent < 0 || fEntryNext <= fEntryCurrent || fEntryNext >= fEntryMax || !fIsTransferred)
+      return;
+   if (fReadAhead && fReadAhead->fEntryCurrent == fEntryNext)
+      return; // Already done or attempted for this range.
+   if (!CanReadAhead())
+      return;
+
+   TTree *tree = ((TBranch *)fBranches->UncheckedAt(0))->GetTree();
+   const Long64_t entry = tree->GetReadEntry();
+   if (entry < fEntryCurrent + fReadAheadFraction * (fEntryNext - fEntryCurrent))
+      return;
+
+   DiscardReadAhead();
+   if (!fReadAhead)
+      fReadAhead.reset(new ReadAhead);
+   auto &ra = *fReadAhead;
+   ra.fEntryCurrent = ra.fEntryNext = fEntryNext;
+
+   // The current baskets are one after the other in fBuffer: use the larger of the free parts before and after them.
+   const Int_t currentBegin = fNseek > 0 ? fSeekPos[0] : 0;
+   const Int_t currentEnd = fNseek > 0 ? fSeekPos[fNseek - 1] + fSeekSortLen[fNseek - 1] : 0;
+   const Int_t freeAfter = fBufferSize - currentEnd;
+   ra.fOffset = freeAfter >= currentBegin ? currentEnd : 0;
+
+   // Collect the baskets of the next clusters, as many whole clusters as fit in the memory left.
+   struct Block {
+      Long64_t fPos;
+      Int_t fLen;
+      TBranch *fBranch;
+      Int_t fBasket;
+   };
+   std::vector<Block> blocks;
+   std::vector<Int_t> lastBasket(fNbranches, -1);
+   // At most half of the cache: the baskets read ahead must not make fBuffer grow once installed.
+   const Int_t sizeLimit = std::min(GetFillSizeLimit(), std::max(freeAfter, currentBegin));
+   Int_t ntot = 0;
+   auto clusterIter = tree->GetClusterIterator(fEntryNext);
+   clusterIter();
+   while (ra.fEntryNext < fEntryMax) {
+      const Long64_t clusterEnd = std::min(clusterIter.GetNextEntry(), fEntryMax);
+      if (clusterEnd <= ra.fEntryNext)
+         break;
+      const auto nblocks = blocks.size();
+      Int_t nbytes = 0;
+      for (Int_t i = 0; i < fNbranches; ++i) {
+         TBranch *b = (TBranch *)fBranches->UncheckedAt(i);
+         if (b->GetDirectory() == 0 || b->TestBit(TBranch::kDoNotProcess))
+            continue;
+         if (b->GetDirectory()->GetFile() != fFile)
+            continue;
+         Int_t *lbaskets = b->GetBasketBytes();
+         Long64_t *entries = b->GetBasketEntry();
+         const Int_t nb = std::min(b->GetWriteBasket() + 1, b->GetMaxBaskets());
+         if (!lbaskets || !entries || nb <= 0)
+            continue;
+         const Int_t blistsize = b->GetListOfBaskets()->GetSize();
+         Int_t j = std::max<Int_t>(TMath::BinarySearch(nb, entries, ra.fEntryNext), 0);
+         for (; j < nb && entries[j] < clusterEnd; ++j) {
+            if (j <= lastBasket[i])
+               continue;
+            if (j < blistsize && b->GetListOfBaskets()->UncheckedAt(j))
+               continue;
+            Long64_t pos = b->GetBasketSeek(j);
+            Int_t len = lbaskets[j];
+            if (pos <= 0 || len <= 0 || len > fBufferSizeMin || b->fCacheInfo.IsVetoed(j))
+               continue;
+            blocks.push_back({pos, len, b, j});
+            nbytes += len;
+         }
+      }
+      if (ntot + nbytes > sizeLimit) {
+         blocks.resize(nblocks);
+         break;
+      }
+      for (auto k = nblocks; k < blocks.size(); ++k) {
+         Int_t i = fBranches->IndexOf(blocks[k].fBranch);
+         lastBasket[i] = std::max(lastBasket[i], blocks[k].fBasket);
+      }
+      ntot += nbytes;
+      ra.fEntryNext = clusterEnd;
+      clusterIter.Next();
+   }
+   if (blocks.empty()) {
+      if (gDebug > 5)
+         Info("StartReadAhead", "Nothing to read ahead from entry %lld", fEntryNext);
+      return;
+   }
+
+   std::sort(blocks.begin(), blocks.end(), [](const Block &a, const Block &b) { return a.fPos < b.fPos; });
+   ra.fSeek.clear();
+   ra.fSeekLen.clear();
+   ra.fBaskets.clear();
+   ntot = 0;
+   for (const auto &block : blocks) {
+      ra.fBaskets.emplace_back(block.fBranch, block.fBasket);
+      if (!ra.fSeek.empty() && ra.fSeek.back() == block.fPos)
+         continue; // Baskets shared by several branches are read once.
+      ra.fSeek.push_back(block.fPos);
+      ra.fSeekLen.push_back(block.fLen);
+      ntot += block.fLen;
+   }
+   ra.fNbytes = ntot;
+   ra.fReadCalls = CountReadAheadCalls(ra.fSeek.data(), ra.fSeekLen.data(), ra.fSeek.size());
+
+   if (gDebug > 5)
+      Info("StartReadAhead", "Reading ahead %zu baskets, %d bytes, for entries [%lld, %lld[", ra.fSeek.size(), ntot,
+           ra.fEntryCurrent, ra.fEntryNext);
+
+   ra.fResult = GetReadAheadThread().Submit(std::bind(ReadAheadBlocks, fFile->GetFd(), fFile->GetArchiveOffset(),
+                                                      ra.fSeek.data(), ra.fSeekLen.data(), (Int_t)ra.fSeek.size(),
+                                                      fBuffer + ra.fOffset));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// If the cluster range read ahead contains `entry`, wait for its reads to
+/// complete and make it the current content of the cache. Return false, and
+/// drop the content read ahead, otherwise.
+
+Bool_t TTreeCache::InstallReadAhead(Long64_t entry)
+{
+   if (!fReadAhead || !fReadAhead->fResult.valid())
+      return kFALSE;
+   auto &ra = *fReadAhead;
+   if (entry < ra.fEntryCurrent || ra.fEntryNext <= entry || !ra.fResult.get()) {
+      DiscardReadAhead();
+      return kFALSE;
+   }
+
+   if (ra.fEntryCurrent < fCurrentClusterStart || fNextClusterStart <= ra.fEntryCurrent) {
+      // We are moving on to another set of clusters.
+      for (Int_t i = 0; i < fNbranches; ++i)
+         ((TBranch *)fBranches->UncheckedAt(i))->fCacheInfo.Reset();
+      fCurrentClusterStart = ra.fEntryCurrent;
+   }
+   fNextClusterStart = ra.fEntryNext;
+   fEntryCurrent = ra.fEntryCurrent;
+   fEntryNext = ra.fEntryNext;
+
+   TFileCacheRead::Prefetch(0, 0);
+   for (size_t i = 0; i < ra.fSeek.size(); ++i)
+      TFileCacheRead::Prefetch(ra.fSeek[i], ra.fSeekLen[i]);
+   TFileCacheRead::Sort();
+   // The baskets are already in fBuffer, where they were read ahead.
+   for (Int_t i = 0; i < fNseek; ++i)
+      fSeekPos[i] += ra.fOffset;
+   fIsTransferred = kTRUE;
+
+   auto perfStats = GetTree()->GetPerfStats();
+   for (const auto &basket : ra.fBaskets) {
+      basket.first->fCacheInfo.SetIsInCache(basket.second);
+      if (R__unlikely(perfStats))
+         perfStats->SetLoaded(basket.first, basket.second);
+   }
+   fNReadPref += ra.fBaskets.size();
+   ++fNReadAhead;
+
+   // The reads happened in another thread: account for them now.
+   const Long64_t nbytes = ra.fNbytes;
+   fBytesRead += nbytes;
+   fReadCalls += ra.fReadCalls;
+   fFile->AddBytesRead(nbytes, ra.fReadCalls);
+
+   if (gDebug > 5)
+      Info("InstallReadAhead", "Using the %zu baskets read ahead for entries [%lld, %lld[", ra.fSeek.size(),
+           fEntryCurrent, fEntryNext);
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Wait for the reads ahead in flight, if any, and drop their content.
+
+void TTreeCache::DiscardReadAhead()
+{
+   if (!fReadAhead)
+      return;
+   if (fReadAhead->fResult.valid())
+      fReadAhead->fResult.wait();
+   fReadAhead->fResult = std::future<Bool_t>();
+   fReadAhead->fEntryCurrent = fReadAhead->fEntryNext = -1;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Fill the cache buffer with the branches in the cache.
 
@@ -1227,6 +1613,10 @@ Bool_t TTreeCache::FillBuffer()
    if (entry == -1)
       entry = 0;
 
+   // The next cluster range may have been read ahead already.
+   if (!fEnablePrefetching && !fIsLearning && InstallReadAhead(entry))
+      return kTRUE;
+
    Bool_t resetBranchInfo = kFALSE;
    if (entry < fCurrentClusterStart || fNextClusterStart <= entry) {
       // We are moving on to another set of clusters.
@@ -1326,6 +1716,7 @@ Bool_t TTreeCache::FillBuffer()
    Long64_t maxReadEntry = minEntry; // If we are stopped before the end of the 2nd pass, this marker will where we need to start next time.
    Int_t nReadPrefRequest = 0;
    auto perfStats = GetTree()->GetPerfStats();
+   const Int_t sizeLimit = GetFillSizeLimit();
    do {
       prevNtot = ntotCurrentBuf;
       Long64_t lowestMaxEntry = fEntryMax; // The lowest maximum entry in the TTreeCache for each branch for each pass.
@@ -1357,7 +1748,7 @@ Bool_t TTreeCache::FillBuffer()
        &cursor, &lowestMaxEntry, &maxReadEntry, &minEntry,
        &reachedEnd, &skippedFirst, &oncePerBranch, &nDistinctLoad, &progress,
        &ranges, &memRanges, &reqRanges,
-       &ntotCurrentBuf, &nReadPrefRequest](EPass pass, ENarrow narrow, Long64_t maxCollectEntry) {
+       &ntotCurrentBuf, &nReadPrefRequest, sizeLimit](EPass pass, ENarrow narrow, Long64_t maxCollectEntry) {
          // The first pass we add one basket per branches around the requested entry
          // then in the second pass we add the other baskets of the cluster.
          // This is to support the case where the cache is too small to hold a full cluster.
@@ -1516,7 +1907,7 @@ Bool_t TTreeCache::FillBuffer()
                   }
                }
 
-               if ((ntotCurrentBuf + len) > fBufferSizeMin) {
+               if ((ntotCurrentBuf + len) > sizeLimit) {
                   // Humm ... we are going to go over the requested size.
                   if (clusterIterations > 0 && cursor[i].fLoadedOnce) {
                      // We already have a full cluster and now we would go over the requested
@@ -1526,14 +1917,14 @@ Bool_t TTreeCache::FillBuffer()
                         Info(
                            "FillBuffer",
                            "Breaking early because %d is greater than %d at cluster iteration %d will restart at %lld",
-                           (ntotCurrentBuf + len), fBufferSizeMin, clusterIterations, minEntry);
+                           (ntotCurrentBuf + len), sizeLimit, clusterIterations, minEntry);
                      }
                      fEntryNext = minEntry;
                      filled = kTRUE;
                      break;
                   } else {
                      if (pass == kStart || !cursor[i].fLoadedOnce) {
-                        if ((ntotCurrentBuf + len) > 4 * fBufferSizeMin) {
+                        if ((ntotCurrentBuf + len) > 4 * sizeLimit) {
                            // Okay, so we have not even made one pass and we already have
                            // accumulated request for more than twice the memory size ...
                            // So stop for now, and will restart at the same point, hoping
@@ -1543,7 +1934,7 @@ Bool_t TTreeCache::FillBuffer()
                            if (showMore || gDebug > 5) {
                               Info("FillBuffer", "Breaking early because %d is greater than 4*%d at cluster iteration "
                                                  "%d pass %d will restart at %lld",
-                                   (ntotCurrentBuf + len), fBufferSizeMin, clusterIterations, pass, fEntryNext);
+                                   (ntotCurrentBuf + len), sizeLimit, clusterIterations, pass, fEntryNext);
                            }
                            filled = kTRUE;
                            break;
@@ -1552,12 +1943,12 @@ Bool_t TTreeCache::FillBuffer()
                         // We have made one pass through the branches and thus already
                         // requested one basket per branch, let's stop prefetching
                         // now.
-                        if ((ntotCurrentBuf + len) > 2 * fBufferSizeMin) {
+                        if ((ntotCurrentBuf + len) > 2 * sizeLimit) {
                            fEntryNext = maxReadEntry;
                            if (showMore || gDebug > 5) {
                               Info("FillBuffer", "Breaking early because %d is greater than 2*%d at cluster iteration "
                                                  "%d pass %d will restart at %lld",
-                                   (ntotCurrentBuf + len), fBufferSizeMin, clusterIterations, pass, fEntryNext);
+                                   (ntotCurrentBuf + len), sizeLimit, clusterIterations, pass, fEntryNext);
                            }
                            filled = kTRUE;
                            break;
@@ -1687,7 +2078,7 @@ Bool_t TTreeCache::FillBuffer()
       // at,
       // which start at 'minEntry', is not past the end of the requested range (minEntry < fEntryMax)
       // and we guess that we not going to go over the requested amount of memory by asking for another set
-      // of entries (fBufferSizeMin > ((Long64_t)ntotCurrentBuf*(clusterIterations+1))/clusterIterations).
+      // of entries (sizeLimit > ((Long64_t)ntotCurrentBuf*(clusterIterations+1))/clusterIterations).
       // ntotCurrentBuf / clusterIterations is the average size we are accumulated so far at each loop.
       // and thus (ntotCurrentBuf / clusterIterations) * (clusterIterations+1) is a good guess at what the next total
       // size
@@ -1695,10 +2086,10 @@ Bool_t TTreeCache::FillBuffer()
       // be 'large' (i.e. 30Mb * 300 intervals) and can overflow the numerical limit of Int_t (i.e. become
       // artificially negative).   To avoid this issue we promote ntotCurrentBuf to a long long (64 bits rather than 32
       // bits)
-      if (!((fBufferSizeMin > ((Long64_t)ntotCurrentBuf * (clusterIterations + 1)) / clusterIterations) &&
+      if (!((sizeLimit > ((Long64_t)ntotCurrentBuf * (clusterIterations + 1)) / clusterIterations) &&
             (prevNtot < ntotCurrentBuf) && (minEntry < fEntryMax))) {
          if (showMore || gDebug > 6)
-            Info("FillBuffer", "Breaking because %d <= %lld || (%d >= %d) || %lld >= %lld", fBufferSizeMin,
+            Info("FillBuffer", "Breaking because %d <= %lld || (%d >= %d) || %lld >= %lld", sizeLimit,
                  ((Long64_t)ntotCurrentBuf * (clusterIterations + 1)) / clusterIterations, prevNtot, ntotCurrentBuf,
                  minEntry, fEntryMax);
          break;
@@ -1756,7 +2147,7 @@ Bool_t TTreeCache::FillBuffer()
    } else {
       if (showMore || gDebug > 5) {
          Info("FillBuffer", "Complete adding %d baskets from %d branches taking in memory %d out of %d",
-              nReadPrefRequest, reqRanges.BranchesRegistered(), ntotCurrentBuf, fBufferSizeMin);
+              nReadPrefRequest, reqRanges.BranchesRegistered(), ntotCurrentBuf, sizeLimit);
       }
    }
 
@@ -1909,6 +2300,8 @@ Int_t TTreeCache::ReadBufferNormal(char *buf, Long64_t pos, Int_t len){
    //Is request already in the cache?
    if (TFileCacheRead::ReadBuffer(buf,pos,len) == 1){
       fNReadOk++;
+      if (fReadAheadFraction > 0)
+         StartReadAhead();
       return 1;
    }
 
@@ -2020,6 +2413,7 @@ Int_t TTreeCache::ReadBuffer(char *buf, Long64_t pos, Int_t len)
 
 void TTreeCache::ResetCache()
 {
+   DiscardReadAhead();
    for (Int_t i = 0; i < fNbranches; ++i) {
       TBranch *b = (TBranch*)fBranches->UncheckedAt(i);
       if (b->GetDirectory()==0 || b->TestBit(TBranch::kDoNotProcess))
@@ -2052,6 +2446,7 @@ void TTreeCache::ResetCache()
 
 Int_t TTreeCache::SetBufferSize(Int_t buffersize)
 {
+   DiscardReadAhead();
    Int_t prevsize = GetBufferSize();
    Int_t res = TFileCacheRead::SetBufferSize(buffersize);
    if (res < 0) {
@@ -2089,6 +2484,8 @@ void TTreeCache::SetEntryRange(Long64_t emin, Long64_t emax)
    // don't restart it if the user has specified the branches.
    Bool_t needLearningStart = (fEntryMin != emin) && fIsLearning && !fIsManual;
 
+   DiscardReadAhead();
+
    fEntryMin  = emin;
    fEntryMax  = emax;
    fEntryNext  = fEntryMin + fgLearnEntries * (fIsLearning && !fIsManual);
@@ -2110,6 +2507,7 @@ void TTreeCache::SetFile(TFile *file, TFile::ECacheAction action)
    // The infinite recursion is 'broken' by the fact that
    // TFile::SetCacheRead remove the entry from fCacheReadMap _before_
    // calling SetFile (and also by setting fFile to zero before the calling).
+   DiscardReadAhead();
    if (fFile) {
       TFile *prevFile = fFile;
       fFile = 0;
@@ -2142,6 +2540,37 @@ void TTreeCache::SetLearnPrefill(TTreeCache::EPrefillType type /* = kNoPrefill *
    fPrefillType = type;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Read the baskets of the next cluster range in a background thread once the
+/// entries read have crossed the given fraction of the current cluster range,
+/// e.g. 0.5 for half-way through it. 0 disables the read-ahead.
+///
+/// The cache memory is then shared between the baskets in use and the baskets
+/// read ahead: each of them gets half of the cache size, and no memory is
+/// allocated besides the cache buffer. GetNReadAhead returns the number of
+/// cluster ranges that were read ahead and then used.
+/// The read-ahead is only done for local files, when neither asynchronous
+/// reading nor prefetching (TFile.AsyncPrefetching) are in use; it is ignored
+/// otherwise.
+/// The default value can be set with TTreeCache.ReadAhead or the environment
+/// variable ROOT_TTREECACHE_READAHEAD.
+
+void TTreeCache::SetReadAhead(Double_t fraction)
+{
+   fReadAheadFraction = std::min(std::max(fraction, 0.), 1.);
+   if (fReadAheadFraction == 0)
+      DiscardReadAhead();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Wait for the baskets being read ahead, if any, before the file is closed.
+
+void TTreeCache::Close(Option_t *option)
+{
+   DiscardReadAhead();
+   TFileCacheRead::Close(option);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// The name should be enough to explain the method.
 /// The only additional comments is that the cache is cleaned before
@@ -2149,6 +2578,7 @@ void TTreeCache::SetLearnPrefill(TTreeCache::EPrefillType type /* = kNoPrefill *
 
 void TTreeCache::StartLearningPhase()
 {
+   DiscardReadAhead();
    fIsLearning = kTRUE;
    fIsManual = kFALSE;
    fNbranches  = 0;
@@ -2190,6 +2620,7 @@ void TTreeCache::StopLearningPhase()
 
 void TTreeCache::UpdateBranches(TTree *tree)
 {
+   DiscardReadAhead();
 
    fTree = tree;
 
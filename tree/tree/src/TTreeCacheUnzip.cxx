@@ -28,6 +28,7 @@ A TTreeCache which exploits parallelized decompression of its own content.
 #include "TROOT.h"
 #include "TMutex.h"
 #include "ROOT/RMakeUnique.hxx"
+#include "ROOT/RZstdDictionary.hxx"
 
 #ifdef R__USE_IMT
 #include "ROOT/TThreadExecutor.hxx"
@@ -857,6 +858,11 @@ Int_t TTreeCacheUnzip::UnzipBuffer(char **dest, char *src)
    Int_t nbytes = 0, objlen = 0, keylen = 0;
    GetRecordHeader(src, hlen, nbytes, objlen, keylen);
 
+   // Baskets compressed with the zstd dictionary of their branch are left to TBasket::ReadBasketBuffers,
+   // which knows where to find the dictionary.
+   if (objlen > nbytes - keylen && ROOT::Internal::RZstdDictionary::IsCompressedWithDictionary((UChar_t *)src + keylen))
+      return -1;
+
    if (!(*dest)) {
       /* early consistency check */
       UChar_t *bufcur = (UChar_t *) (src + keylen);
@@ -35,6 +35,7 @@ Class implementing or helping  the various TTree cloning method
 #include "TFileCacheRead.h"
 #include "TTreeCache.h"
 #include "snprintf.h"
+#include "ROOT/RZstdDictionary.hxx"
 
 #include <algorithm>
 
@@ -201,6 +202,7 @@ Bool_t TTreeCloner::Exec()
    ImportClusterRanges();
    CopyStreamerInfos();
    CopyProcessIds();
+   CopyZstdDictionaries();
    CloseOutWriteBaskets();
    CollectBaskets();
    SortBaskets();
@@ -313,6 +315,22 @@ UInt_t TTreeCloner::CollectBranches(TBranch *from, TBranch *to) {
 
    }
 
+   if (from->fZstdDictSeek) {
+      // The baskets are copied as is: they must be decompressed with the same dictionary.
+      auto fromdict = from->GetZstdDictionary();
+      auto todict = to->GetZstdDictionary();
+      if (!fromdict || (todict && todict->GetContent() != fromdict->GetContent())) {
+         fWarningMsg.Form("The export branch and the import branch (%s) do not have the same zstd dictionary",
+                          from->GetName());
+         if (!(fOptions & kNoWarnings)) {
+            Warning("TTreeCloner::CollectBranches", "%s", fWarningMsg.Data());
+         }
+         fIsValid = kFALSE;
+         fNeedConversion = kTRUE;
+         return 0;
+      }
+   }
+
    fFromBranches.AddLast(from);
    if (!from->TestBit(TBranch::kDoNotUseBufferMap)) {
       // Make sure that we reset the Buffer's map if needed.
@@ -501,6 +519,23 @@ void TTreeCloner::CopyMemoryBaskets()
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Make sure that the zstd dictionaries needed to decompress the copied baskets
+/// are present in the output file.
+
+void TTreeCloner::CopyZstdDictionaries()
+{
+   for (Int_t i = 0; i < fToBranches.GetEntries(); ++i) {
+      TBranch *from = (TBranch *)fFromBranches.UncheckedAt(i);
+      TBranch *to = (TBranch *)fToBranches.UncheckedAt(i);
+      if (!from->fZstdDictSeek)
+         continue;
+      if (!to->GetZstdDictionary())
+         to->SetZstdDictionary(from->GetZstdDictionary()->GetContent());
+      to->WriteZstdDictionary(to->GetFile(1));
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Make sure that all the needed TStreamerInfo are
 /// present in the output file
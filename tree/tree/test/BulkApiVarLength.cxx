@@ -6,15 +6,20 @@
 #include "TFile.h"
 #include "TTree.h"
 #include "TStopwatch.h"
+#include "TSystem.h"
 #include "TTreeReader.h"
 #include "TTreeReaderValue.h"
 #include "TTreeReaderArray.h"
+#include "ROOT/TTreeReaderArrayFast.hxx"
 #include "ROOT/TTreeReaderFast.hxx"
 #include "ROOT/TTreeReaderValueFast.hxx"
 #include "ROOT/TIOFeatures.hxx"
 
 #include "gtest/gtest.h"
 
+#include <memory>
+#include <vector>
+
 class BulkApiVariableTest : public ::testing::Test {
 public:
    static constexpr Long64_t fClusterSize = 1e5;
@@ -235,3 +240,218 @@ TEST_F(BulkApiVariableTest, serializedRead)
    printf("Bulk Serialized API: Successful read of all events.\n");
    printf("Bulk Serialized API: Total elapsed time (seconds) for API: %.2f\n", sw.RealTime());
 }
+
+TEST_F(BulkApiVariableTest, fastRead)
+{
+   auto hfile = TFile::Open(fFileName.c_str());
+   printf("Starting read of file %s.\n", fFileName.c_str());
+   TStopwatch sw;
+
+   printf("Using TTreeReaderFast.\n");
+   ROOT::Experimental::TTreeReaderFast myReader("T", hfile);
+   ROOT::Experimental::TTreeReaderArrayFast<float> myF(myReader, "f");
+   ROOT::Experimental::TTreeReaderArrayFast<double> myD(myReader, "d");
+   ROOT::Experimental::TTreeReaderValueFast<Int_t> myLen(myReader, "myLen");
+   myReader.SetEntry(0);
+   ASSERT_EQ(ROOT::Internal::TTreeReaderValueBase::kSetupMatch, myF.GetSetupStatus());
+   ASSERT_EQ(ROOT::Internal::TTreeReaderValueBase::kSetupMatch, myD.GetSetupStatus());
+   ASSERT_EQ(myReader.GetEntryStatus(), TTreeReader::kEntryValid);
+
+   Long64_t idx = 0;
+   float idx_f = 0;
+   double idx_d = 2;
+   sw.Start();
+   for (auto reader_idx : myReader) {
+      ASSERT_EQ(reader_idx, idx);
+      const Long64_t ev = idx + 1;
+      ASSERT_EQ(*myLen, ev % 10);
+      ASSERT_EQ(myF.size(), static_cast<size_t>(ev % 10));
+      ASSERT_EQ(myD.size(), static_cast<size_t>(ev % 10));
+      for (size_t entry_idx = 0; entry_idx < myF.size(); entry_idx++) {
+         if (R__unlikely((ev < 1600000) && (myF[entry_idx] != idx_f || myD[entry_idx] != idx_d))) {
+            printf("Incorrect values %f and %f, expected %f and %f (event %lld, entry %zu)\n", myF[entry_idx],
+                   myD[entry_idx], idx_f, idx_d, ev, entry_idx);
+            ASSERT_TRUE(false);
+         }
+         idx_f++;
+         idx_d++;
+      }
+      idx++;
+   }
+   ASSERT_EQ(idx, fEventCount);
+
+   sw.Stop();
+   printf("TTreeReaderFast: Successful read of all events.\n");
+   printf("TTreeReaderFast: Total elapsed time (seconds) for bulk APIs: %.2f\n", sw.RealTime());
+}
+
+class BulkApiVectorTest : public ::testing::Test {
+public:
+   static constexpr Long64_t fClusterSize = 1e4;
+   static constexpr Long64_t fEventCount = 1e5;
+   const std::string fFileName = "BulkApiTestVector.root";
+
+protected:
+   virtual void SetUp()
+   {
+      auto hfile = new TFile(fFileName.c_str(), "RECREATE", "TTree vector micro benchmark ROOT file");
+
+      auto tree = new TTree("T", "A ROOT tree of std::vector branches.");
+      tree->SetBit(TTree::kOnlyFlushAtCluster);
+      tree->SetAutoFlush(fClusterSize);
+
+      std::vector<float> f;
+      std::vector<Long64_t> l;
+      tree->Branch("f", &f);
+      tree->Branch("l", &l);
+      float f_counter = 0;
+      for (Long64_t ev = 0; ev < fEventCount; ev++) {
+         f.clear();
+         l.clear();
+         for (Int_t idx = 0; idx < (ev % 7); idx++) {
+            f.push_back(f_counter++);
+            l.push_back(ev * 10 + idx);
+         }
+         tree->Fill();
+      }
+      hfile = tree->GetCurrentFile();
+      hfile->Write();
+      delete hfile;
+   }
+};
+
+constexpr Long64_t BulkApiVectorTest::fClusterSize;
+constexpr Long64_t BulkApiVectorTest::fEventCount;
+
+TEST_F(BulkApiVectorTest, serializedRead)
+{
+   std::unique_ptr<TFile> hfile(TFile::Open(fFileName.c_str()));
+   auto tree = hfile->Get<TTree>("T");
+   ASSERT_TRUE(tree);
+   auto branchFloat = tree->GetBranch("f");
+   ASSERT_TRUE(branchFloat);
+   ASSERT_TRUE(branchFloat->GetBulkRead().SupportsBulkRead());
+
+   TBufferFile floatBuf(TBuffer::kWrite, 32*1024);
+   TBufferFile countBuf(TBuffer::kWrite, 32*1024);
+   float idx_f = 0;
+   Long64_t evt_idx = 0;
+   while (evt_idx < fEventCount) {
+      auto count = branchFloat->GetBulkRead().GetEntriesSerialized(evt_idx, floatBuf, &countBuf);
+      ASSERT_EQ(count, fClusterSize);
+      char *float_buf = floatBuf.GetCurrent();
+      char *count_buf = countBuf.GetCurrent();
+      for (Int_t idx = 0; idx < count; idx++) {
+         int entry_count;
+         frombuf(count_buf, &entry_count);
+         ASSERT_EQ(entry_count, (evt_idx + idx) % 7);
+         for (int entry_idx = 0; entry_idx < entry_count; entry_idx++) {
+            float entry_f;
+            frombuf(float_buf, &entry_f);
+            ASSERT_EQ(entry_f, idx_f++);
+         }
+      }
+      evt_idx += count;
+   }
+}
+
+TEST_F(BulkApiVectorTest, fastRead)
+{
+   std::unique_ptr<TFile> hfile(TFile::Open(fFileName.c_str()));
+   ROOT::Experimental::TTreeReaderFast myReader("T", hfile.get());
+   ROOT::Experimental::TTreeReaderArrayFast<float> myF(myReader, "f");
+   ROOT::Experimental::TTreeReaderArrayFast<Long64_t> myL(myReader, "l");
+   myReader.SetEntry(0);
+   ASSERT_EQ(ROOT::Internal::TTreeReaderValueBase::kSetupMatch, myF.GetSetupStatus());
+   ASSERT_EQ(ROOT::Internal::TTreeReaderValueBase::kSetupMatch, myL.GetSetupStatus());
+
+   Long64_t idx = 0;
+   float idx_f = 0;
+   for (auto reader_idx : myReader) {
+      ASSERT_EQ(reader_idx, idx);
+      ASSERT_EQ(myF.size(), static_cast<size_t>(idx % 7));
+      ASSERT_EQ(myL.size(), static_cast<size_t>(idx % 7));
+      for (size_t entry_idx = 0; entry_idx < myF.size(); entry_idx++) {
+         ASSERT_EQ(myF[entry_idx], idx_f++);
+         ASSERT_EQ(myL[entry_idx], static_cast<Long64_t>(idx * 10 + entry_idx));
+      }
+      idx++;
+   }
+   ASSERT_EQ(idx, fEventCount);
+}
+
+TEST(BulkApiCountTypes, bulkEntries)
+{
+   const auto fileName = "BulkApiTestCountTypes.root";
+   constexpr Long64_t clusterSize = 1000;
+   constexpr Long64_t eventCount = 10000;
+   {
+      TFile hfile(fileName, "RECREATE");
+      TTree tree("T", "A ROOT tree of variable-length arrays with counts of different types.");
+      tree.SetBit(TTree::kOnlyFlushAtCluster);
+      tree.SetAutoFlush(clusterSize);
+      ROOT::TIOFeatures features;
+      features.Set(ROOT::Experimental::EIOFeatures::kGenerateOffsetMap);
+      tree.SetIOFeatures(features);
+
+      UChar_t nb = 0;
+      Short_t ns = 0;
+      float fb[10];
+      float fs[10];
+      tree.Branch("nb", &nb, "nb/b");
+      tree.Branch("fb", fb, "fb[nb]/F");
+      tree.Branch("ns", &ns, "ns/S");
+      tree.Branch("fs", fs, "fs[ns]/F");
+      for (Long64_t ev = 0; ev < eventCount; ev++) {
+         nb = ns = ev % 10;
+         for (Int_t idx = 0; idx < nb; idx++)
+            fb[idx] = fs[idx] = ev + 0.25f * idx;
+         tree.Fill();
+      }
+      hfile.Write();
+   }
+
+   std::unique_ptr<TFile> hfile(TFile::Open(fileName));
+   auto tree = hfile->Get<TTree>("T");
+   ASSERT_TRUE(tree);
+   auto branchB = tree->GetBranch("fb");
+   auto branchS = tree->GetBranch("fs");
+   ASSERT_TRUE(branchB);
+   ASSERT_TRUE(branchS);
+
+   TBufferFile valueBuf(TBuffer::kWrite, 32*1024);
+   TBufferFile countBuf(TBuffer::kWrite, 32*1024);
+   std::vector<Int_t> offsets;
+   Long64_t evt_idx = 0;
+   while (evt_idx < eventCount) {
+      // The UChar_t counts are converted to offsets.
+      auto count = branchB->GetBulkRead().GetBulkEntries(evt_idx, valueBuf, countBuf, offsets);
+      ASSERT_EQ(count, clusterSize);
+      ASSERT_EQ(offsets.size(), static_cast<size_t>(count + 1));
+      auto values = reinterpret_cast<float *>(valueBuf.GetCurrent());
+      for (Int_t idx = 0; idx < count; idx++) {
+         const Long64_t ev = evt_idx + idx;
+         ASSERT_EQ(offsets[idx + 1] - offsets[idx], ev % 10);
+         for (Int_t entry_idx = offsets[idx]; entry_idx < offsets[idx + 1]; entry_idx++)
+            ASSERT_EQ(values[entry_idx], ev + 0.25f * (entry_idx - offsets[idx]));
+      }
+      evt_idx += count;
+   }
+
+   // The Short_t counts cannot be read in bulk: the read fails instead of returning wrong offsets.
+   EXPECT_EQ(branchS->GetBulkRead().GetBulkEntries(0, valueBuf, countBuf, offsets), -1);
+
+   // The baskets handed over to the buffers are not used anymore by the tree.
+   UChar_t nb = 0;
+   float fb[10];
+   tree->SetBranchAddress("nb", &nb);
+   tree->SetBranchAddress("fb", fb);
+   for (Long64_t ev : {0ll, 1234ll, eventCount - 1}) {
+      ASSERT_GT(tree->GetEntry(ev), 0);
+      ASSERT_EQ(nb, ev % 10);
+      for (Int_t idx = 0; idx < nb; idx++)
+         EXPECT_EQ(fb[idx], ev + 0.25f * idx);
+   }
+   hfile.reset();
+   gSystem->Unlink(fileName);
+}
@@ -0,0 +1,82 @@
+#include "TFile.h"
+#include "TSystem.h"
+#include "TTree.h"
+#include "TTreeCache.h"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+
+namespace {
+constexpr const char *kFileName = "TTreeCacheReadAhead.root";
+constexpr int kEventCount = 50000;
+
+void CreateFile()
+{
+   TFile file(kFileName, "RECREATE", "", 0);
+   TTree tree("tree", "A tree with many clusters");
+   tree.SetAutoFlush(5000);
+   Int_t ev;
+   Double_t x;
+   tree.Branch("ev", &ev, "ev/I");
+   tree.Branch("x", &x, "x/D");
+   for (ev = 0; ev < kEventCount; ++ev) {
+      x = 0.5 * ev;
+      tree.Fill();
+   }
+   file.Write();
+}
+
+struct ReadStats {
+   Long64_t fBytesRead{-1};
+   Int_t fReadCalls{-1};
+   Int_t fNReadAhead{-1};
+};
+
+/// Read all entries with the given read-ahead fraction and return the reads of the cache.
+ReadStats ReadAll(Double_t readAhead)
+{
+   std::unique_ptr<TFile> file(TFile::Open(kFileName));
+   auto tree = file->Get<TTree>("tree");
+   EXPECT_NE(tree, nullptr);
+   if (!tree)
+      return {};
+   tree->SetCacheSize(200000);
+   tree->AddBranchToCache("*", true);
+   tree->StopCacheLearningPhase();
+   auto cache = dynamic_cast<TTreeCache *>(file->GetCacheRead(tree));
+   EXPECT_NE(cache, nullptr);
+   if (!cache)
+      return {};
+   cache->SetReadAhead(readAhead);
+   EXPECT_DOUBLE_EQ(cache->GetReadAhead(), readAhead);
+
+   Int_t ev = -1;
+   Double_t x = -1;
+   tree->SetBranchAddress("ev", &ev);
+   tree->SetBranchAddress("x", &x);
+   for (Long64_t i = 0; i < kEventCount; ++i) {
+      EXPECT_GT(tree->GetEntry(i), 0);
+      EXPECT_EQ(ev, i);
+      EXPECT_DOUBLE_EQ(x, 0.5 * i);
+   }
+   EXPECT_EQ(cache->GetNoCacheReadCalls(), 0);
+   EXPECT_LE(cache->GetBufferSize(), 200000);
+   return {cache->GetBytesRead(), cache->GetReadCalls(), cache->GetNReadAhead()};
+}
+} // anonymous namespace
+
+TEST(TTreeCache, ReadAhead)
+{
+   CreateFile();
+   const auto reads = ReadAll(0);
+   const auto readAheadReads = ReadAll(0.5);
+   EXPECT_GT(reads.fReadCalls, 0);
+   EXPECT_EQ(reads.fNReadAhead, 0);
+   // all cluster ranges but the first are read ahead
+   EXPECT_GT(readAheadReads.fNReadAhead, 0);
+   // every basket is read exactly once, but with half of the cache for each cluster range in more, smaller chunks
+   EXPECT_EQ(readAheadReads.fBytesRead, reads.fBytesRead);
+   EXPECT_GE(readAheadReads.fReadCalls, reads.fReadCalls);
+   gSystem->Unlink(kFileName);
+}
@@ -0,0 +1,198 @@
+#include "RConfigure.h" // R__USE_IMT
+#include "ROOT/RZstdDictionary.hxx"
+#include "TBranch.h"
+#include "TFile.h"
+#include "TRandom.h"
+#include "TROOT.h"
+#include "TSystem.h"
+#include "TTree.h"
+#include "TTreeCacheUnzip.h"
+#include "TTreeCloner.h"
+
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+constexpr int kEventCount = 20000;
+
+void CreateFile(const char *name, bool useDictionary)
+{
+   TFile file(name, "RECREATE", "", 505);
+   TTree tree("tree", "A tree with small zstd-compressed baskets");
+   if (useDictionary) {
+      ROOT::TIOFeatures features;
+      features.Set(ROOT::Experimental::EIOFeatures::kZstdDictionary);
+      tree.SetIOFeatures(features);
+   }
+   tree.SetBit(TTree::kOnlyFlushAtCluster);
+   tree.SetAutoFlush(50);
+   Int_t ev, category;
+   Float_t px;
+   tree.Branch("ev", &ev, "ev/I");
+   tree.Branch("category", &category, "category/I");
+   tree.Branch("px", &px, "px/F");
+
+   TRandom random(837);
+   for (ev = 0; ev < kEventCount; ++ev) {
+      category = ev % 7;
+      px = random.Gaus(100, 7);
+      tree.Fill();
+   }
+   file.Write();
+}
+
+void CheckContent(TTree *tree)
+{
+   ASSERT_NE(tree, nullptr);
+   ASSERT_EQ(tree->GetEntries(), kEventCount);
+   Int_t ev = -1, category = -1;
+   Float_t px = 0;
+   tree->SetBranchAddress("ev", &ev);
+   tree->SetBranchAddress("category", &category);
+   tree->SetBranchAddress("px", &px);
+
+   TRandom random(837);
+   for (Long64_t i = 0; i < kEventCount; ++i) {
+      ASSERT_GT(tree->GetEntry(i), 0);
+      EXPECT_EQ(ev, i);
+      EXPECT_EQ(category, i % 7);
+      EXPECT_FLOAT_EQ(px, static_cast<Float_t>(random.Gaus(100, 7)));
+   }
+}
+
+// Read the tree of a file that is opened anew, with the default TTreeCache or with TTreeCacheUnzip
+void CheckFile(const char *name, bool parallelUnzip)
+{
+   std::unique_ptr<TFile> file(TFile::Open(name));
+   ASSERT_NE(file, nullptr);
+   auto tree = file->Get<TTree>("tree");
+   ASSERT_NE(tree, nullptr);
+   if (parallelUnzip) {
+      tree->SetParallelUnzip(kTRUE);
+#ifdef R__USE_IMT
+      EXPECT_NE(dynamic_cast<TTreeCacheUnzip *>(tree->GetReadCache(file.get())), nullptr);
+#endif
+   }
+   CheckContent(tree);
+}
+
+class TZstdDictionary : public ::testing::Test {
+protected:
+   static constexpr const char *kFileName = "TZstdDictionary.root";
+   static constexpr const char *kPlainFileName = "TZstdDictionaryPlain.root";
+
+   static void SetUpTestCase()
+   {
+      CreateFile(kFileName, true);
+      CreateFile(kPlainFileName, false);
+   }
+   static void TearDownTestCase()
+   {
+      gSystem->Unlink(kFileName);
+      gSystem->Unlink(kPlainFileName);
+   }
+};
+constexpr const char *TZstdDictionary::kFileName;
+constexpr const char *TZstdDictionary::kPlainFileName;
+} // anonymous namespace
+
+TEST_F(TZstdDictionary, RoundTrip)
+{
+   CheckFile(kFileName, false);
+}
+
+TEST_F(TZstdDictionary, ParallelUnzip)
+{
+#ifdef R__USE_IMT
+   ROOT::EnableImplicitMT(4);
+#endif
+   CheckFile(kFileName, true);
+#ifdef R__USE_IMT
+   ROOT::DisableImplicitMT();
+#endif
+}
+
+TEST_F(TZstdDictionary, SmallerBaskets)
+{
+   std::unique_ptr<TFile> plainFile(TFile::Open(kPlainFileName));
+   std::unique_ptr<TFile> dictFile(TFile::Open(kFileName));
+   auto plainTree = plainFile->Get<TTree>("tree");
+   auto dictTree = dictFile->Get<TTree>("tree");
+   ASSERT_NE(plainTree, nullptr);
+   ASSERT_NE(dictTree, nullptr);
+   EXPECT_LT(dictTree->GetZipBytes(), plainTree->GetZipBytes());
+}
+
+TEST_F(TZstdDictionary, FastClone)
+{
+   const auto cloneFileName = "TZstdDictionaryClone.root";
+   {
+      std::unique_ptr<TFile> file(TFile::Open(kFileName));
+      auto tree = file->Get<TTree>("tree");
+      ASSERT_NE(tree, nullptr);
+
+      TFile cloneFile(cloneFileName, "RECREATE", "", 505);
+      auto clone = tree->CloneTree(0);
+      ASSERT_NE(clone, nullptr);
+      // unlike CloneTree(-1, "fast"), TTreeCloner does not fall back to a slow copy
+      TTreeCloner cloner(tree, clone, "fast");
+      ASSERT_TRUE(cloner.IsValid()) << cloner.GetWarning();
+      clone->SetEntries(tree->GetEntries());
+      ASSERT_TRUE(cloner.Exec());
+      cloneFile.Write();
+   }
+
+   // the baskets were copied as they are: they can only be read if the dictionaries were copied along with them
+   CheckFile(cloneFileName, false);
+   CheckFile(cloneFileName, true);
+   gSystem->Unlink(cloneFileName);
+}
+
+TEST(RZstdDictionary, CompressionLevels)
+{
+   std::string samples;
+   std::vector<std::size_t> sampleSizes;
+   for (int i = 0; i < 2000; ++i) {
+      char sample[64];
+      const auto len = snprintf(sample, sizeof(sample), "event %d category %d px %.3f", i, i % 7, 100. + (i % 13));
+      samples.append(sample, len);
+      sampleSizes.push_back(len);
+   }
+   auto dict = ROOT::Internal::RZstdDictionary::Train(samples.data(), sampleSizes.data(), sampleSizes.size(), 4096);
+   ASSERT_NE(dict, nullptr);
+
+   std::string src = samples.substr(0, 1000);
+   auto compress = [&](int level) {
+      std::vector<char> tgt(src.size());
+      int srcSize = src.size();
+      int tgtSize = tgt.size();
+      int irep = 0;
+      dict->Compress(level, &srcSize, &src[0], &tgtSize, tgt.data(), &irep);
+      tgt.resize(irep);
+      return tgt;
+   };
+   auto decompress = [&](std::vector<char> &block) {
+      std::string tgt(src.size(), '\0');
+      int srcSize = block.size();
+      int tgtSize = tgt.size();
+      int irep = 0;
+      dict->Decompress(&srcSize, reinterpret_cast<unsigned char *>(block.data()), &tgtSize,
+                       reinterpret_cast<unsigned char *>(&tgt[0]), &irep);
+      tgt.resize(irep);
+      return tgt;
+   };
+
+   // each compression level has its own digested dictionary, the first level used does not stick
+   auto fast = compress(1);
+   auto strong = compress(9);
+   ASSERT_FALSE(fast.empty());
+   ASSERT_FALSE(strong.empty());
+   EXPECT_LE(strong.size(), fast.size());
+   EXPECT_EQ(decompress(fast), src);
+   EXPECT_EQ(decompress(strong), src);
+   EXPECT_EQ(compress(1), fast);
+}
@@ -21,10 +21,12 @@
 #include "TError.h"
 #include "TEntryList.h"
 #include "TFriendElement.h"
+#include "TNotifyLink.h"
 #include "ROOT/RMakeUnique.hxx"
 #include "ROOT/TThreadedObject.hxx"
 #include "ROOT/TThreadExecutor.hxx"
 
+#include <atomic>
 #include <functional>
 #include <utility> // std::pair
 #include <vector>
@@ -62,8 +64,10 @@ class TTreeView {
 private:
    std::vector<std::unique_ptr<TChain>> fFriends; ///< Friends of the tree/chain, if present
    std::unique_ptr<TEntryList> fEntryList;        ///< TEntryList for fChain, if present
-   // NOTE: fFriends and fEntryList MUST come before fChain to be deleted after it, because neither friend trees nor
-   // entrylists are deregistered from the main tree at destruction (ROOT-9283 tracks the issue for friends).
+   std::unique_ptr<TNotifyLinkBase> fReadAheadLink; ///< Sets the TTreeCache read-ahead of fChain, if requested
+   // NOTE: fFriends, fEntryList and fReadAheadLink MUST come before fChain to be deleted after it, because neither
+   // friend trees nor entrylists nor notify links are deregistered from the main tree at destruction (ROOT-9283 tracks
+   // the issue for friends).
    std::unique_ptr<TChain> fChain;                ///< Chain on which to operate
 
    void MakeChain(const std::vector<std::string> &treeName, const std::vector<std::string> &fileNames,
@@ -97,6 +101,7 @@ private:
    Internal::FriendInfo GetFriendInfo(TTree &tree);
    std::vector<std::string> FindTreeNames();
    static unsigned int fgMaxTasksPerFilePerWorker;
+   static std::atomic<Double_t> fgCacheReadAhead;
 
 public:
    TTreeProcessorMT(std::string_view filename, std::string_view treename = "", UInt_t nThreads = 0u);
@@ -108,6 +113,8 @@ public:
    void Process(std::function<void(TTreeReader &)> func);
    static void SetMaxTasksPerFilePerWorker(unsigned int m);
    static unsigned int GetMaxTasksPerFilePerWorker();
+   static void SetCacheReadAhead(Double_t fraction);
+   static Double_t GetCacheReadAhead();
 };
 
 } // End of namespace ROOT
@@ -0,0 +1,90 @@
+/// \file ROOT/TTreeReaderArrayFast.hxx
+/// \date 2020-10-17
+
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TTreeReaderArrayFast
+#define ROOT_TTreeReaderArrayFast
+
+
+////////////////////////////////////////////////////////////////////////////
+//                                                                        //
+// TTreeReaderArrayFast                                                   //
+//                                                                        //
+// A simple interface for reading variable-length arrays and              //
+// std::vector branches from trees or chains through bulk I/O.           //
+//                                                                        //
+////////////////////////////////////////////////////////////////////////////
+
+#include "ROOT/TTreeReaderValueFast.hxx"
+
+#include "TDataType.h"
+
+#include <cstddef>
+#include <type_traits>
+#include <typeinfo>
+#include <vector>
+
+namespace ROOT {
+namespace Experimental {
+
+/* Reads the values of a branch of variable-length arrays, e.g. `x[n]/F`, or of
+ * std::vector of an arithmetic type, e.g. std::vector<float>, for the current
+ * entry of a TTreeReaderFast.
+ *
+ * The values of all the entries of a basket are read at once, byte-swapped in
+ * place and stored contiguously; each entry is a view on its part of them.
+ */
+template <typename T>
+class TTreeReaderArrayFast final : public ROOT::Experimental::Internal::TTreeReaderValueFastBase {
+   static_assert(std::is_arithmetic<T>::value, "TTreeReaderArrayFast only supports arithmetic types");
+
+   public:
+
+      TTreeReaderArrayFast(TTreeReaderFast& tr, const std::string &branchname) :
+            TTreeReaderValueFastBase(&tr, branchname) {}
+
+      /// Return a pointer to the values of the current entry.
+      T* data() {
+         return reinterpret_cast<T*>(fBuffer.GetCurrent()) + fOffsets[fFirst + fEvtIndex];
+      }
+      /// Return the number of values of the current entry.
+      std::size_t size() const {
+         return fOffsets[fFirst + fEvtIndex + 1] - fOffsets[fFirst + fEvtIndex];
+      }
+      bool empty() const { return size() == 0; }
+
+      T& operator[](std::size_t idx) { return data()[idx]; }
+      T* begin() { return data(); }
+      T* end() { return data() + size(); }
+
+   protected:
+      virtual const char *GetTypeName() override {return TDataType::GetTypeName(TDataType::GetType(typeid(T)));}
+      virtual const char *BranchTypeName() override {return GetTypeName();}
+      virtual UInt_t GetSize() override {return sizeof(T);}
+
+      virtual Int_t ReadEntries(Long64_t eventNum) override {
+         fFirst = 0;
+         return fBranch->GetBulkRead().GetBulkEntries(eventNum, fBuffer, fCountBuffer, fOffsets);
+      }
+      // The values stay in place; only the first entry of the offsets moves forward.
+      virtual Int_t Adjust(Int_t eventCount) override {
+         fFirst += eventCount;
+         return 0;
+      }
+
+      TBufferFile fCountBuffer{TBuffer::kWrite, 32*1024}; // Buffer object holding the count branch of the current events.
+      std::vector<Int_t> fOffsets;                        // Offsets of the values of each event, and end of the values.
+      Int_t fFirst{0};                                    // Index in fOffsets of the event at the buffer base.
+};
+
+}  // Experimental
+}  // ROOT
+
+#endif // ROOT_TTreeReaderArrayFast
@@ -66,7 +66,7 @@ class TTreeReaderValueFastBase {
              }
              fRemaining -= adjust;
           } else {
-             fRemaining = fBranch->GetBulkRead().GetEntriesSerialized(eventNum, fBuffer);
+             fRemaining = ReadEntries(eventNum);
              if (R__unlikely(fRemaining < 0)) {
                 fReadStatus = ROOT::Internal::TTreeReaderValueBase::kReadError;
                 //printf("Failed to retrieve entries from the branch.\n");
@@ -84,6 +84,11 @@ class TTreeReaderValueFastBase {
 
    protected:
 
+      // Read the events of the basket starting at eventNum into the buffer; returns their number.
+      virtual Int_t ReadEntries(Long64_t eventNum) {
+         return fBranch->GetBulkRead().GetEntriesSerialized(eventNum, fBuffer);
+      }
+
       // Adjust the current buffer offset forward N events.
       virtual Int_t Adjust(Int_t eventCount) {
          Int_t bufOffset = fBuffer.Length();
@@ -24,10 +24,17 @@
 
 #include "TVirtualIndex.h"
 
+#include <vector>
+
 class TTreeFormula;
 
 class TTreeIndex : public TVirtualIndex {
 
+public:
+   enum EStatusBits {
+      kHashLookup = BIT(14)   // Look up the index values with a hash table
+   };
+
 protected:
    TString        fMajorName;           // Index major name
    TString        fMinorName;           // Index minor name
@@ -39,9 +46,13 @@ protected:
    TTreeFormula  *fMinorFormula;        //! Pointer to minor TreeFormula
    TTreeFormula  *fMajorFormulaParent;  //! Pointer to major TreeFormula in Parent tree (if any)
    TTreeFormula  *fMinorFormulaParent;  //! Pointer to minor TreeFormula in Parent tree (if any)
+   std::vector<Long64_t> fHashSlots;    //! Open-addressing hash table of positions in the sorted index values, if kHashLookup
 
    TTreeFormula  *GetMajorFormulaParent(const TTree *parent);
    TTreeFormula  *GetMinorFormulaParent(const TTree *parent);
+   void           BuildHashTable();
+   Bool_t         ReadValuesInBulk(Long64_t *major, Long64_t *minor);
+   Bool_t         ReadValuesWithFormulas(Long64_t *major, Long64_t *minor);
 
 private:
    TTreeIndex(const TTreeIndex&) = delete;            // Not implemented.
@@ -65,11 +76,15 @@ public:
    virtual Long64_t       GetN()            const {return fN;}
    virtual TTreeFormula  *GetMajorFormula();
    virtual TTreeFormula  *GetMinorFormula();
+   Bool_t                 IsHashLookup()    const {return TestBit(kHashLookup);}
    virtual Bool_t         IsValidFor(const TTree *parent);
    virtual void           Print(Option_t *option="") const;
    virtual void           UpdateFormulaLeaves(const TTree *parent);
+   void                   SetHashLookup(Bool_t on = kTRUE);
    virtual void           SetTree(const TTree *T);
 
+   static Bool_t          IsBulkReadable(const TTree *T, const char *majorname, const char *minorname);
+
    ClassDef(TTreeIndex,2);  //A Tree Index with majorname and minorname.
 };
 
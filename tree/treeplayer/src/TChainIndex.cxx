@@ -18,14 +18,25 @@ The index values from the first tree should be less then
 all the index values from the second tree, and so on.
 If a tree in the chain doesn't have an index the index will be created
 and kept inside this chain index.
+With implicit multi-threading enabled, the indices that can be built in bulk
+(see TTreeIndex::IsBulkReadable) are built concurrently, each tree being
+read from its own copy of the file.
 */
 
 #include "TChainIndex.h"
 #include "TChain.h"
+#include "TChainElement.h"
 #include "TTreeFormula.h"
 #include "TTreeIndex.h"
 #include "TFile.h"
 #include "TError.h"
+#include "TROOT.h"
+
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#endif
+
+#include <memory>
 
 ////////////////////////////////////////////////////////////////////////////////
 /// \class TChainIndex::TChainIndexEntry
@@ -78,6 +89,7 @@ TChainIndex::TChainIndex(const TTree *T, const char *majorname, const char *mino
    fMajorName          = majorname;
    fMinorName          = minorname;
    Int_t i = 0;
+   std::vector<Int_t> concurrentIndices; // trees whose index is built concurrently after this loop
 
    // Go through all the trees and check if they have indeces. If not then build them.
    for (i = 0; i < chain->GetNtrees(); i++) {
@@ -96,6 +108,13 @@ TChainIndex::TChainIndex(const TTree *T, const char *majorname, const char *mino
             return;
          }
       }
+#ifdef R__USE_IMT
+      if (!index && ROOT::IsImplicitMTEnabled() && TTreeIndex::IsBulkReadable(chain->GetTree(), majorname, minorname)) {
+         concurrentIndices.push_back(i);
+         fEntries.push_back(entry);
+         continue;
+      }
+#endif
       if (!index) {
          chain->GetTree()->BuildIndex(majorname, minorname);
          index = chain->GetTree()->GetTreeIndex();
@@ -120,6 +139,34 @@ TChainIndex::TChainIndex(const TTree *T, const char *majorname, const char *mino
       fEntries.push_back(entry);
    }
 
+#ifdef R__USE_IMT
+   if (!concurrentIndices.empty()) {
+      TObjArray *files = chain->GetListOfFiles();
+      auto buildIndex = [&](Int_t treeNo) {
+         auto element = static_cast<TChainElement*>(files->At(treeNo));
+         std::unique_ptr<TFile> file(TFile::Open(element->GetTitle()));
+         TTree *tree = (file && !file->IsZombie()) ? file->Get<TTree>(element->GetName()) : nullptr;
+         if (!tree) return;
+         TTreeIndex *index = new TTreeIndex(tree, majorname, minorname);
+         // The tree is deleted with its file; the lookups in the index do not need it.
+         index->SetTree(0);
+         fEntries[treeNo].fTreeIndex = index;
+      };
+      ROOT::TThreadExecutor pool;
+      pool.Foreach(buildIndex, concurrentIndices);
+      for (Int_t treeNo : concurrentIndices) {
+         TTreeIndex *index = static_cast<TTreeIndex*>(fEntries[treeNo].fTreeIndex);
+         if (!index || index->IsZombie() || index->GetN() == 0) {
+            DeleteIndices();
+            MakeZombie();
+            Error("TChainIndex", "Error creating a tree index on a tree in the chain");
+            return;
+         }
+         fEntries[treeNo].SetMinMaxFrom(index);
+      }
+   }
+#endif
+
    // Check if the indices of different trees are in order. If not then return an error.
    for (i = 0; i < Int_t(fEntries.size() - 1); i++) {
       if( fEntries[i].GetMaxIndexValPair() > fEntries[i+1].GetMinIndexValPair() ) {
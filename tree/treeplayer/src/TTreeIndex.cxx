@@ -17,8 +17,25 @@ A Tree Index with majorname and minorname.
 
 #include "TTreeFormula.h"
 #include "TTree.h"
+#include "TBranch.h"
 #include "TBuffer.h"
+#include "TBufferFile.h"
+#include "TDataType.h"
+#include "TFile.h"
+#include "TKey.h"
+#include "TLeaf.h"
 #include "TMath.h"
+#include "TROOT.h"
+
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <utility>
+#include <vector>
 
 ClassImp(TTreeIndex);
 
@@ -42,6 +59,271 @@ struct IndexSortComparator {
   Long64_t *fValMajor, *fValMinor;
 };
 
+namespace {
+
+// Below this number of entries, reading or sorting the index values is not split in parallel tasks.
+constexpr Long64_t kMinEntriesPerTask = 65536;
+
+// Size of the TTreeCache of a private copy of the tree, which only holds the baskets of the index branches.
+constexpr Long64_t kBulkCacheSize = 8 * 1024 * 1024;
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the branch holding the values of `expression` if it names a plain
+/// branch, or its leaf, with a single arithmetic value per entry that can be
+/// read with the bulk API; return nullptr otherwise.
+
+TBranch *GetBulkIndexBranch(TTree *tree, const char *expression, EDataType &type)
+{
+   TBranch *branch = tree->GetBranch(expression);
+   if (!branch) {
+      TLeaf *leaf = tree->GetLeaf(expression);
+      branch = leaf ? leaf->GetBranch() : nullptr;
+   }
+   // Branches of friend trees and of objects are left to TTreeFormula.
+   if (!branch || branch->IsA() != TBranch::Class() || branch->GetTree() != tree ||
+       branch->GetListOfBranches()->GetEntriesFast() || !branch->GetBulkRead().SupportsBulkRead())
+      return nullptr;
+   TLeaf *leaf = static_cast<TLeaf *>(branch->GetListOfLeaves()->UncheckedAt(0));
+   if (leaf->GetLeafCount() || leaf->GetLenStatic() != 1)
+      return nullptr;
+   TClass *cl = nullptr;
+   if (branch->GetExpectedType(cl, type) || cl)
+      return nullptr;
+   switch (type) {
+   case kUChar_t:
+   case kShort_t:
+   case kUShort_t:
+   case kInt_t:
+   case kUInt_t:
+   case kLong64_t:
+   case kULong64_t:
+   case kFloat_t:
+   case kDouble_t: return branch;
+   default: return nullptr;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Convert n values of type T to index values.
+
+template <typename T>
+void ConvertIndexValues(const char *data, Long64_t n, Long64_t *values)
+{
+   const T *typed = reinterpret_cast<const T *>(data);
+   for (Long64_t i = 0; i < n; ++i)
+      values[i] = (Long64_t)typed[i];
+}
+
+void ConvertIndexValues(EDataType type, const char *data, Long64_t n, Long64_t *values)
+{
+   switch (type) {
+   case kUChar_t: ConvertIndexValues<UChar_t>(data, n, values); break;
+   case kShort_t: ConvertIndexValues<Short_t>(data, n, values); break;
+   case kUShort_t: ConvertIndexValues<UShort_t>(data, n, values); break;
+   case kInt_t: ConvertIndexValues<Int_t>(data, n, values); break;
+   case kUInt_t: ConvertIndexValues<UInt_t>(data, n, values); break;
+   case kLong64_t: ConvertIndexValues<Long64_t>(data, n, values); break;
+   case kULong64_t: ConvertIndexValues<ULong64_t>(data, n, values); break;
+   case kFloat_t: ConvertIndexValues<Float_t>(data, n, values); break;
+   case kDouble_t: ConvertIndexValues<Double_t>(data, n, values); break;
+   default: break;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read with the bulk API the values of branch for the entries [start, end)
+/// into values[0, end - start). Return false if a basket cannot be read in bulk.
+
+bool ReadBulkIndexValues(TBranch &branch, EDataType type, Long64_t start, Long64_t end, Long64_t *values)
+{
+   const Int_t size = TDataType::GetDataType(type)->Size();
+   TBufferFile buffer(TBuffer::kWrite, 32 * 1024);
+   Long64_t entry = start;
+   while (entry < end) {
+      // The bulk API only reads whole baskets: start from the first entry of the one holding entry.
+      const Long64_t basket = TMath::BinarySearch(Long64_t(branch.GetWriteBasket() + 1), branch.GetBasketEntry(), entry);
+      const Long64_t first = branch.GetBasketEntry()[basket];
+      // The TTreeCache of the tree is filled from its read entry.
+      branch.GetTree()->LoadTree(first);
+      const Int_t n = branch.GetBulkRead().GetBulkEntries(first, buffer);
+      if (n <= 0 || first + n <= entry)
+         return false;
+      const Long64_t last = std::min(end, first + n);
+      ConvertIndexValues(type, buffer.GetCurrent() + (entry - first) * size, last - entry, values + (entry - start));
+      entry = last;
+   }
+   return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Reads in bulk the index values of a range of entries from a private copy
+/// of a tree, read again from its key in the same TFile. The bulk API takes
+/// over the baskets it reads: the tree of the caller, whose branches may
+/// already have baskets in memory, and its TTreeCache are left alone.
+
+class BulkIndexReader {
+   std::unique_ptr<TTree> fCopy; ///< Private copy of the tree, with a TTreeCache for the index branches
+   TBranch *fMajor = nullptr;    ///< Branch of the major values in fCopy
+   TBranch *fMinor = nullptr;    ///< Branch of the minor values in fCopy, nullptr if they are 0
+   EDataType fMajorType;         ///< Type of the major values
+   EDataType fMinorType;         ///< Type of the minor values
+   Long64_t fStart;              ///< First entry of the range
+   Long64_t fEnd;                ///< One past the last entry of the range
+
+public:
+   ////////////////////////////////////////////////////////////////////////////////
+   /// Read the copy of tree, with major and minor (which may be nullptr) its
+   /// branches of the index values. The copy is attached to the directory of
+   /// tree: it must be created and destroyed by one thread at a time.
+
+   BulkIndexReader(TTree &tree, const TBranch *major, EDataType majorType, const TBranch *minor, EDataType minorType,
+                   Long64_t start, Long64_t end)
+      : fMajorType(majorType), fMinorType(minorType), fStart(start), fEnd(end)
+   {
+      TDirectory *dir = tree.GetDirectory();
+      TKey *key = dir ? dir->GetKey(tree.GetName()) : nullptr;
+      if (key)
+         fCopy.reset(key->ReadObject<TTree>());
+      // A key with another cycle may hold another version of the tree.
+      if (!fCopy || fCopy->GetEntries() != tree.GetEntries())
+         return;
+      // Only the branches of the copy are read: do not load its friends.
+      if (fCopy->GetListOfFriends())
+         fCopy->GetListOfFriends()->Delete();
+      fMajor = fCopy->GetBranch(major->GetName());
+      fMinor = minor ? fCopy->GetBranch(minor->GetName()) : nullptr;
+      if (minor && !fMinor)
+         fMajor = nullptr;
+      if (!fMajor)
+         return;
+      fCopy->SetCacheSize(kBulkCacheSize);
+      fCopy->SetCacheEntryRange(start, end);
+      fCopy->AddBranchToCache(fMajor);
+      if (fMinor)
+         fCopy->AddBranchToCache(fMinor);
+      fCopy->StopCacheLearningPhase();
+   }
+
+   bool IsValid() const { return fMajor; }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   /// Read the values of the entries of the range into major and minor, both
+   /// indexed from the first entry of the tree, cluster by cluster so that
+   /// both branches are read from the same fill of the TTreeCache. Return
+   /// false if a basket cannot be read in bulk.
+
+   bool Read(Long64_t *major, Long64_t *minor)
+   {
+      auto clusterIter = fCopy->GetClusterIterator(fStart);
+      clusterIter();
+      for (Long64_t first = fStart; first < fEnd; first = clusterIter()) {
+         const Long64_t last = std::min(fEnd, clusterIter.GetNextEntry());
+         if (!ReadBulkIndexValues(*fMajor, fMajorType, first, last, major + first) ||
+             (fMinor && !ReadBulkIndexValues(*fMinor, fMinorType, first, last, minor + first)))
+            return false;
+      }
+      return true;
+   }
+};
+
+#ifdef R__USE_IMT
+////////////////////////////////////////////////////////////////////////////////
+/// Read the index values of tree in parallel, each task reading the branches
+/// for a range of clusters from its own private copy of tree. The file is
+/// read by one task at a time, the baskets are decompressed in parallel.
+/// Return false if the tree is too small to be split or cannot be read again
+/// from its file.
+
+bool ReadBulkIndexValuesMT(TTree &tree, const TBranch *majorBranch, EDataType majorType, const TBranch *minorBranch,
+                           EDataType minorType, Long64_t *major, Long64_t *minor)
+{
+   const Long64_t nEntries = tree.GetEntries();
+   const Long64_t minEntries = std::max(kMinEntriesPerTask, nEntries / ROOT::GetThreadPoolSize());
+   std::vector<std::pair<Long64_t, Long64_t>> ranges;
+   auto clusterIter = tree.GetClusterIterator(0);
+   Long64_t start = 0;
+   while ((start = clusterIter()) < nEntries) {
+      if (!ranges.empty() && ranges.back().second - ranges.back().first < minEntries)
+         ranges.back().second = clusterIter.GetNextEntry();
+      else
+         ranges.emplace_back(start, clusterIter.GetNextEntry());
+   }
+   if (ranges.size() < 2)
+      return false;
+
+   // The copies are read from the file and attached to its directory here, by this thread only.
+   std::vector<std::unique_ptr<BulkIndexReader>> readers;
+   for (const auto &range : ranges) {
+      readers.emplace_back(
+         new BulkIndexReader(tree, majorBranch, majorType, minorBranch, minorType, range.first, range.second));
+      if (!readers.back()->IsValid())
+         return false;
+   }
+
+   std::atomic<bool> ok(true);
+   ROOT::TThreadExecutor pool;
+   pool.Foreach(
+      [&](unsigned i) {
+         if (ok && !readers[i]->Read(major, minor))
+            ok = false;
+      },
+      ROOT::TSeqU(readers.size()));
+   return ok;
+}
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+/// Sort the positions in index by the values major, minor they point to.
+/// With IMT, chunks are sorted in parallel and then merged pairwise.
+
+void SortIndexValues(Long64_t *index, Long64_t n, Long64_t *major, Long64_t *minor)
+{
+   IndexSortComparator comparator(major, minor);
+#ifdef R__USE_IMT
+   const Long64_t nChunks = ROOT::IsImplicitMTEnabled() ? std::min<Long64_t>(ROOT::GetThreadPoolSize(), n / kMinEntriesPerTask) : 1;
+   if (nChunks > 1) {
+      std::vector<Long64_t> bounds;
+      for (Long64_t i = 0; i <= nChunks; ++i)
+         bounds.push_back(n * i / nChunks);
+      ROOT::TThreadExecutor pool;
+      pool.Foreach([&](unsigned i) { std::sort(index + bounds[i], index + bounds[i + 1], comparator); },
+                   ROOT::TSeqU(nChunks));
+      while (bounds.size() > 2) {
+         // Merge each pair of neighbouring sorted chunks; a last odd chunk is kept as is.
+         std::vector<Long64_t> merged;
+         for (std::size_t i = 0; i < bounds.size(); i += 2)
+            merged.push_back(bounds[i]);
+         if (merged.back() != bounds.back())
+            merged.push_back(bounds.back());
+         pool.Foreach(
+            [&](unsigned i) {
+               std::inplace_merge(index + merged[i], index + bounds[2 * i + 1], index + merged[i + 1], comparator);
+            },
+            ROOT::TSeqU(merged.size() - 1));
+         bounds.swap(merged);
+      }
+      return;
+   }
+#endif
+   std::sort(index, index + n, comparator);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Hash of a pair of index values.
+
+inline ULong64_t HashIndexValues(Long64_t major, Long64_t minor)
+{
+   ULong64_t h = static_cast<ULong64_t>(major) * 0x9e3779b97f4a7c15ULL ^ static_cast<ULong64_t>(minor);
+   h ^= h >> 30;
+   h *= 0xbf58476d1ce4e5b9ULL;
+   h ^= h >> 27;
+   h *= 0x94d049bb133111ebULL;
+   h ^= h >> 31;
+   return h;
+}
+
+} // anonymous namespace
+
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Default constructor for TTreeIndex
@@ -122,6 +404,24 @@ TTreeIndex::TTreeIndex(): TVirtualIndex()
 ///
 /// It is possible to play with different TreeIndex in the same Tree.
 /// see comments in TTree::SetTreeIndex.
+///
+/// ## Building the index in bulk
+///
+/// If majorname and minorname (or minorname="0") are the names of plain
+/// branches, or of their leaves, holding a single number per entry, and the
+/// Tree is read from a file, their values are read basket by basket with the
+/// bulk API instead of evaluating TTreeFormula entry by entry. The branches
+/// are read from a private copy of the Tree, read again from the same file,
+/// so that the Tree, the baskets it has in memory and its TTreeCache are left
+/// untouched. With implicit multi-threading enabled (ROOT::EnableImplicitMT())
+/// ranges of clusters are read from one copy each, decompressing the baskets
+/// in parallel, and the values are sorted in parallel. If the branches cannot
+/// be read in bulk, the index is built with TTreeFormula. See IsBulkReadable.
+///
+/// ## Hash lookup
+///
+/// After SetHashLookup(), GetEntryNumberWithIndex looks up the values in a
+/// hash table instead of a binary search; see SetHashLookup.
 
 TTreeIndex::TTreeIndex(const TTree *T, const char *majorname, const char *minorname)
            : TVirtualIndex()
@@ -145,31 +445,101 @@ TTreeIndex::TTreeIndex(const TTree *T, const char *majorname, const char *minorn
       return;
    }
 
+   Long64_t *tmp_major = new Long64_t[fN];
+   Long64_t *tmp_minor = new Long64_t[fN];
+   if (!ReadValuesInBulk(tmp_major, tmp_minor) && !ReadValuesWithFormulas(tmp_major, tmp_minor)) {
+      delete [] tmp_major;
+      delete [] tmp_minor;
+      return;
+   }
+   Long64_t i;
+   fIndex = new Long64_t[fN];
+   for(i = 0; i < fN; i++) { fIndex[i] = i; }
+   SortIndexValues(fIndex, fN, tmp_major, tmp_minor);
+   //TMath::Sort(fN,w,fIndex,0);
+   fIndexValues = new Long64_t[fN];
+   fIndexValuesMinor = new Long64_t[fN];
+   for (i=0;i<fN;i++) {
+      fIndexValues[i] = tmp_major[fIndex[i]];
+      fIndexValuesMinor[i] = tmp_minor[fIndex[i]];
+   }
+
+   delete [] tmp_major;
+   delete [] tmp_minor;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return kTRUE if the index of T with majorname and minorname can be built
+/// by reading the branches in bulk, without TTreeFormula: both names are
+/// plain branches or leaves with a single number per entry (or minorname is
+/// "0") and T, not a TChain, is read from a file that is not being written.
+/// Such indices can also be built concurrently for different trees.
+
+Bool_t TTreeIndex::IsBulkReadable(const TTree *T, const char *majorname, const char *minorname)
+{
+   TTree *tree = const_cast<TTree*>(T);
+   if (!tree || tree->IsA() != TTree::Class())
+      return kFALSE;
+   TFile *file = tree->GetCurrentFile();
+   if (!file || file->IsWritable())
+      return kFALSE;
+   EDataType type;
+   return GetBulkIndexBranch(tree, majorname, type) &&
+          (!strcmp(minorname, "0") || GetBulkIndexBranch(tree, minorname, type));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read the values of the major and minor branches of all entries with the
+/// bulk API, in parallel if IMT is enabled. Return kFALSE, without printing
+/// an error, if the index cannot be built this way; see IsBulkReadable.
+
+Bool_t TTreeIndex::ReadValuesInBulk(Long64_t *major, Long64_t *minor)
+{
+   if (!IsBulkReadable(fTree, fMajorName, fMinorName))
+      return kFALSE;
+   EDataType majorType = kOther_t, minorType = kOther_t;
+   TBranch *majorBranch = GetBulkIndexBranch(fTree, fMajorName, majorType);
+   TBranch *minorBranch = (fMinorName == "0") ? nullptr : GetBulkIndexBranch(fTree, fMinorName, minorType);
+   if (!minorBranch)
+      std::fill(minor, minor + fN, 0);
+
+#ifdef R__USE_IMT
+   if (ROOT::IsImplicitMTEnabled() &&
+       ReadBulkIndexValuesMT(*fTree, majorBranch, majorType, minorBranch, minorType, major, minor))
+      return kTRUE;
+#endif
+   BulkIndexReader reader(*fTree, majorBranch, majorType, minorBranch, minorType, 0, fN);
+   return reader.IsValid() && reader.Read(major, minor);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate the major and minor expressions for all entries with TTreeFormula.
+/// Return kFALSE, and make the index a zombie, if they cannot be evaluated.
+
+Bool_t TTreeIndex::ReadValuesWithFormulas(Long64_t *major, Long64_t *minor)
+{
    GetMajorFormula();
    GetMinorFormula();
    if (!fMajorFormula || !fMinorFormula) {
       MakeZombie();
       Error("TreeIndex","Cannot build the index with major=%s, minor=%s",fMajorName.Data(), fMinorName.Data());
-      return;
+      return kFALSE;
    }
    if ((fMajorFormula->GetNdim() != 1) || (fMinorFormula->GetNdim() != 1)) {
       MakeZombie();
       Error("TreeIndex","Cannot build the index with major=%s, minor=%s",fMajorName.Data(), fMinorName.Data());
-      return;
+      return kFALSE;
    }
    // accessing array elements should be OK
    //if ((fMajorFormula->GetMultiplicity() != 0) || (fMinorFormula->GetMultiplicity() != 0)) {
    //   MakeZombie();
    //   Error("TreeIndex","Cannot build the index with major=%s, minor=%s that cannot be arrays",fMajorName.Data(), fMinorName.Data());
-   //   return;
+   //   return kFALSE;
    //}
 
-   Long64_t *tmp_major = new Long64_t[fN];
-   Long64_t *tmp_minor = new Long64_t[fN];
-   Long64_t i;
    Long64_t oldEntry = fTree->GetReadEntry();
    Int_t current = -1;
-   for (i=0;i<fN;i++) {
+   for (Long64_t i=0;i<fN;i++) {
       Long64_t centry = fTree->LoadTree(i);
       if (centry < 0) break;
       if (fTree->GetTreeNumber() != current) {
@@ -177,23 +547,11 @@ TTreeIndex::TTreeIndex(const TTree *T, const char *majorname, const char *minorn
          fMajorFormula->UpdateFormulaLeaves();
          fMinorFormula->UpdateFormulaLeaves();
       }
-      tmp_major[i] = (Long64_t) fMajorFormula->EvalInstance<LongDouble_t>();
-      tmp_minor[i] = (Long64_t) fMinorFormula->EvalInstance<LongDouble_t>();
+      major[i] = (Long64_t) fMajorFormula->EvalInstance<LongDouble_t>();
+      minor[i] = (Long64_t) fMinorFormula->EvalInstance<LongDouble_t>();
    }
-   fIndex = new Long64_t[fN];
-   for(i = 0; i < fN; i++) { fIndex[i] = i; }
-   std::sort(fIndex, fIndex + fN, IndexSortComparator(tmp_major, tmp_minor) );
-   //TMath::Sort(fN,w,fIndex,0);
-   fIndexValues = new Long64_t[fN];
-   fIndexValuesMinor = new Long64_t[fN];
-   for (i=0;i<fN;i++) {
-      fIndexValues[i] = tmp_major[fIndex[i]];
-      fIndexValuesMinor[i] = tmp_minor[fIndex[i]];
-   }
-
-   delete [] tmp_major;
-   delete [] tmp_minor;
    fTree->LoadTree(oldEntry);
+   return kTRUE;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -230,6 +588,7 @@ void TTreeIndex::Append(const TVirtualIndex *add, Bool_t delaySort )
 
       Long64_t oldn = fN;
       fN += add->GetN();
+      fHashSlots.clear();
 
       Long64_t *oldIndex = fIndex;
       Long64_t *oldValues = GetIndexValues();
@@ -271,7 +630,7 @@ void TTreeIndex::Append(const TVirtualIndex *add, Bool_t delaySort )
       Long64_t *conv = new Long64_t[fN];
 
       for(Long64_t i = 0; i < fN; i++) { conv[i] = i; }
-      std::sort(conv, conv+fN, IndexSortComparator(addValues, addValues2) );
+      SortIndexValues(conv, fN, addValues, addValues2);
       //Long64_t *w = fIndexValues;
       //TMath::Sort(fN,w,conv,0);
 
@@ -288,6 +647,30 @@ void TTreeIndex::Append(const TVirtualIndex *add, Bool_t delaySort )
       delete [] addValues2;
       delete [] ind;
       delete [] conv;
+      if (TestBit(kHashLookup)) BuildHashTable();
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill the hash table of the positions of the sorted index values.
+/// Equal pairs of values are next to each other in the sorted tables: only
+/// the first one is stored, as found by the binary search of FindValues.
+
+void TTreeIndex::BuildHashTable()
+{
+   fHashSlots.clear();
+   if (fN <= 0) return;
+   // Keep at least half of the slots empty for short probe sequences.
+   ULong64_t nSlots = 2;
+   while (nSlots < 2 * ULong64_t(fN)) nSlots <<= 1;
+   fHashSlots.assign(nSlots, -1);
+   const ULong64_t mask = nSlots - 1;
+   for (Long64_t i = 0; i < fN; i++) {
+      if (i > 0 && fIndexValues[i] == fIndexValues[i-1] && fIndexValuesMinor[i] == fIndexValuesMinor[i-1])
+         continue;
+      ULong64_t slot = HashIndexValues(fIndexValues[i], fIndexValuesMinor[i]) & mask;
+      while (fHashSlots[slot] >= 0) slot = (slot + 1) & mask;
+      fHashSlots[slot] = i;
    }
 }
 
@@ -411,6 +794,8 @@ Long64_t TTreeIndex::GetEntryNumberWithBestIndex(Long64_t major, Long64_t minor)
 /// The function performs binary search in this sorted table.
 /// If it finds a pair that maches val, it returns directly the
 /// index in the table, otherwise it returns -1.
+/// If the hash lookup is enabled, see SetHashLookup, the pair is looked up
+/// in a hash table instead, in constant time.
 ///
 /// See also GetEntryNumberWithBestIndex
 
@@ -418,6 +803,16 @@ Long64_t TTreeIndex::GetEntryNumberWithIndex(Long64_t major, Long64_t minor) con
 {
    if (fN == 0) return -1;
 
+   if (!fHashSlots.empty()) {
+      const ULong64_t mask = fHashSlots.size() - 1;
+      for (ULong64_t slot = HashIndexValues(major, minor) & mask; fHashSlots[slot] >= 0; slot = (slot + 1) & mask) {
+         const Long64_t pos = fHashSlots[slot];
+         if (fIndexValues[pos] == major && fIndexValuesMinor[pos] == minor)
+            return fIndex[pos];
+      }
+      return -1;
+   }
+
    Long64_t pos = FindValues(major, minor);
    if( pos < fN && fIndexValues[pos] == major && fIndexValuesMinor[pos] == minor )
       return fIndex[pos];
@@ -551,6 +946,33 @@ void TTreeIndex::Print(Option_t * option) const
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Enable or disable the hash lookup of the index values.
+///
+/// With the hash lookup, GetEntryNumberWithIndex, and thus
+/// TTree::GetEntryWithIndex and the lookups of friend trees by index, find
+/// the pair of values in constant time in an open-addressing hash table,
+/// built here and kept in memory beside the sorted tables (about two to four
+/// times the memory of one table). GetEntryNumberWithBestIndex still uses a
+/// binary search in the sorted tables.
+///
+/// The setting is saved with the index, whose layout on file does not depend
+/// on it: the hash table is rebuilt when the index is read back. Older ROOT
+/// versions read such an index and look the values up with a binary search.
+/// ~~~{.cpp}
+///  tree.BuildIndex("Run","Event");
+///  static_cast<TTreeIndex*>(tree.GetTreeIndex())->SetHashLookup();
+/// ~~~
+
+void TTreeIndex::SetHashLookup(Bool_t on)
+{
+   SetBit(kHashLookup, on);
+   if (on)
+      BuildHashTable();
+   else
+      std::vector<Long64_t>().swap(fHashSlots);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Stream an object of class TTreeIndex.
 /// Note that this Streamer should be changed to an automatic Streamer
@@ -576,6 +998,8 @@ void TTreeIndex::Streamer(TBuffer &R__b)
       fIndex      = new Long64_t[fN];
       R__b.ReadFastArray(fIndex,fN);
       R__b.CheckByteCount(R__s, R__c, TTreeIndex::IsA());
+      if (TestBit(kHashLookup)) BuildHashTable();
+      else fHashSlots.clear();
    } else {
       R__c = R__b.WriteVersion(TTreeIndex::IsA(), kTRUE);
       TVirtualIndex::Streamer(R__b);
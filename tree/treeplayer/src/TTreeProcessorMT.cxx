@@ -19,14 +19,26 @@ passes a function whose only parameter is a TTreeReader. The function iterates
 on a subrange of entries by using that TTreeReader.
 
 The implementation of ROOT::TTreeProcessorMT parallelizes the processing of the subranges,
-each corresponding to a cluster in the TTree. This is possible thanks to the use
+each corresponding to one or more consecutive clusters in the TTree. This is possible thanks to the use
 of a ROOT::TThreadedObject, so that each thread works with its own TFile and TTree
 objects.
+
+Subranges are not fixed in advance: the tasks working on a file take ranges of clusters of decreasing size from it,
+coarse at first and finer as the file is drained, and tasks that are done with their file help with the clusters left
+in the files that are still being processed. This keeps all workers busy until the end of the processing even if
+files or clusters differ a lot in processing time.
 */
 
+#include "TFile.h"
 #include "TROOT.h"
+#include "TTreeCache.h"
 #include "ROOT/TTreeProcessorMT.hxx"
 
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <numeric>
+
 using namespace ROOT;
 
 namespace {
@@ -171,53 +183,95 @@ MakeClusters(const std::vector<std::string> &treeNames, const std::vector<std::s
       entriesPerFile.emplace_back(entries);
    }
 
-   // Here we "fuse" together clusters if the number of clusters is to big with respect to
-   // the number of slots, otherwise we can incurr in an overhead which is so big to make
-   // the parallelisation detrimental for performance.
-   // For example, this is the case when following a merging of many small files a file
-   // contains a tree with many entries and with clusters of just a few entries.
-   // The criterion according to which we fuse clusters together is to have at most
-   // TTreeProcessorMT::GetMaxTasksPerFilePerWorker() clusters per file per slot.
-   // For example: given 2 files and 16 workers, at most
-   // 16 * 2 * TTreeProcessorMT::GetMaxTasksPerFilePerWorker() clusters will be created, at most
-   // 16 * TTreeProcessorMT::GetMaxTasksPerFilePerWorker() per file.
-
-   const auto maxTasksPerFile = TTreeProcessorMT::GetMaxTasksPerFilePerWorker() * ROOT::GetThreadPoolSize();
-   std::vector<std::vector<EntryCluster>> eventRangesPerFile(clustersPerFile.size());
-   auto clustersPerFileIt = clustersPerFile.begin();
-   auto eventRangesPerFileIt = eventRangesPerFile.begin();
-   for (; clustersPerFileIt != clustersPerFile.end(); clustersPerFileIt++, eventRangesPerFileIt++) {
-      const auto clustersInThisFileSize = clustersPerFileIt->size();
-      const auto nFolds = clustersInThisFileSize / maxTasksPerFile;
-      // If the number of clusters is less than maxTasksPerFile
-      // we take the clusters as they are
-      if (nFolds == 0) {
-         std::for_each(
-            clustersPerFileIt->begin(), clustersPerFileIt->end(),
-            [&eventRangesPerFileIt](const EntryCluster &clust) { eventRangesPerFileIt->emplace_back(clust); });
-         continue;
-      }
-      // Otherwise, we have to merge clusters, distributing the reminder evenly
-      // onto the first clusters
-      auto nReminderClusters = clustersInThisFileSize % maxTasksPerFile;
-      const auto clustersInThisFile = *clustersPerFileIt;
-      for (auto i = 0ULL; i < clustersInThisFileSize; ++i) {
-         const auto start = clustersInThisFile[i].start;
-         // We lump together at least nFolds clusters, therefore
-         // we need to jump ahead of nFolds-1.
-         i += (nFolds - 1);
-         // We now add a cluster if we have some reminder left
-         if (nReminderClusters > 0) {
-            i += 1U;
-            nReminderClusters--;
+   return std::make_pair(std::move(clustersPerFile), std::move(entriesPerFile));
+}
+
+////////////////////////////////////////////////////////////////////////
+/// The clusters of one input file that are still to be processed, together with the information needed to build a
+/// TTreeReader on them. The queue is shared by all tasks that work on the file, which take cluster-aligned ranges of
+/// decreasing size from it (guided scheduling): ranges are coarse while there is a lot of work left and get finer as
+/// the file is drained, so that tasks of the same or of other files can split the remaining work among themselves.
+class ClusterQueue {
+   std::vector<EntryCluster> fClusters;
+   std::size_t fNext = 0u;     ///< Index of the first cluster not processed yet
+   std::size_t fMinRange = 1u; ///< Minimum number of clusters per range
+   unsigned int fNWorkers = 1u;
+   std::mutex fMutex;
+
+public:
+   /// Tree name, file name and number of entries of this file, used when clusters have local entry numbers
+   std::vector<std::string> fTreeNames;
+   std::vector<std::string> fFileNames;
+   std::vector<Long64_t> fEntries;
+
+   void SetClusters(std::vector<EntryCluster> clusters, unsigned int nWorkers, unsigned int maxTasksPerWorker)
+   {
+      std::lock_guard<std::mutex> lock(fMutex);
+      fClusters = std::move(clusters);
+      fNWorkers = std::max(nWorkers, 1u);
+      // never create more than maxTasksPerWorker tasks per worker for this file, even if it has many tiny clusters
+      const auto maxTasks = std::max(1u, maxTasksPerWorker * fNWorkers);
+      fMinRange = std::max<std::size_t>(1u, (fClusters.size() + maxTasks - 1u) / maxTasks);
+   }
+
+   std::size_t GetNRemaining()
+   {
+      std::lock_guard<std::mutex> lock(fMutex);
+      return fClusters.size() - fNext;
+   }
+
+   /// Take the next range of clusters to process. Return false if there are none left.
+   bool Pop(EntryCluster &range)
+   {
+      std::lock_guard<std::mutex> lock(fMutex);
+      const auto nRemaining = fClusters.size() - fNext;
+      if (nRemaining == 0u)
+         return false;
+      auto nClusters = std::min(nRemaining, std::max(fMinRange, nRemaining / (2u * fNWorkers)));
+      if (nRemaining - nClusters < fMinRange) // do not leave a range smaller than the minimum behind
+         nClusters = nRemaining;
+      range = EntryCluster{fClusters[fNext].start, fClusters[fNext + nClusters - 1u].end};
+      fNext += nClusters;
+      return true;
+   }
+};
+
+////////////////////////////////////////////////////////////////////////
+/// Keep track of the files that are being processed, so that tasks that are done with their own file can help with
+/// the files that still have clusters left instead of idling.
+class InFlightFiles {
+   std::vector<ClusterQueue *> fQueues;
+   std::mutex fMutex;
+
+public:
+   void Add(ClusterQueue &q)
+   {
+      std::lock_guard<std::mutex> lock(fMutex);
+      fQueues.emplace_back(&q);
+   }
+
+   void Remove(ClusterQueue &q)
+   {
+      std::lock_guard<std::mutex> lock(fMutex);
+      fQueues.erase(std::remove(fQueues.begin(), fQueues.end(), &q), fQueues.end());
+   }
+
+   /// Return the in-flight file with the most clusters left, or nullptr if all in-flight files are drained
+   ClusterQueue *GetBusiest()
+   {
+      std::lock_guard<std::mutex> lock(fMutex);
+      ClusterQueue *busiest = nullptr;
+      std::size_t maxRemaining = 0u;
+      for (auto *q : fQueues) {
+         const auto nRemaining = q->GetNRemaining();
+         if (nRemaining > maxRemaining) {
+            maxRemaining = nRemaining;
+            busiest = q;
          }
-         const auto end = clustersInThisFile[i].end;
-         eventRangesPerFileIt->emplace_back(EntryCluster({start, end}));
       }
+      return busiest;
    }
-
-   return std::make_pair(std::move(eventRangesPerFile), std::move(entriesPerFile));
-}
+};
 
 ////////////////////////////////////////////////////////////////////////
 /// Return a vector containing the number of entries of each file of each friend TChain
@@ -281,11 +335,32 @@ static std::vector<std::string> GetTreeFullPaths(const TTree &tree)
    return {tree.GetName()};
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Set the read-ahead of the TTreeCache of a chain whenever the chain loads a tree.
+/// The cache is created here if it does not exist yet: it is the one the TTreeReader then configures.
+class TCacheReadAheadLink final : public TNotifyLinkBase {
+   TChain &fChain;
+   const Double_t fReadAhead;
+
+public:
+   TCacheReadAheadLink(TChain &chain, Double_t readAhead) : fChain(chain), fReadAhead(readAhead) {}
+
+   Bool_t Notify() final
+   {
+      if (auto curFile = fChain.GetCurrentFile()) {
+         if (auto cache = fChain.GetTree()->GetReadCache(curFile, true))
+            cache->SetReadAhead(fReadAhead);
+      }
+      return fNext ? fNext->Notify() : kTRUE;
+   }
+};
+
 } // anonymous namespace
 
 namespace ROOT {
 
 unsigned int TTreeProcessorMT::fgMaxTasksPerFilePerWorker = 24U;
+std::atomic<Double_t> TTreeProcessorMT::fgCacheReadAhead{-1.};
 
 namespace Internal {
 
@@ -310,6 +385,13 @@ void TTreeView::MakeChain(const std::vector<std::string> &treeNames, const std::
    }
    fChain->ResetBit(TObject::kMustCleanup);
 
+   fReadAheadLink.reset();
+   const auto readAhead = TTreeProcessorMT::GetCacheReadAhead();
+   if (readAhead >= 0) {
+      fReadAheadLink.reset(new TCacheReadAheadLink(*fChain, readAhead));
+      fReadAheadLink->PrependLink(*fChain);
+   }
+
    fFriends.clear();
    const auto nFriends = friendNames.size();
    for (auto i = 0u; i < nFriends; ++i) {
@@ -353,6 +435,7 @@ TTreeView::GetTreeReader(Long64_t start, Long64_t end, const std::vector<std::st
    }
    auto reader = std::make_unique<TTreeReader>(fChain.get(), fEntryList.get());
    reader->SetEntriesRange(start, end);
+
    return reader;
 }
 
@@ -586,31 +669,50 @@ void TTreeProcessorMT::Process(std::function<void(TTreeReader &)> func)
    const auto friendEntries =
       hasFriends ? GetFriendEntries(friendNames, friendFileNames) : std::vector<std::vector<Long64_t>>{};
 
-   // Parent task, spawns tasks that process each of the entry clusters for each input file
-   // TODO: for readability we should have two versions of this lambda, for shouldRetrieveAllClusters == true/false
+   const auto nWorkers = std::max(fPool.GetPoolSize(), 1u);
+   const auto maxTasksPerWorker = GetMaxTasksPerFilePerWorker();
+   std::vector<ClusterQueue> queues(fFileNames.size());
+   InFlightFiles inFlightFiles;
+
+   auto processRange = [&](ClusterQueue &q, const EntryCluster &range) {
+      // with global entry numbers all files are needed to build the TTreeReader, otherwise just the one of the queue
+      const auto &theseTrees = shouldRetrieveAllClusters ? fTreeNames : q.fTreeNames;
+      const auto &theseFiles = shouldRetrieveAllClusters ? fFileNames : q.fFileNames;
+      const auto &theseEntries = shouldRetrieveAllClusters ? entries : q.fEntries;
+      auto r = fTreeView->GetTreeReader(range.start, range.end, theseTrees, theseFiles, fFriendInfo, fEntryList,
+                                        theseEntries, friendEntries);
+      func(*r);
+   };
+
+   // Parent task, spawns one task per worker that processes the clusters of each input file.
+   // Once the clusters of its file are exhausted, a task helps with the remaining clusters of the other files that
+   // are being processed, so that no worker idles while a few large files or expensive clusters are left.
    auto processFile = [&](std::size_t fileIdx) {
-      // theseFiles contains either all files or just the single file to process
-      const auto &theseFiles = shouldRetrieveAllClusters ? fFileNames : std::vector<std::string>({fFileNames[fileIdx]});
-      // either all tree names or just the single tree to process
-      const auto &theseTrees = shouldRetrieveAllClusters ? fTreeNames : std::vector<std::string>({fTreeNames[fileIdx]});
-      // Evaluate clusters (with local entry numbers) and number of entries for this file, if needed
-      const auto theseClustersAndEntries =
-         shouldRetrieveAllClusters ? ClustersAndEntries{} : MakeClusters(theseTrees, theseFiles);
-
-      // All clusters for the file to process, either with global or local entry numbers
-      const auto &thisFileClusters = shouldRetrieveAllClusters ? clusters[fileIdx] : theseClustersAndEntries.first[0];
-
-      // Either all number of entries or just the ones for this file
-      const auto &theseEntries =
-         shouldRetrieveAllClusters ? entries : std::vector<Long64_t>({theseClustersAndEntries.second[0]});
-
-      auto processCluster = [&](const EntryCluster &c) {
-         auto r = fTreeView->GetTreeReader(c.start, c.end, theseTrees, theseFiles, fFriendInfo, fEntryList,
-                                           theseEntries, friendEntries);
-         func(*r);
+      auto &queue = queues[fileIdx];
+      if (shouldRetrieveAllClusters) {
+         queue.SetClusters(clusters[fileIdx], nWorkers, maxTasksPerWorker);
+      } else {
+         // evaluate clusters (with local entry numbers) and number of entries for this file only
+         queue.fTreeNames = {fTreeNames[fileIdx]};
+         queue.fFileNames = {fFileNames[fileIdx]};
+         auto theseClustersAndEntries = MakeClusters(queue.fTreeNames, queue.fFileNames);
+         queue.fEntries = {theseClustersAndEntries.second[0]};
+         queue.SetClusters(std::move(theseClustersAndEntries.first[0]), nWorkers, maxTasksPerWorker);
+      }
+      inFlightFiles.Add(queue);
+
+      auto processClusters = [&]() {
+         EntryCluster range;
+         while (queue.Pop(range))
+            processRange(queue, range);
+         while (auto *busiest = inFlightFiles.GetBusiest()) {
+            if (busiest->Pop(range))
+               processRange(*busiest, range);
+         }
       };
 
-      fPool.Foreach(processCluster, thisFileClusters);
+      fPool.Foreach(processClusters, nWorkers);
+      inFlightFiles.Remove(queue);
    };
 
    std::vector<std::size_t> fileIdxs(fFileNames.size());
@@ -638,3 +740,24 @@ void TTreeProcessorMT::SetMaxTasksPerFilePerWorker(unsigned int maxTasksPerFile)
 {
    fgMaxTasksPerFilePerWorker = maxTasksPerFile;
 }
+
+////////////////////////////////////////////////////////////////////////
+/// \brief Gets the read-ahead fraction used for the TTreeCache of each worker.
+/// \return The fraction, or a negative value if the TTreeCache default is used
+Double_t TTreeProcessorMT::GetCacheReadAhead()
+{
+   return fgCacheReadAhead;
+}
+
+////////////////////////////////////////////////////////////////////////
+/// \brief Sets the read-ahead fraction used for the TTreeCache of each worker.
+/// \param[in] fraction Fraction of a cluster range after which the next one is read ahead, 0 to disable the
+/// read-ahead, or a negative value to use the TTreeCache default.
+///
+/// With the read-ahead enabled, the baskets of the next clusters of each worker are read in the background
+/// while it processes the current ones. See TTreeCache::SetReadAhead.
+/// Only the chains set up after the call use the new value.
+void TTreeProcessorMT::SetCacheReadAhead(Double_t fraction)
+{
+   fgCacheReadAhead = fraction;
+}
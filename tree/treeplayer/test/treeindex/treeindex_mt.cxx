@@ -0,0 +1,225 @@
+#include "ROOT/TSeq.hxx"
+#include "TBufferFile.h"
+#include "TChain.h"
+#include "TChainIndex.h"
+#include "TFile.h"
+#include "TROOT.h"
+#include "TSystem.h"
+#include "TTree.h"
+#include "TTreeCache.h"
+#include "TTreeIndex.h"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+constexpr int kEventsPerRun = 1000;
+constexpr int kRunsPerFile = 100;
+
+// The events of each run are stored out of order.
+Int_t GetEvent(Long64_t entry)
+{
+   return (entry % kEventsPerRun) * 7 % kEventsPerRun;
+}
+
+void CreateFile(const std::string &fileName, int firstRun)
+{
+   TFile file(fileName.c_str(), "RECREATE");
+   TTree tree("tree", "A tree with run and event numbers");
+   tree.SetAutoFlush(5000);
+   Int_t run, event;
+   Double_t x;
+   tree.Branch("run", &run, "run/I");
+   tree.Branch("event", &event, "event/I");
+   tree.Branch("x", &x, "x/D");
+   for (Long64_t i = 0; i < kRunsPerFile * kEventsPerRun; ++i) {
+      run = firstRun + i / kEventsPerRun;
+      event = GetEvent(i);
+      x = 0.5 * i;
+      tree.Fill();
+   }
+   file.Write();
+}
+
+class TTreeIndexMT : public ::testing::Test {
+protected:
+   static void SetUpTestCase()
+   {
+      for (auto i : ROOT::TSeqI(3))
+         CreateFile(FileName(i), 1 + i * kRunsPerFile);
+   }
+   static void TearDownTestCase()
+   {
+      for (auto i : ROOT::TSeqI(3))
+         gSystem->Unlink(FileName(i).c_str());
+   }
+   void TearDown() override { ROOT::DisableImplicitMT(); }
+   static std::string FileName(int i) { return "treeindex_mt" + std::to_string(i) + ".root"; }
+};
+
+void CheckLookups(const TTree &tree, const TVirtualIndex &index, int firstRun)
+{
+   for (Long64_t i = 0; i < tree.GetEntries(); ++i)
+      ASSERT_EQ(index.GetEntryNumberWithIndex(firstRun + i / kEventsPerRun, GetEvent(i)), i);
+   EXPECT_EQ(index.GetEntryNumberWithIndex(firstRun - 1, 0), -1);
+   EXPECT_EQ(index.GetEntryNumberWithIndex(firstRun, kEventsPerRun), -1);
+}
+
+// Read a TTreeIndex as the readers of the plain layout, e.g. older ROOT versions, do: return the result of the byte
+// count check, 0 if the whole object was read, and the sorted tables one after the other in values.
+Int_t ReadPlainLayout(TBuffer &buffer, std::vector<Long64_t> &values)
+{
+   UInt_t start, count;
+   buffer.ReadVersion(&start, &count);
+   TTreeIndex index;
+   index.TVirtualIndex::Streamer(buffer);
+   TString majorName, minorName;
+   majorName.Streamer(buffer);
+   minorName.Streamer(buffer);
+   Long64_t n = -1;
+   buffer >> n;
+   values.resize(3 * n);
+   for (int i = 0; i < 3; ++i)
+      buffer.ReadFastArray(values.data() + i * n, n);
+   return buffer.CheckByteCount(start, count, TTreeIndex::Class());
+}
+} // anonymous namespace
+
+TEST_F(TTreeIndexMT, BulkBuild)
+{
+   std::unique_ptr<TFile> file(TFile::Open(FileName(0).c_str()));
+   auto tree = file->Get<TTree>("tree");
+   ASSERT_NE(tree, nullptr);
+   EXPECT_TRUE(TTreeIndex::IsBulkReadable(tree, "run", "event"));
+   EXPECT_FALSE(TTreeIndex::IsBulkReadable(tree, "run", "event+1"));
+
+   // Expressions are evaluated with TTreeFormula, entry by entry.
+   TTreeIndex reference(tree, "run*1", "event*1");
+   ASSERT_FALSE(reference.IsZombie());
+
+   ROOT::EnableImplicitMT(4);
+   TTreeIndex index(tree, "run", "event");
+   ASSERT_FALSE(index.IsZombie());
+   ASSERT_EQ(index.GetN(), reference.GetN());
+   for (Long64_t i = 0; i < index.GetN(); ++i) {
+      ASSERT_EQ(index.GetIndexValues()[i], reference.GetIndexValues()[i]);
+      ASSERT_EQ(index.GetIndexValuesMinor()[i], reference.GetIndexValuesMinor()[i]);
+      ASSERT_EQ(index.GetIndex()[i], reference.GetIndex()[i]);
+   }
+   CheckLookups(*tree, index, 1);
+}
+
+TEST_F(TTreeIndexMT, BulkBuildAfterGetEntry)
+{
+   std::unique_ptr<TFile> file(TFile::Open(FileName(0).c_str()));
+   auto tree = file->Get<TTree>("tree");
+   ASSERT_NE(tree, nullptr);
+   Int_t run = -1, event = -1;
+   tree->SetBranchAddress("run", &run);
+   tree->SetBranchAddress("event", &event);
+   // Some baskets of the branches are in memory before the index is built, without IMT.
+   const Long64_t entries[] = {0, 12345, 70000};
+   for (auto entry : entries)
+      ASSERT_GT(tree->GetEntry(entry), 0);
+   TTreeCache *cache = tree->GetReadCache(file.get());
+
+   ASSERT_FALSE(ROOT::IsImplicitMTEnabled());
+   TTreeIndex reference(tree, "run*1", "event*1");
+   TTreeIndex index(tree, "run", "event");
+   ASSERT_FALSE(index.IsZombie());
+   ASSERT_EQ(index.GetN(), reference.GetN());
+   for (Long64_t i = 0; i < index.GetN(); ++i) {
+      ASSERT_EQ(index.GetIndexValues()[i], reference.GetIndexValues()[i]);
+      ASSERT_EQ(index.GetIndexValuesMinor()[i], reference.GetIndexValuesMinor()[i]);
+      ASSERT_EQ(index.GetIndex()[i], reference.GetIndex()[i]);
+   }
+   CheckLookups(*tree, index, 1);
+
+   // The baskets and the cache of the tree were left alone.
+   EXPECT_EQ(tree->GetReadCache(file.get()), cache);
+   for (auto entry : entries) {
+      ASSERT_GT(tree->GetEntry(entry), 0);
+      EXPECT_EQ(run, 1 + entry / kEventsPerRun);
+      EXPECT_EQ(event, GetEvent(entry));
+   }
+}
+
+TEST_F(TTreeIndexMT, HashLookup)
+{
+   const auto fileName = FileName(0);
+   std::unique_ptr<TFile> file(TFile::Open(fileName.c_str()));
+   auto tree = file->Get<TTree>("tree");
+   ASSERT_NE(tree, nullptr);
+   TTreeIndex index(tree, "run", "event");
+   ASSERT_FALSE(index.IsZombie());
+   index.SetHashLookup();
+   EXPECT_TRUE(index.IsHashLookup());
+   CheckLookups(*tree, index, 1);
+   for (Long64_t i = 0; i < tree->GetEntries(); i += 997)
+      EXPECT_EQ(index.GetEntryNumberWithBestIndex(1 + i / kEventsPerRun, GetEvent(i)), i);
+
+   // The setting is saved with the index, the hash table is rebuilt when it is read back.
+   const auto hashFileName = "treeindex_mt_hash.root";
+   {
+      TFile hashFile(hashFileName, "RECREATE");
+      hashFile.WriteObject(&index, "index");
+   }
+   TFile hashFile(hashFileName);
+   auto readIndex = hashFile.Get<TTreeIndex>("index");
+   ASSERT_NE(readIndex, nullptr);
+   EXPECT_TRUE(readIndex->IsHashLookup());
+   ASSERT_EQ(readIndex->GetN(), index.GetN());
+   for (Long64_t i = 0; i < index.GetN(); ++i) {
+      ASSERT_EQ(readIndex->GetIndexValues()[i], index.GetIndexValues()[i]);
+      ASSERT_EQ(readIndex->GetIndexValuesMinor()[i], index.GetIndexValuesMinor()[i]);
+      ASSERT_EQ(readIndex->GetIndex()[i], index.GetIndex()[i]);
+   }
+   CheckLookups(*tree, *readIndex, 1);
+   delete readIndex;
+   gSystem->Unlink(hashFileName);
+
+   // The layout on file does not depend on the lookup: readers of the plain layout, e.g. older ROOT versions,
+   // read the sorted tables of the index.
+   std::vector<Long64_t> values;
+   TBufferFile buffer(TBuffer::kWrite);
+   index.Streamer(buffer);
+   buffer.SetReadMode();
+   buffer.SetBufferOffset(0);
+   ASSERT_EQ(ReadPlainLayout(buffer, values), 0);
+   const Long64_t n = index.GetN();
+   ASSERT_EQ(values.size(), static_cast<size_t>(3 * n));
+   for (Long64_t i = 0; i < n; ++i) {
+      ASSERT_EQ(values[i], index.GetIndexValues()[i]);
+      ASSERT_EQ(values[n + i], index.GetIndexValuesMinor()[i]);
+      ASSERT_EQ(values[2 * n + i], index.GetIndex()[i]);
+   }
+}
+
+TEST_F(TTreeIndexMT, ChainIndex)
+{
+   ROOT::EnableImplicitMT(4);
+   TChain chain("tree");
+   for (auto i : ROOT::TSeqI(3))
+      chain.Add(FileName(i).c_str());
+   ASSERT_GE(chain.BuildIndex("run", "event"), 0);
+   auto index = dynamic_cast<TChainIndex *>(chain.GetTreeIndex());
+   ASSERT_NE(index, nullptr);
+   EXPECT_FALSE(index->IsZombie());
+
+   Int_t run = -1, event = -1;
+   Double_t x = -1;
+   chain.SetBranchAddress("run", &run);
+   chain.SetBranchAddress("event", &event);
+   chain.SetBranchAddress("x", &x);
+   for (Long64_t i = 0; i < chain.GetEntries(); i += 4999) {
+      const Long64_t local = i % (kRunsPerFile * kEventsPerRun);
+      ASSERT_GT(chain.GetEntryWithIndex(1 + i / kEventsPerRun, GetEvent(i)), 0);
+      EXPECT_EQ(run, 1 + i / kEventsPerRun);
+      EXPECT_EQ(event, GetEvent(i));
+      EXPECT_DOUBLE_EQ(x, 0.5 * local);
+   }
+   EXPECT_EQ(chain.GetEntryNumberWithIndex(3 * kRunsPerFile + 1, 0), -1);
+}